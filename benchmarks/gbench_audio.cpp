@@ -0,0 +1,208 @@
+#include "benchmark/benchmark.h"
+#include <cmath>
+#include <cstring>
+#include <nctl/Array.h>
+#include <nctl/UniquePtr.h>
+#include <ncine/PCApplication.h>
+#include <ncine/IAppEventHandler.h>
+#include <ncine/AppConfiguration.h>
+#include <ncine/ServiceLocator.h>
+#include <ncine/AudioBuffer.h>
+#include <ncine/AudioBufferPlayer.h>
+#include <ncine/AudioStreamPlayer.h>
+#include <ncine/SoftwareAudio.h>
+
+namespace nc = ncine;
+
+namespace {
+
+/// Number of frames mixed at each iteration, about 23 milliseconds
+const unsigned int FramesPerMix = 1024;
+const float ClipDuration = 2.0f;
+
+/// Creates the file in memory of a 16 bits WAV clip with a sine wave
+nctl::Array<unsigned char> createWavClip(int numChannels, int frequency, float duration)
+{
+	const uint32_t numFrames = static_cast<uint32_t>(frequency * duration);
+	const uint16_t blockAlign = static_cast<uint16_t>(numChannels * 2);
+	const uint32_t dataSize = numFrames * blockAlign;
+	const uint32_t riffSize = 36 + dataSize;
+	const uint32_t fmtSize = 16;
+	const uint16_t format = 1;
+	const uint16_t channels = static_cast<uint16_t>(numChannels);
+	const uint32_t sampleRate = static_cast<uint32_t>(frequency);
+	const uint32_t byteRate = sampleRate * blockAlign;
+	const uint16_t bitsPerSample = 16;
+
+	nctl::Array<unsigned char> clip;
+	clip.setSize(44 + dataSize);
+	unsigned char *ptr = clip.data();
+	auto append = [&ptr](const void *data, unsigned int size) {
+		memcpy(ptr, data, size);
+		ptr += size;
+	};
+
+	append("RIFF", 4);
+	append(&riffSize, 4);
+	append("WAVEfmt ", 8);
+	append(&fmtSize, 4);
+	append(&format, 2);
+	append(&channels, 2);
+	append(&sampleRate, 4);
+	append(&byteRate, 4);
+	append(&blockAlign, 2);
+	append(&bitsPerSample, 2);
+	append("data", 4);
+	append(&dataSize, 4);
+
+	for (uint32_t i = 0; i < numFrames; i++)
+	{
+		const int16_t sample = static_cast<int16_t>(8192.0f * sinf(i * 440.0f * 6.2831853f / frequency));
+		for (int channel = 0; channel < numChannels; channel++)
+			append(&sample, 2);
+	}
+
+	return clip;
+}
+
+/// A clip played by a number of looping players, at a frequency that might need resampling
+class AudioFixture : public benchmark::Fixture
+{
+  public:
+	void SetUp(const ::benchmark::State &state) override
+	{
+		// Sources only advance when the benchmark mixes them
+		nc::SoftwareAudio::setMixingOnUpdate(false);
+		nc::SoftwareAudio::setSink(nc::SoftwareAudio::Sink::NONE);
+		clip_ = createWavClip(static_cast<int>(state.range(1)), static_cast<int>(state.range(2)), ClipDuration);
+	}
+
+	void TearDown(const ::benchmark::State &state) override
+	{
+		nc::theServiceLocator().audioDevice().stopPlayers();
+		players_.clear();
+		streamPlayers_.clear();
+		audioBuffer_.reset(nullptr);
+		nc::SoftwareAudio::setMixingOnUpdate(true);
+	}
+
+  protected:
+	nctl::Array<unsigned char> clip_;
+	nctl::UniquePtr<nc::AudioBuffer> audioBuffer_;
+	nctl::Array<nctl::UniquePtr<nc::AudioBufferPlayer>> players_;
+	nctl::Array<nctl::UniquePtr<nc::AudioStreamPlayer>> streamPlayers_;
+
+	void setLabel(benchmark::State &state)
+	{
+		char label[64];
+		snprintf(label, 64, "%s %ld Hz", state.range(1) == 1 ? "mono" : "stereo", static_cast<long>(state.range(2)));
+		state.SetLabel(label);
+	}
+};
+
+void audioArguments(benchmark::internal::Benchmark *benchmark)
+{
+	for (int64_t numChannels = 1; numChannels <= 2; numChannels++)
+	{
+		// The second frequency is resampled to the one of the mixer
+		for (int64_t frequency : { 44100, 22050 })
+		{
+			for (int64_t numPlayers = 1; numPlayers <= 16; numPlayers *= 4)
+				benchmark->Args({ numPlayers, numChannels, frequency });
+		}
+	}
+	benchmark->Unit(benchmark::kMicrosecond);
+}
+
+}
+
+BENCHMARK_DEFINE_F(AudioFixture, LoadBuffer)(benchmark::State &state)
+{
+	setLabel(state);
+	audioBuffer_ = nctl::makeUnique<nc::AudioBuffer>();
+
+	for (auto _ : state)
+		audioBuffer_->loadFromMemory("clip.wav", clip_.data(), clip_.size());
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * clip_.size());
+}
+BENCHMARK_REGISTER_F(AudioFixture, LoadBuffer)->Args({ 1, 1, 44100 })->Args({ 1, 2, 44100 })->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(AudioFixture, MixBufferPlayers)(benchmark::State &state)
+{
+	setLabel(state);
+	audioBuffer_ = nctl::makeUnique<nc::AudioBuffer>("clip.wav", clip_.data(), clip_.size());
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		players_.pushBack(nctl::makeUnique<nc::AudioBufferPlayer>(audioBuffer_.get()));
+		players_.back()->setLooping(true);
+		players_.back()->play();
+	}
+
+	for (auto _ : state)
+		nc::SoftwareAudio::mix(FramesPerMix);
+
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * FramesPerMix);
+}
+BENCHMARK_REGISTER_F(AudioFixture, MixBufferPlayers)->Apply(audioArguments);
+
+BENCHMARK_DEFINE_F(AudioFixture, MixStreamPlayers)(benchmark::State &state)
+{
+	setLabel(state);
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		streamPlayers_.pushBack(nctl::makeUnique<nc::AudioStreamPlayer>("clip.wav", clip_.data(), clip_.size()));
+		// Decoding on this thread makes its cost part of the measure
+		streamPlayers_.back()->setStreamBuffers(nc::AudioStream::DefaultNumBuffers, nc::AudioStream::DefaultBufferSize, false);
+		streamPlayers_.back()->setLooping(true);
+		streamPlayers_.back()->play();
+	}
+
+	nc::IAudioDevice &audioDevice = nc::theServiceLocator().audioDevice();
+	for (auto _ : state)
+	{
+		nc::SoftwareAudio::mix(FramesPerMix);
+		audioDevice.updatePlayers();
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * FramesPerMix);
+}
+BENCHMARK_REGISTER_F(AudioFixture, MixStreamPlayers)->Apply(audioArguments);
+
+namespace {
+
+/// Runs the benchmarks inside the first frame, once the software audio device has been created
+class BenchmarkEventHandler : public nc::IAppEventHandler
+{
+  public:
+	void onPreInit(nc::AppConfiguration &config) override
+	{
+		// Memory files always warn that they are already opened when a loader opens them
+		config.consoleLogLevel = nc::ILogger::LogLevel::ERROR;
+		config.withAudio = true;
+		config.withDebugOverlay = false;
+	}
+
+	void onFrameStart() override
+	{
+		benchmark::RunSpecifiedBenchmarks();
+		benchmark::Shutdown();
+		nc::theApplication().quit();
+	}
+};
+
+nctl::UniquePtr<nc::IAppEventHandler> createAppEventHandler()
+{
+	return nctl::makeUnique<BenchmarkEventHandler>();
+}
+
+}
+
+int main(int argc, char **argv)
+{
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+
+	return nc::PCApplication::start(createAppEventHandler, argc, argv);
+}
@@ -11,6 +11,31 @@ const float scalingY = 1.5f;
 const float anchorX = -5.0f;
 const float anchorY = 10.0f;
 
+const unsigned int NumElements = 512;
+// Not in an anonymous namespace, or the compiler could skip the computations that do not change between runs
+ncine::Matrix4x4f matsA[NumElements];
+ncine::Matrix4x4f matsB[NumElements];
+ncine::Vector4f vecsA[NumElements];
+ncine::Vector4f vecsB[NumElements];
+
+namespace {
+
+void resetData()
+{
+	for (unsigned int i = 0; i < NumElements; i++)
+	{
+		const float f = static_cast<float>(i + 1);
+		// Rotation matrices keep the chained products in range
+		matsA[i] = ncine::Matrix4x4f::rotationZ(f);
+		matsA[i].rotateX(2.0f * f);
+		matsB[i] = matsA[i];
+		vecsA[i].set(f, -f, f, 1.0f);
+		vecsB[i].set(f, f, f, f);
+	}
+}
+
+}
+
 static void BM_TransformNodeFromIdentity(benchmark::State &state)
 {
 	ncine::Matrix4x4f matrix;
@@ -128,4 +153,56 @@ static void BM_ManyTransformationsInPlace(benchmark::State &state)
 }
 BENCHMARK(BM_ManyTransformationsInPlace)->Arg(Repetitions / 4)->Arg(Repetitions / 2)->Arg(Repetitions);
 
+static void BM_MatrixMult(benchmark::State &state)
+{
+	resetData();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumElements - 1; i++)
+			matsA[i] = matsA[i] * matsA[i + 1];
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * (NumElements - 1));
+}
+BENCHMARK(BM_MatrixMult);
+
+static void BM_MatrixTrans(benchmark::State &state)
+{
+	resetData();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumElements; i++)
+			matsB[i] = matsA[i].transposed();
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+BENCHMARK(BM_MatrixTrans);
+
+static void BM_MatrixVecMult(benchmark::State &state)
+{
+	resetData();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumElements; i++)
+			vecsB[i] = matsA[i] * vecsA[i];
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+BENCHMARK(BM_MatrixVecMult);
+
+static void BM_VecMatrixMult(benchmark::State &state)
+{
+	resetData();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumElements; i++)
+			vecsB[i] = vecsA[i] * matsA[i];
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+BENCHMARK(BM_VecMatrixMult);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,126 @@
+#include "benchmark/benchmark.h"
+#include <nctl/algorithms.h>
+#include <nctl/Array.h>
+#include <nctl/UniquePtr.h>
+#include <ncine/Random.h>
+
+namespace nc = ncine;
+
+namespace {
+
+const unsigned int NumLayers = 4;
+const unsigned int NumMaterials = 32;
+
+/// A stand-in for a render command, with its sort keys buried among unrelated data
+struct Command
+{
+	unsigned char before[256];
+	uint64_t materialSortKey;
+	uint32_t idSortKey;
+	unsigned char after[256];
+};
+
+/// The packed sort key of a command, as collected by the render queue
+struct SortKey
+{
+	uint64_t materialKey;
+	uint32_t idKey;
+	uint32_t commandIndex;
+};
+
+bool descendingOrder(const Command *a, const Command *b)
+{
+	return (a->materialSortKey != b->materialSortKey)
+	           ? a->materialSortKey > b->materialSortKey
+	           : a->idSortKey > b->idSortKey;
+}
+
+class RenderSortFixture : public benchmark::Fixture
+{
+  public:
+	void SetUp(const ::benchmark::State &state) override
+	{
+		const unsigned int numCommands = static_cast<unsigned int>(state.range(0));
+		nc::random().init(numCommands, numCommands);
+
+		commands_ = nctl::makeUnique<Command[]>(numCommands);
+		queue_.clear();
+		for (unsigned int i = 0; i < numCommands; i++)
+		{
+			Command &command = commands_[i];
+			const uint64_t layer = nc::random().integer(0, NumLayers);
+			command.materialSortKey = (layer << 48) + nc::random().integer(0, NumMaterials) * 0x9E3779B1u;
+			command.idSortKey = i;
+			queue_.pushBack(&command);
+		}
+
+		// Commands are visited in a different order than they have been allocated
+		for (unsigned int i = numCommands - 1; i > 0; i--)
+			nctl::swap(queue_[i], queue_[nc::random().integer(0, i + 1)]);
+
+		sortKeys_.clear();
+		for (unsigned int i = 0; i < numCommands; i++)
+		{
+			SortKey sortKey;
+			sortKey.materialKey = ~queue_[i]->materialSortKey;
+			sortKey.idKey = ~queue_[i]->idSortKey;
+			sortKey.commandIndex = i;
+			sortKeys_.pushBack(sortKey);
+		}
+	}
+
+	void TearDown(const ::benchmark::State &state) override
+	{
+		commands_.reset(nullptr);
+	}
+
+  protected:
+	nctl::UniquePtr<Command[]> commands_;
+	nctl::Array<Command *> queue_;
+	nctl::Array<SortKey> sortKeys_;
+};
+
+}
+
+BENCHMARK_DEFINE_F(RenderSortFixture, PointerQuicksort)(benchmark::State &state)
+{
+	nctl::Array<Command *> queue(queue_.size());
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		queue = queue_;
+		state.ResumeTiming();
+
+		nctl::quicksort(queue.begin(), queue.end(), descendingOrder);
+		benchmark::DoNotOptimize(queue.data());
+	}
+}
+BENCHMARK_REGISTER_F(RenderSortFixture, PointerQuicksort)->Arg(1000)->Arg(10000)->Arg(100000);
+
+BENCHMARK_DEFINE_F(RenderSortFixture, PackedKeysRadixSort)(benchmark::State &state)
+{
+	nctl::Array<SortKey> sortKeys(sortKeys_.size());
+	nctl::Array<SortKey> scratch(sortKeys_.size());
+	scratch.setSize(sortKeys_.size());
+	nctl::Array<Command *> queue(queue_.size());
+	queue.setSize(queue_.size());
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		sortKeys = sortKeys_;
+		state.ResumeTiming();
+
+		SortKey *first = sortKeys.data();
+		SortKey *last = first + sortKeys.size();
+		nctl::radixSort(first, last, scratch.data(), [](const SortKey &key) { return key.idKey; });
+		nctl::radixSort(first, last, scratch.data(), [](const SortKey &key) { return key.materialKey; });
+		for (unsigned int i = 0; i < sortKeys.size(); i++)
+			queue[i] = queue_[sortKeys[i].commandIndex];
+		benchmark::DoNotOptimize(queue.data());
+	}
+}
+BENCHMARK_REGISTER_F(RenderSortFixture, PackedKeysRadixSort)->Arg(1000)->Arg(10000)->Arg(100000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,418 @@
+#include "benchmark/benchmark.h"
+#include <nctl/Array.h>
+#include <nctl/String.h>
+#include <nctl/UniquePtr.h>
+#include <ncine/PCApplication.h>
+#include <ncine/IAppEventHandler.h>
+#include <ncine/AppConfiguration.h>
+#include <ncine/Viewport.h>
+#include <ncine/Texture.h>
+#include <ncine/Font.h>
+#include <ncine/Sprite.h>
+#include <ncine/MeshSprite.h>
+#include <ncine/TextNode.h>
+#include <ncine/ParticleSystem.h>
+#include <ncine/ParticleInitializer.h>
+#include <ncine/Random.h>
+#include "RenderQueue.h"
+#include "RenderResources.h"
+#include "RenderBuffersManager.h"
+#include "RenderCommandPool.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const float Interval = 1.0f / 60.0f;
+/// Number of drawable nodes that share the same parent node
+const unsigned int NodesPerGroup = 32;
+const unsigned int ParticlesPerSystem = 64;
+const unsigned int NumLayers = 4;
+
+const int TextureSize = 64;
+const int GlyphWidth = 4;
+const int GlyphHeight = 6;
+
+enum SceneType
+{
+	SPRITES,
+	MESH_SPRITES,
+	TEXT_NODES,
+	PARTICLE_SYSTEMS,
+	MIXED
+};
+
+const char *sceneTypeString(int64_t sceneType)
+{
+	switch (sceneType)
+	{
+		case SceneType::SPRITES: return "sprites";
+		case SceneType::MESH_SPRITES: return "mesh sprites";
+		case SceneType::TEXT_NODES: return "text nodes";
+		case SceneType::PARTICLE_SYSTEMS: return "particles";
+		case SceneType::MIXED: return "mixed";
+		default: return "unknown";
+	}
+}
+
+/// A viewport that exposes the update and the culling pass of its scenegraph
+class BenchmarkViewport : public nc::Viewport
+{
+  public:
+	using nc::Viewport::update;
+	inline void updateCulling(unsigned long int frame) { nc::Viewport::updateCulling(rootNode_, frame); }
+};
+
+/// A synthetic scene of drawable nodes spread on an area four times the size of the screen
+class Scene
+{
+  public:
+	Scene(unsigned int numNodes, SceneType type);
+
+	inline nc::SceneNode &rootNode() { return rootNode_; }
+	inline BenchmarkViewport &viewport() { return viewport_; }
+	inline nc::RenderQueue &renderQueue() { return renderQueue_; }
+
+	/// Moves the whole scene to dirty the transformations of every node
+	void move();
+	/// Clears the render queue and resets the per-frame memory of the renderer, like at the end of a frame
+	void endFrame();
+
+  private:
+	nc::SceneNode rootNode_;
+	BenchmarkViewport viewport_;
+	nc::RenderQueue renderQueue_;
+	nctl::UniquePtr<nc::Texture> texture_;
+	nctl::UniquePtr<nc::Font> font_;
+	nctl::Array<nctl::UniquePtr<nc::SceneNode>> groups_;
+	nctl::Array<nctl::UniquePtr<nc::SceneNode>> nodes_;
+	bool moved_;
+
+	void createFont();
+	nc::SceneNode *nextParent(float width, float height);
+	void addSprites(unsigned int count, float width, float height);
+	void addMeshSprites(unsigned int count, float width, float height);
+	void addTextNodes(unsigned int count, float width, float height);
+	void addParticleSystems(unsigned int numParticles, float width, float height);
+};
+
+Scene::Scene(unsigned int numNodes, SceneType type)
+    : moved_(false)
+{
+	nc::random().init(numNodes, type);
+
+	nctl::UniquePtr<unsigned char[]> texels = nctl::makeUnique<unsigned char[]>(TextureSize * TextureSize * 4);
+	for (unsigned int i = 0; i < TextureSize * TextureSize * 4; i++)
+		texels[i] = static_cast<unsigned char>(nc::random().integer(0, 256));
+	texture_ = nctl::makeUnique<nc::Texture>("Benchmark", nc::Texture::Format::RGBA8, TextureSize, TextureSize);
+	texture_->loadFromTexels(texels.get());
+	createFont();
+
+	const float width = static_cast<float>(nc::theApplication().width());
+	const float height = static_cast<float>(nc::theApplication().height());
+	switch (type)
+	{
+		case SceneType::SPRITES:
+			addSprites(numNodes, width, height);
+			break;
+		case SceneType::MESH_SPRITES:
+			addMeshSprites(numNodes, width, height);
+			break;
+		case SceneType::TEXT_NODES:
+			addTextNodes(numNodes, width, height);
+			break;
+		case SceneType::PARTICLE_SYSTEMS:
+			addParticleSystems(numNodes, width, height);
+			break;
+		case SceneType::MIXED:
+			addSprites(numNodes - 3 * (numNodes / 8), width, height);
+			addMeshSprites(numNodes / 8, width, height);
+			addTextNodes(numNodes / 8, width, height);
+			addParticleSystems(numNodes / 8, width, height);
+			break;
+	}
+
+	// The first update transforms every node and marks the visible ones as rendered in this frame
+	viewport_.setRootNode(&rootNode_);
+	viewport_.update();
+}
+
+void Scene::move()
+{
+	moved_ = !moved_;
+	rootNode_.setPosition(moved_ ? 1.0f : 0.0f, 0.0f);
+}
+
+void Scene::endFrame()
+{
+	renderQueue_.clear();
+	nc::RenderResources::buffersManager().flushUnmap();
+	nc::RenderResources::buffersManager().remap();
+	nc::RenderResources::renderCommandPool().reset();
+}
+
+void Scene::createFont()
+{
+	const unsigned int FirstChar = 32;
+	const unsigned int LastChar = 126;
+	const unsigned int GlyphsPerRow = TextureSize / GlyphWidth;
+
+	nctl::String fnt(8192);
+	fnt.format("info face=\"Benchmark\" size=%d\n", GlyphHeight);
+	fnt.formatAppend("common lineHeight=%d base=%d scaleW=%d scaleH=%d pages=1 packed=0 alphaChnl=0 redChnl=4 greenChnl=4 blueChnl=4\n",
+	                 GlyphHeight, GlyphHeight, TextureSize, TextureSize);
+	fnt.formatAppend("page id=0 file=\"Benchmark\"\n");
+	fnt.formatAppend("chars count=%u\n", LastChar - FirstChar + 1);
+	for (unsigned int i = FirstChar; i <= LastChar; i++)
+	{
+		const unsigned int index = i - FirstChar;
+		fnt.formatAppend("char id=%u x=%u y=%u width=%d height=%d xoffset=0 yoffset=0 xadvance=%d page=0 chnl=15\n",
+		                 i, (index % GlyphsPerRow) * GlyphWidth, (index / GlyphsPerRow) * GlyphHeight, GlyphWidth, GlyphHeight, GlyphWidth);
+	}
+
+	font_ = nctl::makeUnique<nc::Font>("Benchmark", reinterpret_cast<const unsigned char *>(fnt.data()), fnt.length(), texture_.get());
+}
+
+/// Returns the parent of the next node, adding a new group when the last one is full
+nc::SceneNode *Scene::nextParent(float width, float height)
+{
+	if (groups_.isEmpty() || groups_.back()->children().size() >= NodesPerGroup)
+	{
+		const float x = nc::random().fastReal(-0.5f * width, 1.5f * width);
+		const float y = nc::random().fastReal(-0.5f * height, 1.5f * height);
+		groups_.pushBack(nctl::makeUnique<nc::SceneNode>(&rootNode_, x, y));
+	}
+	return groups_.back().get();
+}
+
+void Scene::addSprites(unsigned int count, float width, float height)
+{
+	for (unsigned int i = 0; i < count; i++)
+	{
+		nctl::UniquePtr<nc::Sprite> sprite = nctl::makeUnique<nc::Sprite>(nextParent(width, height), texture_.get(),
+		                                                                  nc::random().fastReal(-128.0f, 128.0f), nc::random().fastReal(-128.0f, 128.0f));
+		sprite->setRotation(nc::random().fastReal(0.0f, 360.0f));
+		sprite->setLayer(static_cast<uint16_t>(nc::random().integer(0, NumLayers)));
+		// Half of the sprites go to the opaque queue
+		sprite->setBlendingEnabled(i % 2 == 0);
+		nodes_.pushBack(nctl::move(sprite));
+	}
+}
+
+void Scene::addMeshSprites(unsigned int count, float width, float height)
+{
+	const nc::Vector2f points[] = { { 0.0f, 0.0f }, { 0.0f, 64.0f }, { 32.0f, 16.0f },
+		                            { 32.0f, 48.0f }, { 64.0f, 0.0f }, { 64.0f, 64.0f } };
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		nctl::UniquePtr<nc::MeshSprite> meshSprite = nctl::makeUnique<nc::MeshSprite>(nextParent(width, height), texture_.get(),
+		                                                                              nc::random().fastReal(-128.0f, 128.0f), nc::random().fastReal(-128.0f, 128.0f));
+		meshSprite->createVerticesFromTexels(sizeof(points) / sizeof(*points), points);
+		meshSprite->setLayer(static_cast<uint16_t>(nc::random().integer(0, NumLayers)));
+		nodes_.pushBack(nctl::move(meshSprite));
+	}
+}
+
+void Scene::addTextNodes(unsigned int count, float width, float height)
+{
+	for (unsigned int i = 0; i < count; i++)
+	{
+		nctl::UniquePtr<nc::TextNode> textNode = nctl::makeUnique<nc::TextNode>(nextParent(width, height), font_.get());
+		textNode->setPosition(nc::random().fastReal(-128.0f, 128.0f), nc::random().fastReal(-128.0f, 128.0f));
+		textNode->setString(i % 2 ? "Score: 0123456789" : "The quick brown fox");
+		textNode->setLayer(static_cast<uint16_t>(nc::random().integer(0, NumLayers)));
+		nodes_.pushBack(nctl::move(textNode));
+	}
+}
+
+/// Adds particle systems, each one with a fixed amount of live particles
+void Scene::addParticleSystems(unsigned int numParticles, float width, float height)
+{
+	nc::ParticleInitializer init;
+	init.setAmount(ParticlesPerSystem);
+	// Particles should stay alive for the whole benchmark
+	init.setLife(3600.0f);
+	init.setPositionInDisc(64.0f);
+	init.setVelocityAndAngle(nc::Vector2f(0.0f, 8.0f), 30.0f);
+
+	const unsigned int numSystems = (numParticles + ParticlesPerSystem - 1) / ParticlesPerSystem;
+	for (unsigned int i = 0; i < numSystems; i++)
+	{
+		nctl::UniquePtr<nc::ParticleSystem> particleSystem = nctl::makeUnique<nc::ParticleSystem>(nextParent(width, height), ParticlesPerSystem, texture_.get());
+		particleSystem->setPosition(nc::random().fastReal(-128.0f, 128.0f), nc::random().fastReal(-128.0f, 128.0f));
+		particleSystem->emitParticles(init);
+		nodes_.pushBack(nctl::move(particleSystem));
+	}
+}
+
+/// Every benchmark runs inside a single application frame, with the scene moved at each iteration
+/*! \note The culling only tests for overlap the nodes that have not been marked as rendered in the same frame,
+ *  and the batcher reuses the instances of commands that have not changed in a later frame than its cache. */
+class SceneGraphFixture : public benchmark::Fixture
+{
+  public:
+	void SetUp(const ::benchmark::State &state) override
+	{
+		scene_ = nctl::makeUnique<Scene>(static_cast<unsigned int>(state.range(0)), static_cast<SceneType>(state.range(1)));
+		frame_ = nc::theApplication().numFrames();
+	}
+
+	void TearDown(const ::benchmark::State &state) override
+	{
+		scene_->endFrame();
+		scene_.reset(nullptr);
+	}
+
+  protected:
+	nctl::UniquePtr<Scene> scene_;
+	unsigned long int frame_;
+
+	/// Moves, updates and culls the scene without visiting it
+	void prepareFrame()
+	{
+		scene_->move();
+		scene_->rootNode().update(Interval);
+		scene_->viewport().updateCulling(frame_);
+	}
+
+	void visitScene()
+	{
+		unsigned int visitOrderIndex = 0;
+		scene_->rootNode().visit(scene_->renderQueue(), visitOrderIndex);
+	}
+};
+
+void sceneArguments(benchmark::internal::Benchmark *benchmark)
+{
+	for (int64_t sceneType = SceneType::SPRITES; sceneType <= SceneType::MIXED; sceneType++)
+	{
+		for (int64_t numNodes = 1024; numNodes <= 16384; numNodes *= 4)
+			benchmark->Args({ numNodes, sceneType });
+	}
+	benchmark->Unit(benchmark::kMicrosecond);
+}
+
+}
+
+BENCHMARK_DEFINE_F(SceneGraphFixture, Update)(benchmark::State &state)
+{
+	state.SetLabel(sceneTypeString(state.range(1)));
+
+	for (auto _ : state)
+	{
+		scene_->move();
+		scene_->rootNode().update(Interval);
+	}
+}
+BENCHMARK_REGISTER_F(SceneGraphFixture, Update)->Apply(sceneArguments);
+
+BENCHMARK_DEFINE_F(SceneGraphFixture, UpdateCulling)(benchmark::State &state)
+{
+	state.SetLabel(sceneTypeString(state.range(1)));
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		scene_->move();
+		scene_->rootNode().update(Interval);
+		// A later frame makes every node in the scene test for overlap again
+		frame_++;
+		state.ResumeTiming();
+
+		scene_->viewport().updateCulling(frame_);
+	}
+}
+BENCHMARK_REGISTER_F(SceneGraphFixture, UpdateCulling)->Apply(sceneArguments);
+
+BENCHMARK_DEFINE_F(SceneGraphFixture, Visit)(benchmark::State &state)
+{
+	state.SetLabel(sceneTypeString(state.range(1)));
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		scene_->endFrame();
+		prepareFrame();
+		state.ResumeTiming();
+
+		visitScene();
+	}
+}
+BENCHMARK_REGISTER_F(SceneGraphFixture, Visit)->Apply(sceneArguments);
+
+BENCHMARK_DEFINE_F(SceneGraphFixture, SortQueue)(benchmark::State &state)
+{
+	state.SetLabel(sceneTypeString(state.range(1)));
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		scene_->endFrame();
+		prepareFrame();
+		visitScene();
+		state.ResumeTiming();
+
+		scene_->renderQueue().sort();
+	}
+}
+BENCHMARK_REGISTER_F(SceneGraphFixture, SortQueue)->Apply(sceneArguments);
+
+BENCHMARK_DEFINE_F(SceneGraphFixture, CreateBatches)(benchmark::State &state)
+{
+	state.SetLabel(sceneTypeString(state.range(1)));
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		scene_->endFrame();
+		prepareFrame();
+		visitScene();
+		scene_->renderQueue().sort();
+		state.ResumeTiming();
+
+		scene_->renderQueue().createBatches();
+	}
+}
+BENCHMARK_REGISTER_F(SceneGraphFixture, CreateBatches)->Apply(sceneArguments);
+
+namespace {
+
+/// Runs the benchmarks inside the first frame, once the rendering resources of the headless backend have been created
+class BenchmarkEventHandler : public nc::IAppEventHandler
+{
+  public:
+	void onPreInit(nc::AppConfiguration &config) override
+	{
+		config.consoleLogLevel = nc::ILogger::LogLevel::WARN;
+		config.withAudio = false;
+		config.withThreads = false;
+		config.withDebugOverlay = false;
+		// Every node is updated and tested for culling, without the dirty list or the culling grid
+		config.useDirtyListUpdate = false;
+		config.cullingGridCellSize = 0.0f;
+	}
+
+	void onFrameStart() override
+	{
+		benchmark::RunSpecifiedBenchmarks();
+		benchmark::Shutdown();
+		nc::theApplication().quit();
+	}
+};
+
+nctl::UniquePtr<nc::IAppEventHandler> createAppEventHandler()
+{
+	return nctl::makeUnique<BenchmarkEventHandler>();
+}
+
+}
+
+int main(int argc, char **argv)
+{
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+
+	return nc::PCApplication::start(createAppEventHandler, argc, argv);
+}
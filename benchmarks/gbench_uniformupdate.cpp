@@ -0,0 +1,217 @@
+#include "benchmark/benchmark.h"
+#include <nctl/Array.h>
+#include <nctl/UniquePtr.h>
+#include <ncine/PCApplication.h>
+#include <ncine/IAppEventHandler.h>
+#include <ncine/AppConfiguration.h>
+#include <ncine/Texture.h>
+#include <ncine/Sprite.h>
+#include <ncine/Colorf.h>
+#include <ncine/Random.h>
+#include "RenderCommand.h"
+#include "Material.h"
+#include "GLUniformBlockCache.h"
+#include "GLUniformCache.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const int TextureSize = 64;
+
+/// A sprite that exposes its material and the update of its render command
+class BenchmarkSprite : public nc::Sprite
+{
+  public:
+	BenchmarkSprite(nc::SceneNode *parent, nc::Texture *texture)
+	    : nc::Sprite(parent, texture) {}
+
+	using nc::BaseSprite::updateRenderCommand;
+	inline nc::Material &material() { return renderCommand_->material(); }
+};
+
+/// The uniforms of a sprite instance block, looked up by name or resolved as handles
+struct SpriteUniforms
+{
+	SpriteUniforms()
+	    : instanceBlock(nullptr), colorUniform(nullptr), spriteSizeUniform(nullptr), texRectUniform(nullptr) {}
+
+	nc::GLUniformBlockCache *instanceBlock;
+	nc::GLUniformCache *colorUniform;
+	nc::GLUniformCache *spriteSizeUniform;
+	nc::GLUniformCache *texRectUniform;
+};
+
+/// Every benchmark updates the uniforms of sprites created with the default shader of the headless backend
+class SpriteUpdateFixture : public benchmark::Fixture
+{
+  public:
+	void SetUp(const ::benchmark::State &state) override
+	{
+		const unsigned int numSprites = static_cast<unsigned int>(state.range(0));
+		nc::random().init(numSprites, numSprites);
+
+		nctl::UniquePtr<unsigned char[]> texels = nctl::makeUnique<unsigned char[]>(TextureSize * TextureSize * 4);
+		for (unsigned int i = 0; i < TextureSize * TextureSize * 4; i++)
+			texels[i] = static_cast<unsigned char>(nc::random().integer(0, 256));
+		texture_ = nctl::makeUnique<nc::Texture>("Benchmark", nc::Texture::Format::RGBA8, TextureSize, TextureSize);
+		texture_->loadFromTexels(texels.get());
+
+		for (unsigned int i = 0; i < numSprites; i++)
+		{
+			sprites_.pushBack(nctl::makeUnique<BenchmarkSprite>(&rootNode_, texture_.get()));
+			sprites_.back()->updateRenderCommand();
+
+			SpriteUniforms uniforms;
+			uniforms.instanceBlock = sprites_.back()->material().uniformBlock(nc::Material::InstanceBlockName);
+			if (uniforms.instanceBlock)
+			{
+				uniforms.colorUniform = uniforms.instanceBlock->uniformHandle(nc::Material::ColorUniformName, GL_FLOAT_VEC4);
+				uniforms.spriteSizeUniform = uniforms.instanceBlock->uniformHandle(nc::Material::SpriteSizeUniformName, GL_FLOAT_VEC2);
+				uniforms.texRectUniform = uniforms.instanceBlock->uniformHandle(nc::Material::TexRectUniformName, GL_FLOAT_VEC4);
+			}
+			uniforms_.pushBack(uniforms);
+		}
+
+		for (unsigned int i = 0; i < 4; i++)
+			color_[i] = nc::random().fastReal();
+	}
+
+	void TearDown(const ::benchmark::State &state) override
+	{
+		uniforms_.clear();
+		sprites_.clear();
+		texture_.reset(nullptr);
+	}
+
+  protected:
+	nc::SceneNode rootNode_;
+	nctl::UniquePtr<nc::Texture> texture_;
+	nctl::Array<nctl::UniquePtr<BenchmarkSprite>> sprites_;
+	nctl::Array<SpriteUniforms> uniforms_;
+	float color_[4];
+
+	/// Returns false if the shader of the sprites has no instance block with the expected uniforms
+	bool hasUniforms() const
+	{
+		const SpriteUniforms &uniforms = uniforms_.front();
+		return (uniforms.colorUniform && uniforms.spriteSizeUniform && uniforms.texRectUniform);
+	}
+};
+
+}
+
+BENCHMARK_DEFINE_F(SpriteUpdateFixture, LookupByName)(benchmark::State &state)
+{
+	if (hasUniforms() == false)
+		state.SkipWithError("The sprite shader has no instance block uniforms");
+	const unsigned int numSprites = static_cast<unsigned int>(state.range(0));
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < numSprites; i++)
+		{
+			nc::GLUniformBlockCache *instanceBlock = uniforms_[i].instanceBlock;
+			nc::GLUniformCache *colorUniform = instanceBlock->uniform(nc::Material::ColorUniformName);
+			if (colorUniform)
+				colorUniform->setFloatVector(color_);
+			nc::GLUniformCache *spriteSizeUniform = instanceBlock->uniform(nc::Material::SpriteSizeUniformName);
+			if (spriteSizeUniform)
+				spriteSizeUniform->setFloatValue(32.0f, 32.0f);
+			nc::GLUniformCache *texRectUniform = instanceBlock->uniform(nc::Material::TexRectUniformName);
+			if (texRectUniform)
+				texRectUniform->setFloatValue(0.5f, 0.0f, 0.5f, 0.0f);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * numSprites);
+}
+BENCHMARK_REGISTER_F(SpriteUpdateFixture, LookupByName)->Arg(1000)->Arg(10000);
+
+BENCHMARK_DEFINE_F(SpriteUpdateFixture, ResolvedHandles)(benchmark::State &state)
+{
+	if (hasUniforms() == false)
+		state.SkipWithError("The sprite shader has no instance block uniforms");
+	const unsigned int numSprites = static_cast<unsigned int>(state.range(0));
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < numSprites; i++)
+		{
+			SpriteUniforms &uniforms = uniforms_[i];
+			if (uniforms.colorUniform)
+				uniforms.colorUniform->storeFloatVector(color_, 4);
+			if (uniforms.spriteSizeUniform)
+				uniforms.spriteSizeUniform->storeFloatValue(32.0f, 32.0f);
+			if (uniforms.texRectUniform)
+				uniforms.texRectUniform->storeFloatValue(0.5f, 0.0f, 0.5f, 0.0f);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * numSprites);
+}
+BENCHMARK_REGISTER_F(SpriteUpdateFixture, ResolvedHandles)->Arg(1000)->Arg(10000);
+
+BENCHMARK_DEFINE_F(SpriteUpdateFixture, UpdateRenderCommand)(benchmark::State &state)
+{
+	if (hasUniforms() == false)
+		state.SkipWithError("The sprite shader has no instance block uniforms");
+	const unsigned int numSprites = static_cast<unsigned int>(state.range(0));
+
+	bool toggle = false;
+	for (auto _ : state)
+	{
+		// Changing the color and the size marks both uniforms as dirty
+		toggle = !toggle;
+		const nc::Colorf color = toggle ? nc::Colorf(color_[0], color_[1], color_[2], color_[3]) : nc::Colorf::White;
+		const float size = toggle ? 32.0f : 16.0f;
+		for (unsigned int i = 0; i < numSprites; i++)
+		{
+			BenchmarkSprite &sprite = *sprites_[i];
+			sprite.setColor(color);
+			sprite.setSize(size, size);
+			sprite.updateRenderCommand();
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * numSprites);
+}
+BENCHMARK_REGISTER_F(SpriteUpdateFixture, UpdateRenderCommand)->Arg(1000)->Arg(10000);
+
+namespace {
+
+/// Runs the benchmarks inside the first frame, once the rendering resources of the headless backend have been created
+class BenchmarkEventHandler : public nc::IAppEventHandler
+{
+  public:
+	void onPreInit(nc::AppConfiguration &config) override
+	{
+		config.consoleLogLevel = nc::ILogger::LogLevel::WARN;
+		config.withAudio = false;
+		config.withThreads = false;
+		config.withDebugOverlay = false;
+	}
+
+	void onFrameStart() override
+	{
+		benchmark::RunSpecifiedBenchmarks();
+		benchmark::Shutdown();
+		nc::theApplication().quit();
+	}
+};
+
+nctl::UniquePtr<nc::IAppEventHandler> createAppEventHandler()
+{
+	return nctl::makeUnique<BenchmarkEventHandler>();
+}
+
+}
+
+int main(int argc, char **argv)
+{
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+
+	return nc::PCApplication::start(createAppEventHandler, argc, argv);
+}
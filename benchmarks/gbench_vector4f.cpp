@@ -0,0 +1,165 @@
+#include "benchmark/benchmark.h"
+#include <ncine/Vector4.h>
+#include <ncine/Quaternion.h>
+
+namespace nc = ncine;
+
+namespace {
+
+const unsigned int NumElements = 512;
+
+}
+
+// Not in the anonymous namespace, or the compiler could skip the computations that do not change between runs
+float nums[NumElements];
+nc::Vector4f vecsA[NumElements];
+nc::Vector4f vecsB[NumElements];
+nc::Vector4f vecsC[NumElements];
+nc::Quaternionf quats[NumElements];
+
+namespace {
+
+void resetVecs()
+{
+	for (unsigned int i = 0; i < NumElements; i++)
+	{
+		// Starting from one to avoid divisions by zero
+		const float f = static_cast<float>(i + 1);
+		nums[i] = f;
+		vecsA[i].set(f, f, f, f);
+		vecsB[i].set(f, f, f, f);
+		vecsC[i].set(f, f, f, f);
+	}
+}
+
+void resetQuats()
+{
+	for (unsigned int i = 0; i < NumElements; i++)
+	{
+		// Unit quaternions keep the chained products in range
+		const float f = static_cast<float>(i + 1);
+		quats[i].set(f, -f, f, -f);
+		quats[i].normalize();
+	}
+}
+
+}
+
+static void BM_Vector4Add(benchmark::State &state)
+{
+	resetVecs();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumElements; i++)
+			vecsC[i] = vecsA[i] + vecsB[i];
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+BENCHMARK(BM_Vector4Add);
+
+static void BM_Vector4Sub(benchmark::State &state)
+{
+	resetVecs();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumElements; i++)
+			vecsC[i] = vecsA[i] - vecsB[i];
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+BENCHMARK(BM_Vector4Sub);
+
+static void BM_Vector4Mul(benchmark::State &state)
+{
+	resetVecs();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumElements; i++)
+			vecsC[i] = vecsA[i] * vecsB[i];
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+BENCHMARK(BM_Vector4Mul);
+
+static void BM_Vector4Div(benchmark::State &state)
+{
+	resetVecs();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumElements; i++)
+			vecsC[i] = vecsA[i] / vecsB[i];
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+BENCHMARK(BM_Vector4Div);
+
+static void BM_Vector4Length(benchmark::State &state)
+{
+	resetVecs();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumElements; i++)
+			nums[i] = vecsA[i].length();
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+BENCHMARK(BM_Vector4Length);
+
+static void BM_Vector4SqrLength(benchmark::State &state)
+{
+	resetVecs();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumElements; i++)
+			nums[i] = vecsA[i].sqrLength();
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+BENCHMARK(BM_Vector4SqrLength);
+
+static void BM_Vector4Normalize(benchmark::State &state)
+{
+	resetVecs();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumElements; i++)
+			vecsC[i] = vecsA[i].normalized();
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+BENCHMARK(BM_Vector4Normalize);
+
+static void BM_Vector4Dot(benchmark::State &state)
+{
+	resetVecs();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumElements; i++)
+			nums[i] = nc::dot(vecsA[i], vecsB[i]);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * NumElements);
+}
+BENCHMARK(BM_Vector4Dot);
+
+static void BM_QuaternionMult(benchmark::State &state)
+{
+	resetQuats();
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < NumElements - 1; i++)
+			quats[i] = quats[i] * quats[i + 1];
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * (NumElements - 1));
+}
+BENCHMARK(BM_QuaternionMult);
+
+BENCHMARK_MAIN();
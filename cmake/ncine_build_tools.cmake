@@ -0,0 +1,3 @@
+if(NCINE_BUILD_TOOLS)
+	add_subdirectory(tools)
+endif()
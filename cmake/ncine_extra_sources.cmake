@@ -67,6 +67,22 @@ elseif(SDL2_FOUND AND NCINE_PREFERRED_BACKEND STREQUAL "SDL2")
 		${NCINE_ROOT}/src/input/SdlKeys.cpp
 		${NCINE_ROOT}/src/graphics/SdlGfxDevice.cpp
 	)
+elseif(NCINE_PREFERRED_BACKEND STREQUAL "HEADLESS")
+	target_compile_definitions(ncine PRIVATE "WITH_HEADLESS")
+
+	list(APPEND HEADERS ${NCINE_ROOT}/include/ncine/HeadlessGL.h)
+
+	list(APPEND PRIVATE_HEADERS
+		${NCINE_ROOT}/src/include/HeadlessInputManager.h
+		${NCINE_ROOT}/src/include/HeadlessGfxDevice.h
+		${NCINE_ROOT}/src/include/HeadlessShaderIntrospection.h
+	)
+	list(APPEND SOURCES
+		${NCINE_ROOT}/src/input/HeadlessInputManager.cpp
+		${NCINE_ROOT}/src/graphics/HeadlessGfxDevice.cpp
+		${NCINE_ROOT}/src/graphics/opengl/HeadlessGL.cpp
+		${NCINE_ROOT}/src/graphics/opengl/HeadlessShaderIntrospection.cpp
+	)
 elseif(Qt5_FOUND AND NCINE_PREFERRED_BACKEND STREQUAL "QT5")
 	target_compile_definitions(ncine PRIVATE "WITH_QT5")
 	target_compile_definitions(ncine_main PRIVATE "WITH_QT5")
@@ -95,9 +111,17 @@ elseif(Qt5_FOUND AND NCINE_PREFERRED_BACKEND STREQUAL "QT5")
 	list(APPEND SOURCES ${NCINE_ROOT}/src/input/Qt5JoyMapping.cpp)
 endif()
 
-if(OPENAL_FOUND)
+if(OPENAL_FOUND OR NCINE_WITH_SOFTWARE_AUDIO)
 	target_compile_definitions(ncine PRIVATE "WITH_AUDIO")
-	target_link_libraries(ncine PRIVATE OpenAL::AL)
+	if(NCINE_WITH_SOFTWARE_AUDIO)
+		# The OpenAL functions are implemented by a software mixer
+		target_compile_definitions(ncine PRIVATE "WITH_SOFTWARE_AUDIO")
+		list(APPEND HEADERS ${NCINE_ROOT}/include/ncine/SoftwareAudio.h)
+		list(APPEND PRIVATE_HEADERS ${NCINE_ROOT}/src/include/SoftwareAL.h)
+		list(APPEND SOURCES ${NCINE_ROOT}/src/audio/SoftwareAL.cpp)
+	else()
+		target_link_libraries(ncine PRIVATE OpenAL::AL)
+	endif()
 
 	list(APPEND HEADERS
 		${NCINE_ROOT}/include/ncine/AudioBuffer.h
@@ -113,6 +137,8 @@ if(OPENAL_FOUND)
 		${NCINE_ROOT}/src/include/AudioLoaderWav.h
 		${NCINE_ROOT}/src/include/AudioReaderWav.h
 		${NCINE_ROOT}/src/include/IAudioReader.h
+		${NCINE_ROOT}/src/include/AudioRingBuffer.h
+		${NCINE_ROOT}/src/include/AudioStreamDecoder.h
 	)
 
 	list(APPEND SOURCES
@@ -122,6 +148,7 @@ if(OPENAL_FOUND)
 		${NCINE_ROOT}/src/audio/AudioReaderWav.cpp
 		${NCINE_ROOT}/src/audio/AudioBuffer.cpp
 		${NCINE_ROOT}/src/audio/AudioStream.cpp
+		${NCINE_ROOT}/src/audio/AudioStreamDecoder.cpp
 		${NCINE_ROOT}/src/audio/IAudioPlayer.cpp
 		${NCINE_ROOT}/src/audio/AudioBufferPlayer.cpp
 		${NCINE_ROOT}/src/audio/AudioStreamPlayer.cpp
@@ -186,6 +213,12 @@ if(Threads_FOUND)
 	list(APPEND PRIVATE_HEADERS ${NCINE_ROOT}/src/include/ThreadPool.h)
 	list(APPEND SOURCES ${NCINE_ROOT}/src/threading/ThreadPool.cpp)
 	list(APPEND PRIVATE_HEADERS ${NCINE_ROOT}/src/include/ThreadCommands.h)
+	list(APPEND PRIVATE_HEADERS ${NCINE_ROOT}/src/include/ParallelSceneUpdate.h)
+	list(APPEND SOURCES ${NCINE_ROOT}/src/graphics/ParallelSceneUpdate.cpp)
+	list(APPEND PRIVATE_HEADERS ${NCINE_ROOT}/src/include/ParallelSceneVisit.h)
+	list(APPEND SOURCES ${NCINE_ROOT}/src/graphics/ParallelSceneVisit.cpp)
+	list(APPEND PRIVATE_HEADERS ${NCINE_ROOT}/src/include/ParallelParticlesUpdate.h)
+	list(APPEND SOURCES ${NCINE_ROOT}/src/graphics/ParallelParticlesUpdate.cpp)
 endif()
 
 if(LUA_FOUND)
@@ -297,7 +330,7 @@ if(LUA_FOUND)
 			${NCINE_ROOT}/src/scripting/LuaShaderState.cpp
 		)
 
-		if(OPENAL_FOUND)
+		if(OPENAL_FOUND OR NCINE_WITH_SOFTWARE_AUDIO)
 			list(APPEND PRIVATE_HEADERS
 				${NCINE_ROOT}/src/include/LuaIAudioDevice.h
 				${NCINE_ROOT}/src/include/LuaIAudioPlayer.h
@@ -440,7 +473,7 @@ endif()
 
 if(NCINE_WITH_TRACY)
 	target_compile_definitions(ncine PRIVATE "WITH_TRACY")
-	if(NOT ANDROID AND NOT APPLE AND NOT EMSCRIPTEN)
+	if(NOT ANDROID AND NOT APPLE AND NOT EMSCRIPTEN AND NOT NCINE_PREFERRED_BACKEND STREQUAL "HEADLESS")
 		target_compile_definitions(ncine PRIVATE "WITH_TRACY_OPENGL")
 	endif()
 	target_compile_definitions(ncine PUBLIC "TRACY_ENABLE")
@@ -241,10 +241,16 @@ if(EXISTS ${CMAKE_SOURCE_DIR}/config.h.in)
 		set(NCINE_WITH_SDL ${SDL2_FOUND})
 	elseif(NCINE_PREFERRED_BACKEND STREQUAL "QT5")
 		set(NCINE_WITH_QT5 ${Qt5_FOUND})
+	elseif(NCINE_PREFERRED_BACKEND STREQUAL "HEADLESS")
+		set(NCINE_WITH_HEADLESS TRUE)
 	endif()
 	set(NCINE_WITH_PNG ${PNG_FOUND})
 	set(NCINE_WITH_WEBP ${WEBP_FOUND})
-	set(NCINE_WITH_AUDIO ${OPENAL_FOUND})
+	if(OPENAL_FOUND OR NCINE_WITH_SOFTWARE_AUDIO)
+		set(NCINE_WITH_AUDIO TRUE)
+	else()
+		set(NCINE_WITH_AUDIO FALSE)
+	endif()
 	if(NCINE_WITH_AUDIO AND VORBIS_FOUND)
 		set(NCINE_WITH_VORBIS TRUE)
 	else()
@@ -279,9 +285,15 @@ if(EXISTS ${CMAKE_SOURCE_DIR}/config.h.in)
 	if(NCINE_WITH_QT5)
 		message(STATUS "NCINE_WITH_QT5: " ${NCINE_WITH_QT5})
 	endif()
+	if(NCINE_WITH_HEADLESS)
+		message(STATUS "NCINE_WITH_HEADLESS: " ${NCINE_WITH_HEADLESS})
+	endif()
 	if(NCINE_WITH_AUDIO)
 		message(STATUS "NCINE_WITH_AUDIO: " ${NCINE_WITH_AUDIO})
 	endif()
+	if(NCINE_WITH_SOFTWARE_AUDIO)
+		message(STATUS "NCINE_WITH_SOFTWARE_AUDIO: " ${NCINE_WITH_SOFTWARE_AUDIO})
+	endif()
 	if(NCINE_WITH_VORBIS)
 		message(STATUS "NCINE_WITH_VORBIS: " ${NCINE_WITH_VORBIS})
 	endif()
@@ -2,6 +2,7 @@ set(HEADERS
 	${NCINE_ROOT}/include/ncine/common_defines.h
 	${NCINE_ROOT}/include/ncine/common_constants.h
 	${NCINE_ROOT}/include/ncine/common_macros.h
+	${NCINE_ROOT}/include/ncine/common_simd.h
 	${NCINE_ROOT}/include/ncine/Random.h
 	${NCINE_ROOT}/include/ncine/Rect.h
 	${NCINE_ROOT}/include/ncine/Color.h
@@ -32,6 +33,7 @@ set(HEADERS
 	${NCINE_ROOT}/include/ncine/Font.h
 	${NCINE_ROOT}/include/ncine/FileSystem.h
 	${NCINE_ROOT}/include/ncine/IFile.h
+	${NCINE_ROOT}/include/ncine/PackArchive.h
 	${NCINE_ROOT}/include/ncine/IGfxDevice.h
 	${NCINE_ROOT}/include/ncine/Texture.h
 	${NCINE_ROOT}/include/ncine/ITextureSaver.h
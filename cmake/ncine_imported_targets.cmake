@@ -89,7 +89,8 @@ endif()
 if(NCINE_WITH_THREADS)
 	find_package(Threads)
 endif()
-if(NOT ANDROID)
+# The headless backend links a stub OpenGL layer instead of a driver
+if(NOT ANDROID AND NOT NCINE_PREFERRED_BACKEND STREQUAL "HEADLESS")
 	find_package(OpenGL REQUIRED)
 endif()
 if(MSVC)
@@ -119,16 +120,22 @@ elseif(NOT ANDROID) # GCC and LLVM
 		endif()
 	endif()
 
-	if(WIN32)
-		find_package(GLEW REQUIRED)
+	if(NCINE_PREFERRED_BACKEND STREQUAL "HEADLESS")
+		if(NCINE_ARM_PROCESSOR)
+			include(check_atomic)
+		endif()
 	else()
-		if(NCINE_WITH_GLEW)
-			find_package(GLEW)
+		if(WIN32)
+			find_package(GLEW REQUIRED)
+		else()
+			if(NCINE_WITH_GLEW)
+				find_package(GLEW)
+			endif()
+		endif()
+		if(NCINE_ARM_PROCESSOR)
+			include(check_atomic)
+			find_package(OpenGLES2)
 		endif()
-	endif()
-	if(NCINE_ARM_PROCESSOR)
-		include(check_atomic)
-		find_package(OpenGLES2)
 	endif()
 	# Look for both GLFW and SDL2 to make the fallback logic work
 	find_package(GLFW)
@@ -140,7 +147,9 @@ elseif(NOT ANDROID) # GCC and LLVM
 		find_package(WebP)
 	endif()
 	if(NCINE_WITH_AUDIO)
-		find_package(OpenAL)
+		if(NOT NCINE_WITH_SOFTWARE_AUDIO)
+			find_package(OpenAL)
+		endif()
 		if(NCINE_WITH_VORBIS)
 			find_package(Vorbis)
 		endif()
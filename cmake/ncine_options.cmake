@@ -1,6 +1,7 @@
 option(NCINE_BUILD_TESTS "Build the engine test programs" ON)
 option(NCINE_BUILD_UNIT_TESTS "Build the engine unit tests" OFF)
 option(NCINE_BUILD_BENCHMARKS "Build the engine micro benchmarks" OFF)
+option(NCINE_BUILD_TOOLS "Build the engine command line tools" ON)
 option(NCINE_INSTALL_DEV_SUPPORT "Install files to support development" ON)
 option(NCINE_LINKTIME_OPTIMIZATION "Compile the engine with link time optimization when in release" OFF)
 option(NCINE_AUTOVECTORIZATION_REPORT "Enable report generation from compiler auto-vectorization" OFF)
@@ -12,7 +13,7 @@ option(NCINE_BUILD_ANDROID "Build the Android version of the engine" OFF)
 option(NCINE_STRIP_BINARIES "Enable symbols stripping from libraries and executables when in release" OFF)
 
 set(NCINE_PREFERRED_BACKEND "GLFW" CACHE STRING "Specify the preferred backend on desktop")
-set_property(CACHE NCINE_PREFERRED_BACKEND PROPERTY STRINGS "GLFW;SDL2;QT5")
+set_property(CACHE NCINE_PREFERRED_BACKEND PROPERTY STRINGS "GLFW;SDL2;QT5;HEADLESS")
 
 if(EMSCRIPTEN)
 	option(NCINE_WITH_THREADS "Enable the Emscripten Pthreads support" OFF)
@@ -29,6 +30,7 @@ option(NCINE_WITH_PNG "Enable PNG image file loading" ON)
 option(NCINE_WITH_WEBP "Enable WebP image file loading" ON)
 option(NCINE_WITH_AUDIO "Enable OpenAL support and thus sound" ON)
 option(NCINE_WITH_VORBIS "Enable Ogg Vorbis audio file loading" ON)
+option(NCINE_WITH_SOFTWARE_AUDIO "Mix audio in software to memory or to a WAV file instead of using OpenAL" OFF)
 option(NCINE_WITH_LUA "Enable Lua scripting integration" ON)
 if(NCINE_WITH_LUA)
 	option(NCINE_WITH_SCRIPTING_API "Enable Lua scripting API" ON)
@@ -39,11 +41,22 @@ option(NCINE_WITH_IMGUI "Enable the integration with Dear ImGui" ON)
 option(NCINE_WITH_NUKLEAR "Enable the integration with Nuklear" OFF)
 option(NCINE_WITH_TRACY "Enable the integration with the Tracy frame profiler" OFF)
 option(NCINE_WITH_RENDERDOC "Enable the integration with RenderDoc" OFF)
+option(NCINE_WITH_SIMD "Enable the SSE or NEON implementations of the float math classes" ON)
 
 if(EMSCRIPTEN)
 	set(NCINE_DYNAMIC_LIBRARY OFF)
 endif()
 
+# There is no window to draw a GUI to and no input to drive it
+if(NCINE_PREFERRED_BACKEND STREQUAL "HEADLESS")
+	set(NCINE_WITH_IMGUI OFF)
+	set(NCINE_WITH_NUKLEAR OFF)
+	# There is no sound hardware to rely on either
+	if(NCINE_WITH_AUDIO)
+		set(NCINE_WITH_SOFTWARE_AUDIO ON)
+	endif()
+endif()
+
 set(NCINE_DATA_DIR "${PARENT_SOURCE_DIR}/nCine-data" CACHE PATH "Set the path to the engine data directory")
 set(NCINE_ICONS_DIR "${PARENT_SOURCE_DIR}/nCine-data/icons" CACHE PATH "Set the path to the engine icons directory")
 set(NCINE_TESTS_DATA_DIR "" CACHE STRING "Set the path to the data directory that will be embedded in test executables")
@@ -125,16 +138,19 @@ if(NCINE_USING_OPTIONS_PRESETS)
 		set(NCINE_INSTALL_DEV_SUPPORT OFF)
 		set(NCINE_BUILD_ANDROID OFF)
 		set(NCINE_BUILD_DOCUMENTATION OFF)
+		set(NCINE_BUILD_TOOLS OFF)
 	elseif("${NCINE_OPTIONS_PRESETS}" STREQUAL "DevDist")
 		set(NCINE_INSTALL_DEV_SUPPORT ON)
 		set(NCINE_BUILD_ANDROID ON)
 		set(NCINE_ASSEMBLE_APK OFF)
 		set(NCINE_NDK_ARCHITECTURES armeabi-v7a arm64-v8a x86_64)
 		set(NCINE_BUILD_DOCUMENTATION OFF)
+		set(NCINE_BUILD_TOOLS ON)
 	elseif("${NCINE_OPTIONS_PRESETS}" STREQUAL "LuaDist")
 		set(NCINE_INSTALL_DEV_SUPPORT OFF)
 		set(NCINE_BUILD_ANDROID OFF)
 		set(NCINE_BUILD_DOCUMENTATION OFF)
+		set(NCINE_BUILD_TOOLS OFF)
 		set(NCINE_WITH_IMGUI OFF)
 		set(NCINE_WITH_THREADS OFF)
 		set(NCINE_WITH_SCRIPTING_API ON)
@@ -151,6 +167,7 @@ if(NCINE_USING_OPTIONS_PRESETS)
 		set(NCINE_WITH_VORBIS OFF)
 		set(NCINE_WITH_LUA OFF)
 		set(NCINE_BUILD_TESTS OFF)
+		set(NCINE_BUILD_TOOLS OFF)
 		if("${NCINE_OPTIONS_PRESETS}" STREQUAL "UnitTests")
 			set(NCINE_LINKTIME_OPTIMIZATION OFF)
 			set(NCINE_STRIP_BINARIES OFF)
@@ -159,6 +176,12 @@ if(NCINE_USING_OPTIONS_PRESETS)
 			set(NCINE_LINKTIME_OPTIMIZATION ON)
 			set(NCINE_STRIP_BINARIES ON)
 			set(NCINE_BUILD_BENCHMARKS ON)
+			# The scenegraph benchmarks run on the stub OpenGL layer, without a window
+			set(NCINE_PREFERRED_BACKEND "HEADLESS")
+			# The audio benchmarks run on the software mixer, without a sound device
+			set(NCINE_WITH_AUDIO ON)
+			set(NCINE_WITH_SOFTWARE_AUDIO ON)
+			set(NCINE_DYNAMIC_LIBRARY OFF)
 		endif()
 	endif()
 
@@ -4,8 +4,12 @@ set(PRIVATE_HEADERS
 	${NCINE_ROOT}/src/include/Clock.h
 	${NCINE_ROOT}/src/include/ArrayIndexer.h
 	${NCINE_ROOT}/src/include/FrameTimer.h
+	${NCINE_ROOT}/src/include/FramePacer.h
 	${NCINE_ROOT}/src/include/MemoryFile.h
 	${NCINE_ROOT}/src/include/StandardFile.h
+	${NCINE_ROOT}/src/include/MappedFile.h
+	${NCINE_ROOT}/src/include/PackFile.h
+	${NCINE_ROOT}/src/include/Lz4Block.h
 	${NCINE_ROOT}/src/include/FileLogger.h
 	${NCINE_ROOT}/src/include/JoyMapping.h
 	${NCINE_ROOT}/src/input/JoyMappingDb.h
@@ -18,12 +22,15 @@ set(PRIVATE_HEADERS
 	${NCINE_ROOT}/src/include/Material.h
 	${NCINE_ROOT}/src/include/Geometry.h
 	${NCINE_ROOT}/src/include/Particle.h
+	${NCINE_ROOT}/src/include/ParticleArrays.h
+	${NCINE_ROOT}/src/include/ParticleArraysNode.h
 	${NCINE_ROOT}/src/include/TextureFormat.h
 	${NCINE_ROOT}/src/include/ITextureLoader.h
 	${NCINE_ROOT}/src/include/TextureLoaderRaw.h
 	${NCINE_ROOT}/src/include/TextureLoaderDds.h
 	${NCINE_ROOT}/src/include/TextureLoaderPvr.h
 	${NCINE_ROOT}/src/include/TextureLoaderKtx.h
+	${NCINE_ROOT}/src/include/TextureUploadQueue.h
 	${NCINE_ROOT}/src/include/GLHashMap.h
 	${NCINE_ROOT}/src/include/GLBufferObject.h
 	${NCINE_ROOT}/src/include/GLBufferObject.h
@@ -54,4 +61,7 @@ set(PRIVATE_HEADERS
 	${NCINE_ROOT}/src/include/RenderVaoPool.h
 	${NCINE_ROOT}/src/include/RenderCommandPool.h
 	${NCINE_ROOT}/src/include/ScreenViewport.h
+	${NCINE_ROOT}/src/include/CullingGrid.h
+	${NCINE_ROOT}/src/include/DirtySceneUpdate.h
+	${NCINE_ROOT}/src/include/BinaryShaderCache.h
 )
@@ -12,6 +12,7 @@ set(SOURCES
 	${NCINE_ROOT}/src/TimeStamp.cpp
 	${NCINE_ROOT}/src/Timer.cpp
 	${NCINE_ROOT}/src/FrameTimer.cpp
+	${NCINE_ROOT}/src/FramePacer.cpp
 	${NCINE_ROOT}/src/Font.cpp
 	${NCINE_ROOT}/src/FntParser.cpp
 	${NCINE_ROOT}/src/FontGlyph.cpp
@@ -19,6 +20,10 @@ set(SOURCES
 	${NCINE_ROOT}/src/IFile.cpp
 	${NCINE_ROOT}/src/MemoryFile.cpp
 	${NCINE_ROOT}/src/StandardFile.cpp
+	${NCINE_ROOT}/src/MappedFile.cpp
+	${NCINE_ROOT}/src/PackFile.cpp
+	${NCINE_ROOT}/src/PackArchive.cpp
+	${NCINE_ROOT}/src/Lz4Block.cpp
 	${NCINE_ROOT}/src/input/IInputManager.cpp
 	${NCINE_ROOT}/src/input/JoyMapping.cpp
 	${NCINE_ROOT}/src/graphics/Color.cpp
@@ -39,6 +44,7 @@ set(SOURCES
 	${NCINE_ROOT}/src/graphics/TextureLoaderKtx.cpp
 	${NCINE_ROOT}/src/graphics/ITextureSaver.cpp
 	${NCINE_ROOT}/src/graphics/Texture.cpp
+	${NCINE_ROOT}/src/graphics/TextureUploadQueue.cpp
 	${NCINE_ROOT}/src/graphics/Shader.cpp
 	${NCINE_ROOT}/src/graphics/ShaderState.cpp
 	${NCINE_ROOT}/src/graphics/DrawableNode.cpp
@@ -49,6 +55,8 @@ set(SOURCES
 	${NCINE_ROOT}/src/Application.cpp
 	${NCINE_ROOT}/src/AppConfiguration.cpp
 	${NCINE_ROOT}/src/graphics/Particle.cpp
+	${NCINE_ROOT}/src/graphics/ParticleArrays.cpp
+	${NCINE_ROOT}/src/graphics/ParticleArraysNode.cpp
 	${NCINE_ROOT}/src/graphics/ParticleAffectors.cpp
 	${NCINE_ROOT}/src/graphics/ParticleSystem.cpp
 	${NCINE_ROOT}/src/graphics/ParticleInitializer.cpp
@@ -85,4 +93,7 @@ set(SOURCES
 	${NCINE_ROOT}/src/graphics/Viewport.cpp
 	${NCINE_ROOT}/src/graphics/ScreenViewport.cpp
 	${NCINE_ROOT}/src/graphics/Camera.cpp
+	${NCINE_ROOT}/src/graphics/CullingGrid.cpp
+	${NCINE_ROOT}/src/graphics/DirtySceneUpdate.cpp
+	${NCINE_ROOT}/src/graphics/BinaryShaderCache.cpp
 )
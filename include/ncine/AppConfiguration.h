@@ -53,9 +53,23 @@ class DLL_PUBLIC AppConfiguration
 
 	/// The flag is `true` if mapping is used to update OpenGL buffers
 	bool useBufferMapping;
+	/// The flag is `true` if the buffers of the renderer are persistently mapped and split in fenced regions, one for each frame in flight
+	/*! \note The value is only taken into account when `GL_ARB_buffer_storage` is available, otherwise buffers are updated every frame. */
+	bool usePersistentMapping;
+	/// The flag is `true` if batches of sprites read per-instance data from vertex attributes instead of a uniform block
+	/*! \note Batches are then limited by the VBO size instead of the maximum size of a uniform block. */
+	bool useInstancedAttributes;
 	/// The flag is `true` when error checking and introspection of shader programs are deferred to first use
 	/*! \note The value is only taken into account when the scenegraph is being used */
 	bool deferShaderQueries;
+	/// The flag is `true` if the binaries of the default shader programs are saved in the save path and loaded on the next runs
+	/*! \note The value is only taken into account when shaders are embedded and program binaries are supported by the device.
+	 *  Binaries are saved once the programs have been linked, on their first use if shader queries are deferred. */
+	bool useBinaryShaderCache;
+	/// The flag is `true` if shader programs are compiled and linked by the driver in the background, without stalling until their first use
+	/*! \note Shader queries are then always deferred and custom shaders report `isLinking()` until they are ready.
+	 *  Completion can only be checked without stalling when the `GL_KHR_parallel_shader_compile` extension is available. */
+	bool useAsyncShaderCompilation;
 	/// Fixed size of render commands to be collected for batching on Emscripten and ANGLE
 	/*! \note Increasing this value too much might negatively affect batching shaders compilation time.
 	A value of zero restores the default behavior of non fixed size for batches. */
@@ -68,6 +82,30 @@ class DLL_PUBLIC AppConfiguration
 	unsigned int vaoPoolSize;
 	/// The initial size for the pool of render commands
 	unsigned int renderCommandPoolSize;
+	/// The maximum number of bytes of asynchronously loaded textures uploaded every frame, or zero to upload them as soon as they are decoded
+	/*! \note Compressed MIP levels are always uploaded as a whole, and at least one row of an uncompressed image is uploaded every frame. */
+	unsigned long textureUploadBudget;
+	/// The scenegraph depth at which subtrees are updated in parallel by the thread pool, or zero to update serially
+	/*! \note The value is only taken into account when the threading subsystem is enabled.
+	 *  The nodes above the depth are updated first, the overridden `update()` methods of nodes below it should not access other subtrees. */
+	unsigned int parallelUpdateDepth;
+	/// The scenegraph depth at which subtrees are visited in parallel by the thread pool to fill the render queues, or zero to visit serially
+	/*! \note The value is only taken into account when the threading subsystem is enabled. */
+	unsigned int parallelVisitDepth;
+	/// The cell size in pixels of the grid that indexes drawable nodes for viewport culling, or zero to test every node
+	/*! \note A good value is a few times the size of a typical node. Nodes only enter the grid once they have been updated. */
+	float cullingGridCellSize;
+	/// The flag is `true` if only the scenegraph subtrees changed since the last frame are updated
+	/*! \note Nodes that override `update()` should call `setUpdatedEveryFrame()`, and the parallel update is not used.
+	 *  Nodes changed by the update of other nodes are updated in the next frame. */
+	bool useDirtyListUpdate;
+	/// The flag is `true` if particle systems store their particles in contiguous arrays and draw them with a single instanced command
+	/*! \note Particles are not scenegraph nodes anymore, and the value is only taken into account when a particle system is created. */
+	bool useParticleArrays;
+	/// The flag is `true` if the particle arrays of every particle system are updated by thread pool jobs
+	/*! \note The value is only taken into account when the threading subsystem and the particle arrays are enabled.
+	 *  The jobs run while the scenegraph update goes on and they are joined before culling and visiting. */
+	bool useParallelParticlesUpdate;
 
 	/// The flag is `true` if the debug overlay is enabled
 	bool withDebugOverlay;
@@ -208,6 +208,7 @@ class DLL_PUBLIC Application
 	friend class Viewport; // for `onDrawViewport()`
 	friend class GlfwInputManager; // for `resizeScreenViewport()`
 	friend class Qt5Widget; // for `resizeScreenViewport()`
+	friend class HeadlessGfxDevice; // for `resizeScreenViewport()`
 };
 
 // Meyers' Singleton
@@ -51,6 +51,11 @@ class DLL_PUBLIC AudioBufferPlayer : public IAudioPlayer
   private:
 	AudioBuffer *audioBuffer_;
 
+	inline bool canReleaseSource() const override { return true; }
+	void acquireSource(unsigned int source) override;
+	void releaseSource() override;
+	void updateVirtualState(float interval) override;
+
 	/// Deleted copy constructor
 	AudioBufferPlayer(const AudioBufferPlayer &) = delete;
 	/// Deleted assignment operator
@@ -1,12 +1,13 @@
 #ifndef CLASS_NCINE_AUDIOSTREAM
 #define CLASS_NCINE_AUDIOSTREAM
 
-#include <nctl/StaticArray.h>
+#include <nctl/Array.h>
 
 namespace ncine {
 
 class IAudioReader;
 class IAudioLoader;
+class AudioStreamDecoder;
 
 /// Audio stream class
 class DLL_PUBLIC AudioStream
@@ -35,7 +36,11 @@ class DLL_PUBLIC AudioStream
 	/// Returns the number of samples in the streaming buffer
 	unsigned long int numSamplesInStreamBuffer() const;
 	/// Returns the size of the streaming buffer in bytes
-	inline int streamBufferSize() const { return BufferSize; }
+	inline int streamBufferSize() const { return bufferSize_; }
+	/// Returns the number of streaming buffers
+	inline unsigned int numStreamBuffers() const { return numBuffers_; }
+	/// Returns true if the stream is decoded ahead by a background thread
+	inline bool hasBackgroundDecoding() const { return hasBackgroundDecoding_; }
 	/// Returns the number of processed buffers since first enqueue
 	inline unsigned int totalProcessedBuffers() const { return totalProcessedBuffers_; }
 
@@ -44,19 +49,33 @@ class DLL_PUBLIC AudioStream
 	/// Unqueues any left buffer and rewinds the loader
 	void stop(unsigned int source);
 
+	/// Sets the number and the size of the streaming buffers, and whether a background thread should decode them ahead
+	/*! \note It should only be called when the stream is stopped */
+	void setStreamBuffers(unsigned int numBuffers, unsigned int bufferSize, bool backgroundDecoding);
+
+	/// Default number of buffers for streaming
+	static const unsigned int DefaultNumBuffers = 3;
+	/// Default size in bytes of each streaming buffer
+	static const unsigned int DefaultBufferSize = 16 * 1024;
+
   private:
 	/// Number of buffers for streaming
-	static const int NumBuffers = 3;
+	unsigned int numBuffers_;
 	/// OpenAL buffer queue for streaming
-	nctl::StaticArray<unsigned int, NumBuffers> buffersIds_;
+	nctl::Array<unsigned int> buffersIds_;
 	/// Index of the next available OpenAL buffer
-	int nextAvailableBufferIndex_;
+	unsigned int nextAvailableBufferIndex_;
 
 	/// Size in bytes of each streaming buffer
-	static const int BufferSize = 16 * 1024;
+	unsigned int bufferSize_;
 	/// Memory buffer to feed OpenAL ones
 	nctl::UniquePtr<char[]> memBuffer_;
 
+	/// Whether the stream should be decoded by a background thread
+	bool hasBackgroundDecoding_;
+	/// Set when the background decoder has delivered the last block of the stream
+	bool hasDecodedLastBlock_;
+
 	/// OpenAL id of the currently playing buffer, or 0 if not
 	unsigned int currentBufferId_;
 
@@ -80,6 +99,9 @@ class DLL_PUBLIC AudioStream
 	int format_;
 	/// The associated reader to continuosly stream decoded data
 	nctl::UniquePtr<IAudioReader> audioReader_;
+	/// The decoder that fills a ring buffer from the reader on a background thread, if any
+	/*! \note It is declared after the reader so that it is destroyed first */
+	nctl::UniquePtr<AudioStreamDecoder> decoder_;
 
 	/// Default constructor
 	AudioStream();
@@ -97,6 +119,14 @@ class DLL_PUBLIC AudioStream
 	bool loadFromFile(const char *filename);
 
 	void createReader(IAudioLoader &audioLoader);
+	void createBuffers();
+	void deleteBuffers();
+	void createDecoder();
+
+	/// Decodes a block on the calling thread and queues it, returns false when there is no more data to play
+	bool enqueueFromReader(unsigned int source, bool looping);
+	/// Queues the blocks decoded by the background thread, returns false when there is no more data to play
+	bool enqueueFromDecoder(unsigned int source, bool looping);
 
 	/// Deleted copy constructor
 	AudioStream(const AudioStream &) = delete;
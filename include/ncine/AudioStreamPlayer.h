@@ -42,6 +42,14 @@ class DLL_PUBLIC AudioStreamPlayer : public IAudioPlayer
 	inline unsigned long int numSamplesInStreamBuffer() const { return audioStream_.numSamplesInStreamBuffer(); }
 	/// Returns the size of the streaming buffer in bytes
 	inline int streamBufferSize() const { return audioStream_.streamBufferSize(); }
+	/// Returns the number of streaming buffers
+	inline unsigned int numStreamBuffers() const { return audioStream_.numStreamBuffers(); }
+	/// Returns true if the stream is decoded ahead by a background thread
+	inline bool hasBackgroundDecoding() const { return audioStream_.hasBackgroundDecoding(); }
+	/// Sets the number and the size of the streaming buffers, and whether a background thread should decode them ahead
+	/*! When decoding in the background, the same number of buffers is kept ready in memory besides the ones queued to OpenAL.
+	 *  \note The buffers can only be changed when the player is stopped */
+	bool setStreamBuffers(unsigned int numBuffers, unsigned int bufferSize, bool backgroundDecoding);
 	/// Returns the sample offset relative to the whole stream
 	unsigned long int sampleOffsetInStream() const;
 
@@ -57,6 +65,12 @@ class DLL_PUBLIC AudioStreamPlayer : public IAudioPlayer
   private:
 	AudioStream audioStream_;
 
+	/// Streams cannot seek, they keep their source until they stop
+	inline bool canReleaseSource() const override { return false; }
+	void acquireSource(unsigned int source) override;
+	void releaseSource() override;
+	void updateVirtualState(float interval) override;
+
 	/// Deleted copy constructor
 	AudioStreamPlayer(const AudioStreamPlayer &) = delete;
 	/// Deleted assignment operator
@@ -7,7 +7,7 @@
 namespace ncine {
 
 class Texture;
-class GLUniformBlockCache;
+class GLUniformCache;
 
 /// The base class for sprites
 /*! \note Users cannot create instances of this class */
@@ -56,7 +56,12 @@ class DLL_PUBLIC BaseSprite : public DrawableNode
 	/// A flag indicating if the sprite texture is vertically flipped
 	bool flippedY_;
 
-	GLUniformBlockCache *instanceBlock_;
+	/// The color uniform handle, resolved when the shader changes
+	GLUniformCache *colorUniform_;
+	/// The sprite size uniform handle, resolved when the shader changes
+	GLUniformCache *spriteSizeUniform_;
+	/// The texture rectangle uniform handle, resolved when the shader changes
+	GLUniformCache *texRectUniform_;
 
 	/// Protected constructor accessible only by derived sprite classes
 	BaseSprite(SceneNode *parent, Texture *texture, float xx, float yy);
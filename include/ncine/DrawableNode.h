@@ -60,10 +60,10 @@ class DLL_PUBLIC DrawableNode : public SceneNode
 	DrawableNode();
 	~DrawableNode() override;
 
-	/// Default move constructor
-	DrawableNode(DrawableNode &&);
-	/// Default move assignment operator
-	DrawableNode &operator=(DrawableNode &&);
+	/// Move constructor
+	DrawableNode(DrawableNode &&other);
+	/// Move assignment operator
+	DrawableNode &operator=(DrawableNode &&other);
 
 	/// Updates the draw command and adds it to the queue
 	bool draw(RenderQueue &renderQueue) override;
@@ -122,10 +122,16 @@ class DLL_PUBLIC DrawableNode : public SceneNode
 	unsigned long int lastFrameRendered_;
 	/// Axis-aligned bounding box of the node area
 	Rectf aabb_;
+	/// The range of culling grid cells the node has been added to, with a zero width if it is not in any cell
+	Recti gridCells_;
+	/// A flag indicating if the node is in the culling grid list of the nodes spanning too many cells
+	bool inGridOversized_;
+	/// A flag indicating if the node is queued to be placed again in the culling grid
+	bool inGridQueue_;
 	/// Calculates updated values for the AABB
 	virtual void updateAabb();
-	/// Called by each viewport update method to update a node culling state
-	void updateCulling();
+	/// Called by each viewport update method to mark the node as rendered in the specified frame if it overlaps the culling rectangle
+	void updateCulling(unsigned long int frame);
 
 	/// Protected copy constructor used to clone objects
 	DrawableNode(const DrawableNode &other);
@@ -142,6 +148,7 @@ class DLL_PUBLIC DrawableNode : public SceneNode
 
 	friend class ShaderState;
 	friend class Viewport;
+	friend class CullingGrid;
 };
 
 }
@@ -0,0 +1,55 @@
+#ifndef CLASS_NCINE_HEADLESSGL
+#define CLASS_NCINE_HEADLESSGL
+
+#include <cstdint>
+#include "common_defines.h"
+
+namespace ncine {
+
+/// The statistics of the stub OpenGL layer linked by the headless backend
+/*! No command reaches a GPU, every OpenGL function only updates the counters and the state needed to answer queries. */
+class DLL_PUBLIC HeadlessGL
+{
+  public:
+	/// The counters of OpenGL calls and of the bytes that would have been uploaded
+	struct Counters
+	{
+		/// Number of OpenGL functions called
+		uint64_t numCalls = 0;
+		/// Number of draw calls, instanced or not
+		uint64_t numDrawCalls = 0;
+		/// Number of object binding calls, shader programs included
+		uint64_t numBindCalls = 0;
+		/// Number of bytes uploaded to buffer objects, by data calls or by flushing and unmapping mapped ranges
+		uint64_t bufferBytes = 0;
+		/// Number of bytes uploaded to textures from the host memory
+		uint64_t textureBytes = 0;
+		/// Number of bytes uploaded to the uniforms of the default block
+		uint64_t uniformBytes = 0;
+	};
+
+	/// Returns the counters accumulated since the start or since the last reset
+	static const Counters &totalCounters();
+	/// Returns the counters of the last completed frame
+	static const Counters &frameCounters();
+	/// Returns the number of frames completed since the start
+	static unsigned long int numFrames();
+	/// Resets the total counters
+	static void resetCounters();
+
+	/// Returns true if shaders and programs report that the driver has completed compiling and linking them
+	static bool isCompilationCompleted();
+	/// Sets whether shaders and programs report completion, to simulate a driver that compiles them in the background
+	/*! The value is only queried through `GL_KHR_parallel_shader_compile`, compilation and linking always succeed. */
+	static void setCompilationCompleted(bool completed);
+
+  private:
+	/// Called by the headless graphics device instead of swapping buffers
+	static void endFrame();
+
+	friend class HeadlessGfxDevice;
+};
+
+}
+
+#endif
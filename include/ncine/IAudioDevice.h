@@ -31,6 +31,8 @@ class DLL_PUBLIC IAudioDevice
 	virtual unsigned int maxNumPlayers() const = 0;
 	/// Returns the number of active players
 	virtual unsigned int numPlayers() const = 0;
+	/// Returns the number of active players without an OpenAL source, as of the last update
+	virtual unsigned int numVirtualPlayers() const = 0;
 	/// Returns the specified running player object
 	virtual const IAudioPlayer *player(unsigned int index) const = 0;
 
@@ -69,6 +71,7 @@ class DLL_PUBLIC NullAudioDevice : public IAudioDevice
 
 	unsigned int maxNumPlayers() const override { return 0; }
 	unsigned int numPlayers() const override { return 0; }
+	unsigned int numVirtualPlayers() const override { return 0; }
 	const IAudioPlayer *player(unsigned int index) const override { return nullptr; }
 
 	void stopPlayers() override {}
@@ -3,6 +3,7 @@
 
 #include "Object.h"
 #include "Vector3.h"
+#include "IAudioDevice.h"
 
 namespace ncine {
 
@@ -68,6 +69,8 @@ class DLL_PUBLIC IAudioPlayer : public Object
 	inline bool isPaused() const { return state_ == PlayerState::PAUSED; }
 	/// Queries the stopped state of the player
 	inline bool isStopped() const { return state_ == PlayerState::STOPPED; }
+	/// Returns true if the player is playing without an OpenAL source, as a virtual voice
+	inline bool isVirtual() const { return state_ == PlayerState::PLAYING && sourceId_ == IAudioDevice::UnavailableSource; }
 
 	/// Queries the looping property of the player
 	inline bool isLooping() const { return isLooping_; }
@@ -89,6 +92,13 @@ class DLL_PUBLIC IAudioPlayer : public Object
 	/// Sets player position value through components
 	void setPosition(float x, float y, float z);
 
+	/// Returns the player priority
+	inline int priority() const { return priority_; }
+	/// Sets the player priority, only players with the same priority compete for OpenAL sources by audibility
+	inline void setPriority(int priority) { priority_ = priority; }
+	/// Returns an estimate of the gain perceived by the listener, based on the player gain and its distance
+	float audibility() const;
+
   protected:
 	/// The OpenAL source id
 	unsigned int sourceId_;
@@ -102,12 +112,25 @@ class DLL_PUBLIC IAudioPlayer : public Object
 	float pitch_;
 	/// Player position in space
 	Vector3f position_;
+	/// Player priority when competing for an OpenAL source
+	int priority_;
+	/// Playback position in seconds, saved when the source is released and advanced while the player is virtual
+	float virtualOffset_;
 
 	/// Updates the state of the player if the source has done playing
 	/*! It is called every frame by the `IAudioDevice` class and it is
 	 *  also responsible for buffer queueing/unqueueing in stream players. */
 	virtual void updateState() = 0;
 
+	/// Returns true if the device can take the OpenAL source away from the player while it is playing
+	virtual bool canReleaseSource() const = 0;
+	/// Binds the player to an OpenAL source and starts it from the playback position
+	virtual void acquireSource(unsigned int source) = 0;
+	/// Saves the playback position and gives the OpenAL source back, the player keeps playing as a virtual voice
+	virtual void releaseSource() = 0;
+	/// Advances the playback position of a virtual voice, stopping it at the end if it is not looping
+	virtual void updateVirtualState(float interval) = 0;
+
 	friend class ALAudioDevice;
 };
 
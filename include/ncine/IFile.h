@@ -18,7 +18,9 @@ class DLL_PUBLIC IFile
 		BASE = 0,
 		MEMORY,
 		STANDARD,
-		ASSET
+		ASSET,
+		MAPPED,
+		PACK
 	};
 
 	/// Open mode bitmask
@@ -63,6 +65,9 @@ class DLL_PUBLIC IFile
 	inline void setCloseOnDestruction(bool shouldCloseOnDestruction) { shouldCloseOnDestruction_ = shouldCloseOnDestruction; }
 	/// Returns true if the file has been sucessfully opened
 	virtual bool isOpened() const;
+	/// Returns a pointer to the contents of an opened file if they are directly accessible in memory, or `nullptr`
+	/*! Memory and mapped files can be consumed in place, without reading them into a copy. */
+	virtual const unsigned char *data() const { return nullptr; }
 
 	/// Returns file name with path
 	const char *filename() const { return filename_.data(); }
@@ -107,8 +112,10 @@ class DLL_PUBLIC IFile
 	/// Returns a read-only memory file
 	static nctl::UniquePtr<IFile> createFromMemory(const unsigned char *bufferPtr, unsigned long int bufferSize);
 
-	/// Returns the proper file handle according to prepended tags
+	/// Returns the proper file handle according to prepended tags, or a packed file if a mounted archive contains it
 	static nctl::UniquePtr<IFile> createFileHandle(const char *filename);
+	/// Returns a read-only file handle that maps a standard file in memory, or the same handle as `createFileHandle()` for other files
+	static nctl::UniquePtr<IFile> createMappedFileHandle(const char *filename);
 
   protected:
 	/// File type
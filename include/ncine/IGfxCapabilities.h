@@ -52,11 +52,14 @@ class DLL_PUBLIC IGfxCapabilities
 		{
 			KHR_DEBUG = 0,
 			ARB_TEXTURE_STORAGE,
+			ARB_BUFFER_STORAGE,
 			EXT_TEXTURE_COMPRESSION_S3TC,
 			OES_COMPRESSED_ETC1_RGB8_TEXTURE,
 			AMD_COMPRESSED_ATC_TEXTURE,
 			IMG_TEXTURE_COMPRESSION_PVRTC,
 			KHR_TEXTURE_COMPRESSION_ASTC_LDR,
+			ARB_GET_PROGRAM_BINARY,
+			KHR_PARALLEL_SHADER_COMPILE,
 
 			COUNT
 		};
@@ -705,6 +705,96 @@ inline Matrix4x4<T> Matrix4x4<T>::perspective(T fovY, T aspect, T near, T far)
 	return frustum(xMin, xMax, yMin, yMax, near, far);
 }
 
+#ifdef NCINE_WITH_SIMD
+template <>
+inline Vector4<float> Matrix4x4<float>::operator*(const Vector4<float> &v) const
+{
+	simd::Float4 col0 = simd::load(vecs_[0].data());
+	simd::Float4 col1 = simd::load(vecs_[1].data());
+	simd::Float4 col2 = simd::load(vecs_[2].data());
+	simd::Float4 col3 = simd::load(vecs_[3].data());
+	simd::transpose(col0, col1, col2, col3);
+
+	const simd::Float4 vec = simd::load(v.data());
+	simd::Float4 sum = simd::mul(col0, simd::splatLane<0>(vec));
+	sum = simd::mulAdd(sum, col1, simd::splatLane<1>(vec));
+	sum = simd::mulAdd(sum, col2, simd::splatLane<2>(vec));
+	sum = simd::mulAdd(sum, col3, simd::splatLane<3>(vec));
+
+	Vector4<float> result;
+	simd::store(result.data(), sum);
+	return result;
+}
+
+inline Vector4<float> operator*(const Vector4<float> &v, const Matrix4x4<float> &m)
+{
+	const simd::Float4 vec = simd::load(v.data());
+	simd::Float4 sum = simd::mul(simd::load(m[0].data()), simd::splatLane<0>(vec));
+	sum = simd::mulAdd(sum, simd::load(m[1].data()), simd::splatLane<1>(vec));
+	sum = simd::mulAdd(sum, simd::load(m[2].data()), simd::splatLane<2>(vec));
+	sum = simd::mulAdd(sum, simd::load(m[3].data()), simd::splatLane<3>(vec));
+
+	Vector4<float> result;
+	simd::store(result.data(), sum);
+	return result;
+}
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::operator*(const Matrix4x4<float> &m2) const
+{
+	const simd::Float4 m1col0 = simd::load(vecs_[0].data());
+	const simd::Float4 m1col1 = simd::load(vecs_[1].data());
+	const simd::Float4 m1col2 = simd::load(vecs_[2].data());
+	const simd::Float4 m1col3 = simd::load(vecs_[3].data());
+	Matrix4x4<float> result;
+
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		const simd::Float4 m2col = simd::load(m2[i].data());
+		simd::Float4 sum = simd::mul(m1col0, simd::splatLane<0>(m2col));
+		sum = simd::mulAdd(sum, m1col1, simd::splatLane<1>(m2col));
+		sum = simd::mulAdd(sum, m1col2, simd::splatLane<2>(m2col));
+		sum = simd::mulAdd(sum, m1col3, simd::splatLane<3>(m2col));
+		simd::store(result[i].data(), sum);
+	}
+
+	return result;
+}
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::transposed() const
+{
+	simd::Float4 col0 = simd::load(vecs_[0].data());
+	simd::Float4 col1 = simd::load(vecs_[1].data());
+	simd::Float4 col2 = simd::load(vecs_[2].data());
+	simd::Float4 col3 = simd::load(vecs_[3].data());
+	simd::transpose(col0, col1, col2, col3);
+
+	Matrix4x4<float> result;
+	simd::store(result[0].data(), col0);
+	simd::store(result[1].data(), col1);
+	simd::store(result[2].data(), col2);
+	simd::store(result[3].data(), col3);
+	return result;
+}
+
+template <>
+inline Matrix4x4<float> &Matrix4x4<float>::transpose()
+{
+	simd::Float4 col0 = simd::load(vecs_[0].data());
+	simd::Float4 col1 = simd::load(vecs_[1].data());
+	simd::Float4 col2 = simd::load(vecs_[2].data());
+	simd::Float4 col3 = simd::load(vecs_[3].data());
+	simd::transpose(col0, col1, col2, col3);
+
+	simd::store(vecs_[0].data(), col0);
+	simd::store(vecs_[1].data(), col1);
+	simd::store(vecs_[2].data(), col2);
+	simd::store(vecs_[3].data(), col3);
+	return *this;
+}
+#endif
+
 template <class T>
 const Matrix4x4<T> Matrix4x4<T>::Zero(Vector4<T>(0, 0, 0, 0), Vector4<T>(0, 0, 0, 0), Vector4<T>(0, 0, 0, 0), Vector4<T>(0, 0, 0, 0));
 template <class T>
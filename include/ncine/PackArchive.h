@@ -0,0 +1,50 @@
+#ifndef CLASS_NCINE_PACKARCHIVE
+#define CLASS_NCINE_PACKARCHIVE
+
+#include <nctl/UniquePtr.h>
+#include "common_defines.h"
+
+namespace ncine {
+
+class IFile;
+
+/// The class mounting pack archives, that gather many asset files into a single indexed one
+/*! A pack starts with an index sorted by the hash of the relative paths, followed by the contents of the files, each one aligned to 4 KB.
+ *  Entries are either stored as they are, and read in place from the mapped archive, or compressed in the LZ4 block format.
+ *  When an archive is mounted, `IFile::createFileHandle()` looks up its entries before the file system, so loaders read them without changes.
+ *  \note Only file handles see inside archives, `FileSystem` functions always inspect the real file system
+ *  \note Archives should not be mounted or unmounted while files are being loaded from other threads */
+class DLL_PUBLIC PackArchive
+{
+  public:
+	/// The file extension of pack archives
+	static const char *Extension;
+
+	/// Mounts a pack archive, the paths of its entries are relative to the root path, or to the data path if it is `nullptr`
+	/*! Archives that are mounted later take precedence over the previous ones. Returns false if the archive is invalid or already mounted. */
+	static bool mount(const char *packFilename, const char *rootPath = nullptr);
+	/// Unmounts a pack archive, the files already opened from it stay valid
+	static bool unmount(const char *packFilename);
+	/// Unmounts all pack archives
+	static void unmountAll();
+	/// Returns the number of mounted pack archives
+	static unsigned int numMounted();
+	/// Returns true if a file with the specified name is found inside a mounted archive
+	static bool contains(const char *filename);
+
+	/// Packs all the files inside a directory and its subdirectories into a new archive
+	/*! \param compress Whether entries are compressed, if it makes them smaller
+	 *  \return True if the archive has been written successfully */
+	static bool build(const char *directory, const char *packFilename, bool compress);
+
+  private:
+	/// Returns a handle to a packed file, or `nullptr` if no mounted archive contains it
+	static nctl::UniquePtr<IFile> createFileHandle(const char *filename);
+
+	/// The `IFile` class needs to access `createFileHandle()`
+	friend class IFile;
+};
+
+}
+
+#endif
@@ -8,6 +8,7 @@
 namespace ncine {
 
 class Particle;
+class ParticleArrays;
 
 const unsigned int StepsInitialSize = 4;
 
@@ -25,14 +26,20 @@ class DLL_PUBLIC ParticleAffector
 		VELOCITY
 	};
 
+	/// Number of entries of the lookup tables sampled when affecting a range of particles
+	static const unsigned int LookupTableSize = 256;
+
 	ParticleAffector(Type type)
-	    : type_(type), enabled_(true) {}
+	    : type_(type), enabled_(true), lookupTableIsDirty_(true) {}
 	virtual ~ParticleAffector() {}
 
 	/// Affects a property of the specified particle
 	void affect(Particle *particle);
 	/// Affects a property of the specified particle, without calculating the normalized age
 	virtual void affect(Particle *particle, float normalizedAge) = 0;
+	/// Affects a property of every particle in the specified range of the arrays, using their precalculated normalized ages
+	/*! \note Instead of searching the steps for every particle, a lookup table is sampled and rebuilt only when the steps change */
+	virtual void affect(ParticleArrays &particles, unsigned int first, unsigned int count) = 0;
 
 	/// Returns the object type (RTTI)
 	inline Type type() const { return type_; }
@@ -54,6 +61,8 @@ class DLL_PUBLIC ParticleAffector
 	Type type_;
 	/// A flag indicating whether the affector is enabled or not
 	bool enabled_;
+	/// A flag indicating whether the lookup table should be rebuilt before affecting a range of particles
+	bool lookupTableIsDirty_;
 
 	/// Protected default copy constructor used to clone objects
 	ParticleAffector(const ParticleAffector &other) = default;
@@ -87,14 +96,23 @@ class DLL_PUBLIC ColorAffector : public ParticleAffector
 
 	/// Affects the color of the specified particle
 	void affect(Particle *particle, float normalizedAge) override;
+	/// Affects the color of every particle in the specified range of the arrays
+	void affect(ParticleArrays &particles, unsigned int first, unsigned int count) override;
 	void addColorStep(float age, const Colorf &color);
 	inline void addColorStep(const ColorStep &step) { addColorStep(step.age, step.color); }
+	/// Sets the age and the color of the step at the specified index, the step is moved to keep the steps sorted by age
+	void setColorStep(unsigned int index, float age, const Colorf &color);
+	inline void setColorStep(unsigned int index, const ColorStep &step) { setColorStep(index, step.age, step.color); }
 
 	inline unsigned int numSteps() const override { return colorSteps_.size(); }
 	void removeStep(unsigned int index) override;
-	inline void clearSteps() override { colorSteps_.clear(); }
+	inline void clearSteps() override
+	{
+		colorSteps_.clear();
+		lookupTableIsDirty_ = true;
+	}
 
-	inline nctl::Array<ColorStep> &steps() { return colorSteps_; }
+	/// Returns the steps sorted by age, they are only modified by the functions that mark the lookup table as dirty
 	inline const nctl::Array<ColorStep> &steps() const { return colorSteps_; }
 
   protected:
@@ -103,6 +121,13 @@ class DLL_PUBLIC ColorAffector : public ParticleAffector
 
   private:
 	nctl::Array<ColorStep> colorSteps_;
+	/// The colors sampled from the steps at evenly spaced ages
+	nctl::Array<Colorf> colorLut_;
+
+	/// Returns the value interpolated between the two steps around the specified age
+	Colorf colorAt(float normalizedAge) const;
+	/// Samples the steps into the lookup table
+	void updateLookupTable();
 };
 
 /// Particle size affector
@@ -147,26 +172,49 @@ class DLL_PUBLIC SizeAffector : public ParticleAffector
 
 	/// Affects the size of the specified particle
 	void affect(Particle *particle, float normalizedAge) override;
+	/// Affects the size of every particle in the specified range of the arrays
+	void affect(ParticleArrays &particles, unsigned int first, unsigned int count) override;
 	inline void addSizeStep(float age, float scale) { addSizeStep(age, scale, scale); }
 	void addSizeStep(float age, float scaleX, float scaleY);
 	inline void addSizeStep(float age, const Vector2f &scale) { addSizeStep(age, scale.x, scale.y); }
 	inline void addSizeStep(const SizeStep &step) { addSizeStep(step.age, step.scale); }
+	/// Sets the age and the scale of the step at the specified index, the step is moved to keep the steps sorted by age
+	void setSizeStep(unsigned int index, float age, float scaleX, float scaleY);
+	inline void setSizeStep(unsigned int index, float age, float scale) { setSizeStep(index, age, scale, scale); }
+	inline void setSizeStep(unsigned int index, float age, const Vector2f &scale) { setSizeStep(index, age, scale.x, scale.y); }
+	inline void setSizeStep(unsigned int index, const SizeStep &step) { setSizeStep(index, step.age, step.scale); }
 
 	inline unsigned int numSteps() const override { return sizeSteps_.size(); }
 	void removeStep(unsigned int index) override;
-	inline void clearSteps() override { sizeSteps_.clear(); }
+	inline void clearSteps() override
+	{
+		sizeSteps_.clear();
+		lookupTableIsDirty_ = true;
+	}
 
-	inline nctl::Array<SizeStep> &steps() { return sizeSteps_; }
+	/// Returns the steps sorted by age, they are only modified by the functions that mark the lookup table as dirty
 	inline const nctl::Array<SizeStep> &steps() const { return sizeSteps_; }
 
 	inline float baseScaleX() const { return baseScale_.x; }
-	inline void setBaseScaleX(float baseScaleX) { baseScale_.x = baseScaleX; }
+	inline void setBaseScaleX(float baseScaleX)
+	{
+		baseScale_.x = baseScaleX;
+		lookupTableIsDirty_ = true;
+	}
 	inline float baseScaleY() const { return baseScale_.y; }
-	inline void setBaseScaleY(float baseScaleY) { baseScale_.y = baseScaleY; }
+	inline void setBaseScaleY(float baseScaleY)
+	{
+		baseScale_.y = baseScaleY;
+		lookupTableIsDirty_ = true;
+	}
 
 	inline const Vector2f &baseScale() const { return baseScale_; }
-	inline void setBaseScale(float baseScale) { baseScale_.set(baseScale, baseScale); }
-	inline void setBaseScale(const Vector2f &baseScale) { baseScale_ = baseScale; }
+	inline void setBaseScale(float baseScale) { setBaseScale(Vector2f(baseScale, baseScale)); }
+	inline void setBaseScale(const Vector2f &baseScale)
+	{
+		baseScale_ = baseScale;
+		lookupTableIsDirty_ = true;
+	}
 
   protected:
 	/// Protected default copy constructor used to clone objects
@@ -175,6 +223,14 @@ class DLL_PUBLIC SizeAffector : public ParticleAffector
   private:
 	nctl::Array<SizeStep> sizeSteps_;
 	Vector2f baseScale_;
+	/// The scales sampled from the steps at evenly spaced ages, multiplied by the base one
+	nctl::Array<float> scaleXLut_;
+	nctl::Array<float> scaleYLut_;
+
+	/// Returns the scale interpolated between the two steps around the specified age, multiplied by the base one
+	Vector2f scaleAt(float normalizedAge) const;
+	/// Samples the steps into the lookup tables
+	void updateLookupTable();
 };
 
 /// Particle rotation affector
@@ -205,14 +261,23 @@ class DLL_PUBLIC RotationAffector : public ParticleAffector
 
 	/// Affects the rotation of the specified particle
 	void affect(Particle *particle, float normalizedAge) override;
+	/// Affects the rotation of every particle in the specified range of the arrays
+	void affect(ParticleArrays &particles, unsigned int first, unsigned int count) override;
 	void addRotationStep(float age, float angle);
 	inline void addRotationStep(const RotationStep &step) { addRotationStep(step.age, step.angle); }
+	/// Sets the age and the angle of the step at the specified index, the step is moved to keep the steps sorted by age
+	void setRotationStep(unsigned int index, float age, float angle);
+	inline void setRotationStep(unsigned int index, const RotationStep &step) { setRotationStep(index, step.age, step.angle); }
 
 	inline unsigned int numSteps() const override { return rotationSteps_.size(); }
 	void removeStep(unsigned int index) override;
-	inline void clearSteps() override { rotationSteps_.clear(); }
+	inline void clearSteps() override
+	{
+		rotationSteps_.clear();
+		lookupTableIsDirty_ = true;
+	}
 
-	inline nctl::Array<RotationStep> &steps() { return rotationSteps_; }
+	/// Returns the steps sorted by age, they are only modified by the functions that mark the lookup table as dirty
 	inline const nctl::Array<RotationStep> &steps() const { return rotationSteps_; }
 
   protected:
@@ -221,6 +286,13 @@ class DLL_PUBLIC RotationAffector : public ParticleAffector
 
   private:
 	nctl::Array<RotationStep> rotationSteps_;
+	/// The angles sampled from the steps at evenly spaced ages
+	nctl::Array<float> angleLut_;
+
+	/// Returns the value interpolated between the two steps around the specified age
+	float angleAt(float normalizedAge) const;
+	/// Samples the steps into the lookup table
+	void updateLookupTable();
 };
 
 /// Particle position affector
@@ -251,15 +323,25 @@ class DLL_PUBLIC PositionAffector : public ParticleAffector
 
 	/// Affects the position of the specified particle
 	void affect(Particle *particle, float normalizedAge) override;
+	/// Affects the position of every particle in the specified range of the arrays
+	void affect(ParticleArrays &particles, unsigned int first, unsigned int count) override;
 	void addPositionStep(float age, float posX, float posY);
 	inline void addPositionStep(float age, const Vector2f &position) { addPositionStep(age, position.x, position.y); }
 	inline void addPositionStep(const PositionStep &step) { addPositionStep(step.age, step.position); }
+	/// Sets the age and the position of the step at the specified index, the step is moved to keep the steps sorted by age
+	void setPositionStep(unsigned int index, float age, float posX, float posY);
+	inline void setPositionStep(unsigned int index, float age, const Vector2f &position) { setPositionStep(index, age, position.x, position.y); }
+	inline void setPositionStep(unsigned int index, const PositionStep &step) { setPositionStep(index, step.age, step.position); }
 
 	inline unsigned int numSteps() const override { return positionSteps_.size(); }
 	void removeStep(unsigned int index) override;
-	inline void clearSteps() override { positionSteps_.clear(); }
+	inline void clearSteps() override
+	{
+		positionSteps_.clear();
+		lookupTableIsDirty_ = true;
+	}
 
-	inline nctl::Array<PositionStep> &steps() { return positionSteps_; }
+	/// Returns the steps sorted by age, they are only modified by the functions that mark the lookup table as dirty
 	inline const nctl::Array<PositionStep> &steps() const { return positionSteps_; }
 
   protected:
@@ -268,6 +350,14 @@ class DLL_PUBLIC PositionAffector : public ParticleAffector
 
   private:
 	nctl::Array<PositionStep> positionSteps_;
+	/// The positions sampled from the steps at evenly spaced ages
+	nctl::Array<float> positionXLut_;
+	nctl::Array<float> positionYLut_;
+
+	/// Returns the value interpolated between the two steps around the specified age
+	Vector2f positionAt(float normalizedAge) const;
+	/// Samples the steps into the lookup tables
+	void updateLookupTable();
 };
 
 /// Particle velocity affector
@@ -298,15 +388,25 @@ class DLL_PUBLIC VelocityAffector : public ParticleAffector
 
 	/// Affects the velocity of the specified particle
 	void affect(Particle *particle, float normalizedAge) override;
+	/// Affects the velocity of every particle in the specified range of the arrays
+	void affect(ParticleArrays &particles, unsigned int first, unsigned int count) override;
 	void addVelocityStep(float age, float velX, float velY);
 	inline void addVelocityStep(float age, const Vector2f &velocity) { addVelocityStep(age, velocity.x, velocity.y); }
 	inline void addVelocityStep(const VelocityStep &step) { addVelocityStep(step.age, step.velocity); }
+	/// Sets the age and the velocity of the step at the specified index, the step is moved to keep the steps sorted by age
+	void setVelocityStep(unsigned int index, float age, float velX, float velY);
+	inline void setVelocityStep(unsigned int index, float age, const Vector2f &velocity) { setVelocityStep(index, age, velocity.x, velocity.y); }
+	inline void setVelocityStep(unsigned int index, const VelocityStep &step) { setVelocityStep(index, step.age, step.velocity); }
 
 	inline unsigned int numSteps() const override { return velocitySteps_.size(); }
 	void removeStep(unsigned int index) override;
-	inline void clearSteps() override { velocitySteps_.clear(); }
+	inline void clearSteps() override
+	{
+		velocitySteps_.clear();
+		lookupTableIsDirty_ = true;
+	}
 
-	inline nctl::Array<VelocityStep> &steps() { return velocitySteps_; }
+	/// Returns the steps sorted by age, they are only modified by the functions that mark the lookup table as dirty
 	inline const nctl::Array<VelocityStep> &steps() const { return velocitySteps_; }
 
   protected:
@@ -315,6 +415,14 @@ class DLL_PUBLIC VelocityAffector : public ParticleAffector
 
   private:
 	nctl::Array<VelocityStep> velocitySteps_;
+	/// The velocitys sampled from the steps at evenly spaced ages
+	nctl::Array<float> velocityXLut_;
+	nctl::Array<float> velocityYLut_;
+
+	/// Returns the value interpolated between the two steps around the specified age
+	Vector2f velocityAt(float normalizedAge) const;
+	/// Samples the steps into the lookup tables
+	void updateLookupTable();
 };
 
 }
@@ -3,6 +3,7 @@
 
 #include <ctime>
 #include <cstdlib>
+#include <nctl/Atomic.h>
 #include "Rect.h"
 #include "SceneNode.h"
 #include "ParticleAffectors.h"
@@ -12,9 +13,14 @@ namespace ncine {
 
 class Texture;
 class Particle;
+class ParticleArraysNode;
+class ParallelParticlesUpdate;
 struct ParticleInitializer;
 
 /// The class representing a particle system
+/*! \note When `AppConfiguration::useParticleArrays` is enabled the particles are not `Particle` sprites,
+ *  they are stored in contiguous arrays by a single child node that draws all of them with one instanced command.
+ *  With `AppConfiguration::useParallelParticlesUpdate` the arrays are then updated by a thread pool job. */
 class DLL_PUBLIC ParticleSystem : public SceneNode
 {
   public:
@@ -22,6 +28,7 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 	ParticleSystem(SceneNode *parent, unsigned int count, Texture *texture);
 	/// Constructs a particle system with the specified maximum amount of particles and the specified texture rectangle
 	ParticleSystem(SceneNode *parent, unsigned int count, Texture *texture, Recti texRect);
+	~ParticleSystem() override;
 
 	/// Default move constructor
 	ParticleSystem(ParticleSystem &&);
@@ -36,6 +43,7 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 	/// Deletes all particle affectors
 	void clearAffectors();
 	/// Emits particles with the specified initialization parameters
+	/*! \note It can be called while the update of the system is being executed by a thread pool job, it waits for it to finish. */
 	void emitParticles(const ParticleInitializer &init);
 	/// Kills all alive particles
 	void killParticles();
@@ -48,7 +56,7 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 	/// Returns the local space flag of the system
 	inline bool inLocalSpace(void) const { return inLocalSpace_; }
 	/// Sets the local space flag of the system
-	inline void setInLocalSpace(bool inLocalSpace) { inLocalSpace_ = inLocalSpace; }
+	void setInLocalSpace(bool inLocalSpace);
 
 	/// Returns true if particles are updating
 	inline bool isParticlesUpdateEnabled(void) const { return particlesUpdateEnabled_; }
@@ -61,9 +69,9 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 	inline void setAffectorsEnabled(bool affectorsEnabled) { affectorsEnabled_ = affectorsEnabled; }
 
 	/// Returns the total number of particles in the system
-	inline unsigned int numParticles() const { return particleArray_.size(); }
+	inline unsigned int numParticles() const { return poolSize_; }
 	/// Returns the number of particles currently alive
-	inline unsigned int numAliveParticles() const { return particleArray_.size() - poolTop_ - 1; }
+	unsigned int numAliveParticles() const;
 
 	/// Sets the texture object for every particle
 	void setTexture(Texture *texture);
@@ -105,6 +113,8 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 	nctl::Array<Particle *> particlePool_;
 	/// The array containing every particle (dead or alive)
 	nctl::Array<nctl::UniquePtr<Particle>> particleArray_;
+	/// The child node storing the particles in arrays, used instead of the pools when enabled
+	nctl::UniquePtr<ParticleArraysNode> arraysNode_;
 
 	/// The array of particle affectors
 	nctl::Array<nctl::UniquePtr<ParticleAffector>> affectors_;
@@ -115,8 +125,31 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 	bool particlesUpdateEnabled_;
 	bool affectorsEnabled_;
 
+	/// The state of the update of the particle arrays deferred to a thread pool job
+	nctl::UniquePtr<nctl::Atomic32> updateJobState_;
+	/// The interval passed to the deferred update of the particle arrays
+	float updateJobInterval_;
+
+	/// The object collecting the deferred updates during the scenegraph walk, or `nullptr` if they are not deferred
+	static ParallelParticlesUpdate *parallelUpdate_;
+
+	/// Updates the particles stored in arrays, removing the dead ones
+	void updateParticleArrays(float interval);
+	/// Marks the deferred update as started, returns false if it has already been started
+	bool claimUpdateJob();
+	/// Updates the particle arrays of a deferred update that has been claimed
+	void executeUpdateJob();
+	/// Updates the particle arrays if the deferred update has not been started yet, returns false otherwise
+	bool runUpdateJob();
+	/// Runs the deferred update of the particle arrays or waits for the job that is executing it
+	void finishUpdateJob();
+	/// Completes the deferred update on the calling thread, after the job has been executed
+	void completeUpdateJob();
+
 	/// Deleted assignment operator
 	ParticleSystem &operator=(const ParticleSystem &) = delete;
+
+	friend class ParallelParticlesUpdate;
 };
 
 }
@@ -340,6 +340,33 @@ inline Quaternion<T> Quaternion<T>::fromZAxisAngle(T degrees)
 	return Quaternion<T>(0, 0, sin(halfRadians), cos(halfRadians));
 }
 
+#ifdef NCINE_WITH_SIMD
+template <>
+inline Quaternion<float> Quaternion<float>::operator*(const Quaternion<float> &q) const
+{
+	const simd::Float4 q0 = simd::load(data());
+	const simd::Float4 q1 = simd::load(q.data());
+	// The sign of the last lane is flipped for the terms that are subtracted from `w` but added to the other components
+	const simd::Float4 flipW = simd::set(1.0f, 1.0f, 1.0f, -1.0f);
+
+	simd::Float4 result = simd::mul(simd::splatLane<3>(q0), q1);
+	result = simd::mulAdd(result, simd::mul(simd::shuffle<0, 1, 2, 0>(q0), flipW), simd::shuffle<3, 3, 3, 0>(q1));
+	result = simd::mulAdd(result, simd::mul(simd::shuffle<1, 2, 0, 1>(q0), flipW), simd::shuffle<2, 0, 1, 1>(q1));
+	result = simd::sub(result, simd::mul(simd::shuffle<2, 0, 1, 2>(q0), simd::shuffle<1, 2, 0, 2>(q1)));
+
+	Quaternion<float> product;
+	simd::store(product.data(), result);
+	return product;
+}
+
+template <>
+inline Quaternion<float> &Quaternion<float>::operator*=(const Quaternion<float> &q)
+{
+	*this = *this * q;
+	return *this;
+}
+#endif
+
 template <class T>
 const Quaternion<T> Quaternion<T>::Zero(0, 0, 0, 0);
 template <class T>
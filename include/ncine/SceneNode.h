@@ -13,6 +13,9 @@ namespace ncine {
 
 class RenderQueue;
 class Viewport;
+class ParallelSceneUpdate;
+class ParallelSceneVisit;
+class DirtySceneUpdate;
 
 /// The base class for the transformation nodes hierarchy
 class DLL_PUBLIC SceneNode : public Object
@@ -82,7 +85,11 @@ class DLL_PUBLIC SceneNode : public Object
 	/// Returns true if the node visit order is used together with the layer
 	inline enum VisitOrderState visitOrderState() const { return visitOrderState_; }
 	/// Enables the use of the node visit order together with the layer
-	inline void setVisitOrderState(enum VisitOrderState visitOrderState) { visitOrderState_ = visitOrderState; }
+	inline void setVisitOrderState(enum VisitOrderState visitOrderState)
+	{
+		visitOrderState_ = visitOrderState;
+		addToDirtyList();
+	}
 	/// Returns the visit drawing order of the node
 	inline uint16_t visitOrderIndex() const { return visitOrderIndex_; }
 
@@ -96,7 +103,11 @@ class DLL_PUBLIC SceneNode : public Object
 	/// Returns true if the node is updating
 	inline bool isUpdateEnabled() const { return updateEnabled_; }
 	/// Enables or disables node updating
-	inline void setUpdateEnabled(bool updateEnabled) { updateEnabled_ = updateEnabled; }
+	inline void setUpdateEnabled(bool updateEnabled)
+	{
+		updateEnabled_ = updateEnabled;
+		addToDirtyList();
+	}
 	/// Returns true if the node is drawing
 	inline bool isDrawEnabled() const { return drawEnabled_; }
 	/// Enables or disables node drawing
@@ -181,7 +192,11 @@ class DLL_PUBLIC SceneNode : public Object
 	/// Sets the node rendering layer
 	/*! \note The lowest value (bottom) is 0 and the highest one (top) is 65535.
 	 *  When the value is 0, the final layer value is inherited from the parent. */
-	void setLayer(uint16_t layer) { layer_ = layer; }
+	void setLayer(uint16_t layer)
+	{
+		layer_ = layer;
+		addToDirtyList();
+	}
 
 	/// Gets the node world matrix
 	inline const Matrix4x4f &worldMatrix() const { return worldMatrix_; }
@@ -202,6 +217,12 @@ class DLL_PUBLIC SceneNode : public Object
 	/// Returns the last frame in which any of the viewports have updated this node
 	inline unsigned long int lastFrameUpdated() const { return lastFrameUpdated_; }
 
+	/// Returns true if the node is updated every frame even when the dirty list update skips the unchanged subtrees
+	inline bool isUpdatedEveryFrame() const { return updatedEveryFrame_; }
+	/// Sets the node to be updated every frame even when it has not changed
+	/*! \note Only needed when the dirty list update is enabled, by nodes that override `update()` to change over time */
+	void setUpdatedEveryFrame(bool updatedEveryFrame);
+
   protected:
 	/// Bit positions inside the dirty bitset
 	enum DirtyBitPositions
@@ -289,6 +310,36 @@ class DLL_PUBLIC SceneNode : public Object
 	void swapChildPointer(SceneNode *first, SceneNode *second);
 
 	virtual void transform();
+
+	/// Adds the node to the roots of the subtrees to update, if the dirty list update is enabled
+	inline void addToDirtyList()
+	{
+		if (dirtyUpdate_ != nullptr && inDirtyList_ == false)
+			registerDirtyNode();
+	}
+
+  private:
+	/// The flag is `true` if the node is in the list of dirty subtree roots
+	bool inDirtyList_;
+	/// The flag is `true` if the node is updated every frame by the dirty list update
+	bool updatedEveryFrame_;
+
+	/// The dirty list update that collects the subtrees to update, if it is enabled
+	static DirtySceneUpdate *dirtyUpdate_;
+	/// The parallel update that is collecting subtrees, if any
+	/*! \note It is only set while the calling thread updates the nodes above the split depth */
+	static ParallelSceneUpdate *parallelUpdate_;
+	/// The parallel visit that is collecting subtrees, if any
+	/*! \note It is only set while the calling thread visits the nodes above the split depth */
+	static ParallelSceneVisit *parallelVisit_;
+
+	friend class ParallelSceneUpdate;
+	friend class ParallelSceneVisit;
+	friend class CullingGrid;
+	friend class DirtySceneUpdate;
+
+	void registerDirtyNode();
+	void takeDirtyUpdateState(SceneNode &other);
 };
 
 inline const nctl::Array<const SceneNode *> &SceneNode::children() const
@@ -300,6 +351,7 @@ inline void SceneNode::setEnabled(bool enabled)
 {
 	updateEnabled_ = enabled;
 	drawEnabled_ = enabled;
+	addToDirtyList();
 }
 
 inline void SceneNode::setPosition(float x, float y)
@@ -307,6 +359,7 @@ inline void SceneNode::setPosition(float x, float y)
 	position_.set(x, y);
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setPosition(const Vector2f &position)
@@ -314,6 +367,7 @@ inline void SceneNode::setPosition(const Vector2f &position)
 	position_ = position;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setPositionX(float x)
@@ -321,6 +375,7 @@ inline void SceneNode::setPositionX(float x)
 	position_.x = x;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setPositionY(float y)
@@ -328,6 +383,7 @@ inline void SceneNode::setPositionY(float y)
 	position_.y = y;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::move(float x, float y)
@@ -336,6 +392,7 @@ inline void SceneNode::move(float x, float y)
 	position_.y += y;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::move(const Vector2f &position)
@@ -343,6 +400,7 @@ inline void SceneNode::move(const Vector2f &position)
 	position_ += position;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::moveX(float x)
@@ -350,6 +408,7 @@ inline void SceneNode::moveX(float x)
 	position_.x += x;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::moveY(float y)
@@ -357,6 +416,7 @@ inline void SceneNode::moveY(float y)
 	position_.y += y;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setAbsAnchorPoint(float x, float y)
@@ -364,6 +424,7 @@ inline void SceneNode::setAbsAnchorPoint(float x, float y)
 	anchorPoint_.set(x, y);
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setAbsAnchorPoint(const Vector2f &point)
@@ -371,6 +432,7 @@ inline void SceneNode::setAbsAnchorPoint(const Vector2f &point)
 	anchorPoint_ = point;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setScale(float scaleFactor)
@@ -378,6 +440,7 @@ inline void SceneNode::setScale(float scaleFactor)
 	scaleFactor_.set(scaleFactor, scaleFactor);
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setScale(float scaleFactorX, float scaleFactorY)
@@ -385,6 +448,7 @@ inline void SceneNode::setScale(float scaleFactorX, float scaleFactorY)
 	scaleFactor_.set(scaleFactorX, scaleFactorY);
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setScale(const Vector2f &scaleFactor)
@@ -392,6 +456,7 @@ inline void SceneNode::setScale(const Vector2f &scaleFactor)
 	scaleFactor_ = scaleFactor;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setRotation(float rotation)
@@ -399,42 +464,49 @@ inline void SceneNode::setRotation(float rotation)
 	rotation_ = fmodf(rotation, 360.0f);
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setColor(Color color)
 {
 	color_ = color;
 	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setColor(Colorf color)
 {
 	color_ = color;
 	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setColor(unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha)
 {
 	color_.set(red, green, blue, alpha);
 	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setColorF(float red, float green, float blue, float alpha)
 {
 	color_ = Colorf(red, green, blue, alpha);
 	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setAlpha(unsigned char alpha)
 {
 	color_.setAlpha(alpha);
 	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setAlphaF(float alpha)
 {
 	color_.setAlpha(static_cast<unsigned char>(alpha * 255));
 	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setWorldMatrix(const Matrix4x4f &worldMatrix)
@@ -442,6 +514,7 @@ inline void SceneNode::setWorldMatrix(const Matrix4x4f &worldMatrix)
 	worldMatrix_ = worldMatrix;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 inline void SceneNode::setLocalMatrix(const Matrix4x4f &localMatrix)
@@ -449,6 +522,7 @@ inline void SceneNode::setLocalMatrix(const Matrix4x4f &localMatrix)
 	localMatrix_ = localMatrix;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 }
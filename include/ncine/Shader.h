@@ -95,6 +95,11 @@ class DLL_PUBLIC Shader : public Object
 
 	/// Returns true if the shader is linked and can therefore be used
 	bool isLinked() const;
+	/// Returns true if the shader is still being compiled and linked asynchronously
+	/*! \note Shaders are only compiled asynchronously when `AppConfiguration::useAsyncShaderCompilation` is enabled
+	 *  and the `GL_KHR_parallel_shader_compile` extension is available. The check never stalls and it should be repeated
+	 *  until it returns false, then `isLinked()` reports whether the shader can be used. */
+	bool isLinking();
 
 	/// Returns the length of the information log including the null termination character
 	unsigned int retrieveInfoLogLength() const;
@@ -23,9 +23,12 @@ class DLL_PUBLIC ShaderState
 	bool setNode(DrawableNode *node);
 
 	inline const Shader *shader() const { return shader_; }
+	/// Sets a new shader, the node keeps its current one until a shader compiled asynchronously has finished linking
 	bool setShader(Shader *shader);
 	/// Triggers a shader update without setting a new shader
 	bool resetShader();
+	/// Returns true if the shader is still linking and it has not been applied to the node yet
+	inline bool isShaderPending() const { return isShaderPending_; }
 
 	bool setTexture(unsigned int unit, const Texture *texture);
 	inline bool setTexture(const Texture *texture) { return setTexture(0, texture); }
@@ -60,11 +63,20 @@ class DLL_PUBLIC ShaderState
 	DrawableNode *node_;
 	Shader *shader_;
 	int previousShaderType_;
+	bool isShaderPending_;
+
+	/// Adds or removes the state from the ones checked every frame for a shader that has finished linking
+	void setShaderPending(bool isShaderPending);
+	/// Applies the shader if the driver has finished linking it
+	void updatePendingShader();
 
 	/// Deleted copy constructor
 	ShaderState(const ShaderState &) = delete;
 	/// Deleted assignment operator
 	ShaderState &operator=(const ShaderState &) = delete;
+
+	/// The `RenderResources` class needs to access `updatePendingShader()`
+	friend class RenderResources;
 };
 
 }
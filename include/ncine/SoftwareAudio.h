@@ -0,0 +1,80 @@
+#ifndef CLASS_NCINE_SOFTWAREAUDIO
+#define CLASS_NCINE_SOFTWAREAUDIO
+
+#include <cstdint>
+#include "common_defines.h"
+
+namespace ncine {
+
+/// The statistics and the output of the software OpenAL layer linked instead of a sound driver
+/*! Sources are resampled and mixed into a 16 bits stereo stream at a fixed frequency, that is then written to a sink.
+ *  By default the audio device mixes the number of frames that fit in the last frame interval at every update. */
+class DLL_PUBLIC SoftwareAudio
+{
+  public:
+	/// The frequency of the mixed stream
+	static const int Frequency = 44100;
+	/// The number of channels of the mixed stream
+	static const int NumChannels = 2;
+
+	/// Where the mixed samples are written to
+	enum class Sink
+	{
+		/// The samples are discarded
+		NONE,
+		/// The samples are appended to an array in memory
+		MEMORY,
+		/// The samples are appended to a WAV file
+		WAV_FILE
+	};
+
+	/// The counters of the mixing work
+	struct Counters
+	{
+		/// Number of stereo frames mixed
+		uint64_t numMixedFrames = 0;
+		/// Number of source frames resampled and added to the mix
+		uint64_t numSourceFrames = 0;
+		/// Number of buffers played to the end by a source
+		uint64_t numProcessedBuffers = 0;
+		/// Number of times a source stopped after playing all of its buffers, an underrun for a stream that has not ended
+		uint64_t numDrainedSources = 0;
+		/// Number of samples clamped to the 16 bits range
+		uint64_t numClippedSamples = 0;
+	};
+
+	/// Returns the counters accumulated since the start or since the last reset
+	static const Counters &counters();
+	/// Resets the counters
+	static void resetCounters();
+
+	/// Returns true if the audio device mixes at every update
+	static bool isMixingOnUpdate();
+	/// Sets whether the audio device mixes at every update or sources only advance by calling `mix()`
+	static void setMixingOnUpdate(bool mixingOnUpdate);
+
+	/// Mixes the specified number of frames, advancing every playing source
+	static void mix(unsigned int numFrames);
+
+	static Sink sink();
+	/// Sets the sink of the mixed samples, a file name is needed by the `WAV_FILE` sink
+	/*! The previous WAV file, if any, is completed and closed. Returns false if the file cannot be opened. */
+	static bool setSink(Sink sink, const char *filename = nullptr);
+
+	/// Returns the interleaved stereo samples written to the memory sink
+	static const int16_t *memorySamples();
+	/// Returns the number of stereo frames written to the memory sink
+	static unsigned long int numMemoryFrames();
+	/// Discards the samples written to the memory sink
+	static void clearMemory();
+
+  private:
+	/// Called by the audio device at every update with the last frame interval
+	static void update(float interval);
+
+	friend class ALAudioDevice;
+};
+
+}
+
+#endif
@@ -9,7 +9,7 @@
 
 namespace ncine {
 
-class GLUniformBlockCache;
+class GLUniformCache;
 class FontGlyph;
 
 /// A scene node to draw a text label
@@ -145,7 +145,8 @@ class DLL_PUBLIC TextNode : public DrawableNode
 	/// The line height for the text node
 	float lineHeight_;
 
-	GLUniformBlockCache *instanceBlock_;
+	/// The color uniform handle, resolved when the shader changes
+	GLUniformCache *colorUniform_;
 
 	/// Deleted assignment operator
 	TextNode &operator=(const TextNode &) = delete;
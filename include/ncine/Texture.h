@@ -5,11 +5,14 @@
 #include "Rect.h"
 #include "Color.h"
 #include "Colorf.h"
+#include <nctl/SharedPtr.h>
 
 namespace ncine {
 
 class ITextureLoader;
 class GLTexture;
+class GLBufferObject;
+struct TextureLoadRequest;
 
 /// Texture class
 class DLL_PUBLIC Texture : public Object
@@ -44,6 +47,19 @@ class DLL_PUBLIC Texture : public Object
 		REPEAT
 	};
 
+	/// Texture loading states
+	enum class LoadingState
+	{
+		/// The texture is not being loaded asynchronously
+		READY,
+		/// The image file is being decoded by a worker thread
+		DECODING,
+		/// The decoded image is being uploaded a few rows per frame
+		UPLOADING,
+		/// The last asynchronous load has failed
+		FAILED
+	};
+
 	/// Creates an OpenGL texture name
 	Texture();
 
@@ -63,10 +79,10 @@ class DLL_PUBLIC Texture : public Object
 
 	~Texture() override;
 
-	/// Default move constructor
-	Texture(Texture &&);
-	/// Default move assignment operator
-	Texture &operator=(Texture &&);
+	/// Move constructor
+	Texture(Texture &&other);
+	/// Move assignment operator
+	Texture &operator=(Texture &&other);
 
 	/// Initializes an empty texture with the specified format, MIP levels, and size
 	void init(const char *name, Format format, int mipMapCount, int width, int height);
@@ -79,6 +95,8 @@ class DLL_PUBLIC Texture : public Object
 
 	bool loadFromMemory(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize);
 	bool loadFromFile(const char *filename);
+	/// Loads a texture from an image file without stalling the frame
+	void loadFromFileAsync(const char *filename);
 
 	/// Loads all texture texels in raw format from a memory buffer in the first mip level
 	bool loadFromTexels(const unsigned char *bufferPtr);
@@ -116,6 +134,11 @@ class DLL_PUBLIC Texture : public Object
 	/// Returns the amount of video memory needed to load the texture
 	inline unsigned long dataSize() const { return dataSize_; }
 
+	/// Returns the state of the last asynchronous load
+	inline LoadingState loadingState() const { return loadingState_; }
+	/// Returns true while an asynchronous load has not completed
+	inline bool isLoading() const { return (loadingState_ == LoadingState::DECODING || loadingState_ == LoadingState::UPLOADING); }
+
 	/// Returns the texture filtering for minification
 	inline Filtering minFiltering() const { return minFiltering_; }
 	/// Returns the texture filtering for magnification
@@ -165,6 +188,10 @@ class DLL_PUBLIC Texture : public Object
 	bool isChromaKeyEnabled_;
 	Color chromaKeyColor_;
 
+	LoadingState loadingState_;
+	/// The pending asynchronous load, shared with the upload queue
+	nctl::SharedPtr<TextureLoadRequest> loadRequest_;
+
 	/// Deleted copy constructor
 	Texture(const Texture &) = delete;
 	/// Deleted assignment operator
@@ -175,8 +202,17 @@ class DLL_PUBLIC Texture : public Object
 	/// Loads the data in a previously initialized texture
 	void load(const ITextureLoader &texLoader);
 
+	/// Cancels the pending asynchronous load, if any
+	void cancelLoadRequest();
+	/// Creates the storage for an asynchronously loaded texture, before uploading its rows
+	void initializeAsync(const ITextureLoader &texLoader);
+	/// Loads a range of rows of a MIP level, or the whole level if compressed, through the pixel buffer if it is not `nullptr`
+	void loadRows(const ITextureLoader &texLoader, int mipLevel, int firstRow, int numRows, GLBufferObject *pixelBuffer);
+
 	friend class Material;
 	friend class Viewport;
+	/// The `TextureUploadQueue` class needs to upload the decoded images and update the loading state
+	friend class TextureUploadQueue;
 };
 
 }
@@ -215,12 +215,12 @@ class DLL_PUBLIC Viewport
 	void visit();
 	void sortAndCommitQueue();
 	void draw(unsigned int nextIndex);
+	/// Marks as rendered in the specified frame every drawable node of the subtree that overlaps the culling rectangle
+	void updateCulling(SceneNode *node, unsigned long int frame);
 
   private:
 	unsigned int numColorAttachments_;
 
-	void updateCulling(SceneNode *node);
-
 	friend class Application;
 	friend class ScreenViewport;
 };
@@ -0,0 +1,152 @@
+#ifndef NCINE_COMMON_SIMD
+#define NCINE_COMMON_SIMD
+
+// The SIMD instruction set is selected at compile time, defining `NCINE_NO_SIMD` forces the scalar implementations
+#ifndef NCINE_NO_SIMD
+	#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#include <emmintrin.h>
+		#define NCINE_SIMD_SSE
+	#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+		#include <arm_neon.h>
+		#define NCINE_SIMD_NEON
+	#endif
+#endif
+
+#if defined(NCINE_SIMD_SSE) || defined(NCINE_SIMD_NEON)
+	#define NCINE_WITH_SIMD
+
+	#include <cstdint>
+
+namespace ncine {
+
+/// Thin wrappers around the four floats intrinsics used by the specializations of the math classes and by the software mixer
+/*! \note Loads and stores are unaligned, as the math classes do not change their alignment requirements.
+ *  The order of additions matches the scalar implementations wherever it is possible. */
+namespace simd {
+
+	#if defined(NCINE_SIMD_SSE)
+	using Float4 = __m128;
+
+	inline Float4 load(const float *src) { return _mm_loadu_ps(src); }
+	inline void store(float *dest, Float4 v) { _mm_storeu_ps(dest, v); }
+	inline Float4 splat(float s) { return _mm_set1_ps(s); }
+	inline Float4 set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+	template <int Lane>
+	inline Float4 splatLane(Float4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane)); }
+	/// Returns a vector made of the specified lanes of the source one
+	template <int X, int Y, int Z, int W>
+	inline Float4 shuffle(Float4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X)); }
+
+	inline Float4 add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+	inline Float4 sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+	inline Float4 mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+	inline Float4 div(Float4 a, Float4 b) { return _mm_div_ps(a, b); }
+	/// Returns `a + b * c`, without fusing the operations
+	inline Float4 mulAdd(Float4 a, Float4 b, Float4 c) { return _mm_add_ps(a, _mm_mul_ps(b, c)); }
+	inline Float4 min(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+	inline Float4 max(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+
+	/// Returns a vector made of the two lower lanes of the first vector and the two lower lanes of the second one
+	inline Float4 lowHalves(Float4 a, Float4 b) { return _mm_movelh_ps(a, b); }
+	/// Returns a vector made of the two upper lanes of the first vector and the two upper lanes of the second one
+	inline Float4 highHalves(Float4 a, Float4 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 2, 3, 2)); }
+
+	/// Returns the number of lanes that differ between the two vectors
+	inline unsigned int countNotEqual(Float4 a, Float4 b)
+	{
+		const int mask = _mm_movemask_ps(_mm_cmpneq_ps(a, b));
+		return (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+	}
+
+	/// Truncates the lanes to integers, then stores them as four 16 bits integers, saturating the ones out of range
+	inline void storeInt16(int16_t *dest, Float4 v)
+	{
+		const __m128i integers = _mm_cvttps_epi32(v);
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(dest), _mm_packs_epi32(integers, integers));
+	}
+
+	inline void transpose(Float4 &r0, Float4 &r1, Float4 &r2, Float4 &r3)
+	{
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	}
+
+	#elif defined(NCINE_SIMD_NEON)
+	using Float4 = float32x4_t;
+
+	inline Float4 load(const float *src) { return vld1q_f32(src); }
+	inline void store(float *dest, Float4 v) { vst1q_f32(dest, v); }
+	inline Float4 splat(float s) { return vdupq_n_f32(s); }
+	inline Float4 set(float x, float y, float z, float w)
+	{
+		const float values[4] = { x, y, z, w };
+		return vld1q_f32(values);
+	}
+	template <int Lane>
+	inline Float4 splatLane(Float4 v) { return vdupq_n_f32(vgetq_lane_f32(v, Lane)); }
+	/// Returns a vector made of the specified lanes of the source one
+	template <int X, int Y, int Z, int W>
+	inline Float4 shuffle(Float4 v)
+	{
+		Float4 result = vdupq_n_f32(vgetq_lane_f32(v, X));
+		result = vsetq_lane_f32(vgetq_lane_f32(v, Y), result, 1);
+		result = vsetq_lane_f32(vgetq_lane_f32(v, Z), result, 2);
+		return vsetq_lane_f32(vgetq_lane_f32(v, W), result, 3);
+	}
+
+	inline Float4 add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+	inline Float4 sub(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+	inline Float4 mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+	inline Float4 div(Float4 a, Float4 b)
+	{
+		#if defined(__aarch64__) || defined(_M_ARM64)
+		return vdivq_f32(a, b);
+		#else
+		// ARMv7 NEON only has a reciprocal estimate, which would not be as precise as the scalar division
+		float result[4];
+		vst1q_f32(result, a);
+		result[0] /= vgetq_lane_f32(b, 0);
+		result[1] /= vgetq_lane_f32(b, 1);
+		result[2] /= vgetq_lane_f32(b, 2);
+		result[3] /= vgetq_lane_f32(b, 3);
+		return vld1q_f32(result);
+		#endif
+	}
+	/// Returns `a + b * c`, without fusing the operations
+	inline Float4 mulAdd(Float4 a, Float4 b, Float4 c) { return vaddq_f32(a, vmulq_f32(b, c)); }
+	inline Float4 min(Float4 a, Float4 b) { return vminq_f32(a, b); }
+	inline Float4 max(Float4 a, Float4 b) { return vmaxq_f32(a, b); }
+
+	/// Returns a vector made of the two lower lanes of the first vector and the two lower lanes of the second one
+	inline Float4 lowHalves(Float4 a, Float4 b) { return vcombine_f32(vget_low_f32(a), vget_low_f32(b)); }
+	/// Returns a vector made of the two upper lanes of the first vector and the two upper lanes of the second one
+	inline Float4 highHalves(Float4 a, Float4 b) { return vcombine_f32(vget_high_f32(a), vget_high_f32(b)); }
+
+	/// Returns the number of lanes that differ between the two vectors
+	inline unsigned int countNotEqual(Float4 a, Float4 b)
+	{
+		const uint32x4_t equal = vshrq_n_u32(vceqq_f32(a, b), 31);
+		const uint32x2_t sum = vpadd_u32(vget_low_u32(equal), vget_high_u32(equal));
+		return 4 - (vget_lane_u32(sum, 0) + vget_lane_u32(sum, 1));
+	}
+
+	/// Truncates the lanes to integers, then stores them as four 16 bits integers, saturating the ones out of range
+	inline void storeInt16(int16_t *dest, Float4 v) { vst1_s16(dest, vqmovn_s32(vcvtq_s32_f32(v))); }
+
+	inline void transpose(Float4 &r0, Float4 &r1, Float4 &r2, Float4 &r3)
+	{
+		const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+		const float32x4x2_t t23 = vtrnq_f32(r2, r3);
+		r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+		r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+		r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+		r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+	}
+	#endif
+
+}
+
+}
+
+#endif
+
+#endif
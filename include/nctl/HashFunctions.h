@@ -258,8 +258,8 @@ class FNV1aHashFunc<String>
 	}
 };
 
-uint64_t fasthash64(const void *buf, size_t len, uint64_t seed);
-uint32_t fasthash32(const void *buf, size_t len, uint32_t seed);
+DLL_PUBLIC uint64_t fasthash64(const void *buf, size_t len, uint64_t seed);
+DLL_PUBLIC uint32_t fasthash32(const void *buf, size_t len, uint32_t seed);
 
 /// fast-hash
 /*!
@@ -794,6 +794,59 @@ inline void quicksortDesc(Iterator first, Iterator last)
 	quicksort(first, last, IteratorTraits<Iterator>::IteratorCategory(), IsNotLess<typename IteratorTraits<Iterator>::ValueType>);
 }
 
+/// Stable LSD radix sort of a contiguous range on the unsigned integer key returned by a function, ascending order
+/*! The scratch buffer should have room for the same number of elements as the range.
+ *  Passes on a key byte that is the same for every element are skipped. The sorted elements always end up in the original range. */
+template <class T, class KeyFunction>
+inline void radixSort(T *first, T *last, T *scratch, KeyFunction keyFunc)
+{
+	using KeyType = typename removeReference<decltype(keyFunc(*first))>::type;
+	const unsigned int NumPasses = sizeof(KeyType);
+	const unsigned int size = static_cast<unsigned int>(last - first);
+	if (size < 2)
+		return;
+
+	// Computing the histograms of all key bytes with a single read of the range
+	unsigned int histograms[NumPasses][256] = {};
+	for (const T *element = first; element != last; ++element)
+	{
+		const KeyType key = keyFunc(*element);
+		for (unsigned int pass = 0; pass < NumPasses; pass++)
+			histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+	}
+
+	T *src = first;
+	T *dest = scratch;
+	for (unsigned int pass = 0; pass < NumPasses; pass++)
+	{
+		const unsigned int shift = pass * 8;
+		unsigned int *offsets = histograms[pass];
+		if (offsets[(keyFunc(*src) >> shift) & 0xFF] == size)
+			continue;
+
+		unsigned int offset = 0;
+		for (unsigned int i = 0; i < 256; i++)
+		{
+			const unsigned int count = offsets[i];
+			offsets[i] = offset;
+			offset += count;
+		}
+
+		for (unsigned int i = 0; i < size; i++)
+			dest[offsets[(keyFunc(src[i]) >> shift) & 0xFF]++] = src[i];
+
+		T *temp = src;
+		src = dest;
+		dest = temp;
+	}
+
+	if (src != first)
+	{
+		for (unsigned int i = 0; i < size; i++)
+			first[i] = src[i];
+	}
+}
+
 }
 
 #endif
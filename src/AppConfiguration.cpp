@@ -31,7 +31,11 @@ AppConfiguration::AppConfiguration()
       windowTitle(128),
       windowIconFilename(128),
       useBufferMapping(false),
+      usePersistentMapping(false),
+      useInstancedAttributes(false),
       deferShaderQueries(true),
+      useBinaryShaderCache(true),
+      useAsyncShaderCompilation(false),
       fixedBatchSize(10),
 #if defined(WITH_IMGUI) || defined(WITH_NUKLEAR)
       vboSize(512 * 1024),
@@ -42,6 +46,13 @@ AppConfiguration::AppConfiguration()
 #endif
       vaoPoolSize(16),
       renderCommandPoolSize(32),
+      textureUploadBudget(4 * 1024 * 1024),
+      parallelUpdateDepth(0),
+      parallelVisitDepth(0),
+      cullingGridCellSize(0.0f),
+      useDirtyListUpdate(false),
+      useParticleArrays(false),
+      useParallelParticlesUpdate(false),
       withDebugOverlay(false),
       withAudio(true),
       withThreads(false),
@@ -74,6 +85,7 @@ AppConfiguration::AppConfiguration()
 	dataPath() = "/";
 	// Always disable mapping on Emscripten as it is not supported by WebGL 2
 	useBufferMapping = false;
+	usePersistentMapping = false;
 #endif
 
 #if defined(__linux__) && defined(WITH_SDL)
@@ -6,10 +6,10 @@
 #include "ArrayIndexer.h"
 #include "GfxCapabilities.h"
 #include "RenderResources.h"
+#include "TextureUploadQueue.h"
 #include "RenderQueue.h"
 #include "ScreenViewport.h"
 #include "GLDebug.h"
-#include "Timer.h" // for `sleep()`
 #include "FrameTimer.h"
 #include "SceneNode.h"
 #include <nctl/StaticString.h>
@@ -223,6 +223,18 @@ void Application::step()
 	}
 #endif
 
+	{
+		// Textures that complete their upload are ready in `onFrameStart()`
+		ZoneScopedN("Texture uploads");
+		RenderResources::textureUploadQueue().process();
+	}
+
+	{
+		// Custom shaders that complete their linking are applied before the scenegraph is updated
+		ZoneScopedN("Pending shaders");
+		RenderResources::updatePendingShaderStates();
+	}
+
 	{
 		ZoneScopedN("onFrameStart");
 		profileStartTime_ = TimeStamp::now();
@@ -332,8 +344,7 @@ void Application::step()
 	if (appCfg_.frameLimit > 0)
 	{
 		const float frameTimeDuration = 1.0f / static_cast<float>(appCfg_.frameLimit);
-		while (frameTimer_->frameInterval() < frameTimeDuration)
-			Timer::sleep(0.0f);
+		frameTimer_->limitFrameDuration(frameTimeDuration);
 	}
 }
 
@@ -0,0 +1,72 @@
+#include <cmath>
+#include "FramePacer.h"
+#include "Timer.h"
+
+namespace ncine {
+
+namespace {
+	/// The number of seconds requested by each sleep
+	const float SleepStep = 0.001f;
+	/// The estimate used before any sleep has been measured, it only lets the thread sleep if there is plenty of time
+	const float InitialSleepEstimate = 0.005f;
+	/// Limiting the samples turns the running mean into a moving one, following changes of the scheduler granularity
+	const unsigned int MaxSleepSamples = 256;
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+FramePacer::FramePacer()
+    : sleepEstimate_(InitialSleepEstimate), sleepMean_(InitialSleepEstimate), sleepM2_(0.0),
+      numSleeps_(1), lastSleepTime_(0.0f), lastSpinTime_(0.0f)
+{
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void FramePacer::waitUntil(const TimeStamp &start, float seconds)
+{
+	lastSleepTime_ = 0.0f;
+	lastSpinTime_ = 0.0f;
+
+	// Sleeping only when even a long sleep would end before the target
+	while (seconds - start.secondsSince() > sleepEstimate_)
+	{
+		const TimeStamp sleepStart = TimeStamp::now();
+		Timer::sleep(SleepStep);
+		const float sleepDuration = sleepStart.secondsSince();
+
+		addSleepDuration(sleepDuration);
+		lastSleepTime_ += sleepDuration;
+	}
+
+	// Spinning for the remaining time, shorter than the scheduler granularity
+	const TimeStamp spinStart = TimeStamp::now();
+	while (start.secondsSince() < seconds) {}
+	lastSpinTime_ = spinStart.secondsSince();
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void FramePacer::addSleepDuration(float seconds)
+{
+	// Welford's online algorithm for the mean and the variance
+	if (numSleeps_ < MaxSleepSamples)
+		numSleeps_++;
+	const double delta = seconds - sleepMean_;
+	sleepMean_ += delta / numSleeps_;
+	sleepM2_ += delta * (seconds - sleepMean_);
+	// Once the samples are capped the sum decays too, so that the variance is a moving one like the mean
+	if (numSleeps_ == MaxSleepSamples)
+		sleepM2_ -= sleepM2_ / numSleeps_;
+
+	const double variance = (numSleeps_ > 1) ? sleepM2_ / (numSleeps_ - 1) : 0.0;
+	sleepEstimate_ = static_cast<float>(sleepMean_ + sqrt(variance));
+}
+
+}
@@ -47,6 +47,12 @@ void FrameTimer::addFrame()
 		fps_ = static_cast<float>(logNumFrames_) / logInterval_;
 		const float msPerFrame = (logInterval_ * 1000.0f) / static_cast<float>(logNumFrames_);
 		LOGV_X("%lu frames in %.0f seconds = %f FPS (%.3f ms per frame)", logNumFrames_, logInterval_, fps_, msPerFrame);
+		if (pacingStats_.numFrames > 0)
+		{
+			LOGV_X("Frame pacing: %.3f ms average error, %.3f ms maximum error, %lu late frames out of %lu (%.3f ms sleeping, %.3f ms spinning per frame)",
+			       pacingStats_.averageError * 1000.0f, pacingStats_.maxError * 1000.0f, pacingStats_.numLateFrames, pacingStats_.numFrames,
+			       pacingStats_.averageSleepTime * 1000.0f, pacingStats_.averageSpinTime * 1000.0f);
+		}
 
 		logNumFrames_ = 0L;
 		lastLogUpdate_ = TimeStamp::now();
@@ -68,4 +74,29 @@ TimeStamp FrameTimer::resume()
 	return suspensionDuration;
 }
 
+void FrameTimer::limitFrameDuration(float seconds)
+{
+	pacingStats_.numFrames++;
+	const float n = static_cast<float>(pacingStats_.numFrames);
+
+	if (frameStart_.secondsSince() >= seconds)
+	{
+		// There is nothing to wait for, the frame is late
+		pacingStats_.numLateFrames++;
+		pacingStats_.averageSleepTime -= pacingStats_.averageSleepTime / n;
+		pacingStats_.averageSpinTime -= pacingStats_.averageSpinTime / n;
+		return;
+	}
+
+	framePacer_.waitUntil(frameStart_, seconds);
+	const float error = frameStart_.secondsSince() - seconds;
+
+	const float numOnTimeFrames = static_cast<float>(pacingStats_.numFrames - pacingStats_.numLateFrames);
+	pacingStats_.averageError += (error - pacingStats_.averageError) / numOnTimeFrames;
+	if (error > pacingStats_.maxError)
+		pacingStats_.maxError = error;
+	pacingStats_.averageSleepTime += (framePacer_.lastSleepTime() - pacingStats_.averageSleepTime) / n;
+	pacingStats_.averageSpinTime += (framePacer_.lastSpinTime() - pacingStats_.averageSpinTime) / n;
+}
+
 }
@@ -0,0 +1,197 @@
+#include <cstring> // for memcpy()
+#include <cstdint>
+#include "common_macros.h"
+#include "Lz4Block.h"
+
+namespace ncine {
+
+namespace {
+
+	const unsigned int MinMatch = 4;
+	/// The last bytes of a block are always literals
+	const unsigned int LastLiterals = 5;
+	/// A match cannot start in the last bytes of a block
+	const unsigned int MatchFindLimit = 12;
+	const unsigned int MaxOffset = 65535;
+	/// Literal and match lengths that do not fit in the four bits of the token are continued in the following bytes
+	const unsigned int TokenMaxLength = 15;
+	const unsigned int HashLog = 12;
+
+	inline uint32_t read32(const unsigned char *ptr)
+	{
+		uint32_t value;
+		memcpy(&value, ptr, sizeof(uint32_t));
+		return value;
+	}
+
+	inline unsigned int hashSequence(uint32_t sequence)
+	{
+		return (sequence * 2654435761U) >> (32 - HashLog);
+	}
+
+	unsigned char *writeLength(unsigned char *op, unsigned int length)
+	{
+		while (length >= 255)
+		{
+			*op++ = 255;
+			length -= 255;
+		}
+		*op++ = static_cast<unsigned char>(length);
+		return op;
+	}
+
+	unsigned char *writeLiterals(unsigned char *op, const unsigned char *literals, unsigned int literalLength, unsigned char *&token)
+	{
+		token = op++;
+		*token = static_cast<unsigned char>(((literalLength >= TokenMaxLength) ? TokenMaxLength : literalLength) << 4);
+		if (literalLength >= TokenMaxLength)
+			op = writeLength(op, literalLength - TokenMaxLength);
+		memcpy(op, literals, literalLength);
+		return op + literalLength;
+	}
+
+	/// Reads the continuation bytes of a length, returns false if the input ends before the length does
+	bool readLength(const unsigned char *&ip, const unsigned char *ipEnd, unsigned long int &length)
+	{
+		unsigned char value = 0;
+		do
+		{
+			if (ip >= ipEnd)
+				return false;
+			value = *ip++;
+			length += value;
+		} while (value == 255);
+
+		return true;
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned int Lz4Block::compressBound(unsigned int srcSize)
+{
+	return srcSize + srcSize / 255 + 16;
+}
+
+/*! \note The destination capacity should be at least `compressBound(srcSize)` */
+unsigned int Lz4Block::compress(const unsigned char *src, unsigned int srcSize, unsigned char *dst, unsigned int dstCapacity)
+{
+	ASSERT(src);
+	ASSERT(dst);
+
+	if (dstCapacity < compressBound(srcSize))
+		return 0;
+
+	// Positions are stored incremented by one, so that zero marks an empty slot
+	uint32_t hashTable[1 << HashLog];
+	memset(hashTable, 0, sizeof(hashTable));
+
+	unsigned char *op = dst;
+	unsigned char *token = nullptr;
+	unsigned int anchor = 0;
+
+	if (srcSize > MatchFindLimit)
+	{
+		const unsigned int matchFindEnd = srcSize - MatchFindLimit;
+		const unsigned int matchEnd = srcSize - LastLiterals;
+
+		unsigned int ip = 0;
+		while (ip <= matchFindEnd)
+		{
+			const uint32_t sequence = read32(src + ip);
+			const unsigned int hash = hashSequence(sequence);
+			const unsigned int candidate = hashTable[hash];
+			hashTable[hash] = ip + 1;
+
+			if (candidate == 0 || ip - (candidate - 1) > MaxOffset || read32(src + candidate - 1) != sequence)
+			{
+				ip++;
+				continue;
+			}
+
+			const unsigned int matchPos = candidate - 1;
+			unsigned int matchLength = MinMatch;
+			while (ip + matchLength < matchEnd && src[matchPos + matchLength] == src[ip + matchLength])
+				matchLength++;
+
+			op = writeLiterals(op, src + anchor, ip - anchor, token);
+			const unsigned int offset = ip - matchPos;
+			*op++ = static_cast<unsigned char>(offset & 0xFF);
+			*op++ = static_cast<unsigned char>(offset >> 8);
+
+			const unsigned int matchCode = matchLength - MinMatch;
+			*token |= static_cast<unsigned char>((matchCode >= TokenMaxLength) ? TokenMaxLength : matchCode);
+			if (matchCode >= TokenMaxLength)
+				op = writeLength(op, matchCode - TokenMaxLength);
+
+			ip += matchLength;
+			anchor = ip;
+		}
+	}
+
+	op = writeLiterals(op, src + anchor, srcSize - anchor, token);
+	return static_cast<unsigned int>(op - dst);
+}
+
+bool Lz4Block::decompress(const unsigned char *src, unsigned int srcSize, unsigned char *dst, unsigned int dstSize)
+{
+	ASSERT(src);
+	ASSERT(dst || dstSize == 0);
+
+	const unsigned char *ip = src;
+	const unsigned char *const ipEnd = src + srcSize;
+	unsigned char *op = dst;
+	unsigned char *const opEnd = dst + dstSize;
+
+	while (ip < ipEnd)
+	{
+		const unsigned char token = *ip++;
+
+		unsigned long int literalLength = token >> 4;
+		if (literalLength == TokenMaxLength && readLength(ip, ipEnd, literalLength) == false)
+			return false;
+		if (literalLength > static_cast<unsigned long int>(ipEnd - ip) || literalLength > static_cast<unsigned long int>(opEnd - op))
+			return false;
+		memcpy(op, ip, literalLength);
+		ip += literalLength;
+		op += literalLength;
+
+		// The last sequence only has literals
+		if (ip == ipEnd)
+			break;
+
+		if (ipEnd - ip < 2)
+			return false;
+		const unsigned int offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if (offset == 0 || offset > static_cast<unsigned int>(op - dst))
+			return false;
+
+		unsigned long int matchLength = token & 0x0F;
+		if (matchLength == TokenMaxLength && readLength(ip, ipEnd, matchLength) == false)
+			return false;
+		matchLength += MinMatch;
+		if (matchLength > static_cast<unsigned long int>(opEnd - op))
+			return false;
+
+		const unsigned char *match = op - offset;
+		if (offset >= matchLength)
+		{
+			memcpy(op, match, matchLength);
+			op += matchLength;
+		}
+		else
+		{
+			// Overlapping matches repeat the last `offset` bytes
+			for (unsigned long int i = 0; i < matchLength; i++)
+				*op++ = *match++;
+		}
+	}
+
+	return (op == opEnd);
+}
+
+}
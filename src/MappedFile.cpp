@@ -0,0 +1,207 @@
+#ifdef _WIN32
+	#include "common_windefines.h"
+	#include <windef.h>
+	#include <WinBase.h>
+	#include <fileapi.h>
+	#include <memoryapi.h>
+	#include <handleapi.h>
+#else
+	#include <sys/mman.h> // for mmap()
+	#include <sys/stat.h> // for fstat()
+	#include <fcntl.h> // for open()
+	#include <unistd.h> // for close()
+#endif
+#include <cstring> // for memcpy()
+
+#include "common_macros.h"
+#include "MappedFile.h"
+
+namespace ncine {
+
+namespace {
+
+	/// Maps the whole file in memory, returns `nullptr` and leaves the size untouched on failure
+	const unsigned char *mapFile(const char *filename, unsigned long int &fileSize)
+	{
+#ifdef _WIN32
+		HANDLE fileHandle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (fileHandle == INVALID_HANDLE_VALUE)
+			return nullptr;
+
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(fileHandle, &size) == 0 || size.QuadPart == 0)
+		{
+			CloseHandle(fileHandle);
+			return nullptr;
+		}
+
+		HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(fileHandle);
+		if (mappingHandle == nullptr)
+			return nullptr;
+
+		// The view keeps the mapping object alive after its handle is closed
+		void *mappedPtr = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mappingHandle);
+		if (mappedPtr == nullptr)
+			return nullptr;
+
+		fileSize = static_cast<unsigned long int>(size.QuadPart);
+		return static_cast<const unsigned char *>(mappedPtr);
+#else
+		const int fileDescriptor = ::open(filename, O_RDONLY);
+		if (fileDescriptor < 0)
+			return nullptr;
+
+		struct stat fileStat;
+		if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+		{
+			::close(fileDescriptor);
+			return nullptr;
+		}
+
+		// The mapping stays valid after the file descriptor is closed
+		void *mappedPtr = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		::close(fileDescriptor);
+		if (mappedPtr == MAP_FAILED)
+			return nullptr;
+
+	#if !defined(__EMSCRIPTEN__)
+		// Loaders go through the file from start to end
+		madvise(mappedPtr, fileStat.st_size, MADV_SEQUENTIAL);
+	#endif
+
+		fileSize = static_cast<unsigned long int>(fileStat.st_size);
+		return static_cast<const unsigned char *>(mappedPtr);
+#endif
+	}
+
+	void unmapFile(const unsigned char *mappedPtr, unsigned long int fileSize)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(mappedPtr);
+#else
+		munmap(const_cast<unsigned char *>(mappedPtr), fileSize);
+#endif
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+MappedFile::MappedFile(const char *filename)
+    : IFile(filename), mappedPtr_(nullptr), seekOffset_(0)
+{
+	type_ = FileType::MAPPED;
+}
+
+MappedFile::~MappedFile()
+{
+	if (shouldCloseOnDestruction_)
+		close();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void MappedFile::open(unsigned char mode)
+{
+	// Checking if the file is already opened
+	if (mappedPtr_ != nullptr)
+		LOGW_X("File \"%s\" is already opened", filename_.data());
+	else if (mode & OpenMode::WRITE)
+		LOGE_X("Cannot open the file \"%s\", mapped files are read-only", filename_.data());
+	else
+	{
+		mappedPtr_ = mapFile(filename_.data(), fileSize_);
+		if (mappedPtr_ == nullptr)
+		{
+			LOGE_X("Cannot open the file \"%s\"", filename_.data());
+			return;
+		}
+		else
+			LOGI_X("File \"%s\" opened and mapped", filename_.data());
+
+		seekOffset_ = 0;
+	}
+}
+
+void MappedFile::close()
+{
+	if (mappedPtr_ != nullptr)
+	{
+		unmapFile(mappedPtr_, fileSize_);
+		LOGI_X("File \"%s\" unmapped and closed", filename_.data());
+		mappedPtr_ = nullptr;
+		seekOffset_ = 0;
+	}
+}
+
+long int MappedFile::seek(long int offset, int whence) const
+{
+	long int seekValue = -1;
+
+	if (mappedPtr_ != nullptr)
+	{
+		switch (whence)
+		{
+			case SEEK_SET:
+				seekValue = offset;
+				break;
+			case SEEK_CUR:
+				seekValue = seekOffset_ + offset;
+				break;
+			case SEEK_END:
+				seekValue = fileSize_ + offset;
+				break;
+		}
+	}
+
+	if (seekValue < 0 || seekValue > static_cast<long int>(fileSize_))
+		seekValue = -1;
+	else
+		seekOffset_ = seekValue;
+
+	return seekValue;
+}
+
+long int MappedFile::tell() const
+{
+	long int tellValue = -1;
+
+	if (mappedPtr_ != nullptr)
+		tellValue = seekOffset_;
+
+	return tellValue;
+}
+
+unsigned long int MappedFile::read(void *buffer, unsigned long int bytes) const
+{
+	ASSERT(buffer);
+
+	unsigned long int bytesRead = 0;
+
+	if (mappedPtr_ != nullptr)
+	{
+		bytesRead = (seekOffset_ + bytes > fileSize_) ? fileSize_ - seekOffset_ : bytes;
+		memcpy(buffer, mappedPtr_ + seekOffset_, bytesRead);
+		seekOffset_ += bytesRead;
+	}
+
+	return bytesRead;
+}
+
+unsigned long int MappedFile::write(const void *buffer, unsigned long int bytes)
+{
+	return 0;
+}
+
+bool MappedFile::isOpened() const
+{
+	return (mappedPtr_ != nullptr);
+}
+
+}
@@ -15,6 +15,9 @@
 #elif defined(WITH_QT5)
 	#include "Qt5GfxDevice.h"
 	#include "Qt5InputManager.h"
+#elif defined(WITH_HEADLESS)
+	#include "HeadlessGfxDevice.h"
+	#include "HeadlessInputManager.h"
 #endif
 
 #ifdef __EMSCRIPTEN__
@@ -95,6 +98,9 @@ void PCApplication::init(nctl::UniquePtr<IAppEventHandler> (*createAppEventHandl
 	FATAL_ASSERT_MSG(qt5Widget_, "The Qt5 widget has not been assigned");
 	gfxDevice_ = nctl::makeUnique<Qt5GfxDevice>(windowMode, glContextInfo, displayMode, *qt5Widget_);
 	inputManager_ = nctl::makeUnique<Qt5InputManager>(*qt5Widget_);
+#elif defined(WITH_HEADLESS)
+	gfxDevice_ = nctl::makeUnique<HeadlessGfxDevice>(windowMode, glContextInfo, displayMode);
+	inputManager_ = nctl::makeUnique<HeadlessInputManager>();
 #endif
 	gfxDevice_->setWindowTitle(appCfg_.windowTitle.data());
 	nctl::String windowIconFilePath = fs::joinPath(fs::dataPath(), appCfg_.windowIconFilename);
@@ -218,6 +224,12 @@ void PCApplication::processEvents()
 		glfwPollEvents();
 	GlfwInputManager::updateJoystickStates();
 }
+#elif defined(WITH_HEADLESS)
+void PCApplication::processEvents()
+{
+	ZoneScoped;
+	// There is no window or input device to generate events
+}
 #endif
 
 #ifdef __EMSCRIPTEN__
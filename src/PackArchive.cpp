@@ -0,0 +1,521 @@
+#include <cstring> // for memcpy()
+#include <nctl/Array.h>
+#include <nctl/algorithms.h>
+#include "common_macros.h"
+#include "return_macros.h"
+#include "PackArchive.h"
+#include "PackFile.h"
+#include "FileSystem.h"
+#include "Lz4Block.h"
+#if defined(WITH_THREADS)
+	#include "ThreadSync.h"
+#endif
+
+namespace ncine {
+
+namespace {
+
+	/// The layout of the header: magic, version, number of entries, size of the names table, alignment and reserved bytes
+	const unsigned int HeaderSize = 32;
+	/// The layout of an index entry: path hash, offset, size, stored size, name offset, name length and flags
+	const unsigned int EntrySize = 32;
+	const char Magic[4] = { 'N', 'C', 'P', 'K' };
+	const uint32_t Version = 1;
+	/// Entries start at page boundaries, so that they can be mapped and consumed in place
+	const uint32_t Alignment = 4096;
+	const uint16_t CompressedFlag = 1;
+	/// The number of entries is capped so that the size of the index always fits in 32 bits
+	const uint32_t MaxNumEntries = UINT32_MAX / EntrySize;
+
+	/// Compressed entries should save at least this fraction of their size, as they cannot be read in place
+	const unsigned int MinCompressionSavingRatio = 16;
+
+	struct IndexEntry
+	{
+		uint64_t hash = 0;
+		uint32_t nameOffset = 0;
+		uint16_t nameLength = 0;
+		PackFile::Entry entry;
+	};
+
+	struct MountedArchive
+	{
+		nctl::String packFilename;
+		/// The normalized root path, with a trailing separator if not empty
+		nctl::String rootPath;
+		nctl::SharedPtr<IFile> packHandle;
+		/// Entries sorted by path hash
+		nctl::Array<IndexEntry> entries;
+		nctl::UniquePtr<char[]> names;
+	};
+
+	nctl::Array<nctl::UniquePtr<MountedArchive>> mountedArchives;
+
+#if defined(WITH_THREADS)
+	/// Archives are looked up by the threads that load assets in the background while others can be mounted
+	Mutex mountedArchivesMutex;
+
+	inline void lockMountedArchives() { mountedArchivesMutex.lock(); }
+	inline void unlockMountedArchives() { mountedArchivesMutex.unlock(); }
+#else
+	inline void lockMountedArchives() {}
+	inline void unlockMountedArchives() {}
+#endif
+
+	/// Returns the index of a mounted archive, or -1 if it is not mounted, the lock should be held
+	int findMountedArchive(const char *packFilename)
+	{
+		for (unsigned int i = 0; i < mountedArchives.size(); i++)
+		{
+			if (mountedArchives[i]->packFilename == packFilename)
+				return static_cast<int>(i);
+		}
+		return -1;
+	}
+
+	inline char normalizedChar(char c)
+	{
+		return (c == '\\') ? '/' : c;
+	}
+
+	/// 64 bits FNV-1a hash of a path, computed byte by byte to be the same on every platform
+	uint64_t hashPath(const char *path, unsigned int length)
+	{
+		uint64_t hash = 0xCBF29CE484222325ULL;
+		for (unsigned int i = 0; i < length; i++)
+		{
+			hash ^= static_cast<unsigned char>(normalizedChar(path[i]));
+			hash *= 0x100000001B3ULL;
+		}
+		return hash;
+	}
+
+	/// Returns the part of the filename relative to the root path, or `nullptr` if it is outside of it
+	const char *relativePath(const char *filename, const nctl::String &rootPath)
+	{
+		for (unsigned int i = 0; i < rootPath.length(); i++)
+		{
+			if (normalizedChar(filename[i]) != rootPath[i])
+				return nullptr;
+		}
+		filename += rootPath.length();
+
+		// Skipping leading separators and current directory components
+		while (true)
+		{
+			if (normalizedChar(filename[0]) == '/')
+				filename++;
+			else if (filename[0] == '.' && normalizedChar(filename[1]) == '/')
+				filename += 2;
+			else
+				break;
+		}
+
+		return filename;
+	}
+
+	const IndexEntry *findEntry(const MountedArchive &archive, const char *path)
+	{
+		const unsigned int length = static_cast<unsigned int>(strlen(path));
+		const uint64_t hash = hashPath(path, length);
+
+		// Binary search of the first entry with the same hash
+		unsigned int first = 0;
+		unsigned int last = archive.entries.size();
+		while (first < last)
+		{
+			const unsigned int middle = first + (last - first) / 2;
+			if (archive.entries[middle].hash < hash)
+				first = middle + 1;
+			else
+				last = middle;
+		}
+
+		for (unsigned int i = first; i < archive.entries.size() && archive.entries[i].hash == hash; i++)
+		{
+			const IndexEntry &indexEntry = archive.entries[i];
+			if (indexEntry.nameLength != length)
+				continue;
+
+			const char *name = archive.names.get() + indexEntry.nameOffset;
+			unsigned int j = 0;
+			while (j < length && name[j] == normalizedChar(path[j]))
+				j++;
+			if (j == length)
+				return &indexEntry;
+		}
+
+		return nullptr;
+	}
+
+	const IndexEntry *findEntry(const char *filename, const MountedArchive *&archive)
+	{
+		for (int i = static_cast<int>(mountedArchives.size()) - 1; i >= 0; i--)
+		{
+			const char *path = relativePath(filename, mountedArchives[i]->rootPath);
+			if (path == nullptr || path[0] == '\0')
+				continue;
+
+			const IndexEntry *indexEntry = findEntry(*mountedArchives[i], path);
+			if (indexEntry != nullptr)
+			{
+				archive = mountedArchives[i].get();
+				return indexEntry;
+			}
+		}
+
+		return nullptr;
+	}
+
+	inline uint16_t readLE16(const unsigned char *ptr)
+	{
+		uint16_t value;
+		memcpy(&value, ptr, sizeof(uint16_t));
+		return IFile::int16FromLE(value);
+	}
+
+	inline uint32_t readLE32(const unsigned char *ptr)
+	{
+		uint32_t value;
+		memcpy(&value, ptr, sizeof(uint32_t));
+		return IFile::int32FromLE(value);
+	}
+
+	inline uint64_t readLE64(const unsigned char *ptr)
+	{
+		uint64_t value;
+		memcpy(&value, ptr, sizeof(uint64_t));
+		return IFile::int64FromLE(value);
+	}
+
+	inline void writeLE16(unsigned char *ptr, uint16_t value)
+	{
+		value = IFile::int16FromLE(value);
+		memcpy(ptr, &value, sizeof(uint16_t));
+	}
+
+	inline void writeLE32(unsigned char *ptr, uint32_t value)
+	{
+		value = IFile::int32FromLE(value);
+		memcpy(ptr, &value, sizeof(uint32_t));
+	}
+
+	inline void writeLE64(unsigned char *ptr, uint64_t value)
+	{
+		value = IFile::int64FromLE(value);
+		memcpy(ptr, &value, sizeof(uint64_t));
+	}
+
+	inline uint64_t alignOffset(uint64_t offset)
+	{
+		return (offset + Alignment - 1) & ~static_cast<uint64_t>(Alignment - 1);
+	}
+
+	/// Appends the relative paths of all files inside a directory and its subdirectories, skipping other pack archives
+	void collectFiles(const nctl::String &directory, const nctl::String &relativeDir, nctl::Array<nctl::String> &paths)
+	{
+		FileSystem::Directory dir(directory.data());
+		while (const char *entryName = dir.readNext())
+		{
+			if (strcmp(entryName, ".") == 0 || strcmp(entryName, "..") == 0)
+				continue;
+
+			const nctl::String entryPath = FileSystem::joinPath(directory, entryName);
+			nctl::String relativePath(relativeDir.length() + strlen(entryName) + 1);
+			relativePath = relativeDir;
+			if (relativePath.isEmpty() == false)
+				relativePath.append("/");
+			relativePath.append(entryName);
+
+			if (FileSystem::isDirectory(entryPath.data()))
+				collectFiles(entryPath, relativePath, paths);
+			else if (FileSystem::hasExtension(entryName, PackArchive::Extension) == false)
+				paths.pushBack(relativePath);
+		}
+	}
+
+	bool writePadding(IFile &packFile, uint64_t offset)
+	{
+		static const unsigned char Zeros[Alignment] = {};
+		const unsigned long int paddingSize = static_cast<unsigned long int>(alignOffset(offset) - offset);
+		return (paddingSize == 0 || packFile.write(Zeros, paddingSize) == paddingSize);
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+const char *PackArchive::Extension = "pak";
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool PackArchive::mount(const char *packFilename, const char *rootPath)
+{
+	ASSERT(packFilename);
+
+	lockMountedArchives();
+	const bool isAlreadyMounted = (findMountedArchive(packFilename) >= 0);
+	unlockMountedArchives();
+	if (isAlreadyMounted)
+		RETURNF_MSG_X("Pack archive \"%s\" is already mounted", packFilename);
+
+	nctl::SharedPtr<IFile> packHandle(PackFile::createPackHandle(packFilename));
+	packHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+	RETURNF_ASSERT_MSG_X(packHandle->isOpened(), "Pack archive \"%s\" cannot be opened", packFilename);
+
+	unsigned char header[HeaderSize];
+	if (packHandle->read(header, HeaderSize) != HeaderSize || memcmp(header, Magic, sizeof(Magic)) != 0)
+		RETURNF_MSG_X("\"%s\" is not a pack archive", packFilename);
+	const uint32_t version = readLE32(header + 4);
+	if (version != Version)
+		RETURNF_MSG_X("Pack archive \"%s\" has an unsupported version: %u", packFilename, version);
+
+	const uint32_t numEntries = readLE32(header + 8);
+	const uint32_t namesSize = readLE32(header + 12);
+	const uint64_t packSize = static_cast<uint64_t>(packHandle->size());
+	if (numEntries > MaxNumEntries)
+		RETURNF_MSG_X("Pack archive \"%s\" has too many entries: %u", packFilename, numEntries);
+	const uint32_t indexSize = numEntries * EntrySize;
+	if (HeaderSize + static_cast<uint64_t>(indexSize) + namesSize > packSize)
+		RETURNF_MSG_X("Pack archive \"%s\" is truncated", packFilename);
+
+	nctl::UniquePtr<MountedArchive> archive = nctl::makeUnique<MountedArchive>();
+	archive->entries.setCapacity(numEntries);
+	nctl::UniquePtr<unsigned char[]> indexData = nctl::makeUnique<unsigned char[]>(indexSize);
+	archive->names = nctl::makeUnique<char[]>(namesSize + 1);
+	if (packHandle->read(indexData.get(), indexSize) != indexSize ||
+	    packHandle->read(archive->names.get(), namesSize) != namesSize)
+	{
+		RETURNF_MSG_X("Pack archive \"%s\" cannot be read", packFilename);
+	}
+	archive->names[namesSize] = '\0';
+
+	uint64_t previousHash = 0;
+	for (unsigned int i = 0; i < numEntries; i++)
+	{
+		const unsigned char *entryData = indexData.get() + i * EntrySize;
+		IndexEntry indexEntry;
+		indexEntry.hash = readLE64(entryData);
+		indexEntry.entry.offset = readLE64(entryData + 8);
+		indexEntry.entry.size = readLE32(entryData + 16);
+		indexEntry.entry.storedSize = readLE32(entryData + 20);
+		indexEntry.nameOffset = readLE32(entryData + 24);
+		indexEntry.nameLength = readLE16(entryData + 28);
+		indexEntry.entry.isCompressed = (readLE16(entryData + 30) & CompressedFlag) != 0;
+
+		// The checks are written so that a corrupt offset cannot wrap around the sums
+		if (indexEntry.hash < previousHash ||
+		    indexEntry.entry.offset > packSize || indexEntry.entry.storedSize > packSize - indexEntry.entry.offset ||
+		    (indexEntry.entry.isCompressed == false && indexEntry.entry.size != indexEntry.entry.storedSize) ||
+		    static_cast<uint64_t>(indexEntry.nameOffset) + indexEntry.nameLength > namesSize)
+		{
+			RETURNF_MSG_X("Pack archive \"%s\" has an invalid index entry: %u", packFilename, i);
+		}
+		previousHash = indexEntry.hash;
+		archive->entries.pushBack(indexEntry);
+	}
+
+	archive->packFilename = packFilename;
+	archive->rootPath = (rootPath != nullptr) ? rootPath : FileSystem::dataPath().data();
+	for (char &c : archive->rootPath)
+		c = normalizedChar(c);
+	if (archive->rootPath.isEmpty() == false && archive->rootPath[archive->rootPath.length() - 1] != '/')
+		archive->rootPath.append("/");
+	archive->packHandle = nctl::move(packHandle);
+
+	const nctl::String mountedRootPath = archive->rootPath;
+
+	// The index is read without holding the lock, the same archive might have been mounted in the meantime
+	lockMountedArchives();
+	const bool hasBeenMounted = (findMountedArchive(packFilename) >= 0);
+	if (hasBeenMounted == false)
+		mountedArchives.pushBack(nctl::move(archive));
+	unlockMountedArchives();
+	if (hasBeenMounted)
+		RETURNF_MSG_X("Pack archive \"%s\" is already mounted", packFilename);
+
+	LOGI_X("Pack archive \"%s\" mounted with %u entries at \"%s\"", packFilename, numEntries, mountedRootPath.data());
+	return true;
+}
+
+bool PackArchive::unmount(const char *packFilename)
+{
+	ASSERT(packFilename);
+
+	// Files already opened from the archive keep its handle alive
+	lockMountedArchives();
+	const int index = findMountedArchive(packFilename);
+	if (index >= 0)
+		mountedArchives.removeAt(static_cast<unsigned int>(index));
+	unlockMountedArchives();
+
+	if (index >= 0)
+		LOGI_X("Pack archive \"%s\" unmounted", packFilename);
+	return (index >= 0);
+}
+
+void PackArchive::unmountAll()
+{
+	lockMountedArchives();
+	mountedArchives.clear();
+	unlockMountedArchives();
+}
+
+unsigned int PackArchive::numMounted()
+{
+	lockMountedArchives();
+	const unsigned int numArchives = mountedArchives.size();
+	unlockMountedArchives();
+	return numArchives;
+}
+
+bool PackArchive::contains(const char *filename)
+{
+	ASSERT(filename);
+	const MountedArchive *archive = nullptr;
+	lockMountedArchives();
+	const bool found = (findEntry(filename, archive) != nullptr);
+	unlockMountedArchives();
+	return found;
+}
+
+bool PackArchive::build(const char *directory, const char *packFilename, bool compress)
+{
+	ASSERT(directory);
+	ASSERT(packFilename);
+
+	RETURNF_ASSERT_MSG_X(FileSystem::isDirectory(directory), "\"%s\" is not a directory", directory);
+	nctl::Array<nctl::String> paths;
+	collectFiles(directory, nctl::String(), paths);
+	// Files in the same directory are stored next to each other
+	nctl::quicksort(paths.begin(), paths.end());
+
+	const unsigned int numEntries = paths.size();
+	nctl::Array<IndexEntry> entries(numEntries);
+	uint32_t namesSize = 0;
+	for (unsigned int i = 0; i < numEntries; i++)
+	{
+		RETURNF_ASSERT_MSG_X(paths[i].length() <= UINT16_MAX, "Path is too long: \"%s\"", paths[i].data());
+		IndexEntry indexEntry;
+		indexEntry.hash = hashPath(paths[i].data(), paths[i].length());
+		indexEntry.nameOffset = namesSize;
+		indexEntry.nameLength = static_cast<uint16_t>(paths[i].length());
+		entries.pushBack(indexEntry);
+		namesSize += paths[i].length() + 1;
+	}
+
+	nctl::UniquePtr<IFile> packFile = IFile::createFileHandle(packFilename);
+	packFile->open(IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+	RETURNF_ASSERT_MSG_X(packFile->isOpened(), "Pack archive \"%s\" cannot be opened for writing", packFilename);
+
+	unsigned char header[HeaderSize] = {};
+	memcpy(header, Magic, sizeof(Magic));
+	writeLE32(header + 4, Version);
+	writeLE32(header + 8, numEntries);
+	writeLE32(header + 12, namesSize);
+	writeLE32(header + 16, Alignment);
+	packFile->write(header, HeaderSize);
+
+	// The index is written at the end, when the offsets and the stored sizes are known
+	const unsigned long int indexSize = numEntries * EntrySize;
+	nctl::UniquePtr<unsigned char[]> indexData = nctl::makeUnique<unsigned char[]>(indexSize);
+	memset(indexData.get(), 0, indexSize);
+	packFile->write(indexData.get(), indexSize);
+	for (unsigned int i = 0; i < numEntries; i++)
+		packFile->write(paths[i].data(), paths[i].length() + 1);
+
+	uint64_t offset = HeaderSize + indexSize + namesSize;
+	unsigned long int totalSize = 0;
+	unsigned long int totalStoredSize = 0;
+	for (unsigned int i = 0; i < numEntries; i++)
+	{
+		const nctl::String filePath = FileSystem::joinPath(directory, paths[i]);
+		nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(filePath.data());
+		fileHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+		RETURNF_ASSERT_MSG_X(fileHandle->isOpened(), "File \"%s\" cannot be opened", filePath.data());
+		RETURNF_ASSERT_MSG_X(static_cast<unsigned long int>(fileHandle->size()) <= UINT32_MAX, "File \"%s\" is too big", filePath.data());
+
+		const uint32_t size = static_cast<uint32_t>(fileHandle->size());
+		nctl::UniquePtr<unsigned char[]> fileData = nctl::makeUnique<unsigned char[]>(size);
+		fileHandle->read(fileData.get(), size);
+		fileHandle->close();
+
+		const unsigned char *storedData = fileData.get();
+		uint32_t storedSize = size;
+		nctl::UniquePtr<unsigned char[]> compressedData;
+		if (compress && size > 0)
+		{
+			const unsigned int compressedCapacity = Lz4Block::compressBound(size);
+			compressedData = nctl::makeUnique<unsigned char[]>(compressedCapacity);
+			const unsigned int compressedSize = Lz4Block::compress(fileData.get(), size, compressedData.get(), compressedCapacity);
+			if (compressedSize > 0 && compressedSize < size - size / MinCompressionSavingRatio)
+			{
+				storedData = compressedData.get();
+				storedSize = compressedSize;
+				entries[i].entry.isCompressed = true;
+			}
+		}
+
+		RETURNF_ASSERT_MSG_X(writePadding(*packFile, offset), "Cannot write to the pack archive \"%s\"", packFilename);
+		offset = alignOffset(offset);
+		RETURNF_ASSERT_MSG_X(packFile->write(storedData, storedSize) == storedSize, "Cannot write to the pack archive \"%s\"", packFilename);
+
+		entries[i].entry.offset = offset;
+		entries[i].entry.size = size;
+		entries[i].entry.storedSize = storedSize;
+		offset += storedSize;
+		totalSize += size;
+		totalStoredSize += storedSize;
+	}
+
+	// Equal hashes are ordered by path, that is the order of the array
+	nctl::quicksort(entries.begin(), entries.end(), [](const IndexEntry &a, const IndexEntry &b) {
+		return (a.hash < b.hash) || (a.hash == b.hash && a.nameOffset < b.nameOffset);
+	});
+
+	for (unsigned int i = 0; i < numEntries; i++)
+	{
+		unsigned char *entryData = indexData.get() + i * EntrySize;
+		writeLE64(entryData, entries[i].hash);
+		writeLE64(entryData + 8, entries[i].entry.offset);
+		writeLE32(entryData + 16, entries[i].entry.size);
+		writeLE32(entryData + 20, entries[i].entry.storedSize);
+		writeLE32(entryData + 24, entries[i].nameOffset);
+		writeLE16(entryData + 28, entries[i].nameLength);
+		writeLE16(entryData + 30, entries[i].entry.isCompressed ? CompressedFlag : 0);
+	}
+	packFile->seek(HeaderSize, SEEK_SET);
+	RETURNF_ASSERT_MSG_X(packFile->write(indexData.get(), indexSize) == indexSize, "Cannot write to the pack archive \"%s\"", packFilename);
+	packFile->close();
+
+	LOGI_X("Pack archive \"%s\" written with %u entries, %lu bytes stored in %lu", packFilename, numEntries, totalSize, totalStoredSize);
+	return true;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::UniquePtr<IFile> PackArchive::createFileHandle(const char *filename)
+{
+	nctl::UniquePtr<IFile> fileHandle;
+
+	// The entry and the archive are only accessed while holding the lock, the file shares the pack handle
+	lockMountedArchives();
+	if (mountedArchives.isEmpty() == false)
+	{
+		const MountedArchive *archive = nullptr;
+		const IndexEntry *indexEntry = findEntry(filename, archive);
+		if (indexEntry != nullptr)
+			fileHandle = nctl::makeUnique<PackFile>(filename, archive->packHandle, indexEntry->entry);
+	}
+	unlockMountedArchives();
+
+	return fileHandle;
+}
+
+}
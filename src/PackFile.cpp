@@ -0,0 +1,193 @@
+#include <cstring> // for memcpy()
+#include "common_macros.h"
+#include "PackFile.h"
+#include "MappedFile.h"
+#include "Lz4Block.h"
+
+#ifdef __ANDROID__
+	#include "AssetFile.h"
+#endif
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+PackFile::PackFile(const char *filename, const nctl::SharedPtr<IFile> &packHandle, const Entry &entry)
+    : IFile(filename), packHandle_(packHandle), entry_(entry), bufferPtr_(nullptr), seekOffset_(0)
+{
+	ASSERT(packHandle_);
+	type_ = FileType::PACK;
+}
+
+PackFile::~PackFile()
+{
+	if (shouldCloseOnDestruction_)
+		close();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void PackFile::open(unsigned char mode)
+{
+	// Checking if the file is already opened
+	if (bufferPtr_ != nullptr)
+		LOGW_X("File \"%s\" is already opened", filename_.data());
+	else if (mode & OpenMode::WRITE)
+		LOGE_X("Cannot open the file \"%s\", packed files are read-only", filename_.data());
+	else
+	{
+		const unsigned char *storedData = nullptr;
+		nctl::UniquePtr<unsigned char[]> storedBuffer;
+		if (packHandle_->data() != nullptr)
+			storedData = packHandle_->data() + entry_.offset;
+		else if (readStoredData(storedBuffer))
+			storedData = storedBuffer.get();
+
+		if (storedData == nullptr)
+		{
+			LOGE_X("Cannot open the file \"%s\"", filename_.data());
+			return;
+		}
+
+		if (entry_.isCompressed)
+		{
+			buffer_ = nctl::makeUnique<unsigned char[]>(entry_.size);
+			if (Lz4Block::decompress(storedData, entry_.storedSize, buffer_.get(), entry_.size) == false)
+			{
+				LOGE_X("Cannot decompress the file \"%s\" from \"%s\"", filename_.data(), packHandle_->filename());
+				buffer_.reset(nullptr);
+				return;
+			}
+			bufferPtr_ = buffer_.get();
+		}
+		else if (storedBuffer != nullptr)
+		{
+			buffer_ = nctl::move(storedBuffer);
+			bufferPtr_ = buffer_.get();
+		}
+		else
+			bufferPtr_ = storedData;
+
+		fileSize_ = entry_.size;
+		seekOffset_ = 0;
+		LOGI_X("File \"%s\" opened from \"%s\"", filename_.data(), packHandle_->filename());
+	}
+}
+
+void PackFile::close()
+{
+	if (bufferPtr_ != nullptr)
+	{
+		buffer_.reset(nullptr);
+		bufferPtr_ = nullptr;
+		seekOffset_ = 0;
+		LOGI_X("File \"%s\" closed", filename_.data());
+	}
+}
+
+long int PackFile::seek(long int offset, int whence) const
+{
+	long int seekValue = -1;
+
+	if (bufferPtr_ != nullptr)
+	{
+		switch (whence)
+		{
+			case SEEK_SET:
+				seekValue = offset;
+				break;
+			case SEEK_CUR:
+				seekValue = seekOffset_ + offset;
+				break;
+			case SEEK_END:
+				seekValue = fileSize_ + offset;
+				break;
+		}
+	}
+
+	if (seekValue < 0 || seekValue > static_cast<long int>(fileSize_))
+		seekValue = -1;
+	else
+		seekOffset_ = seekValue;
+
+	return seekValue;
+}
+
+long int PackFile::tell() const
+{
+	long int tellValue = -1;
+
+	if (bufferPtr_ != nullptr)
+		tellValue = seekOffset_;
+
+	return tellValue;
+}
+
+unsigned long int PackFile::read(void *buffer, unsigned long int bytes) const
+{
+	ASSERT(buffer);
+
+	unsigned long int bytesRead = 0;
+
+	if (bufferPtr_ != nullptr)
+	{
+		bytesRead = (seekOffset_ + bytes > fileSize_) ? fileSize_ - seekOffset_ : bytes;
+		memcpy(buffer, bufferPtr_ + seekOffset_, bytesRead);
+		seekOffset_ += bytesRead;
+	}
+
+	return bytesRead;
+}
+
+unsigned long int PackFile::write(const void *buffer, unsigned long int bytes)
+{
+	return 0;
+}
+
+bool PackFile::isOpened() const
+{
+	return (bufferPtr_ != nullptr);
+}
+
+nctl::UniquePtr<IFile> PackFile::createPackHandle(const char *packFilename)
+{
+	ASSERT(packFilename);
+#ifdef __ANDROID__
+	const char *assetFilename = AssetFile::assetPath(packFilename);
+	if (assetFilename)
+		return nctl::makeUnique<AssetFile>(assetFilename);
+	else
+#endif
+		return nctl::makeUnique<MappedFile>(packFilename);
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool PackFile::readStoredData(nctl::UniquePtr<unsigned char[]> &storedData)
+{
+	// A new handle is opened as the seek position of the shared one cannot be changed safely from different threads
+	nctl::UniquePtr<IFile> packHandle = createPackHandle(packHandle_->filename());
+	packHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+	if (packHandle->isOpened() == false)
+		return false;
+
+	storedData = nctl::makeUnique<unsigned char[]>(entry_.storedSize);
+	if (packHandle->data() != nullptr)
+		memcpy(storedData.get(), packHandle->data() + entry_.offset, entry_.storedSize);
+	else if (packHandle->seek(static_cast<long int>(entry_.offset), SEEK_SET) < 0 ||
+	         packHandle->read(storedData.get(), entry_.storedSize) != entry_.storedSize)
+	{
+		storedData.reset(nullptr);
+		return false;
+	}
+
+	return true;
+}
+
+}
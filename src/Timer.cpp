@@ -50,10 +50,10 @@ float Timer::total() const
 void Timer::sleep(float seconds)
 {
 #if defined(_WIN32)
-	const unsigned int milliseconds = static_cast<unsigned int>(seconds) * 1000;
+	const unsigned int milliseconds = static_cast<unsigned int>(seconds * 1000.0f);
 	SleepEx(milliseconds, FALSE);
 #else
-	const unsigned int microseconds = static_cast<unsigned int>(seconds) * 1000000;
+	const unsigned int microseconds = static_cast<unsigned int>(seconds * 1000000.0f);
 	usleep(microseconds);
 #endif
 }
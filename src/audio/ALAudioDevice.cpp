@@ -2,18 +2,53 @@
 #include "ALAudioDevice.h"
 #include "AudioBufferPlayer.h"
 #include "AudioStreamPlayer.h"
+#include "Application.h"
 #include <nctl/algorithms.h>
+#include "tracy.h"
+
+#ifdef WITH_SOFTWARE_AUDIO
+	#include "SoftwareAudio.h"
+#endif
 
 namespace ncine {
 
+namespace {
+
+	/// How much more audible a virtual player should be to take the source of a player with the same priority
+	/*! It avoids swapping two players with a similar audibility back and forth at every update */
+	const float AudibilityHysteresis = 1.25f;
+
+	bool isMoreAudible(const IAudioPlayer *first, const IAudioPlayer *second)
+	{
+		if (first->priority() != second->priority())
+			return first->priority() > second->priority();
+		return first->audibility() > second->audibility();
+	}
+
+	bool isLessAudible(const IAudioPlayer *first, const IAudioPlayer *second)
+	{
+		return isMoreAudible(second, first);
+	}
+
+	bool shouldTakeSource(const IAudioPlayer &virtualPlayer, const IAudioPlayer &player)
+	{
+		if (virtualPlayer.priority() != player.priority())
+			return virtualPlayer.priority() > player.priority();
+		return virtualPlayer.audibility() > player.audibility() * AudibilityHysteresis;
+	}
+
+}
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
 
 ALAudioDevice::ALAudioDevice()
     : device_(nullptr), context_(nullptr), gain_(1.0f),
-      sources_(nctl::StaticArrayMode::EXTEND_SIZE), deviceName_(nullptr)
+      sources_(nctl::StaticArrayMode::EXTEND_SIZE), numVirtualPlayers_(0), deviceName_(nullptr)
 {
+	static_assert(MaxSources <= sizeof(unsigned int) * 8, "Sources do not fit in the bound sources mask");
+
 	device_ = alcOpenDevice(nullptr);
 	FATAL_ASSERT_MSG_X(device_ != nullptr, "alcOpenDevice failed: 0x%x", alGetError());
 	deviceName_ = alcGetString(device_, ALC_DEVICE_SPECIFIER);
@@ -128,13 +163,18 @@ void ALAudioDevice::unfreezePlayers()
 
 unsigned int ALAudioDevice::nextAvailableSource()
 {
+	// The source of a stream waiting for its first buffers is stopped but it is not available
+	const unsigned int boundSources = boundSourcesMask();
 	ALint sourceState;
 
-	for (ALuint sourceId : sources_)
+	for (unsigned int i = 0; i < sources_.size(); i++)
 	{
-		alGetSourcei(sourceId, AL_SOURCE_STATE, &sourceState);
+		if (boundSources & (1U << i))
+			continue;
+
+		alGetSourcei(sources_[i], AL_SOURCE_STATE, &sourceState);
 		if (sourceState != AL_PLAYING && sourceState != AL_PAUSED)
-			return sourceId;
+			return sources_[i];
 	}
 
 	return UnavailableSource;
@@ -143,21 +183,124 @@ unsigned int ALAudioDevice::nextAvailableSource()
 void ALAudioDevice::registerPlayer(IAudioPlayer *player)
 {
 	ASSERT(player);
-	ASSERT(players_.size() < MaxSources);
+	ASSERT(players_.size() < MaxPlayers);
+
+	// Players resumed after being frozen are still registered
+	if (nctl::find(players_.begin(), players_.end(), player) != players_.end())
+		return;
 
-	if (players_.size() < MaxSources)
+	if (players_.size() < MaxPlayers)
 		players_.pushBack(player);
 }
 
+/*! Virtual players are advanced by the last frame interval, then the most audible ones are given a source. */
 void ALAudioDevice::updatePlayers()
 {
+	const float interval = theApplication().interval();
+#ifdef WITH_SOFTWARE_AUDIO
+	// Sources are advanced by the mixer before the players check their state
+	SoftwareAudio::update(interval);
+#endif
+
+	numVirtualPlayers_ = 0;
 	for (int i = players_.size() - 1; i >= 0; i--)
 	{
-		if (players_[i]->isPlaying())
-			players_[i]->updateState();
+		IAudioPlayer *player = players_[i];
+		if (player->isVirtual())
+		{
+			player->updateVirtualState(interval);
+			if (player->isVirtual())
+				numVirtualPlayers_++;
+		}
+		else if (player->isPlaying())
+			player->updateState();
 		else
 			players_.unorderedRemoveAt(i);
 	}
+
+	if (numVirtualPlayers_ > 0)
+		assignSources();
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned int ALAudioDevice::boundSourcesMask() const
+{
+	unsigned int mask = 0;
+	for (const IAudioPlayer *player : players_)
+	{
+		if (player->isPlaying() == false || player->isVirtual())
+			continue;
+
+		for (unsigned int i = 0; i < sources_.size(); i++)
+		{
+			if (sources_[i] == player->sourceId())
+			{
+				mask |= (1U << i);
+				break;
+			}
+		}
+	}
+
+	return mask;
+}
+
+void ALAudioDevice::assignSources()
+{
+	ZoneScoped;
+
+	virtualPlayers_.clear();
+	releasablePlayers_.clear();
+	for (IAudioPlayer *player : players_)
+	{
+		if (player->isVirtual())
+			virtualPlayers_.pushBack(player);
+		else if (player->isPlaying() && player->canReleaseSource() && releasablePlayers_.size() < MaxSources)
+			releasablePlayers_.pushBack(player);
+	}
+
+	nctl::quicksort(virtualPlayers_.begin(), virtualPlayers_.end(), isMoreAudible);
+	nctl::quicksort(releasablePlayers_.begin(), releasablePlayers_.end(), isLessAudible);
+
+	const unsigned int boundSources = boundSourcesMask();
+	unsigned int sourceIndex = 0;
+	unsigned int releasableIndex = 0;
+	for (IAudioPlayer *player : virtualPlayers_)
+	{
+		unsigned int source = UnavailableSource;
+
+		// Free sources are given away first
+		while (source == UnavailableSource && sourceIndex < sources_.size())
+		{
+			if ((boundSources & (1U << sourceIndex)) == 0)
+			{
+				ALint sourceState;
+				alGetSourcei(sources_[sourceIndex], AL_SOURCE_STATE, &sourceState);
+				if (sourceState != AL_PLAYING && sourceState != AL_PAUSED)
+					source = sources_[sourceIndex];
+			}
+			sourceIndex++;
+		}
+
+		if (source != UnavailableSource)
+			numVirtualPlayers_--;
+		else if (releasableIndex < releasablePlayers_.size() && shouldTakeSource(*player, *releasablePlayers_[releasableIndex]))
+		{
+			// The least audible player becomes a virtual one in place of this one
+			IAudioPlayer *releasingPlayer = releasablePlayers_[releasableIndex++];
+			source = releasingPlayer->sourceId();
+			releasingPlayer->releaseSource();
+		}
+		else
+		{
+			// Players are sorted, none of the following ones can get a source either
+			break;
+		}
+
+		player->acquireSource(source);
+	}
 }
 
 }
@@ -199,6 +199,12 @@ bool AudioBuffer::load(IAudioLoader &audioLoader)
 
 	// Buffer size calculated as samples * channels * bytes per samples
 	const unsigned long int bufferSize = audioLoader.bufferSize();
+
+	// Samples that do not need decoding are uploaded straight from the file contents
+	const unsigned char *inPlaceSamples = audioLoader.inPlaceSamples();
+	if (inPlaceSamples != nullptr)
+		return loadFromSamples(inPlaceSamples, bufferSize);
+
 	nctl::UniquePtr<unsigned char[]> buffer = nctl::makeUnique<unsigned char[]>(bufferSize);
 
 	nctl::UniquePtr<IAudioReader> audioReader = audioLoader.createReader();
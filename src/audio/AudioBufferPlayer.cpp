@@ -2,6 +2,7 @@
 #include "common_headers.h"
 #include "AudioBufferPlayer.h"
 #include "AudioBuffer.h"
+#include <cmath> // for fmodf()
 
 namespace ncine {
 
@@ -67,6 +68,7 @@ void AudioBufferPlayer::setAudioBuffer(AudioBuffer *audioBuffer)
 	audioBuffer_ = audioBuffer;
 }
 
+/*! If there are no free sources the player starts as a virtual voice and the device gives it one when it is audible enough. */
 void AudioBufferPlayer::play()
 {
 	IAudioDevice &device = theServiceLocator().audioDevice();
@@ -80,25 +82,14 @@ void AudioBufferPlayer::play()
 			if (audioBuffer_ == nullptr || canRegisterPlayer == false)
 				break;
 
-			const unsigned int source = device.nextAvailableSource();
-			if (source == IAudioDevice::UnavailableSource)
-			{
-				LOGW("No more available audio sources for playing");
-				return;
-			}
-			sourceId_ = source;
-
-			alSourcei(sourceId_, AL_BUFFER, audioBuffer_->bufferId());
-			// Setting OpenAL source looping only if not streaming
-			alSourcei(sourceId_, AL_LOOPING, isLooping_);
-
-			alSourcef(sourceId_, AL_GAIN, gain_);
-			alSourcef(sourceId_, AL_PITCH, pitch_);
-			alSourcefv(sourceId_, AL_POSITION, position_.data());
-
-			alSourcePlay(sourceId_);
+			virtualOffset_ = 0.0f;
+			sourceId_ = IAudioDevice::UnavailableSource;
 			state_ = PlayerState::PLAYING;
 
+			const unsigned int source = device.nextAvailableSource();
+			if (source != IAudioDevice::UnavailableSource)
+				acquireSource(source);
+
 			device.registerPlayer(this);
 			break;
 		}
@@ -109,7 +100,9 @@ void AudioBufferPlayer::play()
 			if (canRegisterPlayer == false)
 				break;
 
-			alSourcePlay(sourceId_);
+			// A player paused while virtual has no source to resume
+			if (sourceId_ != IAudioDevice::UnavailableSource)
+				alSourcePlay(sourceId_);
 			state_ = PlayerState::PLAYING;
 
 			device.registerPlayer(this);
@@ -127,7 +120,8 @@ void AudioBufferPlayer::pause()
 			break;
 		case PlayerState::PLAYING:
 		{
-			alSourcePause(sourceId_);
+			if (isVirtual() == false)
+				alSourcePause(sourceId_);
 			state_ = PlayerState::PAUSED;
 			break;
 		}
@@ -146,9 +140,12 @@ void AudioBufferPlayer::stop()
 		case PlayerState::PLAYING:
 		case PlayerState::PAUSED:
 		{
-			alSourceStop(sourceId_);
-			// Detach the buffer from source
-			alSourcei(sourceId_, AL_BUFFER, 0);
+			if (sourceId_ != IAudioDevice::UnavailableSource)
+			{
+				alSourceStop(sourceId_);
+				// Detach the buffer from source
+				alSourcei(sourceId_, AL_BUFFER, 0);
+			}
 
 			sourceId_ = 0;
 			state_ = PlayerState::STOPPED;
@@ -176,4 +173,54 @@ void AudioBufferPlayer::updateState()
 	}
 }
 
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void AudioBufferPlayer::acquireSource(unsigned int source)
+{
+	ASSERT(source != IAudioDevice::UnavailableSource);
+	sourceId_ = source;
+
+	alSourcei(sourceId_, AL_BUFFER, audioBuffer_->bufferId());
+	// Setting OpenAL source looping only if not streaming
+	alSourcei(sourceId_, AL_LOOPING, isLooping_);
+
+	alSourcef(sourceId_, AL_GAIN, gain_);
+	alSourcef(sourceId_, AL_PITCH, pitch_);
+	alSourcefv(sourceId_, AL_POSITION, position_.data());
+
+	// The offset of a source that is not playing is applied when it starts
+	alSourcef(sourceId_, AL_SEC_OFFSET, virtualOffset_);
+	alSourcePlay(sourceId_);
+}
+
+void AudioBufferPlayer::releaseSource()
+{
+	alGetSourcef(sourceId_, AL_SEC_OFFSET, &virtualOffset_);
+	alSourceStop(sourceId_);
+	// Detach the buffer from source
+	alSourcei(sourceId_, AL_BUFFER, 0);
+
+	sourceId_ = IAudioDevice::UnavailableSource;
+}
+
+void AudioBufferPlayer::updateVirtualState(float interval)
+{
+	virtualOffset_ += interval * pitch_;
+
+	const float bufferDuration = duration();
+	if (virtualOffset_ >= bufferDuration)
+	{
+		if (isLooping_ && bufferDuration > 0.0f)
+			virtualOffset_ = fmodf(virtualOffset_, bufferDuration);
+		else
+		{
+			virtualOffset_ = 0.0f;
+			sourceId_ = 0;
+			state_ = PlayerState::STOPPED;
+		}
+	}
+}
+
 }
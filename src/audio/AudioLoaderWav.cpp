@@ -48,4 +48,16 @@ nctl::UniquePtr<IAudioReader> AudioLoaderWav::createReader()
 	return nctl::makeUnique<AudioReaderWav>(nctl::move(fileHandle_));
 }
 
+const unsigned char *AudioLoaderWav::inPlaceSamples() const
+{
+	if (hasLoaded_ == false || fileHandle_ == nullptr || fileHandle_->data() == nullptr)
+		return nullptr;
+
+	// PCM samples follow the header and are already in the format expected by OpenAL
+	if (static_cast<unsigned long int>(fileHandle_->size()) < HeaderSize + bufferSize())
+		return nullptr;
+
+	return fileHandle_->data() + HeaderSize;
+}
+
 }
@@ -27,7 +27,8 @@ unsigned long int AudioReaderOgg::read(void *buffer, unsigned long int bufferSiz
 	ASSERT(buffer);
 	ASSERT(bufferSize > 0);
 
-	static int bitStream = 0;
+	// Not static, as streams can be decoded by different threads at the same time
+	int bitStream = 0;
 	long bytes = 0;
 	unsigned long int bufferSeek = 0;
 
@@ -43,10 +44,6 @@ unsigned long int AudioReaderOgg::read(void *buffer, unsigned long int bufferSiz
 			FATAL_MSG_X("Error decoding at bitstream %d", bitStream);
 		}
 
-		// Reset the static variable at the end of a decoding process
-		if (bytes <= 0)
-			bitStream = 0;
-
 		bufferSeek += bytes;
 	} while (bytes > 0 && bufferSize - bufferSeek > 0);
 
@@ -5,25 +5,33 @@
 #include "AudioStream.h"
 #include "IAudioLoader.h"
 #include "IAudioReader.h"
+#include "AudioStreamDecoder.h"
 #include "tracy.h"
 
 namespace ncine {
 
+namespace {
+
+	/// The minimum number of streaming buffers
+	const unsigned int MinNumBuffers = 2;
+	/// The minimum size in bytes of a streaming buffer
+	const unsigned int MinBufferSize = 1024;
+
+}
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
 
 /*! Private constructor called only by `AudioStreamPlayer`. */
 AudioStream::AudioStream()
-    : buffersIds_(nctl::StaticArrayMode::EXTEND_SIZE), nextAvailableBufferIndex_(0),
+    : numBuffers_(DefaultNumBuffers), buffersIds_(DefaultNumBuffers), nextAvailableBufferIndex_(0),
+      bufferSize_(DefaultBufferSize), hasBackgroundDecoding_(false), hasDecodedLastBlock_(false),
       currentBufferId_(0), totalProcessedBuffers_(0), bytesPerSample_(0), numChannels_(0),
       frequency_(0), numSamples_(0), duration_(0.0f)
 {
-	alGetError();
-	alGenBuffers(NumBuffers, buffersIds_.data());
-	const ALenum error = alGetError();
-	ASSERT_MSG_X(error == AL_NO_ERROR, "alGenBuffers failed: 0x%x", error);
-	memBuffer_ = nctl::makeUnique<char[]>(BufferSize);
+	createBuffers();
+	memBuffer_ = nctl::makeUnique<char[]>(bufferSize_);
 }
 
 /*! Private constructor called only by `AudioStreamPlayer`. */
@@ -47,8 +55,7 @@ AudioStream::AudioStream(const char *filename)
 AudioStream::~AudioStream()
 {
 	// Don't delete buffers if this is a moved out object
-	if (buffersIds_.size() == NumBuffers)
-		alDeleteBuffers(NumBuffers, buffersIds_.data());
+	deleteBuffers();
 }
 
 AudioStream::AudioStream(AudioStream &&) = default;
@@ -62,7 +69,7 @@ AudioStream &AudioStream::operator=(AudioStream &&) = default;
 unsigned long int AudioStream::numSamplesInStreamBuffer() const
 {
 	if (numChannels_ * bytesPerSample_ > 0)
-		return BufferSize / (numChannels_ * bytesPerSample_);
+		return bufferSize_ / (numChannels_ * bytesPerSample_);
 	return 0UL;
 }
 
@@ -72,9 +79,6 @@ bool AudioStream::enqueue(unsigned int source, bool looping)
 	if (audioReader_ == nullptr)
 		return false;
 
-	// Set to false when the queue is empty and there is no more data to decode
-	bool shouldKeepPlaying = true;
-
 	ALint numProcessedBuffers;
 	alGetSourcei(source, AL_BUFFERS_PROCESSED, &numProcessedBuffers);
 
@@ -89,40 +93,9 @@ bool AudioStream::enqueue(unsigned int source, bool looping)
 		totalProcessedBuffers_++;
 	}
 
-	// Queueing
-	if (nextAvailableBufferIndex_ < NumBuffers)
-	{
-		currentBufferId_ = buffersIds_[nextAvailableBufferIndex_];
-
-		unsigned long bytes = audioReader_->read(memBuffer_.get(), BufferSize);
-
-		// EOF reached
-		if (bytes < BufferSize)
-		{
-			if (looping)
-			{
-				audioReader_->rewind();
-				const unsigned long moreBytes = audioReader_->read(memBuffer_.get() + bytes, BufferSize - bytes);
-				bytes += moreBytes;
-			}
-			totalProcessedBuffers_ = 0;
-		}
-
-		// If it is still decoding data then enqueue
-		if (bytes > 0)
-		{
-			// On iOS `alBufferDataStatic()` could be used instead
-			alBufferData(currentBufferId_, format_, memBuffer_.get(), bytes, frequency_);
-			alSourceQueueBuffers(source, 1, &currentBufferId_);
-			nextAvailableBufferIndex_++;
-		}
-		// If there is no more data left to decode and the queue is empty
-		else if (nextAvailableBufferIndex_ == 0)
-		{
-			shouldKeepPlaying = false;
-			stop(source);
-		}
-	}
+	// Queueing, the stream is decoded on this thread if the decoding thread cannot serve it
+	const bool useDecoder = (decoder_ != nullptr && decoder_->start());
+	const bool shouldKeepPlaying = useDecoder ? enqueueFromDecoder(source, looping) : enqueueFromReader(source, looping);
 
 	ALenum state;
 	alGetSourcei(source, AL_SOURCE_STATE, &state);
@@ -160,11 +133,53 @@ void AudioStream::stop(unsigned int source)
 		numProcessedBuffers--;
 	}
 
-	audioReader_->rewind();
+	// The decoder gives the reader back to this thread before rewinding it
+	if (decoder_ != nullptr)
+		decoder_->stop();
+	else
+		audioReader_->rewind();
+	hasDecodedLastBlock_ = false;
 	currentBufferId_ = 0;
 	totalProcessedBuffers_ = 0;
 }
 
+void AudioStream::setStreamBuffers(unsigned int numBuffers, unsigned int bufferSize, bool backgroundDecoding)
+{
+	ASSERT(nextAvailableBufferIndex_ == 0);
+
+	// One buffer is played while the other is being filled
+	if (numBuffers < MinNumBuffers)
+		numBuffers = MinNumBuffers;
+	// Buffers should only contain whole frames of two channels of 16 bits samples
+	bufferSize &= ~3U;
+	if (bufferSize < MinBufferSize)
+		bufferSize = MinBufferSize;
+
+#if !defined(WITH_THREADS)
+	if (backgroundDecoding)
+	{
+		LOGW("Audio streams cannot be decoded in the background without thread support");
+		backgroundDecoding = false;
+	}
+#endif
+
+	if (numBuffers != numBuffers_)
+	{
+		deleteBuffers();
+		numBuffers_ = numBuffers;
+		createBuffers();
+	}
+
+	if (bufferSize != bufferSize_)
+	{
+		bufferSize_ = bufferSize;
+		memBuffer_ = nctl::makeUnique<char[]>(bufferSize_);
+	}
+
+	hasBackgroundDecoding_ = backgroundDecoding;
+	createDecoder();
+}
+
 ///////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
@@ -208,7 +223,111 @@ void AudioStream::createReader(IAudioLoader &audioLoader)
 	duration_ = float(numSamples_) / frequency_;
 	format_ = (numChannels_ == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
 
+	// The decoder of the previous reader has to be destroyed first
+	decoder_.reset(nullptr);
 	audioReader_ = audioLoader.createReader();
+	createDecoder();
+}
+
+void AudioStream::createBuffers()
+{
+	buffersIds_.setSize(numBuffers_);
+	alGetError();
+	alGenBuffers(numBuffers_, buffersIds_.data());
+	const ALenum error = alGetError();
+	ASSERT_MSG_X(error == AL_NO_ERROR, "alGenBuffers failed: 0x%x", error);
+}
+
+void AudioStream::deleteBuffers()
+{
+	if (buffersIds_.isEmpty() == false)
+	{
+		alDeleteBuffers(buffersIds_.size(), buffersIds_.data());
+		buffersIds_.clear();
+	}
+}
+
+void AudioStream::createDecoder()
+{
+	decoder_.reset(nullptr);
+	if (hasBackgroundDecoding_ && audioReader_ != nullptr)
+		decoder_ = nctl::makeUnique<AudioStreamDecoder>(*audioReader_, numBuffers_, bufferSize_);
+}
+
+bool AudioStream::enqueueFromReader(unsigned int source, bool looping)
+{
+	if (nextAvailableBufferIndex_ >= numBuffers_)
+		return true;
+
+	currentBufferId_ = buffersIds_[nextAvailableBufferIndex_];
+
+	unsigned long bytes = audioReader_->read(memBuffer_.get(), bufferSize_);
+
+	// EOF reached
+	if (bytes < bufferSize_)
+	{
+		if (looping)
+		{
+			audioReader_->rewind();
+			const unsigned long moreBytes = audioReader_->read(memBuffer_.get() + bytes, bufferSize_ - bytes);
+			bytes += moreBytes;
+		}
+		totalProcessedBuffers_ = 0;
+	}
+
+	// If it is still decoding data then enqueue
+	if (bytes > 0)
+	{
+		// On iOS `alBufferDataStatic()` could be used instead
+		alBufferData(currentBufferId_, format_, memBuffer_.get(), bytes, frequency_);
+		alSourceQueueBuffers(source, 1, &currentBufferId_);
+		nextAvailableBufferIndex_++;
+	}
+	// If there is no more data left to decode and the queue is empty
+	else if (nextAvailableBufferIndex_ == 0)
+	{
+		stop(source);
+		return false;
+	}
+
+	return true;
+}
+
+bool AudioStream::enqueueFromDecoder(unsigned int source, bool looping)
+{
+	decoder_->setLooping(looping);
+	AudioRingBuffer &ringBuffer = decoder_->ringBuffer();
+
+	// Every ready block is queued, an empty ring only means that the decoding thread is late
+	AudioRingBuffer::BlockInfo blockInfo;
+	while (nextAvailableBufferIndex_ < numBuffers_ && hasDecodedLastBlock_ == false)
+	{
+		const char *block = ringBuffer.readBlock(blockInfo);
+		if (block == nullptr)
+			break;
+
+		if (blockInfo.hasRewound || blockInfo.isLast)
+			totalProcessedBuffers_ = 0;
+		hasDecodedLastBlock_ = blockInfo.isLast;
+
+		if (blockInfo.numBytes > 0)
+		{
+			currentBufferId_ = buffersIds_[nextAvailableBufferIndex_];
+			alBufferData(currentBufferId_, format_, block, blockInfo.numBytes, frequency_);
+			alSourceQueueBuffers(source, 1, &currentBufferId_);
+			nextAvailableBufferIndex_++;
+		}
+		ringBuffer.commitRead();
+	}
+
+	// If there is no more data left to decode and the queue is empty
+	if (hasDecodedLastBlock_ && nextAvailableBufferIndex_ == 0)
+	{
+		stop(source);
+		return false;
+	}
+
+	return true;
 }
 
 }
@@ -0,0 +1,202 @@
+#include "common_macros.h"
+#include "AudioStreamDecoder.h"
+#include "IAudioReader.h"
+#if defined(WITH_THREADS)
+	#include "Thread.h"
+	#include "ThreadSync.h"
+	#include "Timer.h"
+	#include <nctl/StaticArray.h>
+	#include "tracy.h"
+#endif
+
+namespace ncine {
+
+#if defined(WITH_THREADS)
+namespace {
+
+	/// The number of seconds the decoding thread sleeps for when every ring buffer is full
+	const float IdleSleepTime = 0.005f;
+
+	Thread decodingThread;
+	/// Held by the decoding thread while it picks the next decoder, and by the other threads while they start or stop decoders
+	Mutex decodersMutex;
+	/// Signalled by the decoding thread every time it has finished filling a ring buffer
+	CondVariable decodedCondition;
+	nctl::StaticArray<AudioStreamDecoder *, AudioStreamDecoder::MaxNumDecoders> decoders;
+	/// The decoder whose ring buffer is being filled, it is accessed with the mutex held
+	AudioStreamDecoder *currentDecoder = nullptr;
+	nctl::Atomic32 shouldQuit;
+
+}
+#endif
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+AudioStreamDecoder::AudioStreamDecoder(const IAudioReader &audioReader, unsigned int numBlocks, unsigned int blockSize)
+    : audioReader_(audioReader), ringBuffer_(numBlocks, blockSize), hasReachedEnd_(false), isStarted_(false), hasFailedStart_(false)
+{
+}
+
+AudioStreamDecoder::~AudioStreamDecoder()
+{
+	if (isStarted_)
+		stop();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note Without thread support no decoder can be started and streams are decoded by the thread that plays them */
+bool AudioStreamDecoder::start()
+{
+#if defined(WITH_THREADS)
+	if (isStarted_)
+		return true;
+	else if (hasFailedStart_)
+		return false;
+
+	decodersMutex.lock();
+	if (decoders.size() >= MaxNumDecoders)
+	{
+		decodersMutex.unlock();
+		hasFailedStart_ = true;
+		return false;
+	}
+
+	const bool isFirstDecoder = decoders.isEmpty();
+	decoders.pushBack(this);
+	decodersMutex.unlock();
+
+	if (isFirstDecoder)
+	{
+		shouldQuit.store(0, nctl::Atomic32::MemoryModel::RELEASE);
+		decodingThread.run(decodingThreadFunction, nullptr);
+#if !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
+		decodingThread.setName("AudioDecoder");
+#endif
+	}
+
+	isStarted_ = true;
+	return true;
+#else
+	return false;
+#endif
+}
+
+void AudioStreamDecoder::stop()
+{
+#if defined(WITH_THREADS)
+	if (isStarted_)
+	{
+		decodersMutex.lock();
+		for (unsigned int i = 0; i < decoders.size(); i++)
+		{
+			if (decoders[i] == this)
+			{
+				decoders.unorderedRemoveAt(i);
+				break;
+			}
+		}
+		// Only the decoding of this decoder is waited for, not a whole pass of the decoding thread
+		while (currentDecoder == this)
+			decodedCondition.wait(decodersMutex);
+		const bool wasLastDecoder = decoders.isEmpty();
+		decodersMutex.unlock();
+
+		if (wasLastDecoder)
+		{
+			shouldQuit.store(1, nctl::Atomic32::MemoryModel::RELEASE);
+			decodingThread.join();
+		}
+		isStarted_ = false;
+	}
+#endif
+
+	// The decoding thread cannot access the reader or the ring buffer anymore
+	audioReader_.rewind();
+	ringBuffer_.clear();
+	hasReachedEnd_ = false;
+	hasFailedStart_ = false;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool AudioStreamDecoder::decode()
+{
+	if (hasReachedEnd_)
+		return false;
+
+	bool hasDecoded = false;
+	const unsigned int blockSize = ringBuffer_.blockSize();
+	while (char *block = ringBuffer_.writeBlock())
+	{
+		AudioRingBuffer::BlockInfo info;
+		info.numBytes = audioReader_.read(block, blockSize);
+
+		// EOF reached
+		if (info.numBytes < blockSize)
+		{
+			if (isLooping_.load(nctl::Atomic32::MemoryModel::ACQUIRE))
+			{
+				audioReader_.rewind();
+				info.numBytes += audioReader_.read(block + info.numBytes, blockSize - info.numBytes);
+				info.hasRewound = true;
+			}
+			else
+			{
+				info.isLast = true;
+				hasReachedEnd_ = true;
+			}
+		}
+
+		ringBuffer_.commitWrite(info);
+		hasDecoded = true;
+
+		if (hasReachedEnd_)
+			break;
+	}
+
+	return hasDecoded;
+}
+
+#if defined(WITH_THREADS)
+void AudioStreamDecoder::decodingThreadFunction(void *arg)
+{
+	LOGD_X("Audio decoding thread %u is starting", Thread::self());
+
+	while (shouldQuit.load(nctl::Atomic32::MemoryModel::ACQUIRE) == 0)
+	{
+		bool hasDecoded = false;
+		{
+			ZoneScopedN("Decode audio streams");
+			// Decoding happens outside of the lock, so that starting or stopping a decoder is never blocked by the others
+			decodersMutex.lock();
+			for (unsigned int i = 0; i < decoders.size(); i++)
+			{
+				AudioStreamDecoder *decoder = decoders[i];
+				currentDecoder = decoder;
+				decodersMutex.unlock();
+
+				hasDecoded |= decoder->decode();
+
+				decodersMutex.lock();
+				currentDecoder = nullptr;
+				decodedCondition.broadcast();
+			}
+			decodersMutex.unlock();
+		}
+
+		if (hasDecoded == false)
+			Timer::sleep(IdleSleepTime);
+	}
+
+	LOGD_X("Audio decoding thread %u is exiting", Thread::self());
+}
+#endif
+
+}
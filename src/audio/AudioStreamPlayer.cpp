@@ -25,7 +25,7 @@ AudioStreamPlayer::AudioStreamPlayer(const char *filename)
 
 AudioStreamPlayer::~AudioStreamPlayer()
 {
-	if (state_ != PlayerState::STOPPED)
+	if (state_ != PlayerState::STOPPED && sourceId_ != IAudioDevice::UnavailableSource)
 		audioStream_.stop(sourceId_);
 }
 
@@ -35,7 +35,7 @@ AudioStreamPlayer::~AudioStreamPlayer()
 
 bool AudioStreamPlayer::loadFromMemory(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize)
 {
-	if (state_ != PlayerState::STOPPED)
+	if (state_ != PlayerState::STOPPED && sourceId_ != IAudioDevice::UnavailableSource)
 		audioStream_.stop(sourceId_);
 
 	const bool hasLoaded = audioStream_.loadFromMemory(bufferName, bufferPtr, bufferSize);
@@ -48,7 +48,7 @@ bool AudioStreamPlayer::loadFromMemory(const char *bufferName, const unsigned ch
 
 bool AudioStreamPlayer::loadFromFile(const char *filename)
 {
-	if (state_ != PlayerState::STOPPED)
+	if (state_ != PlayerState::STOPPED && sourceId_ != IAudioDevice::UnavailableSource)
 		audioStream_.stop(sourceId_);
 
 	const bool hasLoaded = audioStream_.loadFromFile(filename);
@@ -59,11 +59,24 @@ bool AudioStreamPlayer::loadFromFile(const char *filename)
 	return true;
 }
 
+bool AudioStreamPlayer::setStreamBuffers(unsigned int numBuffers, unsigned int bufferSize, bool backgroundDecoding)
+{
+	if (state_ == PlayerState::PLAYING || state_ == PlayerState::PAUSED)
+	{
+		LOGW_X("Cannot change the stream buffers of \"%s\" while it is playing", name());
+		return false;
+	}
+
+	audioStream_.setStreamBuffers(numBuffers, bufferSize, backgroundDecoding);
+	return true;
+}
+
 unsigned long int AudioStreamPlayer::sampleOffsetInStream() const
 {
 	return (audioStream_.totalProcessedBuffers() * audioStream_.numSamplesInStreamBuffer() + sampleOffset());
 }
 
+/*! If there are no free sources the player waits as a virtual voice, without advancing, until the device gives it one. */
 void AudioStreamPlayer::play()
 {
 	IAudioDevice &device = theServiceLocator().audioDevice();
@@ -77,24 +90,13 @@ void AudioStreamPlayer::play()
 			if (canRegisterPlayer == false)
 				break;
 
-			const unsigned int source = device.nextAvailableSource();
-			if (source == IAudioDevice::UnavailableSource)
-			{
-				LOGW("No more available audio sources for playing");
-				return;
-			}
-			sourceId_ = source;
-
-			// Streams looping is not handled at enqueued buffer level
-			alSourcei(sourceId_, AL_LOOPING, AL_FALSE);
-
-			alSourcef(sourceId_, AL_GAIN, gain_);
-			alSourcef(sourceId_, AL_PITCH, pitch_);
-			alSourcefv(sourceId_, AL_POSITION, position_.data());
-
-			alSourcePlay(sourceId_);
+			sourceId_ = IAudioDevice::UnavailableSource;
 			state_ = PlayerState::PLAYING;
 
+			const unsigned int source = device.nextAvailableSource();
+			if (source != IAudioDevice::UnavailableSource)
+				acquireSource(source);
+
 			device.registerPlayer(this);
 			break;
 		}
@@ -105,7 +107,9 @@ void AudioStreamPlayer::play()
 			if (canRegisterPlayer == false)
 				break;
 
-			alSourcePlay(sourceId_);
+			// A player paused while virtual has no source to resume
+			if (sourceId_ != IAudioDevice::UnavailableSource)
+				alSourcePlay(sourceId_);
 			state_ = PlayerState::PLAYING;
 
 			device.registerPlayer(this);
@@ -123,7 +127,8 @@ void AudioStreamPlayer::pause()
 			break;
 		case PlayerState::PLAYING:
 		{
-			alSourcePause(sourceId_);
+			if (isVirtual() == false)
+				alSourcePause(sourceId_);
 			state_ = PlayerState::PAUSED;
 			break;
 		}
@@ -142,10 +147,14 @@ void AudioStreamPlayer::stop()
 		case PlayerState::PLAYING:
 		case PlayerState::PAUSED:
 		{
-			// Stop the source then unqueue every buffer
-			audioStream_.stop(sourceId_);
-			// Detach the buffer from source
-			alSourcei(sourceId_, AL_BUFFER, 0);
+			// A virtual stream has not queued any buffer yet
+			if (sourceId_ != IAudioDevice::UnavailableSource)
+			{
+				// Stop the source then unqueue every buffer
+				audioStream_.stop(sourceId_);
+				// Detach the buffer from source
+				alSourcei(sourceId_, AL_BUFFER, 0);
+			}
 
 			sourceId_ = 0;
 			state_ = PlayerState::STOPPED;
@@ -169,4 +178,33 @@ void AudioStreamPlayer::updateState()
 	}
 }
 
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void AudioStreamPlayer::acquireSource(unsigned int source)
+{
+	ASSERT(source != IAudioDevice::UnavailableSource);
+	sourceId_ = source;
+
+	// Streams looping is not handled at enqueued buffer level
+	alSourcei(sourceId_, AL_LOOPING, AL_FALSE);
+
+	alSourcef(sourceId_, AL_GAIN, gain_);
+	alSourcef(sourceId_, AL_PITCH, pitch_);
+	alSourcefv(sourceId_, AL_POSITION, position_.data());
+
+	alSourcePlay(sourceId_);
+}
+
+void AudioStreamPlayer::releaseSource()
+{
+	ASSERT_MSG(false, "Audio stream players cannot release their source");
+}
+
+void AudioStreamPlayer::updateVirtualState(float interval)
+{
+	// The stream is not decoded while waiting for a source
+}
+
 }
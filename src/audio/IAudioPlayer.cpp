@@ -12,14 +12,16 @@ namespace ncine {
 IAudioPlayer::IAudioPlayer(ObjectType type, const char *name)
     : Object(type, name), sourceId_(IAudioDevice::UnavailableSource),
       state_(PlayerState::STOPPED), isLooping_(false),
-      gain_(1.0f), pitch_(1.0f), position_(0.0f, 0.0f, 0.0f)
+      gain_(1.0f), pitch_(1.0f), position_(0.0f, 0.0f, 0.0f),
+      priority_(0), virtualOffset_(0.0f)
 {
 }
 
 IAudioPlayer::IAudioPlayer(ObjectType type)
     : Object(type), sourceId_(IAudioDevice::UnavailableSource),
       state_(PlayerState::STOPPED), isLooping_(false),
-      gain_(1.0f), pitch_(1.0f), position_(0.0f, 0.0f, 0.0f)
+      gain_(1.0f), pitch_(1.0f), position_(0.0f, 0.0f, 0.0f),
+      priority_(0), virtualOffset_(0.0f)
 {
 }
 
@@ -29,6 +31,9 @@ IAudioPlayer::IAudioPlayer(ObjectType type)
 
 int IAudioPlayer::sampleOffset() const
 {
+	if (isVirtual())
+		return static_cast<int>(virtualOffset_ * frequency());
+
 	int byteOffset = 0;
 	alGetSourcei(sourceId_, AL_SAMPLE_OFFSET, &byteOffset);
 	return byteOffset;
@@ -36,6 +41,13 @@ int IAudioPlayer::sampleOffset() const
 
 void IAudioPlayer::setSampleOffset(int byteOffset)
 {
+	if (isVirtual())
+	{
+		const int samplesFrequency = frequency();
+		virtualOffset_ = (samplesFrequency > 0) ? byteOffset / static_cast<float>(samplesFrequency) : 0.0f;
+		return;
+	}
+
 	alSourcei(sourceId_, AL_SAMPLE_OFFSET, byteOffset);
 }
 
@@ -43,7 +55,7 @@ void IAudioPlayer::setSampleOffset(int byteOffset)
 void IAudioPlayer::setGain(float gain)
 {
 	gain_ = gain;
-	if (state_ == PlayerState::PLAYING)
+	if (state_ == PlayerState::PLAYING && isVirtual() == false)
 		alSourcef(sourceId_, AL_GAIN, gain_);
 }
 
@@ -51,7 +63,7 @@ void IAudioPlayer::setGain(float gain)
 void IAudioPlayer::setPitch(float pitch)
 {
 	pitch_ = pitch;
-	if (state_ == PlayerState::PLAYING)
+	if (state_ == PlayerState::PLAYING && isVirtual() == false)
 		alSourcef(sourceId_, AL_PITCH, pitch_);
 }
 
@@ -59,7 +71,7 @@ void IAudioPlayer::setPitch(float pitch)
 void IAudioPlayer::setPosition(const Vector3f &position)
 {
 	position_ = position;
-	if (state_ == PlayerState::PLAYING)
+	if (state_ == PlayerState::PLAYING && isVirtual() == false)
 		alSourcefv(sourceId_, AL_POSITION, position_.data());
 }
 
@@ -67,8 +79,16 @@ void IAudioPlayer::setPosition(const Vector3f &position)
 void IAudioPlayer::setPosition(float x, float y, float z)
 {
 	position_.set(x, y, z);
-	if (state_ == PlayerState::PLAYING)
+	if (state_ == PlayerState::PLAYING && isVirtual() == false)
 		alSourcefv(sourceId_, AL_POSITION, position_.data());
 }
 
+/*! It follows the default OpenAL distance model, inverse and clamped, with the listener at the origin. */
+float IAudioPlayer::audibility() const
+{
+	// The default reference distance and rolloff factor are both one
+	const float distance = position_.length();
+	return (distance > 1.0f) ? gain_ / distance : gain_;
+}
+
 }
@@ -0,0 +1,932 @@
+#define NCINE_INCLUDE_OPENALC
+#include "common_headers.h"
+#include "common_macros.h"
+#include "common_simd.h"
+#include "SoftwareAudio.h"
+#include "IFile.h"
+#include <nctl/Array.h>
+#include <nctl/UniquePtr.h>
+#include <cmath> // for sqrtf() and floor()
+#include <cstdio> // for SEEK_SET
+#include <cstring> // for memcpy()
+#include "tracy.h"
+
+/// The only device, there is no hardware to enumerate
+struct ALCdevice
+{
+	bool isOpen = false;
+};
+
+struct ALCcontext
+{
+	ALCdevice *device = nullptr;
+};
+
+namespace ncine {
+
+namespace {
+	SoftwareAudio::Counters counters;
+	bool mixingOnUpdate = true;
+	/// The fraction of a frame that did not fit in the last update, carried over to the next one
+	double pendingFrames = 0.0;
+
+	const char *DeviceName = "nCine Software Mixer";
+	ALCdevice device;
+	ALCcontext context;
+	ALenum lastError = AL_NO_ERROR;
+
+	/// The maximum number of frames mixed in one pass, longer mixes are split
+	const unsigned int MaxChunkFrames = 1024;
+	const unsigned int WavHeaderSize = 44;
+
+	/// The samples of a buffer, converted to floating point in the [-1, 1] range
+	struct BufferObject
+	{
+		/// The interleaved samples, one or two per frame
+		nctl::Array<float> samples;
+		int numChannels = 1;
+		int frequency = SoftwareAudio::Frequency;
+		unsigned int numFrames = 0;
+	};
+
+	struct SourceObject
+	{
+		ALenum state = AL_INITIAL;
+		/// The buffers to play in order, a static buffer is a queue of one
+		nctl::Array<ALuint> queue;
+		/// The index of the buffer being played, the ones before it have been processed
+		unsigned int queueIndex = 0;
+		/// The fractional position in frames inside the current buffer
+		double framePosition = 0.0;
+		/// True if the offset has been set on a stopped source, it is kept when the source is played
+		bool hasPendingOffset = false;
+		bool isLooping = false;
+		float gain = 1.0f;
+		float pitch = 1.0f;
+		float position[3] = { 0.0f, 0.0f, 0.0f };
+	};
+
+	struct Listener
+	{
+		float gain = 1.0f;
+		float position[3] = { 0.0f, 0.0f, 0.0f };
+	} listener;
+
+	/// Buffer and source names start from one, the object of name `n` is stored at index `n - 1`
+	nctl::Array<nctl::UniquePtr<BufferObject>> buffers;
+	nctl::Array<nctl::UniquePtr<SourceObject>> sources;
+
+	/// The interleaved stereo frames of the mix, before the conversion to 16 bits
+	float mixBuffer[MaxChunkFrames * SoftwareAudio::NumChannels];
+	/// The interleaved stereo frames of one source after resampling
+	float sourceBuffer[MaxChunkFrames * SoftwareAudio::NumChannels];
+	int16_t outputBuffer[MaxChunkFrames * SoftwareAudio::NumChannels];
+
+	SoftwareAudio::Sink currentSink = SoftwareAudio::Sink::NONE;
+	nctl::Array<int16_t> memorySamples;
+	nctl::UniquePtr<IFile> wavFile;
+	uint32_t wavDataBytes = 0;
+
+	void setError(ALenum error)
+	{
+		// Only the first error is kept until it is retrieved
+		if (lastError == AL_NO_ERROR)
+			lastError = error;
+	}
+
+	BufferObject *bufferObject(ALuint buffer)
+	{
+		if (buffer == 0 || buffer > buffers.size())
+			return nullptr;
+		return buffers[buffer - 1].get();
+	}
+
+	SourceObject *sourceObject(ALuint source)
+	{
+		if (source == 0 || source > sources.size() || sources[source - 1] == nullptr)
+		{
+			setError(AL_INVALID_NAME);
+			return nullptr;
+		}
+		return sources[source - 1].get();
+	}
+
+	/// Returns the number of frames of the processed buffers in the queue plus the position in the current one
+	double sourceFrameOffset(const SourceObject &source)
+	{
+		if ((source.state != AL_PLAYING && source.state != AL_PAUSED) && source.hasPendingOffset == false)
+			return 0.0;
+
+		double frameOffset = source.framePosition;
+		for (unsigned int i = 0; i < source.queueIndex && i < source.queue.size(); i++)
+		{
+			const BufferObject *buffer = bufferObject(source.queue[i]);
+			if (buffer)
+				frameOffset += buffer->numFrames;
+		}
+		return frameOffset;
+	}
+
+	int sourceFrequency(const SourceObject &source)
+	{
+		if (source.queue.isEmpty())
+			return SoftwareAudio::Frequency;
+		const unsigned int index = (source.queueIndex < source.queue.size()) ? source.queueIndex : 0;
+		const BufferObject *buffer = bufferObject(source.queue[index]);
+		return buffer ? buffer->frequency : SoftwareAudio::Frequency;
+	}
+
+	void setSourceFrameOffset(SourceObject &source, double frameOffset)
+	{
+		unsigned int queueIndex = 0;
+		while (queueIndex < source.queue.size())
+		{
+			const BufferObject *buffer = bufferObject(source.queue[queueIndex]);
+			const unsigned int numFrames = buffer ? buffer->numFrames : 0;
+			if (frameOffset < numFrames)
+				break;
+			frameOffset -= numFrames;
+			queueIndex++;
+		}
+
+		if (frameOffset < 0.0 || queueIndex >= source.queue.size())
+		{
+			setError(AL_INVALID_VALUE);
+			return;
+		}
+
+		source.queueIndex = queueIndex;
+		source.framePosition = frameOffset;
+		if (source.state != AL_PLAYING && source.state != AL_PAUSED)
+			source.hasPendingOffset = true;
+	}
+
+	/// Moves the source to its next buffer, it loops back to the first one or it stops after the last one
+	void advanceBuffer(SourceObject &source)
+	{
+		source.queueIndex++;
+		counters.numProcessedBuffers++;
+
+		if (source.queueIndex >= source.queue.size())
+		{
+			if (source.isLooping)
+				source.queueIndex = 0;
+			else
+			{
+				source.state = AL_STOPPED;
+				source.framePosition = 0.0;
+				counters.numDrainedSources++;
+			}
+		}
+	}
+
+	/// Computes the left and right gains, mono sources are attenuated by the distance from the listener and panned
+	/*! The attenuation follows the default inverse distance clamped model, with a reference distance and a rolloff factor of one. */
+	void sourceGains(const SourceObject &source, int numChannels, float &leftGain, float &rightGain)
+	{
+		const float gain = listener.gain * source.gain;
+		leftGain = gain;
+		rightGain = gain;
+		if (numChannels != 1)
+			return;
+
+		const float dx = source.position[0] - listener.position[0];
+		const float dy = source.position[1] - listener.position[1];
+		const float dz = source.position[2] - listener.position[2];
+		const float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+		if (distance <= 0.0f)
+			return;
+
+		const float attenuation = (distance > 1.0f) ? 1.0f / distance : 1.0f;
+		// A balance panning on the horizontal axis, a centered source is played at full gain on both channels
+		const float pan = dx / distance;
+		leftGain = gain * attenuation * (pan > 0.0f ? 1.0f - pan : 1.0f);
+		rightGain = gain * attenuation * (pan < 0.0f ? 1.0f + pan : 1.0f);
+	}
+
+	/// Resamples the buffer from the position with a linear interpolation, writing stereo frames
+	void resample(const BufferObject &buffer, double position, double step, unsigned int numFrames, float *dest)
+	{
+		const float *samples = buffer.samples.data();
+		const unsigned int lastFrame = buffer.numFrames - 1;
+
+		const unsigned int startFrame = static_cast<unsigned int>(position);
+		if (step == 1.0 && position == static_cast<double>(startFrame))
+		{
+			// Same frequency and aligned position, frames are copied
+			if (buffer.numChannels == 2)
+				memcpy(dest, samples + startFrame * 2, numFrames * 2 * sizeof(float));
+			else
+			{
+				for (unsigned int i = 0; i < numFrames; i++)
+				{
+					dest[i * 2] = samples[startFrame + i];
+					dest[i * 2 + 1] = samples[startFrame + i];
+				}
+			}
+			return;
+		}
+
+		unsigned int i = 0;
+#if defined(NCINE_WITH_SIMD)
+		// Frame positions are computed in double precision one by one, only the interpolation of stereo frames is vectorized.
+		// Mono samples would need a gather for every lane, it is slower than the scalar loop without a gather instruction.
+		if (buffer.numChannels == 2)
+		{
+			// Two output frames at a time, each one interpolated between two consecutive stereo frames.
+			// The loop stops when a next frame would be past the end of the buffer, the pitch is always positive.
+			for (; i + 2 <= numFrames; i += 2)
+			{
+				const double framePosition0 = position + step * i;
+				const double framePosition1 = position + step * (i + 1);
+				const unsigned int frame0 = static_cast<unsigned int>(framePosition0);
+				const unsigned int frame1 = static_cast<unsigned int>(framePosition1);
+				if (frame1 >= lastFrame)
+					break;
+				const float fraction0 = static_cast<float>(framePosition0 - frame0);
+				const float fraction1 = static_cast<float>(framePosition1 - frame1);
+
+				const simd::Float4 frames0 = simd::load(samples + frame0 * 2);
+				const simd::Float4 frames1 = simd::load(samples + frame1 * 2);
+				const simd::Float4 current = simd::lowHalves(frames0, frames1);
+				const simd::Float4 next = simd::highHalves(frames0, frames1);
+				const simd::Float4 fractions = simd::set(fraction0, fraction0, fraction1, fraction1);
+				simd::store(dest + i * 2, simd::mulAdd(current, simd::sub(next, current), fractions));
+			}
+		}
+#endif
+		for (; i < numFrames; i++)
+		{
+			const double framePosition = position + step * i;
+			unsigned int frame = static_cast<unsigned int>(framePosition);
+			// Rounding errors cannot read past the end of the buffer
+			if (frame > lastFrame)
+				frame = lastFrame;
+			const unsigned int nextFrame = (frame < lastFrame) ? frame + 1 : lastFrame;
+			const float fraction = static_cast<float>(framePosition - frame);
+
+			if (buffer.numChannels == 2)
+			{
+				dest[i * 2] = samples[frame * 2] + (samples[nextFrame * 2] - samples[frame * 2]) * fraction;
+				dest[i * 2 + 1] = samples[frame * 2 + 1] + (samples[nextFrame * 2 + 1] - samples[frame * 2 + 1]) * fraction;
+			}
+			else
+			{
+				const float sample = samples[frame] + (samples[nextFrame] - samples[frame]) * fraction;
+				dest[i * 2] = sample;
+				dest[i * 2 + 1] = sample;
+			}
+		}
+	}
+
+	/// Adds the stereo frames to the mix, scaled by the left and right gains
+	void accumulate(float *dest, const float *src, unsigned int numSamples, float leftGain, float rightGain)
+	{
+		unsigned int i = 0;
+#if defined(NCINE_WITH_SIMD)
+		// Two stereo frames at a time
+		const simd::Float4 gains = simd::set(leftGain, rightGain, leftGain, rightGain);
+		for (; i + 4 <= numSamples; i += 4)
+			simd::store(dest + i, simd::mulAdd(simd::load(dest + i), simd::load(src + i), gains));
+#endif
+		for (; i < numSamples; i += 2)
+		{
+			dest[i] += src[i] * leftGain;
+			dest[i + 1] += src[i + 1] * rightGain;
+		}
+	}
+
+	/// Converts the mix to 16 bits samples, returns the number of samples that have been clamped
+	unsigned int convertMix(const float *src, int16_t *dest, unsigned int numSamples)
+	{
+		unsigned int numClipped = 0;
+		unsigned int i = 0;
+#if defined(NCINE_WITH_SIMD)
+		const simd::Float4 scale = simd::splat(32767.0f);
+		const simd::Float4 lowest = simd::splat(-32768.0f);
+		const simd::Float4 highest = simd::splat(32767.0f);
+		for (; i + 4 <= numSamples; i += 4)
+		{
+			const simd::Float4 scaled = simd::mul(simd::load(src + i), scale);
+			const simd::Float4 clamped = simd::min(simd::max(scaled, lowest), highest);
+			// Only the samples out of range are changed by the clamp
+			numClipped += simd::countNotEqual(scaled, clamped);
+			simd::storeInt16(dest + i, clamped);
+		}
+#endif
+		for (; i < numSamples; i++)
+		{
+			const float value = src[i] * 32767.0f;
+			if (value > 32767.0f || value < -32768.0f)
+				numClipped++;
+			dest[i] = static_cast<int16_t>(value > 32767.0f ? 32767.0f : (value < -32768.0f ? -32768.0f : value));
+		}
+		return numClipped;
+	}
+
+	/// Resamples and adds one source to the mix until the number of frames is reached or the source stops
+	void mixSource(SourceObject &source, float *dest, unsigned int numFrames)
+	{
+		unsigned int frameIndex = 0;
+		while (frameIndex < numFrames && source.state == AL_PLAYING)
+		{
+			if (source.queueIndex >= source.queue.size())
+			{
+				source.state = AL_STOPPED;
+				source.framePosition = 0.0;
+				counters.numDrainedSources++;
+				break;
+			}
+
+			const BufferObject *buffer = bufferObject(source.queue[source.queueIndex]);
+			if (buffer == nullptr || source.framePosition >= buffer->numFrames)
+			{
+				source.framePosition = (buffer != nullptr) ? source.framePosition - buffer->numFrames : 0.0;
+				advanceBuffer(source);
+				continue;
+			}
+
+			const double step = buffer->frequency * static_cast<double>(source.pitch) / SoftwareAudio::Frequency;
+			// The number of output frames until the end of the buffer
+			const double framesToEnd = ceil((buffer->numFrames - source.framePosition) / step);
+			unsigned int framesToMix = numFrames - frameIndex;
+			if (framesToEnd < framesToMix)
+				framesToMix = static_cast<unsigned int>(framesToEnd);
+
+			float leftGain = 0.0f;
+			float rightGain = 0.0f;
+			sourceGains(source, buffer->numChannels, leftGain, rightGain);
+			resample(*buffer, source.framePosition, step, framesToMix, sourceBuffer);
+			accumulate(dest + frameIndex * 2, sourceBuffer, framesToMix * 2, leftGain, rightGain);
+
+			source.framePosition += step * framesToMix;
+			frameIndex += framesToMix;
+			counters.numSourceFrames += framesToMix;
+		}
+	}
+
+	void writeToSink(const int16_t *samples, unsigned int numSamples)
+	{
+		switch (currentSink)
+		{
+			case SoftwareAudio::Sink::NONE:
+				break;
+			case SoftwareAudio::Sink::MEMORY:
+			{
+				const unsigned int size = memorySamples.size();
+				// The capacity is doubled to amortize the reallocations of a long recording
+				if (size + numSamples > memorySamples.capacity())
+					memorySamples.setCapacity((size + numSamples > size * 2) ? size + numSamples : size * 2);
+				memorySamples.setSize(size + numSamples);
+				memcpy(memorySamples.data() + size, samples, numSamples * sizeof(int16_t));
+				break;
+			}
+			case SoftwareAudio::Sink::WAV_FILE:
+			{
+				const unsigned long int numBytes = numSamples * sizeof(int16_t);
+				wavDataBytes += static_cast<uint32_t>(wavFile->write(samples, numBytes));
+				break;
+			}
+		}
+	}
+
+	void writeWavHeader(IFile &file, uint32_t dataBytes)
+	{
+		const uint16_t format = 1; // PCM
+		const uint16_t numChannels = SoftwareAudio::NumChannels;
+		const uint32_t frequency = SoftwareAudio::Frequency;
+		const uint16_t bitsPerSample = 16;
+		const uint16_t blockAlign = numChannels * bitsPerSample / 8;
+		const uint32_t byteRate = frequency * blockAlign;
+		const uint32_t fmtSize = 16;
+		const uint32_t riffSize = WavHeaderSize - 8 + dataBytes;
+
+		file.write("RIFF", 4);
+		file.write(&riffSize, sizeof(uint32_t));
+		file.write("WAVEfmt ", 8);
+		file.write(&fmtSize, sizeof(uint32_t));
+		file.write(&format, sizeof(uint16_t));
+		file.write(&numChannels, sizeof(uint16_t));
+		file.write(&frequency, sizeof(uint32_t));
+		file.write(&byteRate, sizeof(uint32_t));
+		file.write(&blockAlign, sizeof(uint16_t));
+		file.write(&bitsPerSample, sizeof(uint16_t));
+		file.write("data", 4);
+		file.write(&dataBytes, sizeof(uint32_t));
+	}
+
+	/// Writes the final sizes in the header and closes the file
+	void closeWavFile()
+	{
+		if (wavFile == nullptr)
+			return;
+
+		wavFile->seek(0, SEEK_SET);
+		writeWavHeader(*wavFile, wavDataBytes);
+		wavFile->close();
+		wavFile.reset(nullptr);
+		wavDataBytes = 0;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+const SoftwareAudio::Counters &SoftwareAudio::counters()
+{
+	return ncine::counters;
+}
+
+void SoftwareAudio::resetCounters()
+{
+	ncine::counters = Counters();
+}
+
+bool SoftwareAudio::isMixingOnUpdate()
+{
+	return ncine::mixingOnUpdate;
+}
+
+void SoftwareAudio::setMixingOnUpdate(bool mixingOnUpdate)
+{
+	ncine::mixingOnUpdate = mixingOnUpdate;
+	pendingFrames = 0.0;
+}
+
+void SoftwareAudio::mix(unsigned int numFrames)
+{
+	ZoneScoped;
+
+	while (numFrames > 0)
+	{
+		const unsigned int chunkFrames = (numFrames < MaxChunkFrames) ? numFrames : MaxChunkFrames;
+		const unsigned int numSamples = chunkFrames * NumChannels;
+		memset(mixBuffer, 0, numSamples * sizeof(float));
+
+		for (nctl::UniquePtr<SourceObject> &source : sources)
+		{
+			if (source != nullptr && source->state == AL_PLAYING)
+				mixSource(*source, mixBuffer, chunkFrames);
+		}
+
+		ncine::counters.numClippedSamples += convertMix(mixBuffer, outputBuffer, numSamples);
+		writeToSink(outputBuffer, numSamples);
+
+		ncine::counters.numMixedFrames += chunkFrames;
+		numFrames -= chunkFrames;
+	}
+}
+
+SoftwareAudio::Sink SoftwareAudio::sink()
+{
+	return currentSink;
+}
+
+bool SoftwareAudio::setSink(Sink sink, const char *filename)
+{
+	closeWavFile();
+	currentSink = Sink::NONE;
+
+	if (sink == Sink::WAV_FILE)
+	{
+		ASSERT(filename);
+		if (filename == nullptr)
+			return false;
+
+		wavFile = IFile::createFileHandle(filename);
+		wavFile->open(IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+		if (wavFile->isOpened() == false)
+		{
+			LOGW_X("Cannot open the WAV file \"%s\" for the software audio output", filename);
+			wavFile.reset(nullptr);
+			return false;
+		}
+		// The header is written again with the final sizes when the file is closed
+		writeWavHeader(*wavFile, 0);
+	}
+
+	currentSink = sink;
+	return true;
+}
+
+const int16_t *SoftwareAudio::memorySamples()
+{
+	return ncine::memorySamples.data();
+}
+
+unsigned long int SoftwareAudio::numMemoryFrames()
+{
+	return ncine::memorySamples.size() / NumChannels;
+}
+
+void SoftwareAudio::clearMemory()
+{
+	ncine::memorySamples.clear();
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void SoftwareAudio::update(float interval)
+{
+	if (ncine::mixingOnUpdate == false)
+		return;
+
+	pendingFrames += static_cast<double>(interval) * Frequency;
+	const double numFrames = floor(pendingFrames);
+	pendingFrames -= numFrames;
+	mix(static_cast<unsigned int>(numFrames));
+}
+
+}
+
+using ncine::bufferObject;
+using ncine::sourceObject;
+using ncine::setError;
+
+/// The OpenAL functions, called by the engine instead of the ones of a sound driver
+extern "C" {
+
+///////////////////////////////////////////////////////////
+// BUFFERS
+///////////////////////////////////////////////////////////
+
+ALenum alGetError()
+{
+	const ALenum error = ncine::lastError;
+	ncine::lastError = AL_NO_ERROR;
+	return error;
+}
+
+void alGenBuffers(ALsizei n, ALuint *buffers)
+{
+	for (ALsizei i = 0; i < n; i++)
+	{
+		ncine::buffers.pushBack(nctl::makeUnique<ncine::BufferObject>());
+		buffers[i] = ncine::buffers.size();
+	}
+}
+
+void alDeleteBuffers(ALsizei n, const ALuint *buffers)
+{
+	for (ALsizei i = 0; i < n; i++)
+	{
+		if (buffers[i] > 0 && buffers[i] <= ncine::buffers.size())
+			ncine::buffers[buffers[i] - 1].reset(nullptr);
+	}
+}
+
+void alBufferData(ALuint buffer, ALenum format, const ALvoid *data, ALsizei size, ALsizei freq)
+{
+	ncine::BufferObject *bufferObj = bufferObject(buffer);
+	if (bufferObj == nullptr)
+	{
+		setError(AL_INVALID_NAME);
+		return;
+	}
+	if (freq <= 0 || size < 0)
+	{
+		setError(AL_INVALID_VALUE);
+		return;
+	}
+
+	const bool is16Bits = (format == AL_FORMAT_MONO16 || format == AL_FORMAT_STEREO16);
+	const bool isStereo = (format == AL_FORMAT_STEREO8 || format == AL_FORMAT_STEREO16);
+	if (is16Bits == false && format != AL_FORMAT_MONO8 && format != AL_FORMAT_STEREO8)
+	{
+		setError(AL_INVALID_ENUM);
+		return;
+	}
+
+	const unsigned int numSamples = static_cast<unsigned int>(size) / (is16Bits ? 2 : 1);
+	bufferObj->numChannels = isStereo ? 2 : 1;
+	bufferObj->frequency = freq;
+	bufferObj->numFrames = numSamples / bufferObj->numChannels;
+	bufferObj->samples.clear();
+	bufferObj->samples.setSize(bufferObj->numFrames * bufferObj->numChannels);
+
+	float *samples = bufferObj->samples.data();
+	if (is16Bits)
+	{
+		const int16_t *src = static_cast<const int16_t *>(data);
+		for (unsigned int i = 0; i < bufferObj->samples.size(); i++)
+			samples[i] = src[i] / 32768.0f;
+	}
+	else
+	{
+		// Eight bits samples are unsigned
+		const uint8_t *src = static_cast<const uint8_t *>(data);
+		for (unsigned int i = 0; i < bufferObj->samples.size(); i++)
+			samples[i] = (src[i] - 128) / 128.0f;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// SOURCES
+///////////////////////////////////////////////////////////
+
+void alGenSources(ALsizei n, ALuint *sources)
+{
+	for (ALsizei i = 0; i < n; i++)
+	{
+		ncine::sources.pushBack(nctl::makeUnique<ncine::SourceObject>());
+		sources[i] = ncine::sources.size();
+	}
+}
+
+void alDeleteSources(ALsizei n, const ALuint *sources)
+{
+	for (ALsizei i = 0; i < n; i++)
+	{
+		if (sources[i] > 0 && sources[i] <= ncine::sources.size())
+			ncine::sources[sources[i] - 1].reset(nullptr);
+	}
+}
+
+void alSourcei(ALuint source, ALenum param, ALint value)
+{
+	ncine::SourceObject *sourceObj = sourceObject(source);
+	if (sourceObj == nullptr)
+		return;
+
+	switch (param)
+	{
+		case AL_BUFFER:
+			if (sourceObj->state == AL_PLAYING || sourceObj->state == AL_PAUSED)
+			{
+				setError(AL_INVALID_OPERATION);
+				return;
+			}
+			sourceObj->queue.clear();
+			if (value != 0)
+				sourceObj->queue.pushBack(static_cast<ALuint>(value));
+			sourceObj->queueIndex = 0;
+			sourceObj->framePosition = 0.0;
+			sourceObj->hasPendingOffset = false;
+			break;
+		case AL_LOOPING:
+			sourceObj->isLooping = (value != AL_FALSE);
+			break;
+		case AL_SAMPLE_OFFSET:
+			ncine::setSourceFrameOffset(*sourceObj, static_cast<double>(value));
+			break;
+		default:
+			setError(AL_INVALID_ENUM);
+			break;
+	}
+}
+
+void alSourcef(ALuint source, ALenum param, ALfloat value)
+{
+	ncine::SourceObject *sourceObj = sourceObject(source);
+	if (sourceObj == nullptr)
+		return;
+
+	switch (param)
+	{
+		case AL_GAIN:
+			sourceObj->gain = value;
+			break;
+		case AL_PITCH:
+			if (value <= 0.0f)
+			{
+				setError(AL_INVALID_VALUE);
+				return;
+			}
+			sourceObj->pitch = value;
+			break;
+		case AL_SEC_OFFSET:
+			ncine::setSourceFrameOffset(*sourceObj, static_cast<double>(value) * ncine::sourceFrequency(*sourceObj));
+			break;
+		default:
+			setError(AL_INVALID_ENUM);
+			break;
+	}
+}
+
+void alSourcefv(ALuint source, ALenum param, const ALfloat *values)
+{
+	ncine::SourceObject *sourceObj = sourceObject(source);
+	if (sourceObj == nullptr)
+		return;
+
+	if (param == AL_POSITION)
+	{
+		sourceObj->position[0] = values[0];
+		sourceObj->position[1] = values[1];
+		sourceObj->position[2] = values[2];
+	}
+	else if (param == AL_GAIN || param == AL_PITCH || param == AL_SEC_OFFSET)
+		alSourcef(source, param, values[0]);
+	else
+		setError(AL_INVALID_ENUM);
+}
+
+void alGetSourcei(ALuint source, ALenum param, ALint *value)
+{
+	ncine::SourceObject *sourceObj = sourceObject(source);
+	if (sourceObj == nullptr)
+		return;
+
+	switch (param)
+	{
+		case AL_SOURCE_STATE:
+			*value = sourceObj->state;
+			break;
+		case AL_BUFFER:
+			*value = sourceObj->queue.isEmpty() ? 0 : static_cast<ALint>(sourceObj->queue[0]);
+			break;
+		case AL_LOOPING:
+			*value = sourceObj->isLooping ? AL_TRUE : AL_FALSE;
+			break;
+		case AL_BUFFERS_QUEUED:
+			*value = static_cast<ALint>(sourceObj->queue.size());
+			break;
+		case AL_BUFFERS_PROCESSED:
+			*value = static_cast<ALint>(sourceObj->queueIndex);
+			break;
+		case AL_SAMPLE_OFFSET:
+			*value = static_cast<ALint>(ncine::sourceFrameOffset(*sourceObj));
+			break;
+		default:
+			setError(AL_INVALID_ENUM);
+			break;
+	}
+}
+
+void alGetSourcef(ALuint source, ALenum param, ALfloat *value)
+{
+	ncine::SourceObject *sourceObj = sourceObject(source);
+	if (sourceObj == nullptr)
+		return;
+
+	switch (param)
+	{
+		case AL_GAIN:
+			*value = sourceObj->gain;
+			break;
+		case AL_PITCH:
+			*value = sourceObj->pitch;
+			break;
+		case AL_SEC_OFFSET:
+			*value = static_cast<ALfloat>(ncine::sourceFrameOffset(*sourceObj) / ncine::sourceFrequency(*sourceObj));
+			break;
+		default:
+			setError(AL_INVALID_ENUM);
+			break;
+	}
+}
+
+void alSourcePlay(ALuint source)
+{
+	ncine::SourceObject *sourceObj = sourceObject(source);
+	if (sourceObj == nullptr)
+		return;
+
+	if (sourceObj->state == AL_PAUSED)
+	{
+		sourceObj->state = AL_PLAYING;
+		return;
+	}
+
+	// Playing a source that is already playing restarts it
+	if (sourceObj->hasPendingOffset == false)
+	{
+		sourceObj->queueIndex = 0;
+		sourceObj->framePosition = 0.0;
+	}
+	sourceObj->hasPendingOffset = false;
+	sourceObj->state = sourceObj->queue.isEmpty() ? AL_STOPPED : AL_PLAYING;
+}
+
+void alSourcePause(ALuint source)
+{
+	ncine::SourceObject *sourceObj = sourceObject(source);
+	if (sourceObj != nullptr && sourceObj->state == AL_PLAYING)
+		sourceObj->state = AL_PAUSED;
+}
+
+void alSourceStop(ALuint source)
+{
+	ncine::SourceObject *sourceObj = sourceObject(source);
+	if (sourceObj == nullptr)
+		return;
+
+	// Every buffer of a stopped source is processed
+	sourceObj->state = AL_STOPPED;
+	sourceObj->queueIndex = sourceObj->queue.size();
+	sourceObj->framePosition = 0.0;
+	sourceObj->hasPendingOffset = false;
+}
+
+void alSourceQueueBuffers(ALuint source, ALsizei nb, const ALuint *buffers)
+{
+	ncine::SourceObject *sourceObj = sourceObject(source);
+	if (sourceObj == nullptr)
+		return;
+
+	for (ALsizei i = 0; i < nb; i++)
+	{
+		if (bufferObject(buffers[i]) == nullptr)
+		{
+			setError(AL_INVALID_NAME);
+			return;
+		}
+	}
+
+	for (ALsizei i = 0; i < nb; i++)
+		sourceObj->queue.pushBack(buffers[i]);
+}
+
+void alSourceUnqueueBuffers(ALuint source, ALsizei nb, ALuint *buffers)
+{
+	ncine::SourceObject *sourceObj = sourceObject(source);
+	if (sourceObj == nullptr)
+		return;
+
+	if (nb < 0 || static_cast<unsigned int>(nb) > sourceObj->queueIndex)
+	{
+		setError(AL_INVALID_VALUE);
+		return;
+	}
+
+	for (ALsizei i = 0; i < nb; i++)
+		buffers[i] = sourceObj->queue[i];
+	sourceObj->queue.removeRange(0, nb);
+	sourceObj->queueIndex -= nb;
+}
+
+///////////////////////////////////////////////////////////
+// LISTENER
+///////////////////////////////////////////////////////////
+
+void alListenerf(ALenum param, ALfloat value)
+{
+	if (param == AL_GAIN)
+		ncine::listener.gain = value;
+	else
+		setError(AL_INVALID_ENUM);
+}
+
+void alListener3f(ALenum param, ALfloat value1, ALfloat value2, ALfloat value3)
+{
+	if (param == AL_POSITION)
+	{
+		ncine::listener.position[0] = value1;
+		ncine::listener.position[1] = value2;
+		ncine::listener.position[2] = value3;
+	}
+	else
+		setError(AL_INVALID_ENUM);
+}
+
+///////////////////////////////////////////////////////////
+// DEVICE AND CONTEXT
+///////////////////////////////////////////////////////////
+
+ALCdevice *alcOpenDevice(const ALCchar *devicename)
+{
+	ncine::device.isOpen = true;
+	return &ncine::device;
+}
+
+ALCboolean alcCloseDevice(ALCdevice *device)
+{
+	if (device != &ncine::device || device->isOpen == false)
+		return ALC_FALSE;
+
+	// The WAV file is completed, the samples in memory are kept for inspection
+	if (ncine::currentSink == ncine::SoftwareAudio::Sink::WAV_FILE)
+		ncine::SoftwareAudio::setSink(ncine::SoftwareAudio::Sink::NONE);
+	device->isOpen = false;
+	return ALC_TRUE;
+}
+
+ALCcontext *alcCreateContext(ALCdevice *device, const ALCint *attrlist)
+{
+	if (device != &ncine::device || device->isOpen == false)
+		return nullptr;
+
+	ncine::context.device = device;
+	return &ncine::context;
+}
+
+void alcDestroyContext(ALCcontext *context)
+{
+	if (context == &ncine::context)
+		context->device = nullptr;
+}
+
+ALCboolean alcMakeContextCurrent(ALCcontext *context)
+{
+	return (context == nullptr || context == &ncine::context) ? ALC_TRUE : ALC_FALSE;
+}
+
+const ALCchar *alcGetString(ALCdevice *device, ALCenum param)
+{
+	return (param == ALC_DEVICE_SPECIFIER) ? ncine::DeviceName : nullptr;
+}
+
+}
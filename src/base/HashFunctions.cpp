@@ -1,3 +1,4 @@
+#include <cstring> // for memcpy()
 #include <nctl/HashFunctions.h>
 
 namespace nctl {
@@ -14,19 +15,22 @@ uint64_t fasthash_mix(uint64_t h)
 uint64_t fasthash64(const void *buf, size_t len, uint64_t seed)
 {
 	const uint64_t m = 0x880355f21e6d1965ULL;
-	const uint64_t *pos = reinterpret_cast<const uint64_t *>(buf);
-	const uint64_t *end = pos + (len / 8);
+	const unsigned char *pos = static_cast<const unsigned char *>(buf);
+	const unsigned char *end = pos + (len / 8) * 8;
 	uint64_t h = seed ^ (len * m);
 	uint64_t v = 0;
 
-	while (pos <= end)
+	// Only the full words are read, the remaining bytes are mixed afterwards
+	while (pos != end)
 	{
-		v = *pos++;
+		// Copying the word supports data that is not 8 bytes aligned
+		memcpy(&v, pos, sizeof(uint64_t));
+		pos += sizeof(uint64_t);
 		h ^= fasthash_mix(v);
 		h *= m;
 	}
 
-	const unsigned char *pos2 = reinterpret_cast<const unsigned char *>(pos);
+	const unsigned char *pos2 = pos;
 	v = 0;
 
 	switch (len & 7)
@@ -10,7 +10,7 @@ namespace ncine {
 
 BaseSprite::BaseSprite(SceneNode *parent, Texture *texture, float xx, float yy)
     : DrawableNode(parent, xx, yy), texture_(texture), texRect_(0, 0, 0, 0),
-      flippedX_(false), flippedY_(false), instanceBlock_(nullptr)
+      flippedX_(false), flippedY_(false), colorUniform_(nullptr), spriteSizeUniform_(nullptr), texRectUniform_(nullptr)
 {
 	renderCommand_->material().setBlendingEnabled(true);
 }
@@ -36,6 +36,7 @@ void BaseSprite::setSize(float width, float height)
 	height_ = height;
 	dirtyBits_.set(DirtyBitPositions::SizeBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 /*! \note If you set a texture that is already assigned, this method would be equivalent to `resetTexture()` */
@@ -104,7 +105,7 @@ void BaseSprite::setFlippedY(bool flippedY)
 
 BaseSprite::BaseSprite(const BaseSprite &other)
     : DrawableNode(other), texture_(other.texture_), texRect_(other.texRect_),
-      flippedX_(other.flippedX_), flippedY_(other.flippedY_), instanceBlock_(nullptr)
+      flippedX_(other.flippedX_), flippedY_(other.flippedY_), colorUniform_(nullptr), spriteSizeUniform_(nullptr), texRectUniform_(nullptr)
 {
 }
 
@@ -115,7 +116,10 @@ BaseSprite::BaseSprite(const BaseSprite &other)
 void BaseSprite::shaderHasChanged()
 {
 	renderCommand_->material().reserveUniformsDataMemory();
-	instanceBlock_ = renderCommand_->material().uniformBlock(Material::InstanceBlockName);
+	GLUniformBlockCache *instanceBlock = renderCommand_->material().uniformBlock(Material::InstanceBlockName);
+	colorUniform_ = instanceBlock ? instanceBlock->uniformHandle(Material::ColorUniformName, GL_FLOAT_VEC4) : nullptr;
+	spriteSizeUniform_ = instanceBlock ? instanceBlock->uniformHandle(Material::SpriteSizeUniformName, GL_FLOAT_VEC2) : nullptr;
+	texRectUniform_ = instanceBlock ? instanceBlock->uniformHandle(Material::TexRectUniformName, GL_FLOAT_VEC4) : nullptr;
 	GLUniformCache *textureUniform = renderCommand_->material().uniform(Material::TextureUniformName);
 	if (textureUniform && textureUniform->intValue(0) != 0)
 		textureUniform->setIntValue(0); // GL_TEXTURE0
@@ -137,16 +141,14 @@ void BaseSprite::updateRenderCommand()
 	}
 	if (dirtyBits_.test(DirtyBitPositions::ColorBit))
 	{
-		GLUniformCache *colorUniform = instanceBlock_->uniform(Material::ColorUniformName);
-		if (colorUniform)
-			colorUniform->setFloatVector(Colorf(absColor()).data());
+		if (colorUniform_)
+			colorUniform_->storeFloatVector(Colorf(absColor()).data(), 4);
 		dirtyBits_.reset(DirtyBitPositions::ColorBit);
 	}
 	if (dirtyBits_.test(DirtyBitPositions::SizeBit))
 	{
-		GLUniformCache *spriteSizeUniform = instanceBlock_->uniform(Material::SpriteSizeUniformName);
-		if (spriteSizeUniform)
-			spriteSizeUniform->setFloatValue(width_, height_);
+		if (spriteSizeUniform_)
+			spriteSizeUniform_->storeFloatValue(width_, height_);
 		dirtyBits_.reset(DirtyBitPositions::SizeBit);
 	}
 
@@ -156,8 +158,7 @@ void BaseSprite::updateRenderCommand()
 		{
 			renderCommand_->material().setTexture(*texture_);
 
-			GLUniformCache *texRectUniform = instanceBlock_->uniform(Material::TexRectUniformName);
-			if (texRectUniform)
+			if (texRectUniform_)
 			{
 				const Vector2i texSize = texture_->size();
 				const float texScaleX = texRect_.w / float(texSize.x);
@@ -165,7 +166,7 @@ void BaseSprite::updateRenderCommand()
 				const float texScaleY = texRect_.h / float(texSize.y);
 				const float texBiasY = texRect_.y / float(texSize.y);
 
-				texRectUniform->setFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
+				texRectUniform_->storeFloatValue(texScaleX, texBiasX, texScaleY, texBiasY);
 			}
 		}
 		else
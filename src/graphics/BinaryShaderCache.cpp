@@ -0,0 +1,266 @@
+#include <cstring> // for strlen()
+#include <nctl/HashFunctions.h>
+#include "common_macros.h"
+#include "BinaryShaderCache.h"
+#include "GLShader.h"
+#include "IFile.h"
+#include "FileSystem.h"
+#include "ServiceLocator.h"
+#include "tracy.h"
+
+namespace ncine {
+
+namespace {
+
+	/// The characters at the start of every cache file
+	const uint32_t Signature = 0x4253434E; // "NCSB" in little endian
+	/// The size of the file header: signature, version, device hash, sources hash, binary format and binary length
+	const unsigned int HeaderSize = 4 + 4 + 8 + 8 + 4 + 4;
+	const char *FileExtension = "bin";
+
+	uint64_t hashString(const unsigned char *string, uint64_t seed)
+	{
+		if (string == nullptr)
+			return seed;
+		return nctl::fasthash64(string, strlen(reinterpret_cast<const char *>(string)), seed);
+	}
+
+	bool isProgramBinarySupported()
+	{
+#if defined(__EMSCRIPTEN__)
+		// WebGL does not expose program binaries
+		return false;
+#else
+		const IGfxCapabilities &gfxCaps = theServiceLocator().gfxCapabilities();
+		const int majorVersion = gfxCaps.glVersion(IGfxCapabilities::GLVersion::MAJOR);
+		const int minorVersion = gfxCaps.glVersion(IGfxCapabilities::GLVersion::MINOR);
+	#if defined(WITH_OPENGLES)
+		const bool hasProgramBinary = (majorVersion >= 3);
+	#else
+		const bool hasProgramBinary = (majorVersion > 4 || (majorVersion == 4 && minorVersion >= 1)) ||
+		                              gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::ARB_GET_PROGRAM_BINARY);
+	#endif
+		if (hasProgramBinary == false)
+			return false;
+
+		// Some drivers support the functions but no binary format at all
+		GLint numFormats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+		return (numFormats > 0);
+#endif
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+BinaryShaderCache::BinaryShaderCache(const char *directory)
+    : isAvailable_(false), deviceHash_(0), directory_(directory)
+{
+	ZoneScoped;
+	ASSERT(directory);
+
+	if (isProgramBinarySupported() == false)
+	{
+		LOGI("Program binaries are not supported, the binary shader cache is disabled");
+		return;
+	}
+
+	// The save path itself might not exist yet
+	const nctl::String parentDirectory = fs::dirName(directory_.data());
+	if (fs::isDirectory(parentDirectory.data()) == false)
+		fs::createDir(parentDirectory.data());
+
+	if (fs::isDirectory(directory_.data()) == false && fs::createDir(directory_.data()) == false)
+	{
+		LOGW_X("Cannot create the binary shader cache directory: \"%s\"", directory_.data());
+		return;
+	}
+
+	const IGfxCapabilities::GlInfoStrings &infoStrings = theServiceLocator().gfxCapabilities().glInfoStrings();
+	deviceHash_ = hashString(infoStrings.vendor, Version);
+	deviceHash_ = hashString(infoStrings.renderer, deviceHash_);
+	deviceHash_ = hashString(infoStrings.glVersion, deviceHash_);
+	deviceHash_ = hashString(reinterpret_cast<const unsigned char *>(GLShader::sourcePatchLines()), deviceHash_);
+
+	isAvailable_ = true;
+	const unsigned int numPrunedFiles = pruneStaleFiles();
+	if (numPrunedFiles > 0)
+		LOGI_X("Deleted %u binary shaders saved for a different device or driver", numPrunedFiles);
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+uint64_t BinaryShaderCache::hashSources(const char *vertexSource, const char *fragmentSource) const
+{
+	ASSERT(vertexSource);
+	ASSERT(fragmentSource);
+
+	uint64_t hash = nctl::fasthash64(vertexSource, strlen(vertexSource), deviceHash_);
+	hash = nctl::fasthash64(fragmentSource, strlen(fragmentSource), hash);
+	// Zero is reserved to mark a program that is not going to be saved
+	return (hash != 0) ? hash : 1;
+}
+
+bool BinaryShaderCache::loadFromCache(GLuint glHandle, uint64_t hash)
+{
+#if defined(__EMSCRIPTEN__)
+	return false;
+#else
+	if (isAvailable_ == false)
+		return false;
+
+	ZoneScoped;
+	const nctl::String filename = cacheFilename(hash);
+	if (fs::isFile(filename.data()) == false)
+		return false;
+
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(filename.data());
+	fileHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+	if (fileHandle->isOpened() == false)
+		return false;
+
+	uint32_t signature = 0;
+	uint32_t version = 0;
+	uint64_t deviceHash = 0;
+	uint64_t sourcesHash = 0;
+	uint32_t binaryFormat = 0;
+	uint32_t binaryLength = 0;
+	fileHandle->read(&signature, sizeof(uint32_t));
+	fileHandle->read(&version, sizeof(uint32_t));
+	fileHandle->read(&deviceHash, sizeof(uint64_t));
+	fileHandle->read(&sourcesHash, sizeof(uint64_t));
+	fileHandle->read(&binaryFormat, sizeof(uint32_t));
+	fileHandle->read(&binaryLength, sizeof(uint32_t));
+
+	// A truncated file is detected by comparing the binary length with the size of the file
+	bool isValid = (signature == Signature && version == Version && deviceHash == deviceHash_ && sourcesHash == hash &&
+	                binaryLength > 0 && static_cast<unsigned long int>(fileHandle->size()) == HeaderSize + binaryLength);
+
+	if (isValid)
+	{
+		nctl::UniquePtr<uint8_t[]> binary = nctl::makeUnique<uint8_t[]>(binaryLength);
+		isValid = (fileHandle->read(binary.get(), binaryLength) == binaryLength);
+		fileHandle->close();
+
+		if (isValid)
+		{
+			glProgramBinary(glHandle, static_cast<GLenum>(binaryFormat), binary.get(), static_cast<GLsizei>(binaryLength));
+			GLint status = GL_FALSE;
+			glGetProgramiv(glHandle, GL_LINK_STATUS, &status);
+			isValid = (status == GL_TRUE);
+		}
+	}
+	else
+		fileHandle->close();
+
+	if (isValid == false)
+	{
+		LOGW_X("The binary shader \"%s\" has been rejected", filename.data());
+		fs::deleteFile(filename.data());
+		statistics_.numRejected++;
+		return false;
+	}
+
+	statistics_.numLoaded++;
+	return true;
+#endif
+}
+
+bool BinaryShaderCache::saveToCache(GLuint glHandle, uint64_t hash)
+{
+#if defined(__EMSCRIPTEN__)
+	return false;
+#else
+	if (isAvailable_ == false)
+		return false;
+
+	ZoneScoped;
+	GLint length = 0;
+	glGetProgramiv(glHandle, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return false;
+
+	nctl::UniquePtr<uint8_t[]> binary = nctl::makeUnique<uint8_t[]>(length);
+	GLsizei binaryLength = 0;
+	GLenum format = GL_NONE;
+	glGetProgramBinary(glHandle, length, &binaryLength, &format, binary.get());
+	if (binaryLength <= 0)
+		return false;
+
+	const nctl::String filename = cacheFilename(hash);
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(filename.data());
+	fileHandle->open(IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+	if (fileHandle->isOpened() == false)
+		return false;
+
+	const uint32_t version = Version;
+	const uint32_t binaryFormat = static_cast<uint32_t>(format);
+	const uint32_t length32 = static_cast<uint32_t>(binaryLength);
+	unsigned long int bytesWritten = 0;
+	bytesWritten += fileHandle->write(&Signature, sizeof(uint32_t));
+	bytesWritten += fileHandle->write(&version, sizeof(uint32_t));
+	bytesWritten += fileHandle->write(&deviceHash_, sizeof(uint64_t));
+	bytesWritten += fileHandle->write(&hash, sizeof(uint64_t));
+	bytesWritten += fileHandle->write(&binaryFormat, sizeof(uint32_t));
+	bytesWritten += fileHandle->write(&length32, sizeof(uint32_t));
+	bytesWritten += fileHandle->write(binary.get(), length32);
+	fileHandle->close();
+
+	if (bytesWritten != HeaderSize + length32)
+	{
+		LOGW_X("Cannot write the binary shader \"%s\"", filename.data());
+		fs::deleteFile(filename.data());
+		return false;
+	}
+
+	statistics_.numSaved++;
+	return true;
+#endif
+}
+
+bool BinaryShaderCache::removeFromCache(uint64_t hash)
+{
+	if (isAvailable_ == false)
+		return false;
+
+	const nctl::String filename = cacheFilename(hash);
+	return (fs::isFile(filename.data()) && fs::deleteFile(filename.data()));
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::String BinaryShaderCache::cacheFilename(uint64_t hash) const
+{
+	nctl::String filename(fs::MaxPathLength);
+	filename.format("%016llx_%016llx.%s", static_cast<unsigned long long>(deviceHash_), static_cast<unsigned long long>(hash), FileExtension);
+	return fs::joinPath(directory_, filename);
+}
+
+unsigned int BinaryShaderCache::pruneStaleFiles()
+{
+	nctl::String devicePrefix(32);
+	devicePrefix.format("%016llx_", static_cast<unsigned long long>(deviceHash_));
+
+	unsigned int numPrunedFiles = 0;
+	fs::Directory dir(directory_.data());
+	while (const char *entryName = dir.readNext())
+	{
+		if (fs::hasExtension(entryName, FileExtension) && strncmp(entryName, devicePrefix.data(), devicePrefix.length()) != 0)
+		{
+			if (fs::deleteFile(fs::joinPath(directory_, entryName).data()))
+				numPrunedFiles++;
+		}
+	}
+	dir.close();
+
+	return numPrunedFiles;
+}
+
+}
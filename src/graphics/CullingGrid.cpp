@@ -0,0 +1,215 @@
+#include <cmath> // for floorf()
+#include "CullingGrid.h"
+#include "DrawableNode.h"
+#include "tracy.h"
+
+namespace ncine {
+
+namespace {
+
+	/// Keeping cell coordinates far from the integer limits, so that ranges do not overflow
+	const float MaxCellCoordinate = 1.0e9f;
+
+	int cellCoordinate(float value)
+	{
+		const float coordinate = floorf(value);
+		if (coordinate > MaxCellCoordinate)
+			return static_cast<int>(MaxCellCoordinate);
+		else if (coordinate < -MaxCellCoordinate)
+			return static_cast<int>(-MaxCellCoordinate);
+		return static_cast<int>(coordinate);
+	}
+
+	void removePointer(nctl::Array<DrawableNode *> &array, const DrawableNode *node)
+	{
+		for (unsigned int i = 0; i < array.size(); i++)
+		{
+			if (array[i] == node)
+			{
+				array.unorderedRemoveAt(i);
+				break;
+			}
+		}
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+CullingGrid::CullingGrid(float cellSize)
+    : cellSize_(cellSize), invCellSize_(1.0f / cellSize),
+      buckets_(NumBuckets), oversizedNodes_(16), queuedNodes_(64)
+{
+	FATAL_ASSERT(cellSize > 0.0f);
+	static_assert((NumBuckets & (NumBuckets - 1)) == 0, "The number of buckets should be a power of two");
+	buckets_.setSize(NumBuckets);
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void CullingGrid::nodeHasTransformed(SceneNode &node)
+{
+	if (node.type() == Object::ObjectType::SCENENODE || node.type() == Object::ObjectType::PARTICLE_SYSTEM ||
+	    node.dirtyBits_.test(SceneNode::DirtyBitPositions::AabbBit) == false)
+	{
+		return;
+	}
+
+	DrawableNode &drawable = static_cast<DrawableNode &>(node);
+	drawable.updateAabb();
+	drawable.dirtyBits_.reset(SceneNode::DirtyBitPositions::AabbBit);
+
+	// A node is only transformed by one thread, the flag does not need to be protected
+	if (drawable.inGridQueue_ == false)
+	{
+		drawable.inGridQueue_ = true;
+#ifdef WITH_THREADS
+		queueMutex_.lock();
+#endif
+		queuedNodes_.pushBack(&drawable);
+#ifdef WITH_THREADS
+		queueMutex_.unlock();
+#endif
+	}
+}
+
+void CullingGrid::updateCells()
+{
+	if (queuedNodes_.isEmpty())
+		return;
+
+	ZoneScoped;
+	for (DrawableNode *node : queuedNodes_)
+	{
+		node->inGridQueue_ = false;
+
+		const Recti cells = cellsRange(node->aabb_);
+		const bool isOversized = (static_cast<long>(cells.w) * cells.h > MaxCellsPerNode);
+		if (isOversized)
+		{
+			if (node->inGridOversized_)
+				continue;
+
+			removeFromCells(*node);
+			node->inGridOversized_ = true;
+			oversizedNodes_.pushBack(node);
+		}
+		else
+		{
+			if (node->inGridOversized_)
+			{
+				removePointer(oversizedNodes_, node);
+				node->inGridOversized_ = false;
+			}
+			else if (node->gridCells_ == cells)
+				continue;
+			else
+				removeFromCells(*node);
+
+			insertNode(*node, cells);
+		}
+	}
+	queuedNodes_.clear();
+}
+
+void CullingGrid::markOverlappingNodes(const Rectf &rect, unsigned long int frame)
+{
+	ZoneScoped;
+
+	const Recti cells = cellsRange(rect);
+	if (static_cast<long>(cells.w) * cells.h >= NumBuckets)
+	{
+		// Every bucket would be visited at least once
+		for (nctl::Array<DrawableNode *> &bucket : buckets_)
+		{
+			for (DrawableNode *node : bucket)
+				markIfOverlapping(node, rect, frame);
+		}
+	}
+	else
+	{
+		// Nodes of other cells mapped to the same bucket are filtered out by the overlap test
+		for (int y = cells.y; y < cells.y + cells.h; y++)
+		{
+			for (int x = cells.x; x < cells.x + cells.w; x++)
+			{
+				for (DrawableNode *node : buckets_[bucketIndex(x, y)])
+					markIfOverlapping(node, rect, frame);
+			}
+		}
+	}
+
+	for (DrawableNode *node : oversizedNodes_)
+		markIfOverlapping(node, rect, frame);
+}
+
+void CullingGrid::removeNode(DrawableNode &node)
+{
+	removeFromCells(node);
+	if (node.inGridOversized_)
+	{
+		removePointer(oversizedNodes_, &node);
+		node.inGridOversized_ = false;
+	}
+	if (node.inGridQueue_)
+	{
+		removePointer(queuedNodes_, &node);
+		node.inGridQueue_ = false;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+Recti CullingGrid::cellsRange(const Rectf &rect) const
+{
+	const Vector2f rectMin = rect.min();
+	const Vector2f rectMax = rect.max();
+
+	const int minX = cellCoordinate(rectMin.x * invCellSize_);
+	const int minY = cellCoordinate(rectMin.y * invCellSize_);
+	const int maxX = cellCoordinate(rectMax.x * invCellSize_);
+	const int maxY = cellCoordinate(rectMax.y * invCellSize_);
+
+	return Recti(minX, minY, maxX - minX + 1, maxY - minY + 1);
+}
+
+void CullingGrid::markIfOverlapping(DrawableNode *node, const Rectf &rect, unsigned long int frame)
+{
+	if (node->lastFrameRendered_ < frame && node->aabb_.overlaps(rect))
+		node->lastFrameRendered_ = frame;
+}
+
+unsigned int CullingGrid::bucketIndex(int cellX, int cellY)
+{
+	const unsigned int hash = (static_cast<unsigned int>(cellX) * 73856093u) ^ (static_cast<unsigned int>(cellY) * 19349663u);
+	return hash & (NumBuckets - 1);
+}
+
+void CullingGrid::insertNode(DrawableNode &node, const Recti &cells)
+{
+	for (int y = cells.y; y < cells.y + cells.h; y++)
+	{
+		for (int x = cells.x; x < cells.x + cells.w; x++)
+			buckets_[bucketIndex(x, y)].pushBack(&node);
+	}
+	node.gridCells_ = cells;
+}
+
+void CullingGrid::removeFromCells(DrawableNode &node)
+{
+	const Recti &cells = node.gridCells_;
+	for (int y = cells.y; y < cells.y + cells.h; y++)
+	{
+		for (int x = cells.x; x < cells.x + cells.w; x++)
+			removePointer(buckets_[bucketIndex(x, y)], &node);
+	}
+	node.gridCells_.set(0, 0, 0, 0);
+}
+
+}
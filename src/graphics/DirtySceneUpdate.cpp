@@ -0,0 +1,195 @@
+#include "DirtySceneUpdate.h"
+#include "SceneNode.h"
+#include "Application.h"
+#include "tracy.h"
+
+namespace ncine {
+
+namespace {
+
+	void removePointer(nctl::Array<SceneNode *> &array, const SceneNode *node)
+	{
+		for (unsigned int i = 0; i < array.size(); i++)
+		{
+			if (array[i] == node)
+			{
+				array.unorderedRemoveAt(i);
+				break;
+			}
+		}
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+DirtySceneUpdate::DirtySceneUpdate()
+    : dirtyNodes_(256), subtreeRoots_(256), everyFrameNodes_(32)
+{
+	ASSERT(SceneNode::dirtyUpdate_ == nullptr);
+	SceneNode::dirtyUpdate_ = this;
+}
+
+DirtySceneUpdate::~DirtySceneUpdate()
+{
+	// Nodes that outlive this object should not try to remove themselves from the list
+	for (SceneNode *node : dirtyNodes_)
+		node->inDirtyList_ = false;
+	SceneNode::dirtyUpdate_ = nullptr;
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void DirtySceneUpdate::update(SceneNode &rootNode, float interval)
+{
+	ZoneScoped;
+
+	const unsigned long int frame = theApplication().numFrames();
+	// A hierarchy is updated as a whole the first time, as its nodes might have changed before being added to it
+	const bool fullUpdate = (rootNode.lastFrameUpdated_ == 0);
+
+	{
+		ZoneScopedN("Collect subtrees");
+#ifdef WITH_THREADS
+		dirtyNodesMutex_.lock();
+#endif
+		// The flags are still set while collecting, so that the subtrees of other dirty nodes are only updated once
+		subtreeRoots_.clear();
+		unsigned int numKeptNodes = 0;
+		for (unsigned int i = 0; i < dirtyNodes_.size(); i++)
+		{
+			SceneNode *node = dirtyNodes_[i];
+			const NodeState state = nodeState(node, rootNode, true);
+			if (state == NodeState::REACHABLE && fullUpdate == false)
+				subtreeRoots_.pushBack(node);
+			else if (state == NodeState::DETACHED)
+			{
+				// Moving the node before the ones that are being removed from the list
+				dirtyNodes_[i] = dirtyNodes_[numKeptNodes];
+				dirtyNodes_[numKeptNodes++] = node;
+			}
+		}
+
+		for (unsigned int i = numKeptNodes; i < dirtyNodes_.size(); i++)
+			dirtyNodes_[i]->inDirtyList_ = false;
+		dirtyNodes_.setSize(numKeptNodes);
+		// The flag of a subtree root is only reset when it is updated, in case the root is deleted by the update of another node
+		for (SceneNode *node : subtreeRoots_)
+			node->inDirtyList_ = true;
+#ifdef WITH_THREADS
+		dirtyNodesMutex_.unlock();
+#endif
+	}
+
+	// Nodes changed by the `update()` method of other nodes are added to the list again and updated in the next frame
+	if (fullUpdate)
+		rootNode.update(interval);
+	else
+	{
+		ZoneScopedN("Dirty subtrees");
+		for (unsigned int i = 0; i < subtreeRoots_.size(); i++)
+		{
+			SceneNode *node = subtreeRoots_[i];
+			if (node != nullptr)
+			{
+				node->inDirtyList_ = false;
+				node->update(interval);
+			}
+		}
+	}
+
+	{
+		ZoneScopedN("Every frame nodes");
+		for (unsigned int i = 0; i < everyFrameNodes_.size(); i++)
+		{
+			SceneNode *node = everyFrameNodes_[i];
+			// A node might have already been updated as part of a dirty subtree
+			if (node->lastFrameUpdated_ < frame && nodeState(node, rootNode, false) == NodeState::REACHABLE)
+				node->update(interval);
+		}
+	}
+
+	rootNode.lastFrameUpdated_ = frame;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void DirtySceneUpdate::addDirtyNode(SceneNode *node)
+{
+#ifdef WITH_THREADS
+	dirtyNodesMutex_.lock();
+#endif
+	if (node->inDirtyList_ == false)
+	{
+		node->inDirtyList_ = true;
+		dirtyNodes_.pushBack(node);
+	}
+#ifdef WITH_THREADS
+	dirtyNodesMutex_.unlock();
+#endif
+}
+
+void DirtySceneUpdate::removeDirtyNode(SceneNode *node)
+{
+#ifdef WITH_THREADS
+	dirtyNodesMutex_.lock();
+#endif
+	const unsigned int size = dirtyNodes_.size();
+	removePointer(dirtyNodes_, node);
+	if (dirtyNodes_.size() == size)
+	{
+		// The node is a subtree root that has not been updated yet
+		for (unsigned int i = 0; i < subtreeRoots_.size(); i++)
+		{
+			if (subtreeRoots_[i] == node)
+			{
+				subtreeRoots_[i] = nullptr;
+				break;
+			}
+		}
+	}
+	node->inDirtyList_ = false;
+#ifdef WITH_THREADS
+	dirtyNodesMutex_.unlock();
+#endif
+}
+
+void DirtySceneUpdate::addEveryFrameNode(SceneNode *node)
+{
+	everyFrameNodes_.pushBack(node);
+}
+
+void DirtySceneUpdate::removeEveryFrameNode(SceneNode *node)
+{
+	removePointer(everyFrameNodes_, node);
+}
+
+/*! \param coveredByDirtyNodes When `true` a node is also covered by an ancestor in the dirty list, not only by one updated every frame */
+DirtySceneUpdate::NodeState DirtySceneUpdate::nodeState(const SceneNode *node, const SceneNode &rootNode, bool coveredByDirtyNodes) const
+{
+	if (node->updateEnabled_ == false)
+		return NodeState::DISABLED;
+	// A dirty node that is updated every frame does not need to be updated twice
+	if (coveredByDirtyNodes && node->updatedEveryFrame_)
+		return NodeState::COVERED;
+
+	const SceneNode *ancestor = node;
+	while (ancestor->parent_ != nullptr)
+	{
+		ancestor = ancestor->parent_;
+		if (ancestor->updateEnabled_ == false)
+			return NodeState::DISABLED;
+		if (ancestor->updatedEveryFrame_ || (coveredByDirtyNodes && ancestor->inDirtyList_))
+			return NodeState::COVERED;
+	}
+
+	return (ancestor == &rootNode) ? NodeState::REACHABLE : NodeState::DETACHED;
+}
+
+}
@@ -3,9 +3,9 @@
 #include "RenderQueue.h"
 #include "RenderCommand.h"
 #include "RenderResources.h"
+#include "CullingGrid.h"
 #include "Viewport.h"
 #include "Application.h"
-#include "RenderStatistics.h"
 #include "tracy.h"
 
 namespace ncine {
@@ -58,6 +58,13 @@ namespace {
 		return DrawableNode::BlendingFactor::ZERO;
 	}
 
+	void removeFromCullingGrid(DrawableNode &node)
+	{
+		CullingGrid *cullingGrid = RenderResources::cullingGrid();
+		if (cullingGrid)
+			cullingGrid->removeNode(node);
+	}
+
 }
 
 ///////////////////////////////////////////////////////////
@@ -77,7 +84,7 @@ const Vector2f DrawableNode::AnchorTopRight(1.0f, 1.0f);
 DrawableNode::DrawableNode(SceneNode *parent, float xx, float yy)
     : SceneNode(parent, xx, yy), width_(0.0f), height_(0.0f),
       renderCommand_(nctl::makeUnique<RenderCommand>()),
-      lastFrameRendered_(0)
+      lastFrameRendered_(0), inGridOversized_(false), inGridQueue_(false)
 {
 	renderCommand_->setIdSortKey(id());
 }
@@ -97,11 +104,36 @@ DrawableNode::DrawableNode()
 {
 }
 
-DrawableNode::~DrawableNode() = default;
+DrawableNode::~DrawableNode()
+{
+	removeFromCullingGrid(*this);
+}
 
-DrawableNode::DrawableNode(DrawableNode &&) = default;
+DrawableNode::DrawableNode(DrawableNode &&other)
+    : SceneNode(nctl::move(other)), width_(other.width_), height_(other.height_),
+      renderCommand_(nctl::move(other.renderCommand_)), lastFrameRendered_(other.lastFrameRendered_),
+      aabb_(other.aabb_), inGridOversized_(false), inGridQueue_(false)
+{
+	// The culling grid stores node pointers, the new node is placed again by its next update
+	removeFromCullingGrid(other);
+	dirtyBits_.set(DirtyBitPositions::AabbBit);
+}
 
-DrawableNode &DrawableNode::operator=(DrawableNode &&) = default;
+DrawableNode &DrawableNode::operator=(DrawableNode &&other)
+{
+	SceneNode::operator=(nctl::move(other));
+
+	removeFromCullingGrid(*this);
+	removeFromCullingGrid(other);
+	width_ = other.width_;
+	height_ = other.height_;
+	renderCommand_ = nctl::move(other.renderCommand_);
+	lastFrameRendered_ = other.lastFrameRendered_;
+	aabb_ = other.aabb_;
+	dirtyBits_.set(DirtyBitPositions::AabbBit);
+
+	return *this;
+}
 
 ///////////////////////////////////////////////////////////
 // PUBLIC FUNCTIONS
@@ -128,12 +160,18 @@ bool DrawableNode::draw(RenderQueue &renderQueue)
 	{
 		renderCommand_->setLayer(absLayer_);
 		renderCommand_->setVisitOrder(withVisitOrder_ ? visitOrderIndex_ : 0);
+		// Batches only copy the instance block of commands that have changed since they have been collected
+		if (dirtyBits_.test(DirtyBitPositions::TransformationBit) || dirtyBits_.test(DirtyBitPositions::ColorBit) ||
+		    dirtyBits_.test(DirtyBitPositions::SizeBit) || dirtyBits_.test(DirtyBitPositions::TextureBit))
+		{
+			renderCommand_->setInstanceUpdateFrame(theApplication().numFrames());
+		}
 		updateRenderCommand();
 		renderQueue.addCommand(renderCommand_.get());
 	}
 	else
 	{
-		RenderStatistics::addCulledNode();
+		renderQueue.addCulledNode();
 		return false;
 	}
 
@@ -220,7 +258,7 @@ void DrawableNode::updateAabb()
 	aabb_ = Rectf::fromCenterSize(absPosition_.x, absPosition_.y, rotatedWidth, rotatedHeight);
 }
 
-void DrawableNode::updateCulling()
+void DrawableNode::updateCulling(unsigned long int frame)
 {
 	const bool cullingEnabled = theApplication().renderingSettings().cullingEnabled;
 	if (drawEnabled_ && cullingEnabled && width_ > 0 && height_ > 0)
@@ -232,12 +270,12 @@ void DrawableNode::updateCulling()
 		}
 
 		// Check if at least one viewport in the chain overlaps with this node
-		if (lastFrameRendered_ < theApplication().numFrames())
+		if (lastFrameRendered_ < frame)
 		{
 			const Viewport *viewport = RenderResources::currentViewport();
 			const bool overlaps = aabb_.overlaps(viewport->cullingRect());
 			if (overlaps)
-				lastFrameRendered_ = theApplication().numFrames();
+				lastFrameRendered_ = frame;
 		}
 	}
 }
@@ -246,7 +284,7 @@ DrawableNode::DrawableNode(const DrawableNode &other)
     : SceneNode(other),
       width_(other.width_), height_(other.height_),
       renderCommand_(nctl::makeUnique<RenderCommand>()),
-      lastFrameRendered_(0)
+      lastFrameRendered_(0), inGridOversized_(false), inGridQueue_(false)
 {
 	renderCommand_->setIdSortKey(id());
 	setBlendingEnabled(other.isBlendingEnabled());
@@ -15,7 +15,7 @@ Geometry::Geometry()
       hostVertexPointer_(nullptr), hostIndexPointer_(nullptr),
       vboUsageFlags_(0), sharedVboParams_(nullptr),
       iboUsageFlags_(0), sharedIboParams_(nullptr),
-      hasDirtyVertices_(true), hasDirtyIndices_(true)
+      hasDirtyVertices_(true), hasDirtyIndices_(true), hasInstancedVertices_(false)
 {
 }
 
@@ -201,7 +201,8 @@ void Geometry::bind()
 
 void Geometry::draw(GLsizei numInstances)
 {
-	const GLint vboOffset = static_cast<GLint>(vboParams().offset / numElementsPerVertex_ / sizeof(GLfloat)) + firstVertex_;
+	// Instanced vertex data is offset by the attribute pointers, as the first vertex would only shift `gl_VertexID`
+	const GLint vboOffset = hasInstancedVertices_ ? firstVertex_ : static_cast<GLint>(vboParams().offset / numElementsPerVertex_ / sizeof(GLfloat)) + firstVertex_;
 
 	void *iboOffsetPtr = nullptr;
 	if (numIndices_ > 0)
@@ -231,13 +232,14 @@ void Geometry::draw(GLsizei numInstances)
 	}
 }
 
-void Geometry::commitVertices()
+/*! \param numInstances The number of instances to copy, used instead of the number of vertices when the vertex data is read once per instance */
+void Geometry::commitVertices(GLsizei numInstances)
 {
 	if (hostVertexPointer_ && hasDirtyVertices_)
 	{
 		// Checking if the common VBO is allowed to use mapping and do the same for the custom one
 		const GLenum mapFlags = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::ARRAY).mapFlags;
-		const unsigned int numFloats = numVertices_ * numElementsPerVertex_;
+		const unsigned int numFloats = (hasInstancedVertices_ ? numInstances : numVertices_) * numElementsPerVertex_;
 
 		if (mapFlags == 0 && vbo_)
 		{
@@ -93,13 +93,13 @@ void GfxCapabilities::init()
 
 #ifndef __EMSCRIPTEN__
 	const char *extensionNames[GLExtensions::COUNT] = {
-		"GL_KHR_debug", "GL_ARB_texture_storage", "GL_EXT_texture_compression_s3tc", "GL_OES_compressed_ETC1_RGB8_texture",
-		"GL_AMD_compressed_ATC_texture", "GL_IMG_texture_compression_pvrtc", "GL_KHR_texture_compression_astc_ldr"
+		"GL_KHR_debug", "GL_ARB_texture_storage", "GL_ARB_buffer_storage", "GL_EXT_texture_compression_s3tc", "GL_OES_compressed_ETC1_RGB8_texture",
+		"GL_AMD_compressed_ATC_texture", "GL_IMG_texture_compression_pvrtc", "GL_KHR_texture_compression_astc_ldr", "GL_ARB_get_program_binary", "GL_KHR_parallel_shader_compile"
 	};
 #else
 	const char *extensionNames[GLExtensions::COUNT] = {
-		"GL_KHR_debug", "GL_ARB_texture_storage", "WEBGL_compressed_texture_s3tc", "WEBGL_compressed_texture_etc1",
-		"WEBGL_compressed_texture_atc", "WEBGL_compressed_texture_pvrtc", "WEBGL_compressed_texture_astc"
+		"GL_KHR_debug", "GL_ARB_texture_storage", "GL_ARB_buffer_storage", "WEBGL_compressed_texture_s3tc", "WEBGL_compressed_texture_etc1",
+		"WEBGL_compressed_texture_atc", "WEBGL_compressed_texture_pvrtc", "WEBGL_compressed_texture_astc", "GL_ARB_get_program_binary", "KHR_parallel_shader_compile"
 	};
 #endif
 
@@ -147,11 +147,14 @@ void GfxCapabilities::logGLCaps() const
 	LOGI("---");
 	LOGI_X("GL_KHR_debug: %d", glExtensions_[GLExtensions::KHR_DEBUG]);
 	LOGI_X("GL_ARB_texture_storage: %d", glExtensions_[GLExtensions::ARB_TEXTURE_STORAGE]);
+	LOGI_X("GL_ARB_buffer_storage: %d", glExtensions_[GLExtensions::ARB_BUFFER_STORAGE]);
 	LOGI_X("GL_EXT_texture_compression_s3tc: %d", glExtensions_[GLExtensions::EXT_TEXTURE_COMPRESSION_S3TC]);
 	LOGI_X("GL_OES_compressed_ETC1_RGB8_texture: %d", glExtensions_[GLExtensions::OES_COMPRESSED_ETC1_RGB8_TEXTURE]);
 	LOGI_X("GL_AMD_compressed_ATC_texture: %d", glExtensions_[GLExtensions::AMD_COMPRESSED_ATC_TEXTURE]);
 	LOGI_X("GL_IMG_texture_compression_pvrtc: %d", glExtensions_[GLExtensions::IMG_TEXTURE_COMPRESSION_PVRTC]);
 	LOGI_X("GL_KHR_texture_compression_astc_ldr: %d", glExtensions_[GLExtensions::KHR_TEXTURE_COMPRESSION_ASTC_LDR]);
+	LOGI_X("GL_ARB_get_program_binary: %d", glExtensions_[GLExtensions::ARB_GET_PROGRAM_BINARY]);
+	LOGI_X("GL_KHR_parallel_shader_compile: %d", glExtensions_[GLExtensions::KHR_PARALLEL_SHADER_COMPILE]);
 	LOGI("--- OpenGL device capabilities ---");
 }
 
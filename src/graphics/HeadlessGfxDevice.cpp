@@ -0,0 +1,86 @@
+#include "HeadlessGfxDevice.h"
+#include "HeadlessGL.h"
+#include "Application.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+HeadlessGfxDevice::HeadlessGfxDevice(const WindowMode &windowMode, const GLContextInfo &glContextInfo, const DisplayMode &displayMode)
+    : IGfxDevice(windowMode, glContextInfo, displayMode), windowPosition_(0, 0)
+{
+	initWindowScaling(windowMode);
+
+	// Asking for a video mode that does not change the resolution of the virtual monitor
+	if (width_ <= 0 || height_ <= 0 || isFullScreen_)
+	{
+		width_ = DefaultWidth;
+		height_ = DefaultHeight;
+		isFullScreen_ = true;
+	}
+
+	if (windowMode.windowPositionX != AppConfiguration::WindowPositionIgnore)
+		windowPosition_.x = windowMode.windowPositionX;
+	if (windowMode.windowPositionY != AppConfiguration::WindowPositionIgnore)
+		windowPosition_.y = windowMode.windowPositionY;
+
+	drawableWidth_ = width_;
+	drawableHeight_ = height_;
+	initGLViewport();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void HeadlessGfxDevice::setWindowSize(int width, int height)
+{
+	// Change resolution only in case it is valid and it really changes
+	if (width <= 0 || height <= 0 || isFullScreen_ || (width == width_ && height == height_))
+		return;
+
+	width_ = width;
+	height_ = height;
+	drawableWidth_ = width;
+	drawableHeight_ = height;
+	theApplication().resizeScreenViewport(width, height);
+}
+
+const IGfxDevice::VideoMode &HeadlessGfxDevice::currentVideoMode(unsigned int monitorIndex) const
+{
+	currentVideoMode_ = monitors_[0].videoModes[0];
+	return currentVideoMode_;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void HeadlessGfxDevice::updateMonitors()
+{
+	numMonitors_ = 1;
+
+	Monitor &monitor = monitors_[0];
+	monitor.name = "Headless";
+	monitor.position.set(0, 0);
+	monitor.scale.set(1.0f, 1.0f);
+	monitor.dpi.set(static_cast<int>(DefaultDpi), static_cast<int>(DefaultDpi));
+
+	monitor.numVideoModes = 1;
+	VideoMode &videoMode = monitor.videoModes[0];
+	videoMode.width = DefaultWidth;
+	videoMode.height = DefaultHeight;
+	videoMode.refreshRate = static_cast<float>(DefaultRefreshRate);
+	videoMode.redBits = displayMode_.redBits();
+	videoMode.greenBits = displayMode_.greenBits();
+	videoMode.blueBits = displayMode_.blueBits();
+}
+
+void HeadlessGfxDevice::update()
+{
+	HeadlessGL::endFrame();
+}
+
+}
@@ -22,13 +22,13 @@ namespace ncine {
 
 ITextureLoader::ITextureLoader()
     : hasLoaded_(false), width_(0), height_(0),
-      headerSize_(0), dataSize_(0), mipMapCount_(1)
+      headerSize_(0), dataSize_(0), mipMapCount_(1), inPlacePixels_(nullptr)
 {
 }
 
 ITextureLoader::ITextureLoader(nctl::UniquePtr<IFile> fileHandle)
     : hasLoaded_(false), fileHandle_(nctl::move(fileHandle)),
-      width_(0), height_(0), headerSize_(0), dataSize_(0), mipMapCount_(1)
+      width_(0), height_(0), headerSize_(0), dataSize_(0), mipMapCount_(1), inPlacePixels_(nullptr)
 {
 }
 
@@ -51,13 +51,14 @@ long ITextureLoader::dataSize(unsigned int mipMapLevel) const
 const GLubyte *ITextureLoader::pixels(unsigned int mipMapLevel) const
 {
 	const GLubyte *pixels = nullptr;
+	const GLubyte *basePixels = this->pixels();
 
-	if (pixels_ != nullptr)
+	if (basePixels != nullptr)
 	{
 		if (mipMapCount_ > 1 && int(mipMapLevel) < mipMapCount_)
-			pixels = pixels_.get() + mipDataOffsets_[mipMapLevel];
+			pixels = basePixels + mipDataOffsets_[mipMapLevel];
 		else if (mipMapLevel == 0)
-			pixels = pixels_.get();
+			pixels = basePixels;
 	}
 
 	return pixels;
@@ -72,8 +73,8 @@ nctl::UniquePtr<ITextureLoader> ITextureLoader::createFromMemory(const char *buf
 nctl::UniquePtr<ITextureLoader> ITextureLoader::createFromFile(const char *filename)
 {
 	LOGI_X("Loading file: \"%s\"", filename);
-	// Creating a handle from IFile static method to detect assets file
-	return createLoader(nctl::move(IFile::createFileHandle(filename)), filename);
+	// Creating a handle from IFile static method to detect assets file, standard files are mapped in memory
+	return createLoader(nctl::move(IFile::createMappedFileHandle(filename)), filename);
 }
 
 ///////////////////////////////////////////////////////////
@@ -126,10 +127,16 @@ void ITextureLoader::loadPixels(GLenum internalFormat, GLenum type)
 		fileHandle_->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
 
 	dataSize_ = fileHandle_->size() - headerSize_;
-	fileHandle_->seek(headerSize_, SEEK_SET);
 
-	pixels_ = nctl::makeUnique<unsigned char[]>(dataSize_);
-	fileHandle_->read(pixels_.get(), dataSize_);
+	// Data is already in the format expected by OpenGL, it is uploaded straight from the file contents if they are in memory
+	if (fileHandle_->data() != nullptr)
+		inPlacePixels_ = fileHandle_->data() + headerSize_;
+	else
+	{
+		fileHandle_->seek(headerSize_, SEEK_SET);
+		pixels_ = nctl::makeUnique<unsigned char[]>(dataSize_);
+		fileHandle_->read(pixels_.get(), dataSize_);
+	}
 }
 
 }
@@ -598,11 +598,14 @@ void ImGuiDebugOverlay::guiGraphicsCapabilities()
 		ImGui::Separator();
 		ImGui::Text("GL_KHR_debug: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::KHR_DEBUG));
 		ImGui::Text("GL_ARB_texture_storage: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::ARB_TEXTURE_STORAGE));
+		ImGui::Text("GL_ARB_buffer_storage: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::ARB_BUFFER_STORAGE));
 		ImGui::Text("GL_EXT_texture_compression_s3tc: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::EXT_TEXTURE_COMPRESSION_S3TC));
 		ImGui::Text("GL_OES_compressed_ETC1_RGB8_texture: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::OES_COMPRESSED_ETC1_RGB8_TEXTURE));
 		ImGui::Text("GL_AMD_compressed_ATC_texture: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::AMD_COMPRESSED_ATC_TEXTURE));
 		ImGui::Text("GL_IMG_texture_compression_pvrtc: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::IMG_TEXTURE_COMPRESSION_PVRTC));
 		ImGui::Text("GL_KHR_texture_compression_astc_ldr: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::KHR_TEXTURE_COMPRESSION_ASTC_LDR));
+		ImGui::Text("GL_ARB_get_program_binary: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::ARB_GET_PROGRAM_BINARY));
+		ImGui::Text("GL_KHR_parallel_shader_compile: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::KHR_PARALLEL_SHADER_COMPILE));
 	}
 }
 
@@ -648,11 +651,22 @@ void ImGuiDebugOverlay::guiApplicationConfiguration()
 
 		ImGui::Separator();
 		ImGui::Text("Buffer mapping: %s", appCfg.useBufferMapping ? "true" : "false");
+		ImGui::Text("Persistent mapping: %s", appCfg.usePersistentMapping ? "true" : "false");
+		ImGui::Text("Instanced attributes: %s", appCfg.useInstancedAttributes ? "true" : "false");
 		ImGui::Text("Defer shader queries: %s", appCfg.deferShaderQueries ? "true" : "false");
+		ImGui::Text("Binary shader cache: %s", appCfg.useBinaryShaderCache ? "true" : "false");
+		ImGui::Text("Async shader compilation: %s", appCfg.useAsyncShaderCompilation ? "true" : "false");
 		ImGui::Text("VBO size: %lu", appCfg.vboSize);
 		ImGui::Text("IBO size: %lu", appCfg.iboSize);
 		ImGui::Text("Vao pool size: %u", appCfg.vaoPoolSize);
 		ImGui::Text("RenderCommand pool size: %u", appCfg.renderCommandPoolSize);
+		ImGui::Text("Texture upload budget: %lu", appCfg.textureUploadBudget);
+		ImGui::Text("Parallel update depth: %u", appCfg.parallelUpdateDepth);
+		ImGui::Text("Parallel visit depth: %u", appCfg.parallelVisitDepth);
+		ImGui::Text("Culling grid cell size: %.0f", appCfg.cullingGridCellSize);
+		ImGui::Text("Dirty list update: %s", appCfg.useDirtyListUpdate ? "true" : "false");
+		ImGui::Text("Particle arrays: %s", appCfg.useParticleArrays ? "true" : "false");
+		ImGui::Text("Parallel particles update: %s", appCfg.useParallelParticlesUpdate ? "true" : "false");
 
 		ImGui::Separator();
 		ImGui::Text("Debug Overlay: %s", appCfg.withDebugOverlay ? "true" : "false");
@@ -678,7 +692,9 @@ void ImGuiDebugOverlay::guiRenderingSettings()
 		ImGui::Checkbox("Batching with indices", &settings.batchingWithIndices);
 		ImGui::SameLine();
 		ImGui::Checkbox("Culling", &settings.cullingEnabled);
-		ImGui::DragIntRange2("Batch size", &minBatchSize, &maxBatchSize, 1.0f, 0, 512);
+		// Batches reading instances from vertex attributes are not limited by the size of a uniform block
+		const int maxBatchSizeLimit = theApplication().appConfiguration().useInstancedAttributes ? 4096 : 512;
+		ImGui::DragIntRange2("Batch size", &minBatchSize, &maxBatchSize, 1.0f, 0, maxBatchSizeLimit);
 
 		settings.minBatchSize = minBatchSize;
 		settings.maxBatchSize = maxBatchSize;
@@ -823,7 +839,7 @@ void ImGuiDebugOverlay::guiAudioPlayers()
 		ImGui::Text("Listener Gain: %f", theServiceLocator().audioDevice().gain());
 
 		unsigned int numPlayers = theServiceLocator().audioDevice().numPlayers();
-		ImGui::Text("Active Players: %d", numPlayers);
+		ImGui::Text("Active Players: %d (%u virtual)", numPlayers, theServiceLocator().audioDevice().numVirtualPlayers());
 
 		if (numPlayers > 0)
 		{
@@ -850,6 +866,8 @@ void ImGuiDebugOverlay::guiAudioPlayers()
 				ImGui::NewLine();
 
 				ImGui::Text("State: %s", audioPlayerStateToString(player->state()));
+				ImGui::Text("Virtual: %s", player->isVirtual() ? "true" : "false");
+				ImGui::Text("Priority: %d", player->priority());
 				ImGui::Text("Looping: %s", player->isLooping() ? "true" : "false");
 				ImGui::Text("Gain: %f", player->gain());
 				ImGui::Text("Pitch: %f", player->pitch());
@@ -1516,6 +1534,14 @@ void ImGuiDebugOverlay::guiTopLeft()
 			ImGui::PlotLines("", plotValues_[ValuesType::UBO_USED].get(), numValues_, 0, nullptr, 0.0f, uboBuffers.size / 1024.0f);
 		}
 
+		const unsigned int fenceWaits = vboBuffers.fenceWaits + iboBuffers.fenceWaits + uboBuffers.fenceWaits;
+		if (fenceWaits > 0)
+		{
+			const unsigned int fenceStalls = vboBuffers.fenceStalls + iboBuffers.fenceStalls + uboBuffers.fenceStalls;
+			ImGui::Text("%u/%u buffer fence stalls (VBO %u, IBO %u, UBO %u)", fenceStalls, fenceWaits,
+			            vboBuffers.fenceStalls, iboBuffers.fenceStalls, uboBuffers.fenceStalls);
+		}
+
 		ImGui::Text("Viewport chain length: %u", Viewport::chain().size());
 
 		ImGui::End();
@@ -1,4 +1,5 @@
 #include <cstddef> // for offsetof()
+#include <cstring> // for memset()
 #include "Material.h"
 #include "RenderResources.h"
 #include "GLShaderProgram.h"
@@ -31,6 +32,17 @@ const char *Material::TexCoordsAttributeName = "aTexCoords";
 const char *Material::MeshIndexAttributeName = "aMeshIndex";
 const char *Material::ColorAttributeName = "aColor";
 
+const char *Material::ModelMatrixAttributeNames[NumModelMatrixAttributes] = { "aModelMatrix0", "aModelMatrix1", "aModelMatrix2", "aModelMatrix3" };
+const char *Material::InstanceColorAttributeName = "aInstanceColor";
+const char *Material::InstanceTexRectAttributeName = "aInstanceTexRect";
+const char *Material::InstanceSpriteSizeAttributeName = "aInstanceSpriteSize";
+
+const char *Material::AnchorPointUniformName = "anchorPoint";
+const char *Material::ParticlePositionAttributeName = "aParticlePosition";
+const char *Material::ParticleScaleAttributeName = "aParticleScale";
+const char *Material::ParticleRotationAttributeName = "aParticleRotation";
+const char *Material::ParticleColorAttributeName = "aParticleColor";
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
@@ -42,7 +54,7 @@ Material::Material()
 
 Material::Material(GLShaderProgram *program, GLTexture *texture)
     : isBlendingEnabled_(false), srcBlendingFactor_(GL_SRC_ALPHA), destBlendingFactor_(GL_ONE_MINUS_SRC_ALPHA),
-      shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program), uniformsHostBufferSize_(0)
+      shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program), modelMatrixUniform_(nullptr), uniformsHostBufferSize_(0)
 {
 	for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++)
 		textures_[i] = nullptr;
@@ -85,6 +97,10 @@ void Material::setShaderProgram(GLShaderProgram *program)
 	shaderUniforms_.setProgram(shaderProgram_, nullptr, ProjectionViewMatrixExcludeString);
 	shaderUniformBlocks_.setProgram(shaderProgram_);
 
+	GLUniformBlockCache *instanceBlock = shaderUniformBlocks_.uniformBlock(InstanceBlockName);
+	modelMatrixUniform_ = instanceBlock ? instanceBlock->uniformHandle(ModelMatrixUniformName, GL_FLOAT_MAT4)
+	                                    : shaderUniforms_.uniformHandle(ModelMatrixUniformName, GL_FLOAT_MAT4);
+
 	RenderResources::setDefaultAttributesParameters(*shaderProgram_);
 }
 
@@ -209,7 +225,10 @@ uint32_t Material::sortKey()
 {
 	static const uint32_t Seed = 1697381921;
 	// Align to 64 bits for `fasthash64()` to properly work on Emscripten without alignment faults
-	static SortHashData hashData alignas(8);
+	// Not static, as sort keys can be calculated by more than one thread during a parallel scene visit
+	SortHashData hashData alignas(8);
+	// Padding bytes are part of the hashed data
+	memset(&hashData, 0, sizeof(SortHashData));
 
 	for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++)
 		hashData.textures[i] = (textures_[i] != nullptr) ? textures_[i]->glHandle() : 0;
@@ -88,6 +88,7 @@ void MeshSprite::copyVertices(const MeshSprite &meshSprite)
 
 	dirtyBits_.set(DirtyBitPositions::SizeBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 	dirtyBits_.set(DirtyBitPositions::TextureBit);
 }
 
@@ -125,6 +126,7 @@ void MeshSprite::setVertices(const MeshSprite &meshSprite)
 
 	dirtyBits_.set(DirtyBitPositions::SizeBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 float *MeshSprite::emplaceVertices(unsigned int numElements, unsigned int bytesPerVertex)
@@ -217,6 +219,7 @@ void MeshSprite::createVerticesFromTexels(unsigned int numVertices, const Vector
 
 	dirtyBits_.set(DirtyBitPositions::SizeBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 }
 
 void MeshSprite::createVerticesFromTexels(unsigned int numVertices, const Vector2f *points)
@@ -0,0 +1,114 @@
+#include "ParallelParticlesUpdate.h"
+#include "ParticleSystem.h"
+#include "ServiceLocator.h"
+#include "tracy.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+ParallelParticlesUpdate::ParallelParticlesUpdate()
+    : systems_(16), nextSystem_(0)
+{
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void ParallelParticlesUpdate::begin()
+{
+	ASSERT(ParticleSystem::parallelUpdate_ == nullptr);
+	ASSERT(systems_.isEmpty());
+	ParticleSystem::parallelUpdate_ = this;
+}
+
+void ParallelParticlesUpdate::join()
+{
+	ParticleSystem::parallelUpdate_ = nullptr;
+	if (systems_.isEmpty())
+		return;
+
+	ZoneScoped;
+	// The calling thread runs the updates that no worker thread has started yet
+	for (ParticleSystem *system : systems_)
+	{
+		if (system)
+			system->finishUpdateJob();
+	}
+	// Commands that have not been started are cancelled, the running ones have nothing left to update
+	commandGroup_.wait();
+
+	for (ParticleSystem *system : systems_)
+	{
+		if (system)
+			system->completeUpdateJob();
+	}
+	systems_.clear();
+	nextSystem_ = 0;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool ParallelParticlesUpdate::defer(ParticleSystem &system)
+{
+	IThreadPool &threadPool = theServiceLocator().threadPool();
+	if (threadPool.numThreads() == 0)
+		return false;
+
+	systemsMutex_.lock();
+	systems_.pushBack(&system);
+	systemsMutex_.unlock();
+
+	// Commands do not reference the system, it might be destroyed while they are still in the queue
+	commandGroup_.add(1);
+	threadPool.enqueueCommand(nctl::makeUnique<GroupFunctionCommand>(commandGroup_, updateFunction, this));
+
+	return true;
+}
+
+void ParallelParticlesUpdate::remove(ParticleSystem &system)
+{
+	// No command can claim the update of the system after it has been removed from the array
+	systemsMutex_.lock();
+	for (unsigned int i = 0; i < systems_.size(); i++)
+	{
+		if (systems_[i] == &system)
+		{
+			systems_[i] = nullptr;
+			break;
+		}
+	}
+	systemsMutex_.unlock();
+
+	system.finishUpdateJob();
+}
+
+ParticleSystem *ParallelParticlesUpdate::claimSystem()
+{
+	ParticleSystem *claimedSystem = nullptr;
+
+	systemsMutex_.lock();
+	while (nextSystem_ < systems_.size() && claimedSystem == nullptr)
+	{
+		ParticleSystem *system = systems_[nextSystem_++];
+		if (system && system->claimUpdateJob())
+			claimedSystem = system;
+	}
+	systemsMutex_.unlock();
+
+	return claimedSystem;
+}
+
+void ParallelParticlesUpdate::updateFunction(void *arg)
+{
+	ParallelParticlesUpdate *parallelUpdate = static_cast<ParallelParticlesUpdate *>(arg);
+	while (ParticleSystem *system = parallelUpdate->claimSystem())
+		system->executeUpdateJob();
+}
+
+}
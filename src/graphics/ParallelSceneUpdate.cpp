@@ -0,0 +1,112 @@
+#include "ParallelSceneUpdate.h"
+#include "SceneNode.h"
+#include "ServiceLocator.h"
+#include "tracy.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+ParallelSceneUpdate::ParallelSceneUpdate()
+    : rootNode_(nullptr), splitDepth_(0), interval_(0.0f),
+      subtrees_(64), deferredParents_(16)
+{
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void ParallelSceneUpdate::update(SceneNode &rootNode, float interval, unsigned int splitDepth)
+{
+	ASSERT(SceneNode::parallelUpdate_ == nullptr);
+	ZoneScoped;
+
+	rootNode_ = &rootNode;
+	splitDepth_ = splitDepth;
+	interval_ = interval;
+	subtrees_.clear();
+	deferredParents_.clear();
+
+	// Updating the nodes above the split depth and collecting the subtrees below it
+	{
+		ZoneScopedN("Serial update");
+		SceneNode::parallelUpdate_ = this;
+		rootNode.update(interval);
+		SceneNode::parallelUpdate_ = nullptr;
+	}
+
+	if (subtrees_.isEmpty() == false)
+	{
+		ZoneScopedN("Parallel update");
+		nextSubtree_.store(0);
+
+		IThreadPool &threadPool = theServiceLocator().threadPool();
+		// The calling thread is also updating subtrees
+		const unsigned int maxNumCommands = subtrees_.size() - 1;
+		const unsigned int numCommands = (threadPool.numThreads() < maxNumCommands) ? threadPool.numThreads() : maxNumCommands;
+		commandGroup_.add(numCommands);
+		for (unsigned int i = 0; i < numCommands; i++)
+			threadPool.enqueueCommand(nctl::makeUnique<GroupFunctionCommand>(commandGroup_, updateSubtreesFunction, this));
+
+		updateSubtrees();
+		// Every subtree has been updated, only the commands already started by a worker thread are waited for
+		commandGroup_.wait();
+	}
+
+	// Resetting the dirty bits that have been kept for the deferred children
+	for (SceneNode *node : deferredParents_)
+	{
+		if (node->type_ == Object::ObjectType::SCENENODE)
+		{
+			node->dirtyBits_.reset(SceneNode::DirtyBitPositions::TransformationBit);
+			node->dirtyBits_.reset(SceneNode::DirtyBitPositions::ColorBit);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool ParallelSceneUpdate::deferChildren(SceneNode *node)
+{
+	if (node->children_.isEmpty())
+		return false;
+
+	unsigned int childrenDepth = 1;
+	for (const SceneNode *parent = node; parent != rootNode_ && parent != nullptr; parent = parent->parent_)
+		childrenDepth++;
+
+	if (childrenDepth < splitDepth_)
+		return false;
+
+	for (SceneNode *child : node->children_)
+		subtrees_.pushBack(child);
+	deferredParents_.pushBack(node);
+
+	return true;
+}
+
+void ParallelSceneUpdate::updateSubtrees()
+{
+	ZoneScoped;
+
+	const int32_t numSubtrees = static_cast<int32_t>(subtrees_.size());
+	int32_t index = nextSubtree_.fetchAdd(1);
+	while (index < numSubtrees)
+	{
+		subtrees_[index]->update(interval_);
+		index = nextSubtree_.fetchAdd(1);
+	}
+}
+
+void ParallelSceneUpdate::updateSubtreesFunction(void *arg)
+{
+	ParallelSceneUpdate *parallelUpdate = static_cast<ParallelSceneUpdate *>(arg);
+	parallelUpdate->updateSubtrees();
+}
+
+}
@@ -0,0 +1,196 @@
+#include "ParallelSceneVisit.h"
+#include "SceneNode.h"
+#include "RenderQueue.h"
+#include "RenderCommand.h"
+#include "RenderStatistics.h"
+#include "ServiceLocator.h"
+#include "tracy.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+ParallelSceneVisit::ParallelSceneVisit()
+    : rootNode_(nullptr), splitDepth_(0),
+      serialQueue_(nctl::makeUnique<RenderQueue>()), subtreeQueues_(4),
+      splits_(16), subtrees_(64)
+{
+	serialQueue_->setDeferred(true);
+}
+
+ParallelSceneVisit::~ParallelSceneVisit() = default;
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void ParallelSceneVisit::visit(SceneNode &rootNode, RenderQueue &renderQueue, unsigned int splitDepth)
+{
+	ASSERT(SceneNode::parallelVisit_ == nullptr);
+	ZoneScoped;
+
+	rootNode_ = &rootNode;
+	splitDepth_ = splitDepth;
+	serialQueue_->clear();
+	splits_.clear();
+	subtrees_.clear();
+
+	// Visiting the nodes above the split depth and collecting the subtrees below it
+	{
+		ZoneScopedN("Serial visit");
+		SceneNode::parallelVisit_ = this;
+		unsigned int visitOrderIndex = 0;
+		rootNode.visit(*serialQueue_, visitOrderIndex);
+		SceneNode::parallelVisit_ = nullptr;
+	}
+
+	if (subtrees_.isEmpty() == false)
+	{
+		ZoneScopedN("Parallel visit");
+		nextSubtree_.store(0);
+		nextQueue_.store(1);
+
+		IThreadPool &threadPool = theServiceLocator().threadPool();
+		// The calling thread is also visiting subtrees
+		const unsigned int maxNumCommands = subtrees_.size() - 1;
+		const unsigned int numCommands = (threadPool.numThreads() < maxNumCommands) ? threadPool.numThreads() : maxNumCommands;
+		for (unsigned int i = subtreeQueues_.size(); i < numCommands + 1; i++)
+		{
+			subtreeQueues_.pushBack(nctl::makeUnique<RenderQueue>());
+			subtreeQueues_.back()->setDeferred(true);
+		}
+		for (unsigned int i = 0; i < numCommands + 1; i++)
+			subtreeQueues_[i]->clear();
+
+		commandGroup_.add(numCommands);
+		for (unsigned int i = 0; i < numCommands; i++)
+			threadPool.enqueueCommand(nctl::makeUnique<GroupFunctionCommand>(commandGroup_, visitSubtreesFunction, this));
+
+		visitSubtrees(*subtreeQueues_[0], 0);
+		// Every subtree has been visited, only the commands already started by a worker thread are waited for
+		commandGroup_.wait();
+
+		for (unsigned int i = 0; i < numCommands + 1; i++)
+			RenderStatistics::addCulledNodes(subtreeQueues_[i]->numCulledNodes());
+	}
+	RenderStatistics::addCulledNodes(serialQueue_->numCulledNodes());
+
+	// Merging the queues in visit order, each subtree shifts the indices of everything that follows it
+	{
+		ZoneScopedN("Merge queues");
+		unsigned int visitOrderOffset = 0;
+		unsigned int firstNode = 0;
+		unsigned int firstCommand = 0;
+		unsigned int subtreeIndex = 0;
+		for (const Split &split : splits_)
+		{
+			mergeQueue(renderQueue, *serialQueue_, firstNode, split.numVisitedNodes, firstCommand, split.numCommands, visitOrderOffset);
+			firstNode = split.numVisitedNodes;
+			firstCommand = split.numCommands;
+
+			unsigned int visitOrderIndex = split.visitOrderIndex + visitOrderOffset;
+			for (unsigned int i = 0; i < split.numSubtrees; i++)
+			{
+				const Subtree &subtree = subtrees_[subtreeIndex++];
+				// Subtrees start counting from one, the offset wraps around like the 16 bits indices do
+				mergeQueue(renderQueue, *subtreeQueues_[subtree.queueIndex], subtree.firstNode, subtree.lastNode,
+				           subtree.firstCommand, subtree.lastCommand, visitOrderIndex - 1);
+				visitOrderIndex += subtree.numVisitOrders;
+				visitOrderOffset += subtree.numVisitOrders;
+			}
+		}
+		mergeQueue(renderQueue, *serialQueue_, firstNode, serialQueue_->visitedNodes().size(),
+		           firstCommand, serialQueue_->deferredCommands().size(), visitOrderOffset);
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool ParallelSceneVisit::deferChildren(SceneNode *node, unsigned int visitOrderIndex)
+{
+	if (node->children_.isEmpty())
+		return false;
+
+	unsigned int childrenDepth = 1;
+	for (const SceneNode *parent = node; parent != rootNode_ && parent != nullptr; parent = parent->parent_)
+		childrenDepth++;
+
+	if (childrenDepth < splitDepth_)
+		return false;
+
+	Split split;
+	split.numVisitedNodes = serialQueue_->visitedNodes().size();
+	split.numCommands = serialQueue_->deferredCommands().size();
+	split.visitOrderIndex = visitOrderIndex;
+	split.numSubtrees = node->children_.size();
+	splits_.pushBack(split);
+
+	for (SceneNode *child : node->children_)
+	{
+		Subtree subtree = {};
+		subtree.node = child;
+		subtrees_.pushBack(subtree);
+	}
+
+	return true;
+}
+
+void ParallelSceneVisit::visitSubtrees(RenderQueue &queue, unsigned int queueIndex)
+{
+	ZoneScoped;
+
+	const int32_t numSubtrees = static_cast<int32_t>(subtrees_.size());
+	int32_t index = nextSubtree_.fetchAdd(1);
+	while (index < numSubtrees)
+	{
+		Subtree &subtree = subtrees_[index];
+		subtree.queueIndex = queueIndex;
+		subtree.firstNode = queue.visitedNodes().size();
+		subtree.firstCommand = queue.deferredCommands().size();
+
+		// Starting from one, so that a zero visit order still identifies a command that does not use it
+		unsigned int visitOrderIndex = 1;
+		subtree.node->visit(queue, visitOrderIndex);
+
+		subtree.lastNode = queue.visitedNodes().size();
+		subtree.lastCommand = queue.deferredCommands().size();
+		subtree.numVisitOrders = visitOrderIndex - 1;
+
+		index = nextSubtree_.fetchAdd(1);
+	}
+}
+
+void ParallelSceneVisit::visitSubtreesFunction(void *arg)
+{
+	ParallelSceneVisit *parallelVisit = static_cast<ParallelSceneVisit *>(arg);
+	const unsigned int queueIndex = static_cast<unsigned int>(parallelVisit->nextQueue_.fetchAdd(1));
+	parallelVisit->visitSubtrees(*parallelVisit->subtreeQueues_[queueIndex], queueIndex);
+}
+
+void ParallelSceneVisit::mergeQueue(RenderQueue &renderQueue, const RenderQueue &deferredQueue, unsigned int firstNode, unsigned int lastNode,
+                                    unsigned int firstCommand, unsigned int lastCommand, unsigned int visitOrderOffset)
+{
+	const uint16_t offset = static_cast<uint16_t>(visitOrderOffset);
+
+	if (offset != 0)
+	{
+		const nctl::Array<SceneNode *> &visitedNodes = deferredQueue.visitedNodes();
+		for (unsigned int i = firstNode; i < lastNode; i++)
+			visitedNodes[i]->visitOrderIndex_ += offset;
+	}
+
+	const nctl::Array<RenderCommand *> &commands = deferredQueue.deferredCommands();
+	for (unsigned int i = firstCommand; i < lastCommand; i++)
+	{
+		RenderCommand *command = commands[i];
+		if (offset != 0)
+			command->offsetVisitOrder(offset);
+		renderQueue.addMergedCommand(command);
+	}
+}
+
+}
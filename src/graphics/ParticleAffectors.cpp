@@ -1,9 +1,76 @@
 #include <nctl/algorithms.h>
 #include "ParticleAffectors.h"
 #include "Particle.h"
+#include "ParticleArrays.h"
+#include "common_simd.h"
 
 namespace ncine {
 
+namespace {
+
+	const float LookupTableMaxIndex = static_cast<float>(ParticleAffector::LookupTableSize - 1);
+
+	/// Returns the index of the lookup table entry preceding the specified age, and the interpolation factor towards the next one
+	/*! \note The position is clamped before the conversion to an integer, a particle with a zero starting life has a NaN or an infinite age */
+	inline unsigned int lookupTableIndex(float normalizedAge, float &factor)
+	{
+		float position = normalizedAge * LookupTableMaxIndex;
+		// The negated comparison is also true for NaN
+		if (!(position > 0.0f))
+			position = 0.0f;
+		else if (position > LookupTableMaxIndex)
+			position = LookupTableMaxIndex;
+		unsigned int index = static_cast<unsigned int>(position);
+		if (index > ParticleAffector::LookupTableSize - 2)
+			index = ParticleAffector::LookupTableSize - 2;
+		factor = position - static_cast<float>(index);
+		return index;
+	}
+
+	inline float sampleLookupTable(const float *lut, float normalizedAge)
+	{
+		float factor = 0.0f;
+		const unsigned int index = lookupTableIndex(normalizedAge, factor);
+		return lut[index] + (lut[index + 1] - lut[index]) * factor;
+	}
+
+#ifdef NCINE_WITH_SIMD
+	/// Samples the lookup table at four consecutive ages, the indices are calculated one by one as there are no gather instructions
+	inline simd::Float4 sampleLookupTable4(const float *lut, const float *normalizedAges)
+	{
+		float factors[4];
+		unsigned int indices[4];
+		for (unsigned int i = 0; i < 4; i++)
+			indices[i] = lookupTableIndex(normalizedAges[i], factors[i]);
+
+		const simd::Float4 prev = simd::set(lut[indices[0]], lut[indices[1]], lut[indices[2]], lut[indices[3]]);
+		const simd::Float4 next = simd::set(lut[indices[0] + 1], lut[indices[1] + 1], lut[indices[2] + 1], lut[indices[3] + 1]);
+		return simd::mulAdd(prev, simd::sub(next, prev), simd::load(factors));
+	}
+#endif
+
+	/// Writes the lookup table samples at the specified ages to the destination, added to the addends if they are not null
+	void sampleLookupTable(const float *lut, const float *normalizedAges, const float *addends, float *dest, unsigned int count)
+	{
+		unsigned int i = 0;
+#ifdef NCINE_WITH_SIMD
+		for (; i + 4 <= count; i += 4)
+		{
+			simd::Float4 values = sampleLookupTable4(lut, normalizedAges + i);
+			if (addends)
+				values = simd::add(simd::load(addends + i), values);
+			simd::store(dest + i, values);
+		}
+#endif
+		for (; i < count; i++)
+		{
+			const float value = sampleLookupTable(lut, normalizedAges[i]);
+			dest[i] = addends ? addends[i] + value : value;
+		}
+	}
+
+}
+
 ///////////////////////////////////////////////////////////
 // PUBLIC FUNCTIONS
 ///////////////////////////////////////////////////////////
@@ -34,33 +101,34 @@ void ColorAffector::addColorStep(float age, const Colorf &color)
 	}
 
 	colorSteps_.emplaceAt(index, age, color);
+	lookupTableIsDirty_ = true;
 }
 
-void ColorAffector::removeStep(unsigned int index)
+void ColorAffector::setColorStep(unsigned int index, float age, const Colorf &color)
 {
 	if (index < colorSteps_.size())
+	{
+		// The new age might change the position of the step
 		colorSteps_.removeAt(index);
+		addColorStep(age, color);
+	}
 }
 
-void ColorAffector::affect(Particle *particle, float normalizedAge)
+void ColorAffector::removeStep(unsigned int index)
 {
-	ASSERT(particle);
-	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
-
-	// Affector is disabled or has zero steps
-	if (enabled_ == false || colorSteps_.isEmpty())
-		return;
-
-	if (normalizedAge <= colorSteps_[0].age)
+	if (index < colorSteps_.size())
 	{
-		particle->setColor(colorSteps_[0].color);
-		return;
+		colorSteps_.removeAt(index);
+		lookupTableIsDirty_ = true;
 	}
+}
+
+Colorf ColorAffector::colorAt(float normalizedAge) const
+{
+	if (normalizedAge <= colorSteps_[0].age)
+		return colorSteps_[0].color;
 	else if (normalizedAge >= colorSteps_.back().age)
-	{
-		particle->setColor(colorSteps_.back().color);
-		return;
-	}
+		return colorSteps_.back().color;
 
 	unsigned int index = 0;
 	for (index = 0; index < colorSteps_.size() - 1; index++)
@@ -78,9 +146,56 @@ void ColorAffector::affect(Particle *particle, float normalizedAge)
 	const float green = prevStep.color.g() + (nextStep.color.g() - prevStep.color.g()) * factor;
 	const float blue = prevStep.color.b() + (nextStep.color.b() - prevStep.color.b()) * factor;
 	const float alpha = prevStep.color.a() + (nextStep.color.a() - prevStep.color.a()) * factor;
-	const Colorf color(red, green, blue, alpha);
+	return Colorf(red, green, blue, alpha);
+}
+
+void ColorAffector::affect(Particle *particle, float normalizedAge)
+{
+	ASSERT(particle);
+	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || colorSteps_.isEmpty())
+		return;
+
+	particle->setColor(colorAt(normalizedAge));
+}
+
+void ColorAffector::affect(ParticleArrays &particles, unsigned int first, unsigned int count)
+{
+	ASSERT(first + count <= particles.size);
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || colorSteps_.isEmpty())
+		return;
+
+	if (lookupTableIsDirty_)
+		updateLookupTable();
+
+	// The four channels of a color are interpolated at once
+	for (unsigned int i = first; i < first + count; i++)
+	{
+		float factor = 0.0f;
+		const unsigned int index = lookupTableIndex(particles.normalizedAges[i], factor);
+		const float *prev = colorLut_[index].data();
+		const float *next = colorLut_[index + 1].data();
+		float *dest = particles.colors[i].data();
+#ifdef NCINE_WITH_SIMD
+		const simd::Float4 prevColor = simd::load(prev);
+		simd::store(dest, simd::mulAdd(prevColor, simd::sub(simd::load(next), prevColor), simd::splat(factor)));
+#else
+		for (int j = 0; j < Colorf::NumChannels; j++)
+			dest[j] = prev[j] + (next[j] - prev[j]) * factor;
+#endif
+	}
+}
 
-	particle->setColor(color);
+void ColorAffector::updateLookupTable()
+{
+	colorLut_.setSize(LookupTableSize);
+	for (unsigned int i = 0; i < LookupTableSize; i++)
+		colorLut_[i] = colorAt(i / LookupTableMaxIndex);
+	lookupTableIsDirty_ = false;
 }
 
 ///////////////////////////////////////////////////////////
@@ -103,41 +218,38 @@ void SizeAffector::addSizeStep(float age, float scaleX, float scaleY)
 	}
 
 	sizeSteps_.emplaceAt(index, age, scaleX, scaleY);
+	lookupTableIsDirty_ = true;
 }
 
-void SizeAffector::removeStep(unsigned int index)
+void SizeAffector::setSizeStep(unsigned int index, float age, float scaleX, float scaleY)
 {
 	if (index < sizeSteps_.size())
+	{
+		// The new age might change the position of the step
 		sizeSteps_.removeAt(index);
+		addSizeStep(age, scaleX, scaleY);
+	}
 }
 
-void SizeAffector::affect(Particle *particle, float normalizedAge)
+void SizeAffector::removeStep(unsigned int index)
 {
-	ASSERT(particle);
-	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
-
-	// Affector is disabled
-	if (enabled_ == false)
-		return;
-
-	// Zero steps in the affector
-	if (sizeSteps_.isEmpty())
+	if (index < sizeSteps_.size())
 	{
-		// Applying base scale even with no steps
-		particle->setScale(baseScale_);
-		return;
+		sizeSteps_.removeAt(index);
+		lookupTableIsDirty_ = true;
 	}
+}
+
+Vector2f SizeAffector::scaleAt(float normalizedAge) const
+{
+	// Applying base scale even with no steps
+	if (sizeSteps_.isEmpty())
+		return baseScale_;
 
 	if (normalizedAge <= sizeSteps_[0].age)
-	{
-		particle->setScale(baseScale_ * sizeSteps_[0].scale);
-		return;
-	}
+		return baseScale_ * sizeSteps_[0].scale;
 	else if (normalizedAge >= sizeSteps_.back().age)
-	{
-		particle->setScale(baseScale_ * sizeSteps_.back().scale);
-		return;
-	}
+		return baseScale_ * sizeSteps_.back().scale;
 
 	unsigned int index = 0;
 	for (index = 0; index < sizeSteps_.size() - 1; index++)
@@ -152,8 +264,48 @@ void SizeAffector::affect(Particle *particle, float normalizedAge)
 
 	const float factor = (normalizedAge - prevStep.age) / (nextStep.age - prevStep.age);
 	const Vector2f newScale = prevStep.scale + (nextStep.scale - prevStep.scale) * factor;
+	return baseScale_ * newScale;
+}
+
+void SizeAffector::affect(Particle *particle, float normalizedAge)
+{
+	ASSERT(particle);
+	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
+
+	// Affector is disabled
+	if (enabled_ == false)
+		return;
+
+	particle->setScale(scaleAt(normalizedAge));
+}
+
+void SizeAffector::affect(ParticleArrays &particles, unsigned int first, unsigned int count)
+{
+	ASSERT(first + count <= particles.size);
+
+	// Affector is disabled
+	if (enabled_ == false)
+		return;
+
+	if (lookupTableIsDirty_)
+		updateLookupTable();
 
-	particle->setScale(baseScale_ * newScale);
+	const float *normalizedAges = particles.normalizedAges.get() + first;
+	sampleLookupTable(scaleXLut_.data(), normalizedAges, nullptr, particles.scalesX.get() + first, count);
+	sampleLookupTable(scaleYLut_.data(), normalizedAges, nullptr, particles.scalesY.get() + first, count);
+}
+
+void SizeAffector::updateLookupTable()
+{
+	scaleXLut_.setSize(LookupTableSize);
+	scaleYLut_.setSize(LookupTableSize);
+	for (unsigned int i = 0; i < LookupTableSize; i++)
+	{
+		const Vector2f scale = scaleAt(i / LookupTableMaxIndex);
+		scaleXLut_[i] = scale.x;
+		scaleYLut_[i] = scale.y;
+	}
+	lookupTableIsDirty_ = false;
 }
 
 ///////////////////////////////////////////////////////////
@@ -176,33 +328,34 @@ void RotationAffector::addRotationStep(float age, float angle)
 	}
 
 	rotationSteps_.emplaceAt(index, age, angle);
+	lookupTableIsDirty_ = true;
 }
 
-void RotationAffector::removeStep(unsigned int index)
+void RotationAffector::setRotationStep(unsigned int index, float age, float angle)
 {
 	if (index < rotationSteps_.size())
+	{
+		// The new age might change the position of the step
 		rotationSteps_.removeAt(index);
+		addRotationStep(age, angle);
+	}
 }
 
-void RotationAffector::affect(Particle *particle, float normalizedAge)
+void RotationAffector::removeStep(unsigned int index)
 {
-	ASSERT(particle);
-	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
-
-	// Affector is disabled or has zero steps
-	if (enabled_ == false || rotationSteps_.isEmpty())
-		return;
-
-	if (normalizedAge <= rotationSteps_[0].age)
+	if (index < rotationSteps_.size())
 	{
-		particle->setRotation(particle->startingRotation + rotationSteps_[0].angle);
-		return;
+		rotationSteps_.removeAt(index);
+		lookupTableIsDirty_ = true;
 	}
+}
+
+float RotationAffector::angleAt(float normalizedAge) const
+{
+	if (normalizedAge <= rotationSteps_[0].age)
+		return rotationSteps_[0].angle;
 	else if (normalizedAge >= rotationSteps_.back().age)
-	{
-		particle->setRotation(particle->startingRotation + rotationSteps_.back().angle);
-		return;
-	}
+		return rotationSteps_.back().angle;
 
 	unsigned int index = 0;
 	for (index = 0; index < rotationSteps_.size() - 1; index++)
@@ -216,9 +369,42 @@ void RotationAffector::affect(Particle *particle, float normalizedAge)
 	const RotationStep &nextStep = rotationSteps_[index];
 
 	const float factor = (normalizedAge - prevStep.age) / (nextStep.age - prevStep.age);
-	const float newAngle = prevStep.angle + (nextStep.angle - prevStep.angle) * factor;
+	return prevStep.angle + (nextStep.angle - prevStep.angle) * factor;
+}
+
+void RotationAffector::affect(Particle *particle, float normalizedAge)
+{
+	ASSERT(particle);
+	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || rotationSteps_.isEmpty())
+		return;
+
+	particle->setRotation(particle->startingRotation + angleAt(normalizedAge));
+}
+
+void RotationAffector::affect(ParticleArrays &particles, unsigned int first, unsigned int count)
+{
+	ASSERT(first + count <= particles.size);
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || rotationSteps_.isEmpty())
+		return;
+
+	if (lookupTableIsDirty_)
+		updateLookupTable();
+
+	sampleLookupTable(angleLut_.data(), particles.normalizedAges.get() + first,
+	                  particles.startingRotations.get() + first, particles.rotations.get() + first, count);
+}
 
-	particle->setRotation(particle->startingRotation + newAngle);
+void RotationAffector::updateLookupTable()
+{
+	angleLut_.setSize(LookupTableSize);
+	for (unsigned int i = 0; i < LookupTableSize; i++)
+		angleLut_[i] = angleAt(i / LookupTableMaxIndex);
+	lookupTableIsDirty_ = false;
 }
 
 ///////////////////////////////////////////////////////////
@@ -241,33 +427,34 @@ void PositionAffector::addPositionStep(float age, float posX, float posY)
 	}
 
 	positionSteps_.emplaceAt(index, age, posX, posY);
+	lookupTableIsDirty_ = true;
 }
 
-void PositionAffector::removeStep(unsigned int index)
+void PositionAffector::setPositionStep(unsigned int index, float age, float posX, float posY)
 {
 	if (index < positionSteps_.size())
+	{
+		// The new age might change the position of the step
 		positionSteps_.removeAt(index);
+		addPositionStep(age, posX, posY);
+	}
 }
 
-void PositionAffector::affect(Particle *particle, float normalizedAge)
+void PositionAffector::removeStep(unsigned int index)
 {
-	ASSERT(particle);
-	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
-
-	// Affector is disabled or has zero steps
-	if (enabled_ == false || positionSteps_.isEmpty())
-		return;
-
-	if (normalizedAge <= positionSteps_[0].age)
+	if (index < positionSteps_.size())
 	{
-		particle->move(positionSteps_[0].position);
-		return;
+		positionSteps_.removeAt(index);
+		lookupTableIsDirty_ = true;
 	}
+}
+
+Vector2f PositionAffector::positionAt(float normalizedAge) const
+{
+	if (normalizedAge <= positionSteps_[0].age)
+		return positionSteps_[0].position;
 	else if (normalizedAge >= positionSteps_.back().age)
-	{
-		particle->move(positionSteps_.back().position);
-		return;
-	}
+		return positionSteps_.back().position;
 
 	unsigned int index = 0;
 	for (index = 0; index < positionSteps_.size() - 1; index++)
@@ -281,9 +468,50 @@ void PositionAffector::affect(Particle *particle, float normalizedAge)
 	const PositionStep &nextStep = positionSteps_[index];
 
 	const float factor = (normalizedAge - prevStep.age) / (nextStep.age - prevStep.age);
-	const Vector2f newPosition = prevStep.position + (nextStep.position - prevStep.position) * factor;
+	return prevStep.position + (nextStep.position - prevStep.position) * factor;
+}
+
+void PositionAffector::affect(Particle *particle, float normalizedAge)
+{
+	ASSERT(particle);
+	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || positionSteps_.isEmpty())
+		return;
+
+	particle->move(positionAt(normalizedAge));
+}
+
+void PositionAffector::affect(ParticleArrays &particles, unsigned int first, unsigned int count)
+{
+	ASSERT(first + count <= particles.size);
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || positionSteps_.isEmpty())
+		return;
+
+	if (lookupTableIsDirty_)
+		updateLookupTable();
 
-	particle->move(newPosition);
+	const float *normalizedAges = particles.normalizedAges.get() + first;
+	float *positionsX = particles.positionsX.get() + first;
+	float *positionsY = particles.positionsY.get() + first;
+	sampleLookupTable(positionXLut_.data(), normalizedAges, positionsX, positionsX, count);
+	sampleLookupTable(positionYLut_.data(), normalizedAges, positionsY, positionsY, count);
+}
+
+void PositionAffector::updateLookupTable()
+{
+	positionXLut_.setSize(LookupTableSize);
+	positionYLut_.setSize(LookupTableSize);
+	for (unsigned int i = 0; i < LookupTableSize; i++)
+	{
+		const Vector2f position = positionAt(i / LookupTableMaxIndex);
+		positionXLut_[i] = position.x;
+		positionYLut_[i] = position.y;
+	}
+	lookupTableIsDirty_ = false;
 }
 
 ///////////////////////////////////////////////////////////
@@ -306,33 +534,34 @@ void VelocityAffector::addVelocityStep(float age, float velX, float velY)
 	}
 
 	velocitySteps_.emplaceAt(index, age, velX, velY);
+	lookupTableIsDirty_ = true;
 }
 
-void VelocityAffector::removeStep(unsigned int index)
+void VelocityAffector::setVelocityStep(unsigned int index, float age, float velX, float velY)
 {
 	if (index < velocitySteps_.size())
+	{
+		// The new age might change the position of the step
 		velocitySteps_.removeAt(index);
+		addVelocityStep(age, velX, velY);
+	}
 }
 
-void VelocityAffector::affect(Particle *particle, float normalizedAge)
+void VelocityAffector::removeStep(unsigned int index)
 {
-	ASSERT(particle);
-	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
-
-	// Affector is disabled or has zero steps
-	if (enabled_ == false || velocitySteps_.isEmpty())
-		return;
-
-	if (normalizedAge <= velocitySteps_[0].age)
+	if (index < velocitySteps_.size())
 	{
-		particle->velocity_ += velocitySteps_[0].velocity;
-		return;
+		velocitySteps_.removeAt(index);
+		lookupTableIsDirty_ = true;
 	}
+}
+
+Vector2f VelocityAffector::velocityAt(float normalizedAge) const
+{
+	if (normalizedAge <= velocitySteps_[0].age)
+		return velocitySteps_[0].velocity;
 	else if (normalizedAge >= velocitySteps_.back().age)
-	{
-		particle->velocity_ += velocitySteps_.back().velocity;
-		return;
-	}
+		return velocitySteps_.back().velocity;
 
 	unsigned int index = 0;
 	for (index = 0; index < velocitySteps_.size() - 1; index++)
@@ -346,9 +575,50 @@ void VelocityAffector::affect(Particle *particle, float normalizedAge)
 	const VelocityStep &nextStep = velocitySteps_[index];
 
 	const float factor = (normalizedAge - prevStep.age) / (nextStep.age - prevStep.age);
-	const Vector2f newVelocity = prevStep.velocity + (nextStep.velocity - prevStep.velocity) * factor;
+	return prevStep.velocity + (nextStep.velocity - prevStep.velocity) * factor;
+}
+
+void VelocityAffector::affect(Particle *particle, float normalizedAge)
+{
+	ASSERT(particle);
+	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || velocitySteps_.isEmpty())
+		return;
+
+	particle->velocity_ += velocityAt(normalizedAge);
+}
+
+void VelocityAffector::affect(ParticleArrays &particles, unsigned int first, unsigned int count)
+{
+	ASSERT(first + count <= particles.size);
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || velocitySteps_.isEmpty())
+		return;
+
+	if (lookupTableIsDirty_)
+		updateLookupTable();
+
+	const float *normalizedAges = particles.normalizedAges.get() + first;
+	float *velocitiesX = particles.velocitiesX.get() + first;
+	float *velocitiesY = particles.velocitiesY.get() + first;
+	sampleLookupTable(velocityXLut_.data(), normalizedAges, velocitiesX, velocitiesX, count);
+	sampleLookupTable(velocityYLut_.data(), normalizedAges, velocitiesY, velocitiesY, count);
+}
 
-	particle->velocity_ += newVelocity;
+void VelocityAffector::updateLookupTable()
+{
+	velocityXLut_.setSize(LookupTableSize);
+	velocityYLut_.setSize(LookupTableSize);
+	for (unsigned int i = 0; i < LookupTableSize; i++)
+	{
+		const Vector2f velocity = velocityAt(i / LookupTableMaxIndex);
+		velocityXLut_[i] = velocity.x;
+		velocityYLut_[i] = velocity.y;
+	}
+	lookupTableIsDirty_ = false;
 }
 
 }
@@ -0,0 +1,117 @@
+#include "common_macros.h"
+#include "ParticleArrays.h"
+#include "common_simd.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+ParticleArrays::ParticleArrays(unsigned int cap)
+    : capacity(cap), size(0),
+      positionsX(nctl::makeUnique<float[]>(cap)), positionsY(nctl::makeUnique<float[]>(cap)),
+      velocitiesX(nctl::makeUnique<float[]>(cap)), velocitiesY(nctl::makeUnique<float[]>(cap)),
+      lives(nctl::makeUnique<float[]>(cap)), startingLives(nctl::makeUnique<float[]>(cap)),
+      rotations(nctl::makeUnique<float[]>(cap)), startingRotations(nctl::makeUnique<float[]>(cap)),
+      scalesX(nctl::makeUnique<float[]>(cap)), scalesY(nctl::makeUnique<float[]>(cap)),
+      colors(nctl::makeUnique<Colorf[]>(cap)), normalizedAges(nctl::makeUnique<float[]>(cap))
+{
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool ParticleArrays::add(float life, const Vector2f &pos, const Vector2f &vel, float rot)
+{
+	if (size >= capacity)
+		return false;
+
+	positionsX[size] = pos.x;
+	positionsY[size] = pos.y;
+	velocitiesX[size] = vel.x;
+	velocitiesY[size] = vel.y;
+	lives[size] = life;
+	startingLives[size] = life;
+	rotations[size] = rot;
+	startingRotations[size] = rot;
+	// Affectors might not change all properties, the ones of the previous particle in this slot are not kept
+	scalesX[size] = 1.0f;
+	scalesY[size] = 1.0f;
+	colors[size] = Colorf::White;
+	size++;
+
+	return true;
+}
+
+void ParticleArrays::remove(unsigned int index)
+{
+	ASSERT(index < size);
+
+	size--;
+	if (index == size)
+		return;
+
+	positionsX[index] = positionsX[size];
+	positionsY[index] = positionsY[size];
+	velocitiesX[index] = velocitiesX[size];
+	velocitiesY[index] = velocitiesY[size];
+	lives[index] = lives[size];
+	startingLives[index] = startingLives[size];
+	rotations[index] = rotations[size];
+	startingRotations[index] = startingRotations[size];
+	scalesX[index] = scalesX[size];
+	scalesY[index] = scalesY[size];
+	colors[index] = colors[size];
+}
+
+void ParticleArrays::updateNormalizedAges(unsigned int first, unsigned int count)
+{
+	ASSERT(first + count <= size);
+
+	unsigned int i = first;
+	const unsigned int end = first + count;
+#ifdef NCINE_WITH_SIMD
+	const simd::Float4 ones = simd::splat(1.0f);
+	for (; i + 4 <= end; i += 4)
+		simd::store(&normalizedAges[i], simd::sub(ones, simd::div(simd::load(&lives[i]), simd::load(&startingLives[i]))));
+#endif
+	for (; i < end; i++)
+		normalizedAges[i] = 1.0f - lives[i] / startingLives[i];
+}
+
+void ParticleArrays::integrate(unsigned int first, unsigned int count, float interval)
+{
+	ASSERT(first + count <= size);
+
+	unsigned int i = first;
+	const unsigned int end = first + count;
+#ifdef NCINE_WITH_SIMD
+	const simd::Float4 intervals = simd::splat(interval);
+	for (; i + 4 <= end; i += 4)
+	{
+		simd::store(&lives[i], simd::sub(simd::load(&lives[i]), intervals));
+		simd::store(&positionsX[i], simd::mulAdd(simd::load(&positionsX[i]), simd::load(&velocitiesX[i]), intervals));
+		simd::store(&positionsY[i], simd::mulAdd(simd::load(&positionsY[i]), simd::load(&velocitiesY[i]), intervals));
+	}
+#endif
+	for (; i < end; i++)
+	{
+		lives[i] -= interval;
+		positionsX[i] += velocitiesX[i] * interval;
+		positionsY[i] += velocitiesY[i] * interval;
+	}
+}
+
+void ParticleArrays::removeDead()
+{
+	// Iterating backwards, so that a dead particle is replaced by one that has already been checked
+	for (int i = static_cast<int>(size) - 1; i >= 0; i--)
+	{
+		if (lives[i] <= 0.0f)
+			remove(i);
+	}
+}
+
+}
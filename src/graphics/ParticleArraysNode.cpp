@@ -0,0 +1,235 @@
+#include <cmath> // for sqrtf()
+#include <nctl/algorithms.h>
+#include "ParticleArraysNode.h"
+#include "RenderCommand.h"
+#include "RenderResources.h"
+#include "Texture.h"
+#include "Application.h"
+#include "tracy.h"
+
+namespace ncine {
+
+namespace {
+
+	const unsigned int NumFloatsPerParticle = sizeof(RenderResources::InstanceFormatParticle) / sizeof(GLfloat);
+
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+ParticleArraysNode::ParticleArraysNode(SceneNode *parent, unsigned int count, Texture *texture, const Recti &texRect)
+    : BaseSprite(parent, texture, 0.0f, 0.0f), particles_(count),
+      instancesData_(nctl::makeUnique<float[]>(count * NumFloatsPerParticle)),
+      particlesAnchorPoint_(AnchorCenter), inLocalSpace_(false), particlesChanged_(true), anchorPointUniform_(nullptr)
+{
+	init();
+	setTexRect(texRect);
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void ParticleArraysNode::setParticlesAnchorPoint(float xx, float yy)
+{
+	particlesAnchorPoint_.set(nctl::clamp(xx, 0.0f, 1.0f), nctl::clamp(yy, 0.0f, 1.0f));
+	dirtyBits_.set(DirtyBitPositions::SizeBit);
+	dirtyBits_.set(DirtyBitPositions::AabbBit);
+}
+
+void ParticleArraysNode::setInLocalSpace(bool inLocalSpace)
+{
+	if (inLocalSpace_ != inLocalSpace)
+	{
+		inLocalSpace_ = inLocalSpace;
+		dirtyBits_.set(DirtyBitPositions::TransformationBit);
+		dirtyBits_.set(DirtyBitPositions::AabbBit);
+	}
+}
+
+void ParticleArraysNode::particlesHaveChanged()
+{
+	particlesChanged_ = true;
+	dirtyBits_.set(DirtyBitPositions::AabbBit);
+}
+
+bool ParticleArraysNode::draw(RenderQueue &renderQueue)
+{
+	// An instanced command with zero instances would be drawn as a non-instanced one
+	if (particles_.size == 0)
+		return false;
+
+	return DrawableNode::draw(renderQueue);
+}
+
+///////////////////////////////////////////////////////////
+// PROTECTED FUNCTIONS
+///////////////////////////////////////////////////////////
+
+ParticleArraysNode::ParticleArraysNode(const ParticleArraysNode &other)
+    : BaseSprite(other), particles_(other.particles_.capacity),
+      instancesData_(nctl::makeUnique<float[]>(other.particles_.capacity * NumFloatsPerParticle)),
+      particlesAnchorPoint_(other.particlesAnchorPoint_), inLocalSpace_(other.inLocalSpace_),
+      particlesChanged_(true), anchorPointUniform_(nullptr)
+{
+	// The texture rectangle and the size have already been copied, with the flipping applied
+	init();
+}
+
+void ParticleArraysNode::updateAabb()
+{
+	ZoneScoped;
+
+	if (particles_.size == 0)
+	{
+		aabb_.set(0.0f, 0.0f, 0.0f, 0.0f);
+		return;
+	}
+
+	// The farthest distance of a quad vertex from the particle position, before scaling
+	const float halfWidth = fabsf((particlesAnchorPoint_.x - 0.5f) * width_) + fabsf(width_ * 0.5f);
+	const float halfHeight = fabsf((particlesAnchorPoint_.y - 0.5f) * height_) + fabsf(height_ * 0.5f);
+	const float radius = sqrtf(halfWidth * halfWidth + halfHeight * halfHeight);
+
+	float minX = particles_.positionsX[0];
+	float minY = particles_.positionsY[0];
+	float maxX = minX;
+	float maxY = minY;
+	for (unsigned int i = 0; i < particles_.size; i++)
+	{
+		const float extent = radius * nctl::max(fabsf(particles_.scalesX[i]), fabsf(particles_.scalesY[i]));
+		minX = nctl::min(minX, particles_.positionsX[i] - extent);
+		minY = nctl::min(minY, particles_.positionsY[i] - extent);
+		maxX = nctl::max(maxX, particles_.positionsX[i] + extent);
+		maxY = nctl::max(maxY, particles_.positionsY[i] + extent);
+	}
+
+	if (inLocalSpace_)
+	{
+		// The corners of the box are transformed by the world matrix of the particle system
+		const Vector4f corners[4] = { worldMatrix_ * Vector4f(minX, minY, 0.0f, 1.0f), worldMatrix_ * Vector4f(maxX, minY, 0.0f, 1.0f),
+			                          worldMatrix_ * Vector4f(minX, maxY, 0.0f, 1.0f), worldMatrix_ * Vector4f(maxX, maxY, 0.0f, 1.0f) };
+		minX = maxX = corners[0].x;
+		minY = maxY = corners[0].y;
+		for (unsigned int i = 1; i < 4; i++)
+		{
+			minX = nctl::min(minX, corners[i].x);
+			minY = nctl::min(minY, corners[i].y);
+			maxX = nctl::max(maxX, corners[i].x);
+			maxY = nctl::max(maxY, corners[i].y);
+		}
+	}
+
+	aabb_ = Rectf::fromMinMax(minX, minY, maxX, maxY);
+}
+
+void ParticleArraysNode::shaderHasChanged()
+{
+	BaseSprite::shaderHasChanged();
+	GLUniformBlockCache *instanceBlock = renderCommand_->material().uniformBlock(Material::InstanceBlockName);
+	anchorPointUniform_ = instanceBlock ? instanceBlock->uniformHandle(Material::AnchorPointUniformName, GL_FLOAT_VEC2) : nullptr;
+}
+
+void ParticleArraysNode::textureHasChanged(Texture *newTexture)
+{
+	if (renderCommand_->material().shaderProgramType() != Material::ShaderProgramType::CUSTOM)
+	{
+		const Material::ShaderProgramType shaderProgramType = (newTexture && newTexture->numChannels() < 3)
+		                                                          ? Material::ShaderProgramType::PARTICLES_GRAY
+		                                                          : Material::ShaderProgramType::PARTICLES;
+		const bool hasChanged = renderCommand_->material().setShaderProgramType(shaderProgramType);
+		if (hasChanged)
+			shaderHasChanged();
+	}
+
+	if (newTexture)
+		setTexRect(Recti(0, 0, newTexture->width(), newTexture->height()));
+}
+
+void ParticleArraysNode::updateRenderCommand()
+{
+	ZoneScoped;
+
+	if (dirtyBits_.test(DirtyBitPositions::SizeBit) && anchorPointUniform_)
+		anchorPointUniform_->storeFloatValue((particlesAnchorPoint_.x - 0.5f) * width_, (particlesAnchorPoint_.y - 0.5f) * height_);
+	BaseSprite::updateRenderCommand();
+
+	// A node is drawn once for every viewport that does not cull it, but particles only change once per frame
+	if (particlesChanged_)
+	{
+		ZoneScopedN("Fill instances data");
+		RenderResources::InstanceFormatParticle *instances = reinterpret_cast<RenderResources::InstanceFormatParticle *>(instancesData_.get());
+		for (unsigned int i = 0; i < particles_.size; i++)
+		{
+			RenderResources::InstanceFormatParticle &instance = instances[i];
+			instance.position[0] = particles_.positionsX[i];
+			instance.position[1] = particles_.positionsY[i];
+			instance.scale[0] = particles_.scalesX[i];
+			instance.scale[1] = particles_.scalesY[i];
+			instance.rotation = particles_.rotations[i];
+			const Colorf &color = particles_.colors[i];
+			instance.color[0] = color.r();
+			instance.color[1] = color.g();
+			instance.color[2] = color.b();
+			instance.color[3] = color.a();
+		}
+
+		// Setting the pointer again marks the vertices as dirty for a custom VBO
+		renderCommand_->geometry().setHostVertexPointer(instancesData_.get());
+		renderCommand_->setNumInstances(particles_.size);
+		particlesChanged_ = false;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void ParticleArraysNode::init()
+{
+	ZoneScoped;
+	if (texture_ && texture_->name() != nullptr)
+	{
+		// When Tracy is disabled the statement body is empty and braces are needed
+		ZoneText(texture_->name(), nctl::strnlen(texture_->name(), Object::MaxNameLength));
+	}
+
+	type_ = ObjectType::PARTICLE;
+	renderCommand_->setType(RenderCommand::CommandTypes::PARTICLE);
+
+	const Material::ShaderProgramType shaderProgramType = (texture_ && texture_->numChannels() < 3)
+	                                                          ? Material::ShaderProgramType::PARTICLES_GRAY
+	                                                          : Material::ShaderProgramType::PARTICLES;
+	renderCommand_->material().setShaderProgramType(shaderProgramType);
+	shaderHasChanged();
+
+	// Every particle is a triangle strip quad with vertices calculated from `gl_VertexID`
+	Geometry &geometry = renderCommand_->geometry();
+	geometry.setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
+	geometry.setNumElementsPerVertex(NumFloatsPerParticle);
+	geometry.setInstancedVertices(true);
+
+	// The instances of a big system might not fit in the common VBO
+	const unsigned long instancesDataSize = particles_.capacity * sizeof(RenderResources::InstanceFormatParticle);
+	if (instancesDataSize > theApplication().appConfiguration().vboSize)
+		geometry.createCustomVbo(particles_.capacity * NumFloatsPerParticle, GL_DYNAMIC_DRAW);
+}
+
+void ParticleArraysNode::transform()
+{
+	SceneNode::transform();
+
+	if (inLocalSpace_ == false)
+	{
+		// Particle positions are already in world space
+		worldMatrix_ = localMatrix_;
+
+		absScaleFactor_ = scaleFactor_;
+		absRotation_ = rotation_;
+		absPosition_ = position_;
+	}
+}
+
+}
@@ -2,9 +2,17 @@
 #include "Random.h"
 #include "Vector2.h"
 #include "Particle.h"
+#include "ParticleArraysNode.h"
 #include "ParticleInitializer.h"
 #include "Texture.h"
 #include "Application.h"
+#include "RenderResources.h"
+#include "CullingGrid.h"
+
+#ifdef WITH_THREADS
+	#include "ParallelParticlesUpdate.h"
+	#include "Thread.h"
+#endif
 
 #ifdef WITH_TRACY
 	#include <nctl/StaticString.h>
@@ -15,11 +23,27 @@
 namespace ncine {
 
 namespace {
-#ifdef WITH_TRACY
-	nctl::StaticString<128> tracyInfoString;
-#endif
+	bool useParticleArrays()
+	{
+		return theApplication().appConfiguration().useParticleArrays;
+	}
+
+	/// The states of the update of the particle arrays deferred to a thread pool job
+	enum UpdateJobState
+	{
+		/// There is no deferred update
+		IDLE = 0,
+		/// The job has been enqueued but no thread has started it yet
+		QUEUED,
+		/// A thread is updating the particle arrays
+		RUNNING,
+		/// The particle arrays have been updated and the job should be completed by the thread that joins it
+		DONE
+	};
 }
 
+ParallelParticlesUpdate *ParticleSystem::parallelUpdate_ = nullptr;
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
@@ -31,10 +55,10 @@ ParticleSystem::ParticleSystem(SceneNode *parent, unsigned int count, Texture *t
 
 ParticleSystem::ParticleSystem(SceneNode *parent, unsigned int count, Texture *texture, Recti texRect)
     : SceneNode(parent, 0, 0), poolSize_(count), poolTop_(count - 1),
-      particlePool_(poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
-      particleArray_(poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
+      particlePool_(useParticleArrays() ? 0 : poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
+      particleArray_(useParticleArrays() ? 0 : poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
       affectors_(4), inLocalSpace_(false),
-      particlesUpdateEnabled_(true), affectorsEnabled_(true)
+      particlesUpdateEnabled_(true), affectorsEnabled_(true), updateJobInterval_(0.0f)
 {
 	ZoneScoped;
 	if (texture && texture->name() != nullptr)
@@ -44,6 +68,15 @@ ParticleSystem::ParticleSystem(SceneNode *parent, unsigned int count, Texture *t
 	}
 
 	type_ = ObjectType::PARTICLE_SYSTEM;
+	// Particles are emitted and moved at every update
+	setUpdatedEveryFrame(true);
+
+	if (useParticleArrays())
+	{
+		arraysNode_ = nctl::makeUnique<ParticleArraysNode>(this, poolSize_, texture, texRect);
+		updateJobState_ = nctl::makeUnique<nctl::Atomic32>(IDLE);
+		return;
+	}
 
 	children_.setCapacity(poolSize_);
 	for (unsigned int i = 0; i < poolSize_; i++)
@@ -55,6 +88,15 @@ ParticleSystem::ParticleSystem(SceneNode *parent, unsigned int count, Texture *t
 	}
 }
 
+ParticleSystem::~ParticleSystem()
+{
+#ifdef WITH_THREADS
+	// A job might still be referencing the system
+	if (updateJobState_ && updateJobState_->load() != IDLE)
+		parallelUpdate_->remove(*this);
+#endif
+}
+
 ParticleSystem::ParticleSystem(ParticleSystem &&) = default;
 
 ParticleSystem &ParticleSystem::operator=(ParticleSystem &&) = default;
@@ -68,6 +110,22 @@ void ParticleSystem::clearAffectors()
 	affectors_.clear();
 }
 
+void ParticleSystem::setInLocalSpace(bool inLocalSpace)
+{
+	inLocalSpace_ = inLocalSpace;
+	// Particles in arrays all share the same space, while each sprite particle keeps the one it has been emitted with
+	if (arraysNode_)
+		arraysNode_->setInLocalSpace(inLocalSpace);
+}
+
+unsigned int ParticleSystem::numAliveParticles() const
+{
+	if (arraysNode_)
+		return arraysNode_->particles().size;
+
+	return particleArray_.size() - poolTop_ - 1;
+}
+
 void ParticleSystem::emitParticles(const ParticleInitializer &init)
 {
 	if (updateEnabled_ == false)
@@ -76,16 +134,23 @@ void ParticleSystem::emitParticles(const ParticleInitializer &init)
 	ZoneScoped;
 	const unsigned int amount = static_cast<unsigned int>(random().integer(init.rndAmount.x, init.rndAmount.y));
 #ifdef WITH_TRACY
+	// Particle systems can be updated and emit particles from multiple threads
+	nctl::StaticString<128> tracyInfoString;
 	tracyInfoString.format("Count: %d", amount);
 	ZoneText(tracyInfoString.data(), tracyInfoString.length());
 #endif
+	// Particles are not emitted while a thread pool job is updating the arrays
+	if (arraysNode_)
+		finishUpdateJob();
+
 	Vector2f position(0.0f, 0.0f);
 	Vector2f velocity(0.0f, 0.0f);
 
 	for (unsigned int i = 0; i < amount; i++)
 	{
 		// No more unused particles in the pool
-		if (poolTop_ < 0)
+		const bool poolIsEmpty = arraysNode_ ? (arraysNode_->particles().size >= poolSize_) : (poolTop_ < 0);
+		if (poolIsEmpty)
 			break;
 
 		const float life = random().real(init.rndLife.x, init.rndLife.y);
@@ -108,15 +173,32 @@ void ParticleSystem::emitParticles(const ParticleInitializer &init)
 		if (inLocalSpace_ == false)
 			position += absPosition();
 
+		if (arraysNode_)
+		{
+			arraysNode_->particles().add(life, position, velocity, rotation);
+			continue;
+		}
+
 		// Acquiring a particle from the pool
 		particlePool_[poolTop_]->init(life, position, velocity, rotation, inLocalSpace_);
 		addChildNode(particlePool_[poolTop_]);
 		poolTop_--;
 	}
+
+	if (arraysNode_)
+		arraysNode_->particlesHaveChanged();
 }
 
 void ParticleSystem::killParticles()
 {
+	if (arraysNode_)
+	{
+		finishUpdateJob();
+		arraysNode_->particles().clear();
+		arraysNode_->particlesHaveChanged();
+		return;
+	}
+
 	for (int i = children_.size() - 1; i >= 0; i--)
 	{
 		Particle *particle = static_cast<Particle *>(children_[i]);
@@ -135,54 +217,108 @@ void ParticleSystem::killParticles()
 
 void ParticleSystem::setTexture(Texture *texture)
 {
+	if (arraysNode_)
+	{
+		arraysNode_->setTexture(texture);
+		return;
+	}
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setTexture(texture);
 }
 
 void ParticleSystem::setTexRect(const Recti &rect)
 {
+	if (arraysNode_)
+	{
+		arraysNode_->setTexRect(rect);
+		return;
+	}
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setTexRect(rect);
 }
 
 void ParticleSystem::setAnchorPoint(float xx, float yy)
 {
+	if (arraysNode_)
+	{
+		arraysNode_->setParticlesAnchorPoint(xx, yy);
+		return;
+	}
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setAnchorPoint(xx, yy);
 }
 
 void ParticleSystem::setAnchorPoint(const Vector2f &point)
 {
+	if (arraysNode_)
+	{
+		arraysNode_->setParticlesAnchorPoint(point.x, point.y);
+		return;
+	}
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setAnchorPoint(point);
 }
 
 void ParticleSystem::setFlippedX(bool flippedX)
 {
+	if (arraysNode_)
+	{
+		arraysNode_->setFlippedX(flippedX);
+		return;
+	}
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setFlippedX(flippedX);
 }
 
 void ParticleSystem::setFlippedY(bool flippedY)
 {
+	if (arraysNode_)
+	{
+		arraysNode_->setFlippedY(flippedY);
+		return;
+	}
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setFlippedY(flippedY);
 }
 
 void ParticleSystem::setBlendingPreset(DrawableNode::BlendingPreset blendingPreset)
 {
+	if (arraysNode_)
+	{
+		arraysNode_->setBlendingPreset(blendingPreset);
+		return;
+	}
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setBlendingPreset(blendingPreset);
 }
 
 void ParticleSystem::setBlendingFactors(DrawableNode::BlendingFactor srcBlendingFactor, DrawableNode::BlendingFactor destBlendingFactor)
 {
+	if (arraysNode_)
+	{
+		arraysNode_->setBlendingFactors(srcBlendingFactor, destBlendingFactor);
+		return;
+	}
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setBlendingFactors(srcBlendingFactor, destBlendingFactor);
 }
 
 void ParticleSystem::setLayer(uint16_t layer)
 {
+	if (arraysNode_)
+	{
+		arraysNode_->setLayer(layer);
+		return;
+	}
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setLayer(layer);
 }
@@ -195,38 +331,69 @@ void ParticleSystem::update(float interval)
 	ZoneScoped;
 	// Overridden `update()` method should call `transform()` like `SceneNode::update()` does
 	SceneNode::transform();
+	CullingGrid *cullingGrid = RenderResources::cullingGrid();
 
-	for (int i = children_.size() - 1; i >= 0; i--)
+	if (arraysNode_)
 	{
-		Particle *particle = static_cast<Particle *>(children_[i]);
+		ASSERT(updateJobState_->load() == IDLE);
+		// The transformation of the node does not depend on the particles, it is calculated before the job is enqueued
+		arraysNode_->transform();
 
-		// Update the particle if it's alive
-		if (particle->isAlive())
+		bool updateIsDeferred = false;
+#ifdef WITH_THREADS
+		if (parallelUpdate_)
 		{
-			if (affectorsEnabled_)
-			{
-				// Calculating the normalized age only once per particle
-				const float normalizedAge = 1.0f - particle->life_ / particle->startingLife;
-				for (nctl::UniquePtr<ParticleAffector> &affector : affectors_)
-					affector->affect(particle, normalizedAge);
-			}
+			updateJobInterval_ = interval;
+			updateJobState_->store(QUEUED);
+			updateIsDeferred = parallelUpdate_->defer(*this);
+			if (updateIsDeferred == false)
+				updateJobState_->store(IDLE);
+		}
+#endif
+		if (updateIsDeferred == false)
+		{
+			updateParticleArrays(interval);
+			arraysNode_->particlesHaveChanged();
+			if (cullingGrid)
+				cullingGrid->nodeHasTransformed(*arraysNode_);
+		}
+	}
+	else
+	{
+		for (int i = children_.size() - 1; i >= 0; i--)
+		{
+			Particle *particle = static_cast<Particle *>(children_[i]);
 
-			if (particlesUpdateEnabled_)
+			// Update the particle if it's alive
+			if (particle->isAlive())
 			{
-				particle->update(interval);
+				if (affectorsEnabled_)
+				{
+					// Calculating the normalized age only once per particle
+					const float normalizedAge = 1.0f - particle->life_ / particle->startingLife;
+					for (nctl::UniquePtr<ParticleAffector> &affector : affectors_)
+						affector->affect(particle, normalizedAge);
+				}
 
-				// Releasing the particle if it has just died
-				if (particle->isAlive() == false)
+				if (particlesUpdateEnabled_)
 				{
-					poolTop_++;
-					particlePool_[poolTop_] = particle;
-					removeChildNodeAt(i);
-					continue;
+					particle->update(interval);
+
+					// Releasing the particle if it has just died
+					if (particle->isAlive() == false)
+					{
+						poolTop_++;
+						particlePool_[poolTop_] = particle;
+						removeChildNodeAt(i);
+						continue;
+					}
 				}
-			}
 
-			// Transforming the particle only if it's still alive
-			particle->transform();
+				// Transforming the particle only if it's still alive
+				particle->transform();
+				if (cullingGrid)
+					cullingGrid->nodeHasTransformed(*particle);
+			}
 		}
 	}
 
@@ -237,8 +404,12 @@ void ParticleSystem::update(float interval)
 	lastFrameUpdated_ = theApplication().numFrames();
 
 #ifdef WITH_TRACY
-	tracyInfoString.format("Alive: %d", numAliveParticles());
-	ZoneText(tracyInfoString.data(), tracyInfoString.length());
+	if (updateJobState_ == nullptr || updateJobState_->load() == IDLE)
+	{
+		nctl::StaticString<128> tracyInfoString;
+		tracyInfoString.format("Alive: %d", numAliveParticles());
+		ZoneText(tracyInfoString.data(), tracyInfoString.length());
+	}
 #endif
 }
 
@@ -248,11 +419,11 @@ void ParticleSystem::update(float interval)
 
 ParticleSystem::ParticleSystem(const ParticleSystem &other)
     : SceneNode(other), poolSize_(other.poolSize_), poolTop_(other.poolSize_ - 1),
-      particlePool_(other.poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
-      particleArray_(other.poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
+      particlePool_(other.arraysNode_ ? 0 : other.poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
+      particleArray_(other.arraysNode_ ? 0 : other.poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
       affectors_(4), inLocalSpace_(other.inLocalSpace_),
       particlesUpdateEnabled_(other.particlesUpdateEnabled_),
-      affectorsEnabled_(other.affectorsEnabled_)
+      affectorsEnabled_(other.affectorsEnabled_), updateJobInterval_(0.0f)
 {
 	ZoneScoped;
 	type_ = ObjectType::PARTICLE_SYSTEM;
@@ -280,6 +451,14 @@ ParticleSystem::ParticleSystem(const ParticleSystem &other)
 		}
 	}
 
+	if (other.arraysNode_)
+	{
+		arraysNode_ = nctl::makeUnique<ParticleArraysNode>(other.arraysNode_->clone());
+		arraysNode_->setParent(this);
+		updateJobState_ = nctl::makeUnique<nctl::Atomic32>(IDLE);
+		return;
+	}
+
 	children_.setCapacity(poolSize_);
 	if (poolSize_ > 0)
 	{
@@ -299,4 +478,80 @@ ParticleSystem::ParticleSystem(const ParticleSystem &other)
 	}
 }
 
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void ParticleSystem::updateParticleArrays(float interval)
+{
+	ParticleArrays &particles = arraysNode_->particles();
+
+	if (affectorsEnabled_ && particles.size > 0)
+	{
+		// Calculating the normalized ages only once, then every affector processes all particles with a single call
+		particles.updateNormalizedAges(0, particles.size);
+		for (nctl::UniquePtr<ParticleAffector> &affector : affectors_)
+			affector->affect(particles, 0, particles.size);
+	}
+
+	if (particlesUpdateEnabled_)
+	{
+		// A particle dies when its remaining life is not longer than the interval
+		particles.integrate(0, particles.size, interval);
+		particles.removeDead();
+	}
+}
+
+bool ParticleSystem::claimUpdateJob()
+{
+	return updateJobState_->cmpExchange(RUNNING, QUEUED);
+}
+
+void ParticleSystem::executeUpdateJob()
+{
+	ASSERT(updateJobState_->load() == RUNNING);
+	ZoneScoped;
+	updateParticleArrays(updateJobInterval_);
+#ifdef WITH_TRACY
+	nctl::StaticString<128> tracyInfoString;
+	tracyInfoString.format("Alive: %d", arraysNode_->particles().size);
+	ZoneText(tracyInfoString.data(), tracyInfoString.length());
+#endif
+	// The system might be destroyed by the thread waiting for the job as soon as the state changes
+	updateJobState_->store(DONE);
+}
+
+bool ParticleSystem::runUpdateJob()
+{
+	if (claimUpdateJob() == false)
+		return false;
+
+	executeUpdateJob();
+	return true;
+}
+
+void ParticleSystem::finishUpdateJob()
+{
+#ifdef WITH_THREADS
+	if (runUpdateJob() == false)
+	{
+		while (updateJobState_->load() == RUNNING)
+			Thread::yieldExecution();
+	}
+#endif
+}
+
+void ParticleSystem::completeUpdateJob()
+{
+	ASSERT(updateJobState_->load() == DONE);
+	updateJobState_->store(IDLE);
+
+	// Setting the dirty bits of the node on this thread, as they might have been accessed by the scenegraph walk
+	arraysNode_->particlesHaveChanged();
+	CullingGrid *cullingGrid = RenderResources::cullingGrid();
+	if (cullingGrid)
+		cullingGrid->nodeHasTransformed(*arraysNode_);
+}
+
 }
@@ -9,6 +9,20 @@
 
 namespace ncine {
 
+namespace {
+
+	/// Returns the shader registered to batch the commands of a shader, or `nullptr` if there is none or if it is still linking
+	const GLShaderProgram *readyBatchedShader(const RenderCommand *command)
+	{
+		GLShaderProgram *batchedShader = RenderResources::batchedShader(command->material().shaderProgram());
+		// Commands are drawn one by one instead of stalling until the driver completes linking
+		if (batchedShader != nullptr && batchedShader->pollStatus() == GLShaderProgram::Status::LINKING)
+			return nullptr;
+		return batchedShader;
+	}
+
+}
+
 ///////////////////////////////////////////////////////////
 // STATIC DEFINITIONS
 ///////////////////////////////////////////////////////////
@@ -19,24 +33,25 @@ unsigned int RenderBatcher::UboMaxSize = 0;
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
 
+RenderBatcher::BatchCache::BatchCache()
+    : minBatchSize_(0), maxBatchSize_(0), frame_(0), numBatches_(0)
+{
+}
+
 RenderBatcher::RenderBatcher()
-    : buffers_(1)
 {
 	const IGfxCapabilities &gfxCaps = theServiceLocator().gfxCapabilities();
 	const unsigned int maxUniformBlockSize = static_cast<unsigned int>(gfxCaps.value(IGfxCapabilities::GLIntValues::MAX_UNIFORM_BLOCK_SIZE));
 
 	// Clamping the value as some drivers report a maximum size similar to SSBO one
 	UboMaxSize = maxUniformBlockSize <= 64 * 1024 ? maxUniformBlockSize : 64 * 1024;
-
-	// Create the first buffer right away
-	createBuffer(UboMaxSize);
 }
 
 ///////////////////////////////////////////////////////////
 // PUBLIC FUNCTIONS
 ///////////////////////////////////////////////////////////
 
-void RenderBatcher::createBatches(const nctl::Array<RenderCommand *> &srcQueue, nctl::Array<RenderCommand *> &destQueue)
+void RenderBatcher::createBatches(const nctl::Array<RenderCommand *> &srcQueue, nctl::Array<RenderCommand *> &destQueue, BatchCache &cache)
 {
 #if defined(__EMSCRIPTEN__) || defined(WITH_ANGLE)
 	const unsigned int fixedBatchSize = theApplication().appConfiguration().fixedBatchSize;
@@ -49,79 +64,124 @@ void RenderBatcher::createBatches(const nctl::Array<RenderCommand *> &srcQueue,
 	ASSERT(minBatchSize > 1);
 	ASSERT(maxBatchSize >= minBatchSize);
 
-	unsigned int lastSplit = 0;
-
-	for (unsigned int i = 1; i < srcQueue.size(); i++)
+	// The segments of last frame are reused if the sorted queue has not changed
+	const bool cacheIsValid = isCacheValid(srcQueue, cache, minBatchSize, maxBatchSize);
+	if (cacheIsValid == false)
 	{
-		const RenderCommand *command = srcQueue[i];
-		const GLenum primitive = command->geometry().primitiveType();
-
-		const RenderCommand *prevCommand = srcQueue[i - 1];
-		const GLenum prevPrimitive = prevCommand->geometry().primitiveType();
-
-		// Should split if the lower part of a material's sort key or the primitive type differ
-		const bool shouldSplit = command->lowerMaterialSortKey() != prevCommand->lowerMaterialSortKey() || prevPrimitive != primitive;
+		createSegments(srcQueue, cache, minBatchSize);
+		cache.minBatchSize_ = minBatchSize;
+		cache.maxBatchSize_ = maxBatchSize;
+	}
 
-		// Also collect the very last command if it can be batched with the previous one
-		unsigned int endSplit = (i == srcQueue.size() - 1 && !shouldSplit) ? i + 1 : i;
+	// Reset managed buffers, batches acquire the same memory as last frame if the queue has not changed
+	for (BatchCache::ManagedBuffer &buffer : cache.buffers_)
+		buffer.freeSpace = buffer.size;
+	cache.numBatches_ = 0;
 
-		// Split point if last command or split condition
-		if (i == srcQueue.size() - 1 || shouldSplit)
+	for (const BatchCache::Segment &segment : cache.segments_)
+	{
+		unsigned int lastSplit = segment.start;
+		if (segment.batched)
 		{
-			const GLShaderProgram *batchedShader = RenderResources::batchedShader(prevCommand->material().shaderProgram());
-			if (batchedShader && (endSplit - lastSplit) >= minBatchSize)
+			// Split point for the maximum batch size
+			while (lastSplit < segment.end)
 			{
-				// Split point for the maximum batch size
-				while (lastSplit < endSplit)
-				{
-					const unsigned int batchSize = endSplit - lastSplit;
-					unsigned int nextSplit = endSplit;
-					if (batchSize > maxBatchSize)
-						nextSplit = lastSplit + maxBatchSize;
-					else if (batchSize < minBatchSize)
-						break;
-
-					nctl::Array<RenderCommand *>::ConstIterator start = srcQueue.cBegin() + lastSplit;
-					nctl::Array<RenderCommand *>::ConstIterator end = srcQueue.cBegin() + nextSplit;
-
-					// Handling early splits while collecting (not enough UBO free space)
-					RenderCommand *batchCommand = collectCommands(start, end, start);
-					destQueue.pushBack(batchCommand);
-					lastSplit = start - srcQueue.cBegin();
-				}
+				const unsigned int batchSize = segment.end - lastSplit;
+				unsigned int nextSplit = segment.end;
+				if (batchSize > maxBatchSize)
+					nextSplit = lastSplit + maxBatchSize;
+				else if (batchSize < minBatchSize)
+					break;
+
+				nctl::Array<RenderCommand *>::ConstIterator start = srcQueue.cBegin() + lastSplit;
+				nctl::Array<RenderCommand *>::ConstIterator end = srcQueue.cBegin() + nextSplit;
+
+				// Handling early splits while collecting (not enough UBO free space)
+				RenderCommand *batchCommand = collectCommands(start, end, start, cache, cacheIsValid);
+				destQueue.pushBack(batchCommand);
+				lastSplit = start - srcQueue.cBegin();
 			}
+		}
+
+		// Passthrough for unsupported command types and for the last few commands that are less than the minimum batch size
+		for (unsigned int i = lastSplit; i < segment.end; i++)
+			destQueue.pushBack(srcQueue[i]);
+	}
+	cache.batches_.setSize(cache.numBatches_);
+	cache.frame_ = theApplication().numFrames();
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
 
-			// Also collect the very last command
-			endSplit = (i == srcQueue.size() - 1) ? i + 1 : i;
+bool RenderBatcher::isCacheValid(const nctl::Array<RenderCommand *> &srcQueue, const BatchCache &cache, unsigned int minBatchSize, unsigned int maxBatchSize) const
+{
+	if (srcQueue.size() != cache.commands_.size() || minBatchSize != cache.minBatchSize_ || maxBatchSize != cache.maxBatchSize_)
+		return false;
 
-			// Passthrough for unsupported command types and for the last few commands that are less than the minimum batch size
-			for (unsigned int j = lastSplit; j < endSplit; j++)
-				destQueue.pushBack(srcQueue[j]);
+	for (unsigned int i = 0; i < srcQueue.size(); i++)
+	{
+		if (srcQueue[i] != cache.commands_[i] || srcQueue[i]->materialSortKey() != cache.materialSortKeys_[i])
+			return false;
+	}
 
-			lastSplit = endSplit;
-		}
+	// A batched shader might have been unregistered, or might have completed linking, since the segments have been created
+	for (const BatchCache::Segment &segment : cache.segments_)
+	{
+		const bool shouldBeBatched = (readyBatchedShader(srcQueue[segment.start]) != nullptr && (segment.end - segment.start) >= minBatchSize);
+		if (segment.batched != shouldBeBatched)
+			return false;
 	}
 
-	// If the queue has only one command the for loop didn't execute, the command has to passthrough
-	if (srcQueue.size() == 1)
-		destQueue.pushBack(srcQueue[0]);
+	return true;
 }
 
-void RenderBatcher::reset()
+void RenderBatcher::createSegments(const nctl::Array<RenderCommand *> &srcQueue, BatchCache &cache, unsigned int minBatchSize)
 {
-	// Reset managed buffers
-	for (ManagedBuffer &buffer : buffers_)
-		buffer.freeSpace = buffer.size;
-}
+	cache.segments_.clear();
+	cache.batches_.clear();
+	cache.commands_.setSize(srcQueue.size());
+	cache.materialSortKeys_.setSize(srcQueue.size());
+	for (unsigned int i = 0; i < srcQueue.size(); i++)
+	{
+		cache.commands_[i] = srcQueue[i];
+		cache.materialSortKeys_[i] = srcQueue[i]->materialSortKey();
+	}
 
-///////////////////////////////////////////////////////////
-// PRIVATE FUNCTIONS
-///////////////////////////////////////////////////////////
+	unsigned int lastSplit = 0;
+	for (unsigned int i = 1; i <= srcQueue.size(); i++)
+	{
+		bool shouldSplit = (i == srcQueue.size());
+		if (shouldSplit == false)
+		{
+			const RenderCommand *command = srcQueue[i];
+			const RenderCommand *prevCommand = srcQueue[i - 1];
+
+			// Should split if the lower part of a material's sort key or the primitive type differ
+			shouldSplit = command->lowerMaterialSortKey() != prevCommand->lowerMaterialSortKey() ||
+			              command->geometry().primitiveType() != prevCommand->geometry().primitiveType();
+		}
+
+		if (shouldSplit)
+		{
+			BatchCache::Segment segment;
+			segment.start = lastSplit;
+			segment.end = i;
+			const GLShaderProgram *batchedShader = readyBatchedShader(srcQueue[lastSplit]);
+			segment.batched = (batchedShader != nullptr && (segment.end - segment.start) >= minBatchSize);
+			cache.segments_.pushBack(segment);
+
+			lastSplit = i;
+		}
+	}
+}
 
 RenderCommand *RenderBatcher::collectCommands(
     nctl::Array<RenderCommand *>::ConstIterator start,
     nctl::Array<RenderCommand *>::ConstIterator end,
-    nctl::Array<RenderCommand *>::ConstIterator &nextStart)
+    nctl::Array<RenderCommand *>::ConstIterator &nextStart,
+    BatchCache &cache, bool cacheIsValid)
 {
 	ASSERT(end > start);
 
@@ -149,7 +209,14 @@ RenderCommand *RenderBatcher::collectCommands(
 	if (commandAdded)
 		batchCommand->setType(refCommand->type());
 	instancesBlock = batchCommand->material().uniformBlock(Material::InstancesBlockName);
-	FATAL_ASSERT_MSG_X(instancesBlock != nullptr, "Batched shader does not have an %s uniform block", Material::InstancesBlockName);
+	// A batched shader with no instances block reads the instance block of every command from vertex attributes
+	const bool instancedAttributes = (instancesBlock == nullptr && batchedShader->attribute(Material::InstanceColorAttributeName) != nullptr);
+	FATAL_ASSERT_MSG_X(instancesBlock != nullptr || instancedAttributes, "Batched shader does not have an %s uniform block", Material::InstancesBlockName);
+	if (instancedAttributes)
+	{
+		const GLVertexFormat::Attribute *instanceColorAttribute = batchedShader->attribute(Material::InstanceColorAttributeName);
+		FATAL_ASSERT_MSG(instanceColorAttribute->stride() == singleInstanceBlockSizePacked, "Per-instance attributes do not match the instance block layout");
+	}
 
 	const unsigned long nonBlockUniformsSize = batchCommand->material().shaderProgram()->uniformsSize();
 	nctl::StaticString<GLUniformBlock::MaxNameLength> uniformBlockName;
@@ -177,18 +244,19 @@ RenderCommand *RenderBatcher::collectCommands(
 		if ((*it)->geometry().numIndices() > 0)
 			batchingWithIndices = true;
 
-		// Don't request more bytes than a UBO can hold
+		// Don't request more bytes than a UBO can hold, instances in vertex attributes are only limited by the VBO size
 		const unsigned long currentSize = nonBlockUniformsSize + nonInstancesBlocksSize + instancesBlockSize;
-		if (currentSize + singleInstanceBlockSize > UboMaxSize)
+		if (instancedAttributes == false && currentSize + singleInstanceBlockSize > UboMaxSize)
 			break;
-		else
+		else if (instancedAttributes == false)
 			instancesBlockSize += singleInstanceBlockSize;
 
 		++it;
 	}
 	nextStart = it;
 
-	batchCommand->material().setUniformsDataPointer(acquireMemory(nonBlockUniformsSize + nonInstancesBlocksSize + instancesBlockSize));
+	unsigned char *uniformsData = acquireMemory(cache, nonBlockUniformsSize + nonInstancesBlocksSize + instancesBlockSize);
+	batchCommand->material().setUniformsDataPointer(uniformsData);
 	// Copying data for non-instances uniform blocks from the first command in the batch
 	for (const GLUniformBlockCache &uniformBlockCache : allUniformBlocks)
 	{
@@ -239,6 +307,8 @@ RenderCommand *RenderBatcher::collectCommands(
 			if (batchingWithIndices)
 				numIndices = (numIndices > 0) ? numIndices + 2 : numVertices + 2;
 		}
+		else if (instancedAttributes)
+			vertexDataSize = singleInstanceBlockSizePacked;
 
 		// Don't request more bytes than a common VBO or IBO can hold
 		if (instancesVertexDataSize + vertexDataSize > maxVertexDataSize ||
@@ -255,11 +325,23 @@ RenderCommand *RenderBatcher::collectCommands(
 	}
 	nextStart = it;
 
+	// If the same batch got the same memory last frame, only the instances that have changed since then need to be copied
+	const unsigned int batchIndex = cache.numBatches_++;
+	const unsigned int batchSize = nextStart - start;
+	const bool reuseInstances = (cacheIsValid && instancedAttributes == false && batchIndex < cache.batches_.size() &&
+	                             cache.batches_[batchIndex].firstCommand == *start && cache.batches_[batchIndex].size == batchSize &&
+	                             cache.batches_[batchIndex].uniformsData == uniformsData);
+	if (batchIndex >= cache.batches_.size())
+		cache.batches_.setSize(batchIndex + 1);
+	cache.batches_[batchIndex].firstCommand = *start;
+	cache.batches_[batchIndex].size = batchSize;
+	cache.batches_[batchIndex].uniformsData = uniformsData;
+
 	// Remove the two missing degenerate vertices or indices from first and last elements
 	const unsigned long twoVerticesDataSize = 2 * (refCommand->geometry().numElementsPerVertex() + 1) * sizeof(GLfloat);
 	if (instancesIndicesAmount >= 2)
 		instancesIndicesAmount -= 2;
-	else if (instancesVertexDataSize >= twoVerticesDataSize)
+	else if (instancedAttributes == false && instancesVertexDataSize >= twoVerticesDataSize)
 		instancesVertexDataSize -= twoVerticesDataSize;
 
 	const unsigned int NumFloatsVertexFormat = refCommand->geometry().numElementsPerVertex();
@@ -270,7 +352,7 @@ RenderCommand *RenderBatcher::collectCommands(
 	float *destVtx = nullptr;
 	GLushort *destIdx = nullptr;
 
-	const bool batchedShaderHasAttributes = (batchedShader->numAttributes() > 1);
+	const bool batchedShaderHasAttributes = (instancedAttributes == false && batchedShader->numAttributes() > 1);
 	if (batchedShaderHasAttributes)
 	{
 		const unsigned int numFloats = instancesVertexDataSize / sizeof(GLfloat);
@@ -279,6 +361,12 @@ RenderCommand *RenderBatcher::collectCommands(
 		if (instancesIndicesAmount > 0)
 			destIdx = batchCommand->geometry().acquireIndexPointer(instancesIndicesAmount);
 	}
+	else if (instancedAttributes)
+	{
+		const unsigned int numFloats = instancesVertexDataSize / sizeof(GLfloat);
+		// No alignment to the instance size is needed, as the offset is applied to the attribute pointers
+		destVtx = batchCommand->geometry().acquireVertexPointer(numFloats);
+	}
 
 	it = start;
 	unsigned int instancesBlockOffset = 0;
@@ -286,12 +374,27 @@ RenderCommand *RenderBatcher::collectCommands(
 	while (it != nextStart)
 	{
 		RenderCommand *command = *it;
-		command->commitNodeTransformation();
+		// The instance data of last frame is still in the batch memory if the command has not changed since then
+		const bool instanceChanged = (reuseInstances == false || command->instanceUpdateFrame() > cache.frame_);
+		if (instanceChanged)
+		{
+			command->commitNodeTransformation();
 
-		const GLUniformBlockCache *singleInstanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		const bool dataCopied = instancesBlock->copyData(instancesBlockOffset, singleInstanceBlock->dataPointer(), singleInstanceBlockSize);
-		ASSERT(dataCopied);
-		instancesBlockOffset += singleInstanceBlockSize;
+			const GLUniformBlockCache *singleInstanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
+			if (instancedAttributes)
+			{
+				// The packed instance block has the same layout as the per-instance vertex format
+				memcpy(destVtx, singleInstanceBlock->dataPointer(), singleInstanceBlockSizePacked);
+				destVtx += singleInstanceBlockSizePacked / sizeof(GLfloat);
+			}
+			else
+			{
+				const bool dataCopied = instancesBlock->copyData(instancesBlockOffset, singleInstanceBlock->dataPointer(), singleInstanceBlockSize);
+				ASSERT(dataCopied);
+			}
+		}
+		if (instancedAttributes == false)
+			instancesBlockOffset += singleInstanceBlockSize;
 
 		if (batchedShaderHasAttributes)
 		{
@@ -359,7 +462,7 @@ RenderCommand *RenderBatcher::collectCommands(
 		++it;
 	}
 
-	if (batchedShaderHasAttributes)
+	if (batchedShaderHasAttributes || instancedAttributes)
 	{
 		batchCommand->geometry().releaseVertexPointer();
 		if (destIdx)
@@ -371,7 +474,8 @@ RenderCommand *RenderBatcher::collectCommands(
 	batchCommand->material().setBlendingEnabled(refCommand->material().isBlendingEnabled());
 	batchCommand->material().setBlendingFactors(refCommand->material().srcBlendingFactor(), refCommand->material().destBlendingFactor());
 	batchCommand->setBatchSize(nextStart - start);
-	batchCommand->material().uniformBlock(Material::InstancesBlockName)->setUsedSize(instancesBlockOffset);
+	if (instancesBlock)
+		instancesBlock->setUsedSize(instancesBlockOffset);
 	batchCommand->setLayer(refCommand->layer());
 	batchCommand->setVisitOrder(refCommand->visitOrder());
 
@@ -382,19 +486,27 @@ RenderCommand *RenderBatcher::collectCommands(
 		batchCommand->geometry().setNumElementsPerVertex(NumFloatsVertexFormatAndIndex);
 		batchCommand->geometry().setNumIndices(instancesIndicesAmount);
 	}
+	else if (instancedAttributes)
+	{
+		// Every instance is a triangle strip quad with vertices calculated from `gl_VertexID`
+		batchCommand->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
+		batchCommand->geometry().setNumElementsPerVertex(singleInstanceBlockSizePacked / sizeof(GLfloat));
+		batchCommand->geometry().setInstancedVertices(true);
+		batchCommand->setNumInstances(nextStart - start);
+	}
 	else
 		batchCommand->geometry().setDrawParameters(GL_TRIANGLES, 0, 6 * (nextStart - start));
 
 	return batchCommand;
 }
 
-unsigned char *RenderBatcher::acquireMemory(unsigned int bytes)
+unsigned char *RenderBatcher::acquireMemory(BatchCache &cache, unsigned int bytes)
 {
 	FATAL_ASSERT(bytes <= UboMaxSize);
 
 	unsigned char *ptr = nullptr;
 
-	for (ManagedBuffer &buffer : buffers_)
+	for (BatchCache::ManagedBuffer &buffer : cache.buffers_)
 	{
 		if (buffer.freeSpace >= bytes)
 		{
@@ -407,22 +519,22 @@ unsigned char *RenderBatcher::acquireMemory(unsigned int bytes)
 
 	if (ptr == nullptr)
 	{
-		createBuffer(UboMaxSize);
-		ptr = buffers_.back().buffer.get();
-		buffers_.back().freeSpace -= bytes;
+		createBuffer(cache, UboMaxSize);
+		ptr = cache.buffers_.back().buffer.get();
+		cache.buffers_.back().freeSpace -= bytes;
 	}
 
 	return ptr;
 }
 
-void RenderBatcher::createBuffer(unsigned int size)
+void RenderBatcher::createBuffer(BatchCache &cache, unsigned int size)
 {
-	ManagedBuffer managedBuffer;
+	BatchCache::ManagedBuffer managedBuffer;
 	managedBuffer.size = size;
 	managedBuffer.freeSpace = size;
 	managedBuffer.buffer = nctl::makeUnique<unsigned char[]>(size);
 
-	buffers_.pushBack(nctl::move(managedBuffer));
+	cache.buffers_.pushBack(nctl::move(managedBuffer));
 }
 
 }
@@ -9,14 +9,24 @@ namespace ncine {
 namespace {
 	/// The string used to output OpenGL debug group information
 	static nctl::StaticString<64> debugString;
+
+	/// The maximum time in nanoseconds to wait for a fence before checking it again
+	const GLuint64 FenceTimeout = 1000000000;
+
+#if !defined(WITH_OPENGLES) && !defined(__EMSCRIPTEN__)
+	/// The flags used to create the storage of a persistently mapped buffer
+	const GLbitfield PersistentStorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT;
+	/// The flags used to persistently map a buffer, written ranges are flushed explicitly
+	const GLbitfield PersistentMapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+#endif
 }
 
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
 
-RenderBuffersManager::RenderBuffersManager(bool useBufferMapping, unsigned long vboMaxSize, unsigned long iboMaxSize)
-    : buffers_(4)
+RenderBuffersManager::RenderBuffersManager(bool useBufferMapping, bool usePersistentMapping, unsigned long vboMaxSize, unsigned long iboMaxSize)
+    : withPersistentMapping_(false), currentRegion_(0), buffers_(4)
 {
 	BufferSpecifications &vboSpecs = specs_[BufferTypes::ARRAY];
 	vboSpecs.type = BufferTypes::ARRAY;
@@ -49,11 +59,32 @@ RenderBuffersManager::RenderBuffersManager(bool useBufferMapping, unsigned long
 	uboSpecs.maxSize = static_cast<unsigned long>(uboMaxSize);
 	uboSpecs.alignment = static_cast<unsigned int>(offsetAlignment);
 
+#if !defined(WITH_OPENGLES) && !defined(__EMSCRIPTEN__)
+	if (usePersistentMapping)
+	{
+		withPersistentMapping_ = gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::ARB_BUFFER_STORAGE);
+		if (withPersistentMapping_ == false)
+			LOGW("GL_ARB_buffer_storage is not available, falling back to per-frame buffer updates");
+	}
+#endif
+
 	// Create the first buffer for each type right away
 	for (unsigned int i = 0; i < BufferTypes::COUNT; i++)
 		createBuffer(specs_[i]);
 }
 
+RenderBuffersManager::~RenderBuffersManager()
+{
+	for (ManagedBuffer &buffer : buffers_)
+	{
+		for (unsigned int i = 0; i < NumRegions; i++)
+		{
+			if (buffer.fences[i] != nullptr)
+				glDeleteSync(buffer.fences[i]);
+		}
+	}
+}
+
 ///////////////////////////////////////////////////////////
 // PUBLIC FUNCTIONS
 ///////////////////////////////////////////////////////////
@@ -90,7 +121,8 @@ RenderBuffersManager::Parameters RenderBuffersManager::acquireMemory(BufferTypes
 	{
 		if (buffer.type == type)
 		{
-			const unsigned long offset = buffer.size - buffer.freeSpace;
+			// Aligning the offset from the start of the buffer, as a region might not start at a multiple of the alignment
+			const unsigned long offset = buffer.regionOffset + buffer.size - buffer.freeSpace;
 			const unsigned int alignAmount = (alignment - offset % alignment) % alignment;
 
 			if (buffer.freeSpace >= bytes + alignAmount)
@@ -108,11 +140,15 @@ RenderBuffersManager::Parameters RenderBuffersManager::acquireMemory(BufferTypes
 	if (params.object == nullptr)
 	{
 		createBuffer(specs_[type]);
-		params.object = buffers_.back().object.get();
-		params.offset = 0;
+		ManagedBuffer &buffer = buffers_.back();
+		const unsigned int alignAmount = (alignment - buffer.regionOffset % alignment) % alignment;
+		FATAL_ASSERT(buffer.freeSpace >= bytes + alignAmount);
+
+		params.object = buffer.object.get();
+		params.offset = buffer.regionOffset + alignAmount;
 		params.size = bytes;
-		buffers_.back().freeSpace -= bytes;
-		params.mapBase = buffers_.back().mapBase;
+		buffer.freeSpace -= bytes + alignAmount;
+		params.mapBase = buffer.mapBase;
 	}
 
 	return params;
@@ -130,10 +166,20 @@ void RenderBuffersManager::flushUnmap()
 	for (ManagedBuffer &buffer : buffers_)
 	{
 		RenderStatistics::gatherStatistics(buffer);
+		buffer.fenceWaits = 0;
+		buffer.fenceStalls = 0;
 		const unsigned long usedSize = buffer.size - buffer.freeSpace;
 		FATAL_ASSERT(usedSize <= specs_[buffer.type].maxSize);
 		buffer.freeSpace = buffer.size;
 
+		if (withPersistentMapping_)
+		{
+			// The buffer stays mapped, only the range written in the current region needs to be flushed
+			if (usedSize > 0)
+				buffer.object->flushMappedBufferRange(buffer.regionOffset, usedSize);
+			continue;
+		}
+
 		if (specs_[buffer.type].mapFlags == 0)
 		{
 			if (usedSize > 0)
@@ -155,6 +201,25 @@ void RenderBuffersManager::remap()
 	ZoneScoped;
 	GLDebug::ScopedGroup scoped("RenderBuffersManager::remap()");
 
+	if (withPersistentMapping_)
+	{
+		// Protecting the region used in this frame and moving to the next one
+		for (ManagedBuffer &buffer : buffers_)
+		{
+			ASSERT(buffer.fences[currentRegion_] == nullptr);
+			buffer.fences[currentRegion_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
+
+		currentRegion_ = (currentRegion_ + 1) % NumRegions;
+		for (ManagedBuffer &buffer : buffers_)
+		{
+			ASSERT(buffer.freeSpace == buffer.size);
+			waitForRegion(buffer);
+			buffer.regionOffset = currentRegion_ * buffer.regionStride;
+		}
+		return;
+	}
+
 	for (ManagedBuffer &buffer : buffers_)
 	{
 		ASSERT(buffer.freeSpace == buffer.size);
@@ -180,8 +245,18 @@ void RenderBuffersManager::createBuffer(const BufferSpecifications &specs)
 	managedBuffer.type = specs.type;
 	managedBuffer.size = specs.maxSize;
 	managedBuffer.object = nctl::makeUnique<GLBufferObject>(specs.target);
-	managedBuffer.object->bufferData(managedBuffer.size, nullptr, specs.usageFlags);
 	managedBuffer.freeSpace = managedBuffer.size;
+	if (withPersistentMapping_)
+	{
+		// Every region starts at an offset that respects the alignment of the buffer type
+		managedBuffer.regionStride = ((managedBuffer.size + specs.alignment - 1) / specs.alignment) * specs.alignment;
+		managedBuffer.regionOffset = currentRegion_ * managedBuffer.regionStride;
+#if !defined(WITH_OPENGLES) && !defined(__EMSCRIPTEN__)
+		managedBuffer.object->bufferStorage(managedBuffer.regionStride * NumRegions, nullptr, PersistentStorageFlags);
+#endif
+	}
+	else
+		managedBuffer.object->bufferData(managedBuffer.size, nullptr, specs.usageFlags);
 
 	switch (managedBuffer.type)
 	{
@@ -197,7 +272,13 @@ void RenderBuffersManager::createBuffer(const BufferSpecifications &specs)
 			break;
 	}
 
-	if (specs.mapFlags == 0)
+	if (withPersistentMapping_)
+	{
+#if !defined(WITH_OPENGLES) && !defined(__EMSCRIPTEN__)
+		managedBuffer.mapBase = static_cast<GLubyte *>(managedBuffer.object->mapBufferRange(0, managedBuffer.regionStride * NumRegions, PersistentMapFlags));
+#endif
+	}
+	else if (specs.mapFlags == 0)
 	{
 		managedBuffer.hostBuffer = nctl::makeUnique<GLubyte[]>(specs.maxSize);
 		managedBuffer.mapBase = managedBuffer.hostBuffer.get();
@@ -213,4 +294,28 @@ void RenderBuffersManager::createBuffer(const BufferSpecifications &specs)
 	GLDebug::messageInsert(debugString.data());
 }
 
+void RenderBuffersManager::waitForRegion(ManagedBuffer &buffer)
+{
+	GLsync &fence = buffer.fences[currentRegion_];
+	if (fence == nullptr)
+		return;
+
+	buffer.fenceWaits++;
+	GLenum waitResult = glClientWaitSync(fence, 0, 0);
+	if (waitResult == GL_TIMEOUT_EXPIRED)
+	{
+		ZoneScopedN("Fence stall");
+		// The GPU is still reading from the region, commands need to be flushed for the fence to ever be signaled
+		buffer.fenceStalls++;
+		do
+		{
+			waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeout);
+		} while (waitResult == GL_TIMEOUT_EXPIRED);
+	}
+	ASSERT(waitResult != GL_WAIT_FAILED);
+
+	glDeleteSync(fence);
+	fence = nullptr;
+}
+
 }
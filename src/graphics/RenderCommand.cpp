@@ -20,7 +20,7 @@ const float RenderCommand::LayerStep = 1.0f / static_cast<float>(0xFFFF);
 
 RenderCommand::RenderCommand(CommandTypes::Enum profilingType)
     : materialSortKey_(0), layer_(0),
-      numInstances_(0), batchSize_(0), transformationCommitted_(false),
+      numInstances_(0), batchSize_(0), instanceUpdateFrame_(~0UL), transformationCommitted_(false),
       profilingType_(profilingType), modelMatrix_(Matrix4x4f::Identity)
 {
 }
@@ -41,6 +41,17 @@ void RenderCommand::calculateMaterialSortKey()
 	materialSortKey_ = upper + lower;
 }
 
+void RenderCommand::offsetVisitOrder(uint16_t offset)
+{
+	// A zero visit order index means that the visit order is not used for this command
+	if (visitOrder_ == 0)
+		return;
+
+	visitOrder_ += offset;
+	const uint64_t upper = static_cast<uint64_t>(layerSortKey()) << 32;
+	materialSortKey_ = upper + lowerMaterialSortKey();
+}
+
 void RenderCommand::issue()
 {
 	ZoneScoped;
@@ -56,9 +67,11 @@ void RenderCommand::issue()
 		GLScissorTest::enable(scissorRect_);
 
 	unsigned int offset = 0;
+	if (geometry_.hasInstancedVertices_)
+		offset = geometry_.vboParams().offset;
 #if (defined(WITH_OPENGLES) && !GL_ES_VERSION_3_2) || defined(__EMSCRIPTEN__)
 	// Simulating missing `glDrawElementsBaseVertex()` on OpenGL ES 3.0
-	if (geometry_.numIndices_ > 0)
+	else if (geometry_.numIndices_ > 0)
 		offset = geometry_.vboParams().offset + (geometry_.firstVertex_ * geometry_.numElementsPerVertex_ * sizeof(GLfloat));
 #endif
 	material_.defineVertexFormat(geometry_.vboParams().object, geometry_.iboParams().object, offset);
@@ -91,14 +104,10 @@ void RenderCommand::commitNodeTransformation()
 
 	if (material_.shaderProgram_ && material_.shaderProgram_->status() == GLShaderProgram::Status::LINKED_WITH_INTROSPECTION)
 	{
-		GLUniformBlockCache *instanceBlock = material_.uniformBlock(Material::InstanceBlockName);
-		GLUniformCache *matrixUniform = instanceBlock
-		                                    ? instanceBlock->uniform(Material::ModelMatrixUniformName)
-		                                    : material_.uniform(Material::ModelMatrixUniformName);
-		if (matrixUniform)
+		if (material_.modelMatrixUniform_)
 		{
 			ZoneScopedN("Set model matrix");
-			matrixUniform->setFloatVector(modelMatrix_.data());
+			material_.modelMatrixUniform_->storeFloatVector(modelMatrix_.data(), 16);
 		}
 	}
 
@@ -133,7 +142,7 @@ void RenderCommand::commitAll()
 	// Copy the vertices and indices stored in host memory to video memory
 	/* This step is not needed if the command uses a custom VBO or IBO
 	 * or directly writes into the common one */
-	geometry_.commitVertices();
+	geometry_.commitVertices(numInstances_);
 	geometry_.commitIndices();
 
 	// The model matrix should always be updated before committing uniform blocks
@@ -4,12 +4,18 @@
 
 namespace ncine {
 
+namespace {
+	/// The initial capacity of the index of free commands, it grows with the number of shader programs
+	const unsigned int FreeCommandsIndexSize = 32;
+}
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
 
 RenderCommandPool::RenderCommandPool(unsigned int poolSize)
-    : freeCommandsPool_(poolSize), usedCommandsPool_(poolSize)
+    : freeCommandsPools_(FreeCommandsIndexSize), freeCommandsIndex_(FreeCommandsIndexSize),
+      numFreeCommands_(0), usedCommandsPool_(poolSize)
 {
 }
 
@@ -39,22 +45,17 @@ RenderCommand *RenderCommandPool::retrieve(GLShaderProgram *shaderProgram)
 {
 	RenderCommand *retrievedCommand = nullptr;
 
-	for (unsigned int i = 0; i < freeCommandsPool_.size(); i++)
+	const unsigned int *poolIndex = freeCommandsIndex_.find(shaderProgram);
+	if (poolIndex && freeCommandsPools_[*poolIndex].isEmpty() == false)
 	{
-		const unsigned int poolSize = freeCommandsPool_.size();
-		nctl::UniquePtr<RenderCommand> &command = freeCommandsPool_[i];
-		if (command && command->material().shaderProgram() == shaderProgram)
-		{
-			retrievedCommand = command.get();
-			usedCommandsPool_.pushBack(nctl::move(command));
-			command = nctl::move(freeCommandsPool_[poolSize - 1]);
-			freeCommandsPool_.popBack();
-			break;
-		}
-	}
+		nctl::Array<nctl::UniquePtr<RenderCommand>> &freeCommandsPool = freeCommandsPools_[*poolIndex];
+		retrievedCommand = freeCommandsPool.back().get();
+		usedCommandsPool_.pushBack(nctl::move(freeCommandsPool.back()));
+		freeCommandsPool.popBack();
+		numFreeCommands_--;
 
-	if (retrievedCommand)
 		RenderStatistics::addCommandPoolRetrieval();
+	}
 
 	return retrievedCommand;
 }
@@ -75,11 +76,35 @@ RenderCommand *RenderCommandPool::retrieveOrAdd(GLShaderProgram *shaderProgram,
 
 void RenderCommandPool::reset()
 {
-	RenderStatistics::gatherCommandPoolStatistics(usedCommandsPool_.size(), freeCommandsPool_.size());
+	RenderStatistics::gatherCommandPoolStatistics(usedCommandsPool_.size(), numFreeCommands_);
 
 	for (nctl::UniquePtr<RenderCommand> &command : usedCommandsPool_)
-		freeCommandsPool_.pushBack(nctl::move(command));
+	{
+		// The shader program of a command might have changed since it has been retrieved
+		nctl::Array<nctl::UniquePtr<RenderCommand>> &freeCommandsPool = freeCommands(command->material().shaderProgram());
+		freeCommandsPool.pushBack(nctl::move(command));
+	}
+	numFreeCommands_ += usedCommandsPool_.size();
 	usedCommandsPool_.clear();
 }
 
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::Array<nctl::UniquePtr<RenderCommand>> &RenderCommandPool::freeCommands(const GLShaderProgram *shaderProgram)
+{
+	const unsigned int *poolIndex = freeCommandsIndex_.find(shaderProgram);
+	if (poolIndex)
+		return freeCommandsPools_[*poolIndex];
+
+	// Keeping the load factor of the index low
+	if (freeCommandsIndex_.size() * 2 >= freeCommandsIndex_.capacity())
+		freeCommandsIndex_.rehash(freeCommandsIndex_.capacity() * 2);
+
+	freeCommandsIndex_.insert(shaderProgram, freeCommandsPools_.size());
+	freeCommandsPools_.emplaceBack();
+	return freeCommandsPools_.back();
+}
+
 }
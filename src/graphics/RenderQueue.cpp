@@ -23,8 +23,11 @@ namespace {
 ///////////////////////////////////////////////////////////
 
 RenderQueue::RenderQueue()
-    : opaqueQueue_(16), opaqueBatchedQueue_(16),
-      transparentQueue_(16), transparentBatchedQueue_(16)
+    : isDeferred_(false), opaqueQueue_(16), opaqueBatchedQueue_(16),
+      transparentQueue_(16), transparentBatchedQueue_(16),
+      opaqueSortKeys_(16), transparentSortKeys_(16),
+      sortKeysScratch_(16), sortedQueue_(16),
+      deferredCommands_(16), visitedNodes_(16), numCulledNodes_(0)
 {
 }
 
@@ -34,7 +37,7 @@ RenderQueue::RenderQueue()
 
 bool RenderQueue::isEmpty() const
 {
-	return (opaqueQueue_.isEmpty() && transparentQueue_.isEmpty());
+	return (opaqueQueue_.isEmpty() && transparentQueue_.isEmpty() && deferredCommands_.isEmpty());
 }
 
 void RenderQueue::addCommand(RenderCommand *command)
@@ -42,27 +45,49 @@ void RenderQueue::addCommand(RenderCommand *command)
 	// Calculating the material sorting key before adding the command to the queue
 	command->calculateMaterialSortKey();
 
-	if (command->material().isBlendingEnabled() == false)
-		opaqueQueue_.pushBack(command);
+	// The visit order of a deferred command is not final yet
+	if (isDeferred_)
+		deferredCommands_.pushBack(command);
 	else
-		transparentQueue_.pushBack(command);
+		addMergedCommand(command);
 }
 
-namespace {
+void RenderQueue::addMergedCommand(RenderCommand *command)
+{
+	ASSERT(isDeferred_ == false);
+
+	// Keys are collected while the command is still hot in cache, so that sorting never dereferences it
+	SortKey sortKey;
+	sortKey.materialKey = command->materialSortKey();
+	sortKey.idKey = command->idSortKey();
 
-	bool descendingOrder(const RenderCommand *a, const RenderCommand *b)
+	if (command->material().isBlendingEnabled() == false)
 	{
-		return (a->materialSortKey() != b->materialSortKey())
-		           ? a->materialSortKey() > b->materialSortKey()
-		           : a->idSortKey() > b->idSortKey();
+		// Inverting the keys to sort opaque commands in descending order
+		sortKey.materialKey = ~sortKey.materialKey;
+		sortKey.idKey = ~sortKey.idKey;
+		sortKey.commandIndex = opaqueQueue_.size();
+		opaqueSortKeys_.pushBack(sortKey);
+		opaqueQueue_.pushBack(command);
 	}
-
-	bool ascendingOrder(const RenderCommand *a, const RenderCommand *b)
+	else
 	{
-		return (a->materialSortKey() != b->materialSortKey())
-		           ? a->materialSortKey() < b->materialSortKey()
-		           : a->idSortKey() < b->idSortKey();
+		sortKey.commandIndex = transparentQueue_.size();
+		transparentSortKeys_.pushBack(sortKey);
+		transparentQueue_.pushBack(command);
 	}
+}
+
+void RenderQueue::addCulledNode()
+{
+	// Statistics are not thread-safe, culled nodes are accounted for when merging a deferred queue
+	if (isDeferred_)
+		numCulledNodes_++;
+	else
+		RenderStatistics::addCulledNode();
+}
+
+namespace {
 
 	const char *commandTypeString(const RenderCommand &command)
 	{
@@ -83,26 +108,54 @@ namespace {
 		}
 	}
 
+	/// Removes the commands whose shader program is linking again, they would stall the driver until it completes
+	void removeLinkingCommands(nctl::Array<RenderCommand *> &queue)
+	{
+		unsigned int numReadyCommands = 0;
+		for (unsigned int i = 0; i < queue.size(); i++)
+		{
+			GLShaderProgram *shaderProgram = queue[i]->material().shaderProgram();
+			if (shaderProgram == nullptr || shaderProgram->pollStatus() != GLShaderProgram::Status::LINKING)
+				queue[numReadyCommands++] = queue[i];
+		}
+		queue.setSize(numReadyCommands);
+	}
+
 }
 
 void RenderQueue::sortAndCommit()
 {
-	const bool batchingEnabled = theApplication().renderingSettings().batchingEnabled;
-
-	// Sorting the queues with the relevant orders
-	nctl::quicksort(opaqueQueue_.begin(), opaqueQueue_.end(), descendingOrder);
-	nctl::quicksort(transparentQueue_.begin(), transparentQueue_.end(), ascendingOrder);
+	sort();
+	// The sort keys are not needed anymore, commands can be removed without updating them
+	removeLinkingCommands(opaqueQueue_);
+	removeLinkingCommands(transparentQueue_);
+	// Always create batches after sorting
+	createBatches();
+	commit();
+}
 
-	nctl::Array<RenderCommand *> *opaques = batchingEnabled ? &opaqueBatchedQueue_ : &opaqueQueue_;
-	nctl::Array<RenderCommand *> *transparents = batchingEnabled ? &transparentBatchedQueue_ : &transparentQueue_;
+void RenderQueue::sort()
+{
+	ZoneScopedN("Sorting");
+	sortQueue(opaqueQueue_, opaqueSortKeys_);
+	sortQueue(transparentQueue_, transparentSortKeys_);
+}
 
-	if (batchingEnabled)
+void RenderQueue::createBatches()
+{
+	if (theApplication().renderingSettings().batchingEnabled)
 	{
 		ZoneScopedN("Batching");
-		// Always create batches after sorting
-		RenderResources::renderBatcher().createBatches(opaqueQueue_, opaqueBatchedQueue_);
-		RenderResources::renderBatcher().createBatches(transparentQueue_, transparentBatchedQueue_);
+		RenderResources::renderBatcher().createBatches(opaqueQueue_, opaqueBatchedQueue_, opaqueBatchCache_);
+		RenderResources::renderBatcher().createBatches(transparentQueue_, transparentBatchedQueue_, transparentBatchCache_);
 	}
+}
+
+void RenderQueue::commit()
+{
+	const bool batchingEnabled = theApplication().renderingSettings().batchingEnabled;
+	nctl::Array<RenderCommand *> *opaques = batchingEnabled ? &opaqueBatchedQueue_ : &opaqueQueue_;
+	nctl::Array<RenderCommand *> *transparents = batchingEnabled ? &transparentBatchedQueue_ : &transparentQueue_;
 
 	// Avoid GPU stalls by uploading to VBOs, IBOs and UBOs before drawing
 	if (opaques->isEmpty() == false)
@@ -201,8 +254,35 @@ void RenderQueue::clear()
 	opaqueBatchedQueue_.clear();
 	transparentQueue_.clear();
 	transparentBatchedQueue_.clear();
+	opaqueSortKeys_.clear();
+	transparentSortKeys_.clear();
+	deferredCommands_.clear();
+	visitedNodes_.clear();
+	numCulledNodes_ = 0;
+}
 
-	RenderResources::renderBatcher().reset();
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void RenderQueue::sortQueue(nctl::Array<RenderCommand *> &queue, nctl::Array<SortKey> &sortKeys)
+{
+	const unsigned int size = sortKeys.size();
+	if (size < 2)
+		return;
+
+	SortKey *first = sortKeys.data();
+	SortKey *last = first + size;
+	sortKeysScratch_.setSize(size);
+
+	// Least significant key first, the radix sort is stable
+	nctl::radixSort(first, last, sortKeysScratch_.data(), [](const SortKey &key) { return key.idKey; });
+	nctl::radixSort(first, last, sortKeysScratch_.data(), [](const SortKey &key) { return key.materialKey; });
+
+	sortedQueue_.setSize(size);
+	for (unsigned int i = 0; i < size; i++)
+		sortedQueue_[i] = queue[sortKeys[i].commandIndex];
+	nctl::swap(queue, sortedQueue_);
 }
 
 }
@@ -5,13 +5,19 @@
 #include "RenderVaoPool.h"
 #include "RenderCommandPool.h"
 #include "RenderBatcher.h"
+#include "CullingGrid.h"
+#include "DirtySceneUpdate.h"
+#include "BinaryShaderCache.h"
+#include "TextureUploadQueue.h"
+#include "ServiceLocator.h"
 #include "Camera.h"
+#include "ShaderState.h"
 #include "Application.h"
 
+#include "FileSystem.h" // for dataPath() and savePath()
+
 #ifdef WITH_EMBEDDED_SHADERS
 	#include "shader_strings.h"
-#else
-	#include "FileSystem.h" // for dataPath()
 #endif
 
 namespace ncine {
@@ -24,9 +30,16 @@ nctl::UniquePtr<RenderBuffersManager> RenderResources::buffersManager_;
 nctl::UniquePtr<RenderVaoPool> RenderResources::vaoPool_;
 nctl::UniquePtr<RenderCommandPool> RenderResources::renderCommandPool_;
 nctl::UniquePtr<RenderBatcher> RenderResources::renderBatcher_;
+nctl::UniquePtr<CullingGrid> RenderResources::cullingGrid_;
+nctl::UniquePtr<DirtySceneUpdate> RenderResources::dirtySceneUpdate_;
+nctl::UniquePtr<BinaryShaderCache> RenderResources::binaryShaderCache_;
+nctl::UniquePtr<TextureUploadQueue> RenderResources::textureUploadQueue_;
+
+const char *RenderResources::BinaryShaderCacheDirectory = "ncine_shader_cache";
 
 nctl::UniquePtr<GLShaderProgram> RenderResources::defaultShaderPrograms_[NumDefaultShaderPrograms];
 nctl::HashMap<const GLShaderProgram *, GLShaderProgram *> RenderResources::batchedShaders_(32);
+nctl::Array<ShaderState *> RenderResources::pendingShaderStates_;
 
 unsigned char RenderResources::cameraUniformsBuffer_[UniformsBufferSize];
 nctl::HashMap<GLShaderProgram *, RenderResources::CameraUniformData> RenderResources::cameraUniformDataMap_(32);
@@ -78,6 +91,26 @@ bool RenderResources::unregisterBatchedShader(const GLShaderProgram *shader)
 	return removed;
 }
 
+void RenderResources::addPendingShaderState(ShaderState *shaderState)
+{
+	ASSERT(shaderState != nullptr);
+	pendingShaderStates_.pushBack(shaderState);
+}
+
+bool RenderResources::removePendingShaderState(ShaderState *shaderState)
+{
+	ASSERT(shaderState != nullptr);
+	for (unsigned int i = 0; i < pendingShaderStates_.size(); i++)
+	{
+		if (pendingShaderStates_[i] == shaderState)
+		{
+			pendingShaderStates_.unorderedRemoveAt(i);
+			return true;
+		}
+	}
+	return false;
+}
+
 RenderResources::CameraUniformData *RenderResources::findCameraUniformData(GLShaderProgram *shaderProgram)
 {
 	return cameraUniformDataMap_.find(shaderProgram);
@@ -144,6 +177,58 @@ void RenderResources::setDefaultAttributesParameters(GLShaderProgram &shaderProg
 			if (positionAttribute->stride() == 0)
 				positionAttribute->setVboParameters(sizeof(VertexFormatPos2), reinterpret_cast<void *>(offsetof(VertexFormatPos2, position)));
 		}
+
+		GLVertexFormat::Attribute *instanceColorAttribute = shaderProgram.attribute(Material::InstanceColorAttributeName);
+		GLVertexFormat::Attribute *instanceTexRectAttribute = shaderProgram.attribute(Material::InstanceTexRectAttributeName);
+		GLVertexFormat::Attribute *instanceSpriteSizeAttribute = shaderProgram.attribute(Material::InstanceSpriteSizeAttributeName);
+
+		// Per-instance attributes of batched sprites, advancing once for every instance
+		if (instanceColorAttribute != nullptr && instanceSpriteSizeAttribute != nullptr && instanceColorAttribute->stride() == 0)
+		{
+			const bool hasTexRect = (instanceTexRectAttribute != nullptr);
+			const GLsizei stride = hasTexRect ? sizeof(InstanceFormatSprite) : sizeof(InstanceFormatSpriteNoTexture);
+
+			for (unsigned int i = 0; i < Material::NumModelMatrixAttributes; i++)
+			{
+				GLVertexFormat::Attribute *modelMatrixAttribute = shaderProgram.attribute(Material::ModelMatrixAttributeNames[i]);
+				ASSERT(modelMatrixAttribute != nullptr);
+				if (modelMatrixAttribute != nullptr)
+				{
+					// Each attribute is a column of the model matrix
+					modelMatrixAttribute->setVboParameters(stride, reinterpret_cast<void *>(offsetof(InstanceFormatSprite, modelMatrix) + i * 4 * sizeof(GLfloat)));
+					modelMatrixAttribute->setDivisor(1);
+				}
+			}
+
+			instanceColorAttribute->setVboParameters(stride, reinterpret_cast<void *>(hasTexRect ? offsetof(InstanceFormatSprite, color) : offsetof(InstanceFormatSpriteNoTexture, color)));
+			instanceColorAttribute->setDivisor(1);
+			if (hasTexRect)
+			{
+				instanceTexRectAttribute->setVboParameters(stride, reinterpret_cast<void *>(offsetof(InstanceFormatSprite, texRect)));
+				instanceTexRectAttribute->setDivisor(1);
+			}
+			instanceSpriteSizeAttribute->setVboParameters(stride, reinterpret_cast<void *>(hasTexRect ? offsetof(InstanceFormatSprite, spriteSize) : offsetof(InstanceFormatSpriteNoTexture, spriteSize)));
+			instanceSpriteSizeAttribute->setDivisor(1);
+		}
+
+		GLVertexFormat::Attribute *particlePositionAttribute = shaderProgram.attribute(Material::ParticlePositionAttributeName);
+		GLVertexFormat::Attribute *particleScaleAttribute = shaderProgram.attribute(Material::ParticleScaleAttributeName);
+		GLVertexFormat::Attribute *particleRotationAttribute = shaderProgram.attribute(Material::ParticleRotationAttributeName);
+		GLVertexFormat::Attribute *particleColorAttribute = shaderProgram.attribute(Material::ParticleColorAttributeName);
+
+		// Per-instance attributes of particles stored in arrays, advancing once for every particle
+		if (particlePositionAttribute != nullptr && particleScaleAttribute != nullptr &&
+		    particleRotationAttribute != nullptr && particleColorAttribute != nullptr && particlePositionAttribute->stride() == 0)
+		{
+			particlePositionAttribute->setVboParameters(sizeof(InstanceFormatParticle), reinterpret_cast<void *>(offsetof(InstanceFormatParticle, position)));
+			particlePositionAttribute->setDivisor(1);
+			particleScaleAttribute->setVboParameters(sizeof(InstanceFormatParticle), reinterpret_cast<void *>(offsetof(InstanceFormatParticle, scale)));
+			particleScaleAttribute->setDivisor(1);
+			particleRotationAttribute->setVboParameters(sizeof(InstanceFormatParticle), reinterpret_cast<void *>(offsetof(InstanceFormatParticle, rotation)));
+			particleRotationAttribute->setDivisor(1);
+			particleColorAttribute->setVboParameters(sizeof(InstanceFormatParticle), reinterpret_cast<void *>(offsetof(InstanceFormatParticle, color)));
+			particleColorAttribute->setDivisor(1);
+		}
 	}
 }
 
@@ -208,10 +293,17 @@ void RenderResources::create()
 	LOGI("Creating rendering resources...");
 
 	const AppConfiguration &appCfg = theApplication().appConfiguration();
-	buffersManager_ = nctl::makeUnique<RenderBuffersManager>(appCfg.useBufferMapping, appCfg.vboSize, appCfg.iboSize);
+	buffersManager_ = nctl::makeUnique<RenderBuffersManager>(appCfg.useBufferMapping, appCfg.usePersistentMapping, appCfg.vboSize, appCfg.iboSize);
 	vaoPool_ = nctl::makeUnique<RenderVaoPool>(appCfg.vaoPoolSize);
 	renderCommandPool_ = nctl::makeUnique<RenderCommandPool>(appCfg.vaoPoolSize);
 	renderBatcher_ = nctl::makeUnique<RenderBatcher>();
+	if (appCfg.cullingGridCellSize > 0.0f)
+		cullingGrid_ = nctl::makeUnique<CullingGrid>(appCfg.cullingGridCellSize);
+	if (appCfg.useDirtyListUpdate)
+		dirtySceneUpdate_ = nctl::makeUnique<DirtySceneUpdate>();
+	if (appCfg.useBinaryShaderCache && fs::savePath().isEmpty() == false)
+		binaryShaderCache_ = nctl::makeUnique<BinaryShaderCache>(fs::joinPath(fs::savePath(), BinaryShaderCacheDirectory).data());
+	textureUploadQueue_ = nctl::makeUnique<TextureUploadQueue>(appCfg.textureUploadBudget);
 	defaultCamera_ = nctl::makeUnique<Camera>();
 	currentCamera_ = defaultCamera_.get();
 
@@ -234,7 +326,12 @@ void RenderResources::create()
 		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_NO_TEXTURE)], "batched_meshsprites_notexture_vs.glsl", "sprite_notexture_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Batched_MeshSprites_NoTexture" },
 		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_ALPHA)], "batched_textnodes_vs.glsl", "textnode_alpha_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Batched_TextNodes_Alpha" },
 		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)], "batched_textnodes_vs.glsl", "textnode_red_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Batched_TextNodes_Red" },
-		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_SPRITE)], "batched_textnodes_vs.glsl", "sprite_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Batched_TextNodes_Sprite" }
+		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_SPRITE)], "batched_textnodes_vs.glsl", "sprite_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Batched_TextNodes_Sprite" },
+		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES)], "instanced_sprites_vs.glsl", "sprite_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Instanced_Sprites" },
+		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES_GRAY)], "instanced_sprites_vs.glsl", "sprite_gray_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Instanced_Sprites_Gray" },
+		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES_NO_TEXTURE)], "instanced_sprites_notexture_vs.glsl", "sprite_notexture_fs.glsl", GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Instanced_Sprites_NoTexture" },
+		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::PARTICLES)], "particles_vs.glsl", "sprite_fs.glsl", GLShaderProgram::Introspection::ENABLED, "Particles" },
+		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::PARTICLES_GRAY)], "particles_vs.glsl", "sprite_gray_fs.glsl", GLShaderProgram::Introspection::ENABLED, "Particles_Gray" }
 #else
 		// Skipping the initial new line character of the raw string literal
 		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE)], ShaderStrings::sprite_vs + 1, ShaderStrings::sprite_fs + 1, GLShaderProgram::Introspection::ENABLED, "Sprite" },
@@ -254,30 +351,67 @@ void RenderResources::create()
 		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_NO_TEXTURE)], ShaderStrings::batched_meshsprites_notexture_vs + 1, ShaderStrings::sprite_notexture_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Batched_MeshSprites_NoTexture" },
 		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_ALPHA)], ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::textnode_alpha_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Batched_TextNodes_Alpha" },
 		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)], ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::textnode_red_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Batched_TextNodes_Red" },
-		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_SPRITE)], ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::sprite_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Batched_TextNodes_Sprite" }
+		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_SPRITE)], ShaderStrings::batched_textnodes_vs + 1, ShaderStrings::sprite_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Batched_TextNodes_Sprite" },
+		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES)], ShaderStrings::instanced_sprites_vs + 1, ShaderStrings::sprite_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Instanced_Sprites" },
+		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES_GRAY)], ShaderStrings::instanced_sprites_vs + 1, ShaderStrings::sprite_gray_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Instanced_Sprites_Gray" },
+		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES_NO_TEXTURE)], ShaderStrings::instanced_sprites_notexture_vs + 1, ShaderStrings::sprite_notexture_fs + 1, GLShaderProgram::Introspection::NO_UNIFORMS_IN_BLOCKS, "Instanced_Sprites_NoTexture" },
+		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::PARTICLES)], ShaderStrings::particles_vs + 1, ShaderStrings::sprite_fs + 1, GLShaderProgram::Introspection::ENABLED, "Particles" },
+		{ RenderResources::defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::PARTICLES_GRAY)], ShaderStrings::particles_vs + 1, ShaderStrings::sprite_gray_fs + 1, GLShaderProgram::Introspection::ENABLED, "Particles_Gray" }
 #endif
 	};
 
-	const GLShaderProgram::QueryPhase queryPhase = appCfg.deferShaderQueries ? GLShaderProgram::QueryPhase::DEFERRED : GLShaderProgram::QueryPhase::IMMEDIATE;
+#if defined(GL_COMPLETION_STATUS_KHR) && !defined(__EMSCRIPTEN__)
+	if (appCfg.useAsyncShaderCompilation && theServiceLocator().gfxCapabilities().hasExtension(IGfxCapabilities::GLExtensions::KHR_PARALLEL_SHADER_COMPILE))
+	{
+		// Let the driver choose the number of compiler threads
+		glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+	}
+#endif
+
+	// All programs are compiled and linked up front, so that an asynchronous driver can work on them in parallel
+	const bool deferQueries = (appCfg.deferShaderQueries || appCfg.useAsyncShaderCompilation);
+	const GLShaderProgram::QueryPhase queryPhase = deferQueries ? GLShaderProgram::QueryPhase::DEFERRED : GLShaderProgram::QueryPhase::IMMEDIATE;
 	const unsigned int numShaderToLoad = (sizeof(shadersToLoad) / sizeof(*shadersToLoad));
 	FATAL_ASSERT(numShaderToLoad <= NumDefaultShaderPrograms);
+	// The shader programs with per-instance attributes are the last ones to load, followed by the particle ones
+	const unsigned int firstParticleShader = numShaderToLoad - NumParticleShaderPrograms;
+	const unsigned int firstInstancedShader = firstParticleShader - NumInstancedShaderPrograms;
 	for (unsigned int i = 0; i < numShaderToLoad; i++)
 	{
+		if ((i >= firstInstancedShader && i < firstParticleShader && appCfg.useInstancedAttributes == false) ||
+		    (i >= firstParticleShader && appCfg.useParticleArrays == false))
+		{
+			continue;
+		}
+
 		const ShaderLoad &shaderToLoad = shadersToLoad[i];
 
 		shaderToLoad.shaderProgram = nctl::makeUnique<GLShaderProgram>(queryPhase);
 #ifndef WITH_EMBEDDED_SHADERS
 		shaderToLoad.shaderProgram->attachShader(GL_VERTEX_SHADER, (fs::dataPath() + "shaders/" + shaderToLoad.vertexShader).data());
 		shaderToLoad.shaderProgram->attachShader(GL_FRAGMENT_SHADER, (fs::dataPath() + "shaders/" + shaderToLoad.fragmentShader).data());
-#else
-		shaderToLoad.shaderProgram->attachShaderFromString(GL_VERTEX_SHADER, shaderToLoad.vertexShader);
-		shaderToLoad.shaderProgram->attachShaderFromString(GL_FRAGMENT_SHADER, shaderToLoad.fragmentShader);
-#endif
 		shaderToLoad.shaderProgram->setObjectLabel(shaderToLoad.objectLabel);
 		const bool hasLinked = shaderToLoad.shaderProgram->link(shaderToLoad.introspection);
+#else
+		const uint64_t sourcesHash = (binaryShaderCache_ != nullptr) ? binaryShaderCache_->hashSources(shaderToLoad.vertexShader, shaderToLoad.fragmentShader) : 0;
+		bool hasLinked = shaderToLoad.shaderProgram->linkFromBinaryCache(sourcesHash, shaderToLoad.introspection);
+		if (hasLinked == false)
+		{
+			shaderToLoad.shaderProgram->attachShaderFromString(GL_VERTEX_SHADER, shaderToLoad.vertexShader);
+			shaderToLoad.shaderProgram->attachShaderFromString(GL_FRAGMENT_SHADER, shaderToLoad.fragmentShader);
+			hasLinked = shaderToLoad.shaderProgram->link(shaderToLoad.introspection);
+		}
+		shaderToLoad.shaderProgram->setObjectLabel(shaderToLoad.objectLabel);
+#endif
 		FATAL_ASSERT(hasLinked == true);
 	}
 
+	if (binaryShaderCache_ != nullptr)
+	{
+		const BinaryShaderCache::Statistics &stats = binaryShaderCache_->statistics();
+		LOGI_X("Binary shader cache: %u programs loaded, %u rejected", stats.numLoaded, stats.numRejected);
+	}
+
 	registerDefaultBatchedShaders();
 
 	// Calculating a default projection matrix for all shader programs
@@ -293,20 +427,27 @@ void RenderResources::createMinimal()
 	LOGI("Creating a minimal set of rendering resources...");
 
 	const AppConfiguration &appCfg = theApplication().appConfiguration();
-	buffersManager_ = nctl::makeUnique<RenderBuffersManager>(appCfg.useBufferMapping, appCfg.vboSize, appCfg.iboSize);
+	buffersManager_ = nctl::makeUnique<RenderBuffersManager>(appCfg.useBufferMapping, appCfg.usePersistentMapping, appCfg.vboSize, appCfg.iboSize);
 	vaoPool_ = nctl::makeUnique<RenderVaoPool>(appCfg.vaoPoolSize);
+	textureUploadQueue_ = nctl::makeUnique<TextureUploadQueue>(appCfg.textureUploadBudget);
 
 	LOGI("Minimal rendering resources created");
 }
 
 void RenderResources::dispose()
 {
+	pendingShaderStates_.clear();
+
 	for (nctl::UniquePtr<GLShaderProgram> &shaderProgram : defaultShaderPrograms_)
 		shaderProgram.reset(nullptr);
 
 	ASSERT(cameraUniformDataMap_.isEmpty());
 
 	defaultCamera_.reset(nullptr);
+	textureUploadQueue_.reset(nullptr);
+	binaryShaderCache_.reset(nullptr);
+	dirtySceneUpdate_.reset(nullptr);
+	cullingGrid_.reset(nullptr);
 	renderBatcher_.reset(nullptr);
 	renderCommandPool_.reset(nullptr);
 	vaoPool_.reset(nullptr);
@@ -317,9 +458,19 @@ void RenderResources::dispose()
 
 void RenderResources::registerDefaultBatchedShaders()
 {
-	batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_SPRITES)].get());
-	batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE_GRAY)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_SPRITES_GRAY)].get());
-	batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE_NO_TEXTURE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_SPRITES_NO_TEXTURE)].get());
+	if (theApplication().appConfiguration().useInstancedAttributes)
+	{
+		// Sprite batches are not limited by the size of a uniform block when reading instances from vertex attributes
+		batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES)].get());
+		batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE_GRAY)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES_GRAY)].get());
+		batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE_NO_TEXTURE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::INSTANCED_SPRITES_NO_TEXTURE)].get());
+	}
+	else
+	{
+		batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_SPRITES)].get());
+		batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE_GRAY)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_SPRITES_GRAY)].get());
+		batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::SPRITE_NO_TEXTURE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_SPRITES_NO_TEXTURE)].get());
+	}
 	batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::MESH_SPRITE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES)].get());
 	batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::MESH_SPRITE_GRAY)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_GRAY)].get());
 	batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::MESH_SPRITE_NO_TEXTURE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_MESH_SPRITES_NO_TEXTURE)].get());
@@ -328,4 +479,11 @@ void RenderResources::registerDefaultBatchedShaders()
 	batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::TEXTNODE_SPRITE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_SPRITE)].get());
 }
 
+void RenderResources::updatePendingShaderStates()
+{
+	// Iterating backwards as a state removes itself from the array when its shader is applied
+	for (int i = static_cast<int>(pendingShaderStates_.size()) - 1; i >= 0; i--)
+		pendingShaderStates_[i]->updatePendingShader();
+}
+
 }
@@ -77,6 +77,8 @@ void RenderStatistics::gatherStatistics(const RenderBuffersManager::ManagedBuffe
 	typedBuffers_[typeIndex].count++;
 	typedBuffers_[typeIndex].size += buffer.size;
 	typedBuffers_[typeIndex].usedSpace += buffer.size - buffer.freeSpace;
+	typedBuffers_[typeIndex].fenceWaits += buffer.fenceWaits;
+	typedBuffers_[typeIndex].fenceStalls += buffer.fenceStalls;
 }
 
 }
@@ -16,7 +16,8 @@ namespace {
 ///////////////////////////////////////////////////////////
 
 RenderVaoPool::RenderVaoPool(unsigned int vaoPoolSize)
-    : vaoPool_(vaoPoolSize, nctl::ArrayMode::FIXED_CAPACITY)
+    : vaoPool_(vaoPoolSize, nctl::ArrayMode::FIXED_CAPACITY), formatIndex_(vaoPoolSize * 2),
+      mostRecent_(InvalidIndex), leastRecent_(InvalidIndex)
 {
 	// Start with a VAO bound to the OpenGL context
 	GLVertexFormat format;
@@ -29,41 +30,49 @@ RenderVaoPool::RenderVaoPool(unsigned int vaoPoolSize)
 
 void RenderVaoPool::bindVao(const GLVertexFormat &vertexFormat)
 {
-	bool vaoFound = false;
-	for (VaoBinding &binding : vaoPool_)
+	const uint64_t formatHash = vertexFormat.hash();
+	const unsigned int *foundIndex = formatIndex_.find(formatHash);
+
+	if (foundIndex && vaoPool_[*foundIndex].format == vertexFormat)
 	{
-		if (binding.format == vertexFormat)
+		VaoBinding &binding = vaoPool_[*foundIndex];
+		const bool bindChanged = binding.object->bind();
+		const GLuint iboHandle = vertexFormat.ibo() ? vertexFormat.ibo()->glHandle() : 0;
+		if (bindChanged)
 		{
-			vaoFound = true;
-			const bool bindChanged = binding.object->bind();
-			const GLuint iboHandle = vertexFormat.ibo() ? vertexFormat.ibo()->glHandle() : 0;
-			if (bindChanged)
-			{
-				if (GLDebug::isAvailable())
-					insertGLDebugMessage(binding);
+			if (GLDebug::isAvailable())
+				insertGLDebugMessage(binding);
 
-				// Binding a VAO changes the current bound element array buffer
-				GLBufferObject::setBoundHandle(GL_ELEMENT_ARRAY_BUFFER, iboHandle);
-			}
-			else
-			{
-				// The VAO was already bound but it is not known if the bound element array buffer changed in the meantime
-				GLBufferObject::bindHandle(GL_ELEMENT_ARRAY_BUFFER, iboHandle);
-			}
-			binding.lastBindTime = TimeStamp::now();
-			RenderStatistics::addVaoPoolBinding();
-			break;
+			// Binding a VAO changes the current bound element array buffer
+			GLBufferObject::setBoundHandle(GL_ELEMENT_ARRAY_BUFFER, iboHandle);
 		}
+		else
+		{
+			// The VAO was already bound but it is not known if the bound element array buffer changed in the meantime
+			GLBufferObject::bindHandle(GL_ELEMENT_ARRAY_BUFFER, iboHandle);
+		}
+		markAsMostRecent(*foundIndex);
+		RenderStatistics::addVaoPoolBinding();
 	}
-
-	if (vaoFound == false)
+	else
 	{
 		unsigned int index = 0;
-		if (vaoPool_.size() < vaoPool_.capacity())
+		if (foundIndex)
+		{
+			// A different format with the same hash, its VAO is defined again and keeps the same key
+			index = *foundIndex;
+			debugString.format("Reuse and define VAO 0x%lx (%u) after a hash collision", uintptr_t(vaoPool_[index].object.get()), index);
+			GLDebug::messageInsert(debugString.data());
+			RenderStatistics::addVaoPoolReuse();
+		}
+		else if (vaoPool_.size() < vaoPool_.capacity())
 		{
 			vaoPool_.emplaceBack();
 			vaoPool_.back().object = nctl::makeUnique<GLVertexArrayObject>();
+			vaoPool_.back().moreRecent = InvalidIndex;
+			vaoPool_.back().lessRecent = InvalidIndex;
 			index = vaoPool_.size() - 1;
+			formatIndex_.insert(formatHash, index);
 
 			if (GLDebug::isAvailable())
 			{
@@ -76,16 +85,10 @@ void RenderVaoPool::bindVao(const GLVertexFormat &vertexFormat)
 		}
 		else
 		{
-			// Find the least recently used VAO
-			TimeStamp time = vaoPool_[0].lastBindTime;
-			for (unsigned int i = 1; i < vaoPool_.size(); i++)
-			{
-				if (vaoPool_[i].lastBindTime < time)
-				{
-					index = i;
-					time = vaoPool_[i].lastBindTime;
-				}
-			}
+			// Reuse the least recently used VAO
+			index = leastRecent_;
+			formatIndex_.remove(vaoPool_[index].formatHash);
+			formatIndex_.insert(formatHash, index);
 
 			debugString.format("Reuse and define VAO 0x%lx (%u)", uintptr_t(vaoPool_[index].object.get()), index);
 			GLDebug::messageInsert(debugString.data());
@@ -99,7 +102,8 @@ void RenderVaoPool::bindVao(const GLVertexFormat &vertexFormat)
 		GLBufferObject::setBoundHandle(GL_ELEMENT_ARRAY_BUFFER, oldIboHandle);
 		vaoPool_[index].format = vertexFormat;
 		vaoPool_[index].format.define();
-		vaoPool_[index].lastBindTime = TimeStamp::now();
+		vaoPool_[index].formatHash = formatHash;
+		markAsMostRecent(index);
 		RenderStatistics::addVaoPoolBinding();
 	}
 
@@ -110,6 +114,30 @@ void RenderVaoPool::bindVao(const GLVertexFormat &vertexFormat)
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
 
+void RenderVaoPool::markAsMostRecent(unsigned int index)
+{
+	if (index == mostRecent_)
+		return;
+
+	// Unlinking the binding, unless it has just been added to the pool
+	VaoBinding &binding = vaoPool_[index];
+	if (binding.moreRecent != InvalidIndex)
+		vaoPool_[binding.moreRecent].lessRecent = binding.lessRecent;
+	if (binding.lessRecent != InvalidIndex)
+		vaoPool_[binding.lessRecent].moreRecent = binding.moreRecent;
+	else if (leastRecent_ == index)
+		leastRecent_ = binding.moreRecent;
+
+	binding.moreRecent = InvalidIndex;
+	binding.lessRecent = mostRecent_;
+	if (mostRecent_ != InvalidIndex)
+		vaoPool_[mostRecent_].moreRecent = index;
+	mostRecent_ = index;
+
+	if (leastRecent_ == InvalidIndex)
+		leastRecent_ = index;
+}
+
 void RenderVaoPool::insertGLDebugMessage(const VaoBinding &binding)
 {
 	debugString.format("Bind VAO 0x%lx (", uintptr_t(binding.object.get()));
@@ -1,7 +1,16 @@
 #include "SceneNode.h"
 #include "Application.h"
+#include "RenderResources.h"
+#include "CullingGrid.h"
+#include "DirtySceneUpdate.h"
 #include "tracy.h"
 
+#ifdef WITH_THREADS
+	#include "ParallelSceneUpdate.h"
+	#include "ParallelSceneVisit.h"
+	#include "RenderQueue.h"
+#endif
+
 namespace ncine {
 
 ///////////////////////////////////////////////////////////
@@ -9,6 +18,9 @@ namespace ncine {
 ///////////////////////////////////////////////////////////
 
 const float SceneNode::MinRotation = 0.5f;
+ParallelSceneUpdate *SceneNode::parallelUpdate_ = nullptr;
+ParallelSceneVisit *SceneNode::parallelVisit_ = nullptr;
+DirtySceneUpdate *SceneNode::dirtyUpdate_ = nullptr;
 
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
@@ -24,7 +36,8 @@ SceneNode::SceneNode(SceneNode *parent, float x, float y)
       color_(Color::White), layer_(0), absPosition_(0.0f, 0.0f), absScaleFactor_(1.0f, 1.0f),
       absRotation_(0.0f), absColor_(Color::White), absLayer_(0),
       worldMatrix_(Matrix4x4f::Identity), localMatrix_(Matrix4x4f::Identity),
-      shouldDeleteChildrenOnDestruction_(true), dirtyBits_(0xFF), lastFrameUpdated_(0)
+      shouldDeleteChildrenOnDestruction_(true), dirtyBits_(0xFF), lastFrameUpdated_(0),
+      inDirtyList_(false), updatedEveryFrame_(false)
 {
 	setParent(parent);
 }
@@ -60,6 +73,14 @@ SceneNode::~SceneNode()
 	}
 
 	setParent(nullptr);
+
+	if (dirtyUpdate_)
+	{
+		if (inDirtyList_)
+			dirtyUpdate_->removeDirtyNode(this);
+		if (updatedEveryFrame_)
+			dirtyUpdate_->removeEveryFrameNode(this);
+	}
 }
 
 SceneNode::SceneNode(SceneNode &&other)
@@ -70,11 +91,13 @@ SceneNode::SceneNode(SceneNode &&other)
       position_(other.position_), anchorPoint_(other.anchorPoint_),
       scaleFactor_(other.scaleFactor_), rotation_(other.rotation_), color_(other.color_),
       layer_(other.layer_), shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_),
-      dirtyBits_(other.dirtyBits_), lastFrameUpdated_(other.lastFrameUpdated_)
+      dirtyBits_(other.dirtyBits_), lastFrameUpdated_(other.lastFrameUpdated_),
+      inDirtyList_(false), updatedEveryFrame_(false)
 {
 	swapChildPointer(this, &other);
 	for (SceneNode *child : children_)
 		child->parent_ = this;
+	takeDirtyUpdateState(other);
 }
 
 SceneNode &SceneNode::operator=(SceneNode &&other)
@@ -99,6 +122,7 @@ SceneNode &SceneNode::operator=(SceneNode &&other)
 	swapChildPointer(this, &other);
 	for (SceneNode *child : children_)
 		child->parent_ = this;
+	takeDirtyUpdateState(other);
 
 	return *this;
 }
@@ -125,6 +149,7 @@ bool SceneNode::setParent(SceneNode *parentNode)
 
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 
 	return true;
 }
@@ -144,6 +169,7 @@ bool SceneNode::addChildNode(SceneNode *childNode)
 	childNode->parent_ = this;
 	childNode->dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	childNode->dirtyBits_.set(DirtyBitPositions::AabbBit);
+	childNode->addToDirtyList();
 
 	return true;
 }
@@ -183,6 +209,7 @@ bool SceneNode::removeChildNodeAt(unsigned int index)
 	children_[index]->parent_ = nullptr;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	addToDirtyList();
 	// Fast removal without preserving the order
 	children_.unorderedRemoveAt(index);
 	// The last child has been moved to this index position
@@ -203,6 +230,7 @@ bool SceneNode::removeAllChildrenNodes()
 		dirtyBits_.set(DirtyBitPositions::TransformationBit);
 		dirtyBits_.set(DirtyBitPositions::AabbBit);
 	}
+	addToDirtyList();
 	children_.clear();
 
 	return true;
@@ -286,6 +314,17 @@ void SceneNode::update(float interval)
 	if (updateEnabled_)
 	{
 		transform();
+		CullingGrid *cullingGrid = RenderResources::cullingGrid();
+		if (cullingGrid)
+			cullingGrid->nodeHasTransformed(*this);
+#ifdef WITH_THREADS
+		if (parallelUpdate_ && parallelUpdate_->deferChildren(this))
+		{
+			// Dirty bits are reset by the parallel update after the children have been updated
+			lastFrameUpdated_ = theApplication().numFrames();
+			return;
+		}
+#endif
 		for (SceneNode *child : children_)
 			child->update(interval);
 
@@ -300,6 +339,21 @@ void SceneNode::update(float interval)
 	}
 }
 
+void SceneNode::setUpdatedEveryFrame(bool updatedEveryFrame)
+{
+	if (updatedEveryFrame_ == updatedEveryFrame)
+		return;
+
+	updatedEveryFrame_ = updatedEveryFrame;
+	if (dirtyUpdate_)
+	{
+		if (updatedEveryFrame)
+			dirtyUpdate_->addEveryFrameNode(this);
+		else
+			dirtyUpdate_->removeEveryFrameNode(this);
+	}
+}
+
 void SceneNode::visit(RenderQueue &renderQueue, unsigned int &visitOrderIndex)
 {
 	// Early return not needed, the first call to this method is on the root node
@@ -317,6 +371,15 @@ void SceneNode::visit(RenderQueue &renderQueue, unsigned int &visitOrderIndex)
 		const bool incrementIndex = (rendered && type_ != ObjectType::PARTICLE) || type_ == ObjectType::PARTICLE_SYSTEM;
 		visitOrderIndex_ = incrementIndex ? visitOrderIndex++ : visitOrderIndex;
 
+#ifdef WITH_THREADS
+		if (renderQueue.isDeferred())
+		{
+			// The visit order index of the node is offset when the deferred queue is merged
+			renderQueue.addVisitedNode(this);
+			if (parallelVisit_ && parallelVisit_->deferChildren(this, visitOrderIndex))
+				return;
+		}
+#endif
 		for (SceneNode *child : children_)
 			child->visit(renderQueue, visitOrderIndex);
 	}
@@ -334,9 +397,11 @@ SceneNode::SceneNode(const SceneNode &other)
       scaleFactor_(other.scaleFactor_), rotation_(other.rotation_), color_(other.color_),
       layer_(other.layer_), absPosition_(0.0f, 0.0f), absScaleFactor_(1.0f, 1.0f), absRotation_(0.0f),
       absColor_(Color::White), absLayer_(0), worldMatrix_(Matrix4x4f::Identity), localMatrix_(Matrix4x4f::Identity),
-      shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_), dirtyBits_(0xFF)
+      shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_), dirtyBits_(0xFF),
+      lastFrameUpdated_(0), inDirtyList_(false), updatedEveryFrame_(false)
 {
 	setParent(other.parent_);
+	setUpdatedEveryFrame(other.updatedEveryFrame_);
 }
 
 /*! \note It is faster than calling `setParent()` on the first child and `removeChildNode()` on the second one */
@@ -419,4 +484,30 @@ void SceneNode::transform()
 	absPosition_.y = worldMatrix_[3][1];
 }
 
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void SceneNode::registerDirtyNode()
+{
+	dirtyUpdate_->addDirtyNode(this);
+}
+
+/*! \note The moved node is replaced by this one in the lists of the dirty list update */
+void SceneNode::takeDirtyUpdateState(SceneNode &other)
+{
+	if (dirtyUpdate_)
+	{
+		if (other.inDirtyList_)
+			dirtyUpdate_->removeDirtyNode(&other);
+		if (other.updatedEveryFrame_)
+			dirtyUpdate_->removeEveryFrameNode(&other);
+	}
+	const bool updatedEveryFrame = other.updatedEveryFrame_;
+	other.updatedEveryFrame_ = false;
+
+	setUpdatedEveryFrame(updatedEveryFrame);
+	addToDirtyList();
+}
+
 }
@@ -5,6 +5,7 @@
 #include "Shader.h"
 #include "GLShaderProgram.h"
 #include "RenderResources.h"
+#include "Application.h"
 #include "tracy.h"
 
 #ifdef WITH_EMBEDDED_SHADERS
@@ -54,7 +55,9 @@ namespace {
 
 Shader::Shader()
     : Object(ObjectType::SHADER),
-      glShaderProgram_(nctl::makeUnique<GLShaderProgram>(GLShaderProgram::QueryPhase::IMMEDIATE))
+      glShaderProgram_(nctl::makeUnique<GLShaderProgram>(theApplication().appConfiguration().useAsyncShaderCompilation
+                                                             ? GLShaderProgram::QueryPhase::DEFERRED
+                                                             : GLShaderProgram::QueryPhase::IMMEDIATE))
 {
 }
 
@@ -164,7 +167,7 @@ bool Shader::loadFromMemory(const char *shaderName, Introspection introspection,
 	glShaderProgram_->attachShaderFromString(GL_FRAGMENT_SHADER, fragment);
 	glShaderProgram_->link(shaderToShaderProgramIntrospection(introspection));
 
-	return isLinked();
+	return (isLinking() || isLinked());
 }
 
 bool Shader::loadFromMemory(const char *shaderName, const char *vertex, const char *fragment)
@@ -193,7 +196,7 @@ bool Shader::loadFromMemory(const char *shaderName, Introspection introspection,
 	glShaderProgram_->attachShaderFromString(GL_FRAGMENT_SHADER, fragment);
 	glShaderProgram_->link(shaderToShaderProgramIntrospection(introspection));
 
-	return isLinked();
+	return (isLinking() || isLinked());
 }
 
 bool Shader::loadFromMemory(const char *shaderName, DefaultVertex vertex, const char *fragment)
@@ -223,7 +226,7 @@ bool Shader::loadFromMemory(const char *shaderName, Introspection introspection,
 	loadDefaultShader(fragment);
 	glShaderProgram_->link(shaderToShaderProgramIntrospection(introspection));
 
-	return isLinked();
+	return (isLinking() || isLinked());
 }
 
 bool Shader::loadFromMemory(const char *shaderName, const char *vertex, DefaultFragment fragment)
@@ -252,7 +255,7 @@ bool Shader::loadFromFile(const char *shaderName, Introspection introspection, c
 	glShaderProgram_->attachShader(GL_FRAGMENT_SHADER, fragment);
 	glShaderProgram_->link(shaderToShaderProgramIntrospection(introspection));
 
-	return isLinked();
+	return (isLinking() || isLinked());
 }
 
 bool Shader::loadFromFile(const char *shaderName, const char *vertex, const char *fragment)
@@ -281,7 +284,7 @@ bool Shader::loadFromFile(const char *shaderName, Introspection introspection, D
 	glShaderProgram_->attachShader(GL_FRAGMENT_SHADER, fragment);
 	glShaderProgram_->link(shaderToShaderProgramIntrospection(introspection));
 
-	return isLinked();
+	return (isLinking() || isLinked());
 }
 
 bool Shader::loadFromFile(const char *shaderName, DefaultVertex vertex, const char *fragment)
@@ -311,7 +314,7 @@ bool Shader::loadFromFile(const char *shaderName, Introspection introspection, c
 	loadDefaultShader(fragment);
 	glShaderProgram_->link(shaderToShaderProgramIntrospection(introspection));
 
-	return isLinked();
+	return (isLinking() || isLinked());
 }
 
 bool Shader::loadFromFile(const char *shaderName, const char *vertex, DefaultFragment fragment)
@@ -338,6 +341,11 @@ bool Shader::isLinked() const
 	return glShaderProgram_->isLinked();
 }
 
+bool Shader::isLinking()
+{
+	return (glShaderProgram_->pollStatus() == GLShaderProgram::Status::LINKING);
+}
+
 unsigned int Shader::retrieveInfoLogLength() const
 {
 	return glShaderProgram_->retrieveInfoLogLength();
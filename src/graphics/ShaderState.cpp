@@ -4,22 +4,34 @@
 #include "DrawableNode.h"
 #include "RenderCommand.h"
 #include "Material.h"
+#include "Application.h"
+#include "RenderResources.h"
 
 namespace ncine {
 
 namespace {
 
-	GLUniformCache *retrieveUniform(Material &material, const char *blockName, const char *name)
+	GLUniformBlockCache *retrieveUniformBlock(RenderCommand &command, const char *blockName)
+	{
+		GLUniformBlockCache *uniformBlock = command.material().uniformBlock(blockName);
+		// Batches need to know that the instance block of the command is going to change
+		if (uniformBlock)
+			command.setInstanceUpdateFrame(theApplication().numFrames());
+
+		return uniformBlock;
+	}
+
+	GLUniformCache *retrieveUniform(RenderCommand &command, const char *blockName, const char *name)
 	{
 		GLUniformCache *uniform = nullptr;
 		if (blockName != nullptr && blockName[0] != '\0')
 		{
-			GLUniformBlockCache *uniformBlock = material.uniformBlock(blockName);
+			GLUniformBlockCache *uniformBlock = retrieveUniformBlock(command, blockName);
 			if (uniformBlock)
 				uniform = uniformBlock->uniform(name);
 		}
 		else
-			uniform = material.uniform(name);
+			uniform = command.material().uniform(name);
 
 		return uniform;
 	}
@@ -37,7 +49,7 @@ ShaderState::ShaderState()
 
 ShaderState::ShaderState(DrawableNode *node, Shader *shader)
     : node_(nullptr), shader_(nullptr),
-      previousShaderType_(static_cast<int>(Material::ShaderProgramType::CUSTOM))
+      previousShaderType_(static_cast<int>(Material::ShaderProgramType::CUSTOM)), isShaderPending_(false)
 {
 	setNode(node);
 	setShader(shader);
@@ -85,6 +97,7 @@ bool ShaderState::setNode(DrawableNode *node)
 bool ShaderState::setShader(Shader *shader)
 {
 	bool shaderHasChanged = false;
+	bool isShaderPending = false;
 
 	// Allow shader self-assignment to take into account the case where it loads new data
 	if (node_ != nullptr)
@@ -95,6 +108,14 @@ bool ShaderState::setShader(Shader *shader)
 			const Material::ShaderProgramType programType = static_cast<Material::ShaderProgramType>(previousShaderType_);
 			material.setShaderProgramType(programType);
 		}
+		else if (shader->isLinking())
+		{
+			// The node keeps drawing with its current program, or with the previous one if the shader is loading new data
+			if (material.shaderProgram() == shader->glShaderProgram_.get())
+				material.setShaderProgramType(static_cast<Material::ShaderProgramType>(previousShaderType_));
+			// The shader is set again when linking completes
+			isShaderPending = true;
+		}
 		else if (shader->isLinked())
 		{
 			if (material.shaderProgramType() != Material::ShaderProgramType::CUSTOM)
@@ -108,18 +129,25 @@ bool ShaderState::setShader(Shader *shader)
 		shaderHasChanged = true;
 	}
 
+	setShaderPending(isShaderPending);
 	return shaderHasChanged;
 }
 
 /*! \note Use this method when the content of the currently assigned shader changes */
 bool ShaderState::resetShader()
 {
-	if (shader_ != nullptr && shader_->isLinked() && node_)
+	if (shader_ != nullptr && node_)
 	{
-		Material &material = node_->renderCommand_->material();
-		material.setShaderProgram(shader_->glShaderProgram_.get());
-		node_->shaderHasChanged();
-		return true;
+		if (shader_->isLinking())
+			return setShader(shader_);
+		else if (shader_->isLinked())
+		{
+			Material &material = node_->renderCommand_->material();
+			material.setShaderProgram(shader_->glShaderProgram_.get());
+			node_->shaderHasChanged();
+			setShaderPending(false);
+			return true;
+		}
 	}
 	return false;
 }
@@ -142,7 +170,7 @@ bool ShaderState::setUniformInt(const char *blockName, const char *name, const i
 		return false;
 
 	bool result = false;
-	GLUniformCache *uniform = retrieveUniform(node_->renderCommand_->material(), blockName, name);
+	GLUniformCache *uniform = retrieveUniform(*node_->renderCommand_, blockName, name);
 	if (uniform)
 		result = uniform->setIntVector(vector);
 
@@ -155,7 +183,7 @@ bool ShaderState::setUniformInt(const char *blockName, const char *name, int val
 		return false;
 
 	bool result = false;
-	GLUniformCache *uniform = retrieveUniform(node_->renderCommand_->material(), blockName, name);
+	GLUniformCache *uniform = retrieveUniform(*node_->renderCommand_, blockName, name);
 	if (uniform)
 		result = uniform->setIntValue(value0);
 
@@ -168,7 +196,7 @@ bool ShaderState::setUniformInt(const char *blockName, const char *name, int val
 		return false;
 
 	bool result = false;
-	GLUniformCache *uniform = retrieveUniform(node_->renderCommand_->material(), blockName, name);
+	GLUniformCache *uniform = retrieveUniform(*node_->renderCommand_, blockName, name);
 	if (uniform)
 		result = uniform->setIntValue(value0, value1);
 
@@ -181,7 +209,7 @@ bool ShaderState::setUniformInt(const char *blockName, const char *name, int val
 		return false;
 
 	bool result = false;
-	GLUniformCache *uniform = retrieveUniform(node_->renderCommand_->material(), blockName, name);
+	GLUniformCache *uniform = retrieveUniform(*node_->renderCommand_, blockName, name);
 	if (uniform)
 		result = uniform->setIntValue(value0, value1, value2);
 
@@ -194,7 +222,7 @@ bool ShaderState::setUniformInt(const char *blockName, const char *name, int val
 		return false;
 
 	bool result = false;
-	GLUniformCache *uniform = retrieveUniform(node_->renderCommand_->material(), blockName, name);
+	GLUniformCache *uniform = retrieveUniform(*node_->renderCommand_, blockName, name);
 	if (uniform)
 		result = uniform->setIntValue(value0, value1, value2, value3);
 
@@ -222,7 +250,7 @@ bool ShaderState::setUniformFloat(const char *blockName, const char *name, const
 		return false;
 
 	bool result = false;
-	GLUniformCache *uniform = retrieveUniform(node_->renderCommand_->material(), blockName, name);
+	GLUniformCache *uniform = retrieveUniform(*node_->renderCommand_, blockName, name);
 	if (uniform)
 		result = uniform->setFloatVector(vector);
 
@@ -235,7 +263,7 @@ bool ShaderState::setUniformFloat(const char *blockName, const char *name, float
 		return false;
 
 	bool result = false;
-	GLUniformCache *uniform = retrieveUniform(node_->renderCommand_->material(), blockName, name);
+	GLUniformCache *uniform = retrieveUniform(*node_->renderCommand_, blockName, name);
 	if (uniform)
 		result = uniform->setFloatValue(value0);
 
@@ -248,7 +276,7 @@ bool ShaderState::setUniformFloat(const char *blockName, const char *name, float
 		return false;
 
 	bool result = false;
-	GLUniformCache *uniform = retrieveUniform(node_->renderCommand_->material(), blockName, name);
+	GLUniformCache *uniform = retrieveUniform(*node_->renderCommand_, blockName, name);
 	if (uniform)
 		result = uniform->setFloatValue(value0, value1);
 
@@ -261,7 +289,7 @@ bool ShaderState::setUniformFloat(const char *blockName, const char *name, float
 		return false;
 
 	bool result = false;
-	GLUniformCache *uniform = retrieveUniform(node_->renderCommand_->material(), blockName, name);
+	GLUniformCache *uniform = retrieveUniform(*node_->renderCommand_, blockName, name);
 	if (uniform)
 		result = uniform->setFloatValue(value0, value1, value2);
 
@@ -274,7 +302,7 @@ bool ShaderState::setUniformFloat(const char *blockName, const char *name, float
 		return false;
 
 	bool result = false;
-	GLUniformCache *uniform = retrieveUniform(node_->renderCommand_->material(), blockName, name);
+	GLUniformCache *uniform = retrieveUniform(*node_->renderCommand_, blockName, name);
 	if (uniform)
 		result = uniform->setFloatValue(value0, value1, value2, value3);
 
@@ -320,7 +348,7 @@ bool ShaderState::copyToUniformBlock(const char *blockName, unsigned int destInd
 		return false;
 
 	bool result = false;
-	GLUniformBlockCache *uniformBlock = node_->renderCommand_->material().uniformBlock(blockName);
+	GLUniformBlockCache *uniformBlock = retrieveUniformBlock(*node_->renderCommand_, blockName);
 	if (uniformBlock)
 		result = uniformBlock->copyData(destIndex, src, numBytes);
 
@@ -338,11 +366,34 @@ bool ShaderState::copyToUniformBlock(const char *blockName, unsigned char *src)
 		return false;
 
 	bool result = false;
-	GLUniformBlockCache *uniformBlock = node_->renderCommand_->material().uniformBlock(blockName);
+	GLUniformBlockCache *uniformBlock = retrieveUniformBlock(*node_->renderCommand_, blockName);
 	if (uniformBlock)
 		result = uniformBlock->copyData(src);
 
 	return result;
 }
 
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void ShaderState::setShaderPending(bool isShaderPending)
+{
+	if (isShaderPending_ == isShaderPending)
+		return;
+
+	isShaderPending_ = isShaderPending;
+	if (isShaderPending)
+		RenderResources::addPendingShaderState(this);
+	else
+		RenderResources::removePendingShaderState(this);
+}
+
+void ShaderState::updatePendingShader()
+{
+	// Setting the shader again after linking applies it, or clears the pending state if it has failed
+	if (shader_->isLinking() == false)
+		setShader(shader_);
+}
+
 }
@@ -43,7 +43,7 @@ TextNode::TextNode(SceneNode *parent, Font *font, unsigned int maxStringLength)
       dirtyBoundaries_(true), withKerning_(true), font_(font),
       interleavedVertices_(maxStringLength * 4 + (maxStringLength - 1) * 2),
       xAdvance_(0.0f), yAdvance_(0.0f), lineLengths_(4), alignment_(Alignment::LEFT),
-      lineHeight_(font ? font->lineHeight() : 0.0f), instanceBlock_(nullptr)
+      lineHeight_(font ? font->lineHeight() : 0.0f), colorUniform_(nullptr)
 {
 	ASSERT(maxStringLength > 0);
 	init();
@@ -315,7 +315,7 @@ TextNode::TextNode(const TextNode &other)
       withKerning_(other.withKerning_), font_(other.font_),
       interleavedVertices_(string_.capacity() * 4 + (string_.capacity() - 1) * 2),
       xAdvance_(0.0f), yAdvance_(0.0f), lineLengths_(4), alignment_(other.alignment_),
-      lineHeight_(font_ ? font_->lineHeight() : 0.0f), instanceBlock_(nullptr)
+      lineHeight_(font_ ? font_->lineHeight() : 0.0f), colorUniform_(nullptr)
 {
 	init();
 	setBlendingEnabled(other.isBlendingEnabled());
@@ -414,6 +414,7 @@ void TextNode::calculateBoundaries() const
 		// Total advance on the Y-axis for the entire string (vertical boundary)
 		mutableNode->height_ = yAdvance_;
 		mutableNode->dirtyBits_.set(DirtyBitPositions::AabbBit);
+		mutableNode->addToDirtyList();
 
 		if (oldWidth > 0.0f && oldHeight > 0.0f)
 		{
@@ -480,7 +481,8 @@ void TextNode::processGlyph(const FontGlyph *glyph, Degenerate degen)
 void TextNode::shaderHasChanged()
 {
 	renderCommand_->material().reserveUniformsDataMemory();
-	instanceBlock_ = renderCommand_->material().uniformBlock(Material::InstanceBlockName);
+	GLUniformBlockCache *instanceBlock = renderCommand_->material().uniformBlock(Material::InstanceBlockName);
+	colorUniform_ = instanceBlock ? instanceBlock->uniformHandle(Material::ColorUniformName, GL_FLOAT_VEC4) : nullptr;
 	GLUniformCache *textureUniform = renderCommand_->material().uniform(Material::TextureUniformName);
 	if (textureUniform && textureUniform->intValue(0) != 0)
 		textureUniform->setIntValue(0); // GL_TEXTURE0
@@ -500,9 +502,8 @@ void TextNode::updateRenderCommand()
 	}
 	if (dirtyBits_.test(DirtyBitPositions::ColorBit))
 	{
-		GLUniformCache *colorUniform = instanceBlock_->uniform(Material::ColorUniformName);
-		if (colorUniform)
-			colorUniform->setFloatVector(Colorf(absColor()).data());
+		if (colorUniform_)
+			colorUniform_->storeFloatVector(Colorf(absColor()).data(), 4);
 		dirtyBits_.reset(DirtyBitPositions::ColorBit);
 	}
 }
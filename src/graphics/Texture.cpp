@@ -1,10 +1,14 @@
 #define NCINE_INCLUDE_OPENGL
 #include "common_headers.h"
 #include "common_macros.h"
+#include <cstring> // for memcpy()
 #include <nctl/CString.h>
 #include "Texture.h"
 #include "TextureLoaderRaw.h"
+#include "TextureUploadQueue.h"
 #include "GLTexture.h"
+#include "GLBufferObject.h"
+#include "RenderResources.h"
 #include "RenderStatistics.h"
 #include "tracy.h"
 
@@ -86,7 +90,7 @@ Texture::Texture()
     : Object(ObjectType::TEXTURE), glTexture_(nctl::makeUnique<GLTexture>(GL_TEXTURE_2D)),
       width_(0), height_(0), mipMapLevels_(0), isCompressed_(false), format_(Format::UNKNOWN), dataSize_(0),
       minFiltering_(Filtering::NEAREST), magFiltering_(Filtering::NEAREST), wrapMode_(Wrap::REPEAT),
-      isChromaKeyEnabled_(false), chromaKeyColor_(Color::Magenta)
+      isChromaKeyEnabled_(false), chromaKeyColor_(Color::Magenta), loadingState_(LoadingState::READY)
 {
 }
 
@@ -134,14 +138,50 @@ Texture::Texture(const char *filename)
 
 Texture::~Texture()
 {
+	cancelLoadRequest();
+
 	// Don't remove data from statistics if this is a moved out object
 	if (dataSize_ > 0 && glTexture_)
 		RenderStatistics::removeTexture(dataSize_);
 }
 
-Texture::Texture(Texture &&) = default;
+Texture::Texture(Texture &&other)
+    : Object(nctl::move(other)), glTexture_(nctl::move(other.glTexture_)),
+      width_(other.width_), height_(other.height_), mipMapLevels_(other.mipMapLevels_), isCompressed_(other.isCompressed_),
+      format_(other.format_), dataSize_(other.dataSize_), minFiltering_(other.minFiltering_), magFiltering_(other.magFiltering_),
+      wrapMode_(other.wrapMode_), isChromaKeyEnabled_(other.isChromaKeyEnabled_), chromaKeyColor_(other.chromaKeyColor_),
+      loadingState_(other.loadingState_), loadRequest_(nctl::move(other.loadRequest_))
+{
+	// The pending request should upload to the moved texture
+	if (loadRequest_ != nullptr)
+		loadRequest_->texture = this;
+}
+
+Texture &Texture::operator=(Texture &&other)
+{
+	cancelLoadRequest();
 
-Texture &Texture::operator=(Texture &&) = default;
+	Object::operator=(nctl::move(other));
+	glTexture_ = nctl::move(other.glTexture_);
+	width_ = other.width_;
+	height_ = other.height_;
+	mipMapLevels_ = other.mipMapLevels_;
+	isCompressed_ = other.isCompressed_;
+	format_ = other.format_;
+	dataSize_ = other.dataSize_;
+	minFiltering_ = other.minFiltering_;
+	magFiltering_ = other.magFiltering_;
+	wrapMode_ = other.wrapMode_;
+	isChromaKeyEnabled_ = other.isChromaKeyEnabled_;
+	chromaKeyColor_ = other.chromaKeyColor_;
+	loadingState_ = other.loadingState_;
+	loadRequest_ = nctl::move(other.loadRequest_);
+
+	if (loadRequest_ != nullptr)
+		loadRequest_->texture = this;
+
+	return *this;
+}
 
 ///////////////////////////////////////////////////////////
 // PUBLIC FUNCTIONS
@@ -158,6 +198,7 @@ void Texture::init(const char *name, Format format, int mipMapCount, int width,
 
 	TextureLoaderRaw texLoader(width, height, mipMapCount, ncFormatToInternal(format));
 
+	cancelLoadRequest();
 	if (dataSize_ > 0)
 		RenderStatistics::removeTexture(dataSize_);
 
@@ -199,6 +240,7 @@ bool Texture::loadFromMemory(const char *bufferName, const unsigned char *buffer
 	if (texLoader->hasLoaded() == false)
 		return false;
 
+	cancelLoadRequest();
 	if (dataSize_ > 0)
 		RenderStatistics::removeTexture(dataSize_);
 
@@ -221,6 +263,7 @@ bool Texture::loadFromFile(const char *filename)
 	if (texLoader->hasLoaded() == false)
 		return false;
 
+	cancelLoadRequest();
 	if (dataSize_ > 0)
 		RenderStatistics::removeTexture(dataSize_);
 
@@ -234,6 +277,20 @@ bool Texture::loadFromFile(const char *filename)
 	return true;
 }
 
+/*! The image is decoded by a worker thread, then uploaded by the main thread within the per-frame budget of `AppConfiguration::textureUploadBudget`.
+ *  The previous contents stay valid until the upload starts, and `isLoading()` returns false once the texture is ready or the load has failed.
+ *  \note Filtering and wrap modes are reset when the upload starts, they should be changed after the texture is ready */
+void Texture::loadFromFileAsync(const char *filename)
+{
+	ZoneScoped;
+	ZoneText(filename, nctl::strnlen(filename, nctl::String::MaxCStringLength));
+
+	cancelLoadRequest();
+	setName(filename);
+	loadRequest_ = RenderResources::textureUploadQueue().enqueue(*this, filename);
+	loadingState_ = LoadingState::DECODING;
+}
+
 /*! \note It loads uncompressed pixel data from memory using the `Format` specified in the constructor */
 bool Texture::loadFromTexels(const unsigned char *bufferPtr)
 {
@@ -473,6 +530,101 @@ void Texture::initialize(const ITextureLoader &texLoader)
 	dataSize_ = dataSize;
 }
 
+void Texture::cancelLoadRequest()
+{
+	if (loadRequest_ != nullptr)
+	{
+		// The upload queue drops requests without a texture
+		loadRequest_->texture = nullptr;
+		loadRequest_ = nctl::SharedPtr<TextureLoadRequest>();
+	}
+	loadingState_ = LoadingState::READY;
+}
+
+void Texture::initializeAsync(const ITextureLoader &texLoader)
+{
+	if (dataSize_ > 0)
+		RenderStatistics::removeTexture(dataSize_);
+
+	glTexture_->bind();
+	initialize(texLoader);
+	// The OpenGL texture might have been recreated by the initialization
+	glTexture_->setObjectLabel(name());
+
+	RenderStatistics::addTexture(dataSize_);
+	loadingState_ = LoadingState::UPLOADING;
+}
+
+void Texture::loadRows(const ITextureLoader &texLoader, int mipLevel, int firstRow, int numRows, GLBufferObject *pixelBuffer)
+{
+#if (defined(WITH_OPENGLES) && GL_ES_VERSION_3_0) || defined(__EMSCRIPTEN__)
+	const bool withTexStorage = true;
+#else
+	const IGfxCapabilities &gfxCaps = theServiceLocator().gfxCapabilities();
+	const bool withTexStorage = gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::ARB_TEXTURE_STORAGE);
+#endif
+
+	const TextureFormat &texFormat = texLoader.texFormat();
+	const int levelWidth = (width_ >> mipLevel) > 0 ? (width_ >> mipLevel) : 1;
+	const int levelHeight = (height_ >> mipLevel) > 0 ? (height_ >> mipLevel) : 1;
+
+	GLenum format = texFormat.format();
+	const GLubyte *data = texLoader.pixels(mipLevel);
+	unsigned long dataSize = texLoader.dataSize(mipLevel);
+	nctl::UniquePtr<uint32_t[]> chromaPixels;
+
+	if (texFormat.isCompressed() == false)
+	{
+		const unsigned long rowSize = dataSize / levelHeight;
+		data += firstRow * rowSize;
+		dataSize = numRows * rowSize;
+
+		if (format == GL_RGB && isChromaKeyEnabled_)
+		{
+			format = GL_RGBA;
+			const unsigned int numPixels = levelWidth * numRows;
+			chromaPixels = nctl::makeUnique<uint32_t[]>(numPixels);
+			chromaKeyPixels(chromaPixels.get(), data, numPixels, chromaKeyColor_);
+			data = reinterpret_cast<const unsigned char *>(chromaPixels.get());
+			dataSize = numPixels * 4;
+		}
+	}
+
+	if (pixelBuffer != nullptr)
+	{
+		// Orphaning the previous storage lets the driver keep sourcing the last upload while the new one is copied
+		pixelBuffer->bind();
+		pixelBuffer->bufferData(static_cast<GLsizeiptr>(dataSize), nullptr, GL_STREAM_DRAW);
+		void *mappedData = pixelBuffer->mapBufferRange(0, static_cast<GLsizeiptr>(dataSize), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+		if (mappedData != nullptr)
+		{
+			memcpy(mappedData, data, dataSize);
+			pixelBuffer->unmap();
+			// The pixels are now sourced from the beginning of the bound buffer
+			data = nullptr;
+		}
+		else
+		{
+			pixelBuffer->unbind();
+			pixelBuffer = nullptr;
+		}
+	}
+
+	if (texFormat.isCompressed())
+	{
+		if (withTexStorage)
+			glTexture_->compressedTexSubImage2D(mipLevel, 0, 0, levelWidth, levelHeight, texFormat.internalFormat(), dataSize, data);
+		else
+			glTexture_->compressedTexImage2D(mipLevel, texFormat.internalFormat(), levelWidth, levelHeight, dataSize, data);
+	}
+	else
+		glTexture_->texSubImage2D(mipLevel, 0, firstRow, levelWidth, numRows, format, texFormat.type(), data);
+
+	// Other uploads source their pixels from client memory
+	if (pixelBuffer != nullptr)
+		pixelBuffer->unbind();
+}
+
 void Texture::load(const ITextureLoader &texLoader)
 {
 #if (defined(WITH_OPENGLES) && GL_ES_VERSION_3_0) || defined(__EMSCRIPTEN__)
@@ -0,0 +1,212 @@
+#define NCINE_INCLUDE_OPENGL
+#include "common_headers.h"
+#include "common_macros.h"
+#include "TextureUploadQueue.h"
+#include "ITextureLoader.h"
+#include "Texture.h"
+#include "GLBufferObject.h"
+#include "IThreadPool.h"
+#include "IThreadCommand.h"
+#include "ServiceLocator.h"
+#include "tracy.h"
+
+namespace ncine {
+
+namespace {
+
+	/// A thread command that decodes the image of a texture load request
+	class DecodeTextureCommand : public IThreadCommand
+	{
+	  public:
+		explicit DecodeTextureCommand(const nctl::SharedPtr<TextureLoadRequest> &request)
+		    : request_(request) {}
+
+		inline void execute() override { request_->decode(); }
+
+	  private:
+		/// The request stays alive until decoded, even if the texture and the queue have been destroyed
+		nctl::SharedPtr<TextureLoadRequest> request_;
+	};
+
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+TextureLoadRequest::TextureLoadRequest(Texture *tex, const char *name)
+    : filename(name), state(QUEUED), texture(tex), mipLevel(0), row(0)
+{
+}
+
+TextureLoadRequest::~TextureLoadRequest() = default;
+
+TextureUploadQueue::TextureUploadQueue(unsigned long budget)
+    : budget_(budget)
+{
+#if !defined(__EMSCRIPTEN__)
+	// WebGL cannot map buffers, there would be no gain in staging through one
+	pixelBuffer_ = nctl::makeUnique<GLBufferObject>(GL_PIXEL_UNPACK_BUFFER);
+	pixelBuffer_->setObjectLabel("Texture_Upload_PBO");
+#endif
+}
+
+TextureUploadQueue::~TextureUploadQueue()
+{
+	for (nctl::SharedPtr<TextureLoadRequest> &request : requests_)
+	{
+		if (request->texture != nullptr)
+			request->texture->loadingState_ = Texture::LoadingState::FAILED;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void TextureLoadRequest::decode()
+{
+	ZoneScopedN("Decode texture");
+	ZoneText(filename.data(), filename.length());
+
+	texLoader = ITextureLoader::createFromFile(filename.data());
+	// The release store makes the decoded image visible to the main thread
+	state.store(texLoader->hasLoaded() ? DECODED : FAILED, nctl::Atomic32::MemoryModel::RELEASE);
+}
+
+nctl::SharedPtr<TextureLoadRequest> TextureUploadQueue::enqueue(Texture &texture, const char *filename)
+{
+	ASSERT(filename);
+	nctl::SharedPtr<TextureLoadRequest> request = nctl::makeShared<TextureLoadRequest>(&texture, filename);
+	requests_.pushBack(request);
+	return request;
+}
+
+void TextureUploadQueue::process()
+{
+	if (requests_.isEmpty())
+		return;
+
+	ZoneScoped;
+	IThreadPool &threadPool = theServiceLocator().threadPool();
+	const unsigned int numThreads = threadPool.numThreads();
+	unsigned int numDecoding = 0;
+	unsigned long uploadedBytes = 0;
+
+	unsigned int index = 0;
+	while (index < requests_.size())
+	{
+		TextureLoadRequest &request = *requests_[index];
+		bool hasCompleted = (request.texture == nullptr);
+
+		if (hasCompleted == false)
+		{
+			switch (request.state.load(nctl::Atomic32::MemoryModel::ACQUIRE))
+			{
+				case TextureLoadRequest::DECODING:
+					numDecoding++;
+					break;
+				case TextureLoadRequest::DECODED:
+					if (budget_ == 0 || uploadedBytes < budget_)
+					{
+						uploadedBytes += upload(request, (budget_ > 0) ? budget_ - uploadedBytes : 0);
+						hasCompleted = (request.mipLevel >= request.texLoader->mipMapCount());
+						if (hasCompleted)
+						{
+							request.texture->loadingState_ = Texture::LoadingState::READY;
+							request.texture->loadRequest_ = nctl::SharedPtr<TextureLoadRequest>();
+						}
+					}
+					break;
+				case TextureLoadRequest::FAILED:
+					LOGE_X("Texture \"%s\" cannot be loaded", request.filename.data());
+					request.texture->loadingState_ = Texture::LoadingState::FAILED;
+					request.texture->loadRequest_ = nctl::SharedPtr<TextureLoadRequest>();
+					hasCompleted = true;
+					break;
+				case TextureLoadRequest::QUEUED:
+				default:
+					break;
+			}
+		}
+
+		if (hasCompleted)
+			requests_.removeAt(index);
+		else
+			index++;
+	}
+
+	// One worker is left free, otherwise the parallel scenegraph commands would wait for the decoding ones
+	const unsigned int maxDecoding = (numThreads > 0) ? numThreads - 1 : 0;
+	// Without a spare worker a single image is decoded every frame by the main thread
+	const bool decodeOnMainThread = (maxDecoding == 0);
+	const unsigned int maxStarted = decodeOnMainThread ? 1 : maxDecoding;
+	for (unsigned int i = 0; i < requests_.size() && numDecoding < maxStarted; i++)
+	{
+		TextureLoadRequest &request = *requests_[i];
+		if (request.state.load(nctl::Atomic32::MemoryModel::RELAXED) != TextureLoadRequest::QUEUED)
+			continue;
+
+		request.state.store(TextureLoadRequest::DECODING, nctl::Atomic32::MemoryModel::RELAXED);
+		if (decodeOnMainThread)
+			request.decode();
+		else
+			threadPool.enqueueCommand(nctl::makeUnique<DecodeTextureCommand>(requests_[i]));
+		numDecoding++;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned long TextureUploadQueue::upload(TextureLoadRequest &request, unsigned long remainingBudget)
+{
+	ZoneScopedN("Upload texture");
+	ZoneText(request.filename.data(), request.filename.length());
+
+	const ITextureLoader &texLoader = *request.texLoader;
+	Texture &texture = *request.texture;
+	if (request.mipLevel == 0 && request.row == 0)
+		texture.initializeAsync(texLoader);
+
+	unsigned long uploadedBytes = 0;
+	while (request.mipLevel < texLoader.mipMapCount() && (remainingBudget == 0 || uploadedBytes < remainingBudget))
+	{
+		const unsigned long levelSize = static_cast<unsigned long>(texLoader.dataSize(request.mipLevel));
+		const int levelHeight = (texLoader.height() >> request.mipLevel) > 0 ? (texLoader.height() >> request.mipLevel) : 1;
+
+		// Compressed levels are uploaded as a whole, uncompressed ones are split in ranges of rows
+		int numRows = levelHeight - request.row;
+		if (texLoader.texFormat().isCompressed())
+			uploadedBytes += levelSize;
+		else
+		{
+			unsigned long rowSize = (levelSize / levelHeight > 0) ? levelSize / levelHeight : 1;
+			// Chroma keyed pixels are expanded to four channels before being uploaded
+			if (texLoader.texFormat().format() == GL_RGB && texture.isChromaKeyEnabled())
+				rowSize = (rowSize / 3) * 4;
+			if (remainingBudget > 0)
+			{
+				const unsigned long budgetRows = (remainingBudget - uploadedBytes) / rowSize;
+				// At least one row is uploaded every frame
+				if (budgetRows < static_cast<unsigned long>(numRows))
+					numRows = (budgetRows > 0) ? static_cast<int>(budgetRows) : 1;
+			}
+			uploadedBytes += numRows * rowSize;
+		}
+
+		texture.loadRows(texLoader, request.mipLevel, request.row, numRows, pixelBuffer_.get());
+
+		request.row += numRows;
+		if (request.row >= levelHeight)
+		{
+			request.mipLevel++;
+			request.row = 0;
+		}
+	}
+
+	return uploadedBytes;
+}
+
+}
@@ -5,6 +5,8 @@
 #include "Application.h"
 #include "IAppEventHandler.h"
 #include "DrawableNode.h"
+#include "CullingGrid.h"
+#include "DirtySceneUpdate.h"
 #include "Camera.h"
 #include "GLFramebufferObject.h"
 #include "Texture.h"
@@ -18,11 +20,27 @@
 	#include "Qt5GfxDevice.h"
 #endif
 
+#ifdef WITH_THREADS
+	#include "ParallelSceneUpdate.h"
+	#include "ParallelSceneVisit.h"
+	#include "ParallelParticlesUpdate.h"
+	#include "ServiceLocator.h"
+#endif
+
 namespace ncine {
 
 namespace {
 	/// The string used to output OpenGL debug group information
 	static nctl::StaticString<64> debugString;
+
+#ifdef WITH_THREADS
+	/// The object distributing the scenegraph update to the thread pool, shared by all viewports
+	static ParallelSceneUpdate parallelSceneUpdate;
+	/// The object distributing the scenegraph visit to the thread pool, shared by all viewports
+	static ParallelSceneVisit parallelSceneVisit;
+	/// The object deferring the update of particle arrays to the thread pool, shared by all viewports
+	static ParallelParticlesUpdate parallelParticlesUpdate;
+#endif
 }
 
 GLenum depthStencilFormatToGLFormat(Viewport::DepthStencilFormat format)
@@ -356,9 +374,39 @@ void Viewport::update()
 	{
 		ZoneScoped;
 		if (rootNode_->lastFrameUpdated() < theApplication().numFrames())
-			rootNode_->update(theApplication().interval());
+		{
+			DirtySceneUpdate *dirtySceneUpdate = RenderResources::dirtySceneUpdate();
+#ifdef WITH_THREADS
+			const AppConfiguration &appCfg = theApplication().appConfiguration();
+			const unsigned int parallelUpdateDepth = appCfg.parallelUpdateDepth;
+			if (appCfg.useParallelParticlesUpdate && appCfg.useParticleArrays)
+				parallelParticlesUpdate.begin();
+#endif
+			// Only the subtrees that have changed are updated, it takes precedence over the parallel update
+			if (dirtySceneUpdate)
+				dirtySceneUpdate->update(*rootNode_, theApplication().interval());
+#ifdef WITH_THREADS
+			else if (parallelUpdateDepth > 0 && theServiceLocator().threadPool().numThreads() > 0)
+				parallelSceneUpdate.update(*rootNode_, theApplication().interval(), parallelUpdateDepth);
+#endif
+			else
+				rootNode_->update(theApplication().interval());
+#ifdef WITH_THREADS
+			// Particles should be updated before their AABBs are used for culling
+			parallelParticlesUpdate.join();
+#endif
+		}
 		// AABBs should update after nodes have been transformed
-		updateCulling(rootNode_);
+		CullingGrid *cullingGrid = RenderResources::cullingGrid();
+		if (cullingGrid)
+		{
+			// Only the nodes in the cells overlapped by the culling rectangle are tested
+			cullingGrid->updateCells();
+			if (theApplication().renderingSettings().cullingEnabled)
+				cullingGrid->markOverlappingNodes(cullingRect_, theApplication().numFrames());
+		}
+		else
+			updateCulling(rootNode_, theApplication().numFrames());
 	}
 
 	stateBits_.set(StateBitPositions::UpdatedBit);
@@ -371,8 +419,16 @@ void Viewport::visit()
 	if (rootNode_)
 	{
 		ZoneScoped;
-		unsigned int visitOrderIndex = 0;
-		rootNode_->visit(*renderQueue_, visitOrderIndex);
+#ifdef WITH_THREADS
+		const unsigned int parallelVisitDepth = theApplication().appConfiguration().parallelVisitDepth;
+		if (parallelVisitDepth > 0 && theServiceLocator().threadPool().numThreads() > 0)
+			parallelSceneVisit.visit(*rootNode_, *renderQueue_, parallelVisitDepth);
+		else
+#endif
+		{
+			unsigned int visitOrderIndex = 0;
+			rootNode_->visit(*renderQueue_, visitOrderIndex);
+		}
 	}
 
 	stateBits_.set(StateBitPositions::VisitedBit);
@@ -494,20 +550,16 @@ void Viewport::draw(unsigned int nextIndex)
 	}
 }
 
-///////////////////////////////////////////////////////////
-// PRIVATE FUNCTIONS
-///////////////////////////////////////////////////////////
-
-void Viewport::updateCulling(SceneNode *node)
+void Viewport::updateCulling(SceneNode *node, unsigned long int frame)
 {
 	for (SceneNode *child : node->children())
-		updateCulling(child);
+		updateCulling(child, frame);
 
 	if (node->type() != Object::ObjectType::SCENENODE &&
 	    node->type() != Object::ObjectType::PARTICLE_SYSTEM)
 	{
 		DrawableNode *drawable = static_cast<DrawableNode *>(node);
-		drawable->updateCulling();
+		drawable->updateCulling(frame);
 	}
 }
 
@@ -14,6 +14,38 @@ namespace {
 
 	static nctl::StaticString<256> patchLines;
 
+	void initPatchLines()
+	{
+		if (patchLines.isEmpty())
+		{
+#if (defined(WITH_OPENGLES) && GL_ES_VERSION_3_0) || defined(__EMSCRIPTEN__)
+			patchLines.append("#version 300 es\n");
+#else
+			patchLines.append("#version 330\n");
+#endif
+
+#if defined(__EMSCRIPTEN__)
+			patchLines.append("#define __EMSCRIPTEN__\n");
+#elif defined(__ANDROID__)
+			patchLines.append("#define __ANDROID__\n");
+#elif defined(WITH_ANGLE)
+			patchLines.append("#define WITH_ANGLE\n");
+#endif
+
+#if defined(__EMSCRIPTEN__) || defined(WITH_ANGLE)
+			// ANGLE does not seem capable of handling large arrays that are not entirely filled.
+			// A small array size will also make shader compilation a lot faster.
+			if (theApplication().appConfiguration().fixedBatchSize > 0)
+			{
+				patchLines.append("#define WITH_FIXED_BATCH_SIZE\n");
+				patchLines.formatAppend("#define BATCH_SIZE (%u)\n", theApplication().appConfiguration().fixedBatchSize);
+			}
+#endif
+			// Exclude patch lines when counting line numbers in info logs
+			patchLines.append("#line 0\n");
+		}
+	}
+
 }
 
 ///////////////////////////////////////////////////////////
@@ -29,35 +61,7 @@ char GLShader::infoLogString_[MaxInfoLogLength];
 GLShader::GLShader(GLenum type)
     : glHandle_(0), status_(Status::NOT_COMPILED)
 {
-	if (patchLines.isEmpty())
-	{
-#if (defined(WITH_OPENGLES) && GL_ES_VERSION_3_0) || defined(__EMSCRIPTEN__)
-		patchLines.append("#version 300 es\n");
-#else
-		patchLines.append("#version 330\n");
-#endif
-
-#if defined(__EMSCRIPTEN__)
-		patchLines.append("#define __EMSCRIPTEN__\n");
-#elif defined(__ANDROID__)
-		patchLines.append("#define __ANDROID__\n");
-#elif defined(WITH_ANGLE)
-		patchLines.append("#define WITH_ANGLE\n");
-#endif
-
-#if defined(__EMSCRIPTEN__) || defined(WITH_ANGLE)
-		// ANGLE does not seem capable of handling large arrays that are not entirely filled.
-		// A small array size will also make shader compilation a lot faster.
-		if (theApplication().appConfiguration().fixedBatchSize > 0)
-		{
-			patchLines.append("#define WITH_FIXED_BATCH_SIZE\n");
-			patchLines.formatAppend("#define BATCH_SIZE (%u)\n", theApplication().appConfiguration().fixedBatchSize);
-		}
-#endif
-		// Exclude patch lines when counting line numbers in info logs
-		patchLines.append("#line 0\n");
-	}
-
+	initPatchLines();
 	glHandle_ = glCreateShader(type);
 }
 
@@ -76,6 +80,12 @@ GLShader::~GLShader()
 // PUBLIC FUNCTIONS
 ///////////////////////////////////////////////////////////
 
+const char *GLShader::sourcePatchLines()
+{
+	initPatchLines();
+	return patchLines.data();
+}
+
 void GLShader::loadFromString(const char *string)
 {
 	ASSERT(string);
@@ -4,6 +4,8 @@
 #include "GLDebug.h"
 #include "RenderResources.h"
 #include "RenderVaoPool.h"
+#include "BinaryShaderCache.h"
+#include "ServiceLocator.h"
 #include "tracy.h"
 
 namespace ncine {
@@ -26,7 +28,7 @@ GLShaderProgram::GLShaderProgram()
 
 GLShaderProgram::GLShaderProgram(QueryPhase queryPhase)
     : glHandle_(0), attachedShaders_(AttachedShadersInitialSize),
-      status_(Status::NOT_LINKED), queryPhase_(queryPhase), shouldLogOnErrors_(true),
+      status_(Status::NOT_LINKED), queryPhase_(queryPhase), binaryCacheHash_(0), shouldLogOnErrors_(true),
       uniformsSize_(0), uniformBlocksSize_(0), uniforms_(UniformsInitialSize),
       uniformBlocks_(UniformBlocksInitialSize), attributes_(AttributesInitialSize)
 {
@@ -138,6 +140,10 @@ bool GLShaderProgram::attachShaderFromString(GLenum type, const char *string)
 bool GLShaderProgram::link(Introspection introspection)
 {
 	introspection_ = introspection;
+#ifndef __EMSCRIPTEN__
+	if (binaryCacheHash_ != 0)
+		glProgramParameteri(glHandle_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
 	glLinkProgram(glHandle_);
 
 	if (queryPhase_ == QueryPhase::IMMEDIATE)
@@ -156,11 +162,62 @@ bool GLShaderProgram::link(Introspection introspection)
 	}
 	else
 	{
-		status_ = GLShaderProgram::Status::LINKED_WITH_DEFERRED_QUERIES;
+		status_ = isParallelCompileAvailable() ? Status::LINKING : Status::LINKED_WITH_DEFERRED_QUERIES;
 		return true;
 	}
 }
 
+bool GLShaderProgram::linkFromBinaryCache(uint64_t sourcesHash, Introspection introspection)
+{
+	ASSERT(attachedShaders_.isEmpty());
+	BinaryShaderCache *binaryShaderCache = RenderResources::binaryShaderCache();
+	if (binaryShaderCache == nullptr || binaryShaderCache->isAvailable() == false || sourcesHash == 0)
+		return false;
+
+	if (binaryShaderCache->loadFromCache(glHandle_, sourcesHash) == false)
+	{
+		// The binary will be saved after linking from sources
+		binaryCacheHash_ = sourcesHash;
+		return false;
+	}
+
+	// The link status has already been checked by the cache, only introspection can be deferred
+	introspection_ = introspection;
+	binaryCacheHash_ = 0;
+	status_ = Status::LINKED;
+	if (queryPhase_ == QueryPhase::IMMEDIATE)
+		performIntrospection();
+	else
+		status_ = Status::LINKED_WITH_DEFERRED_QUERIES;
+
+	return true;
+}
+
+GLShaderProgram::Status GLShaderProgram::pollStatus()
+{
+	if (status_ != Status::LINKED_WITH_DEFERRED_QUERIES && status_ != Status::LINKING)
+		return status_;
+
+#ifdef GL_COMPLETION_STATUS_KHR
+	if (isParallelCompileAvailable())
+	{
+		GLint completed = GL_FALSE;
+		glGetProgramiv(glHandle_, GL_COMPLETION_STATUS_KHR, &completed);
+		if (completed == GL_FALSE)
+		{
+			status_ = Status::LINKING;
+			return status_;
+		}
+
+		// Queries will not stall anymore
+		status_ = Status::LINKED_WITH_DEFERRED_QUERIES;
+		deferredQueries();
+	}
+#endif
+
+	return status_;
+}
+
 void GLShaderProgram::use()
 {
 	if (boundProgram_ != glHandle_)
@@ -236,6 +293,7 @@ void GLShaderProgram::reset()
 	}
 
 	status_ = Status::NOT_LINKED;
+	binaryCacheHash_ = 0;
 }
 
 void GLShaderProgram::setObjectLabel(const char *label)
@@ -247,15 +305,31 @@ void GLShaderProgram::setObjectLabel(const char *label)
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
 
+bool GLShaderProgram::isParallelCompileAvailable()
+{
+#ifdef GL_COMPLETION_STATUS_KHR
+	return theServiceLocator().gfxCapabilities().hasExtension(IGfxCapabilities::GLExtensions::KHR_PARALLEL_SHADER_COMPILE);
+#else
+	return false;
+#endif
+}
+
 bool GLShaderProgram::deferredQueries()
 {
-	if (status_ == GLShaderProgram::Status::LINKED_WITH_DEFERRED_QUERIES)
+	if (status_ == GLShaderProgram::Status::LINKED_WITH_DEFERRED_QUERIES || status_ == GLShaderProgram::Status::LINKING)
 	{
 		for (nctl::UniquePtr<GLShader> &attachedShader : attachedShaders_)
 		{
 			const bool compileCheck = attachedShader->checkCompilation(shouldLogOnErrors_);
 			if (compileCheck == false)
+			{
+				// The program can be reused by attaching new shaders after a reset
+				for (const nctl::UniquePtr<GLShader> &shader : attachedShaders_)
+					glDetachShader(glHandle_, shader->glHandle());
+				attachedShaders_.clear();
+				status_ = Status::COMPILATION_FAILED;
 				return false;
+			}
 		}
 
 		const bool linkCheck = checkLinking();
@@ -294,10 +368,18 @@ bool GLShaderProgram::checkLinking()
 		}
 
 		status_ = Status::LINKING_FAILED;
+		binaryCacheHash_ = 0;
 		return false;
 	}
 
 	status_ = Status::LINKED;
+	if (binaryCacheHash_ != 0)
+	{
+		BinaryShaderCache *binaryShaderCache = RenderResources::binaryShaderCache();
+		if (binaryShaderCache != nullptr)
+			binaryShaderCache->saveToCache(glHandle_, binaryCacheHash_);
+		binaryCacheHash_ = 0;
+	}
 	return true;
 }
 
@@ -1,6 +1,7 @@
 #include "GLShaderUniforms.h"
 #include "GLShaderProgram.h"
 #include "GLUniformCache.h"
+#include "GLUniform.h"
 #include "RenderResources.h"
 #include <nctl/StaticHashMapIterator.h>
 #include <nctl/algorithms.h>
@@ -81,6 +82,15 @@ GLUniformCache *GLShaderUniforms::uniform(const char *name)
 	return uniformCache;
 }
 
+GLUniformCache *GLShaderUniforms::uniformHandle(const char *name, GLenum type)
+{
+	GLUniformCache *uniformCache = uniform(name);
+	if (uniformCache && uniformCache->uniform()->type() != type)
+		uniformCache = nullptr;
+
+	return uniformCache;
+}
+
 void GLShaderUniforms::commitUniforms()
 {
 	if (shaderProgram_)
@@ -1,6 +1,7 @@
 #include "common_macros.h"
 #include "GLUniformBlockCache.h"
 #include "GLUniformBlock.h"
+#include "GLUniform.h"
 #include <nctl/StaticHashMapIterator.h>
 
 namespace ncine {
@@ -101,6 +102,15 @@ GLUniformCache *GLUniformBlockCache::uniform(const char *name)
 	return uniformCaches_.find(name);
 }
 
+GLUniformCache *GLUniformBlockCache::uniformHandle(const char *name, GLenum type)
+{
+	GLUniformCache *uniformCache = uniformCaches_.find(name);
+	if (uniformCache && uniformCache->uniform()->type() != type)
+		uniformCache = nullptr;
+
+	return uniformCache;
+}
+
 void GLUniformBlockCache::setBlockBinding(GLuint blockBinding)
 {
 	if (uniformBlock_)
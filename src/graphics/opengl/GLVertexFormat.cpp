@@ -1,4 +1,5 @@
 #include "common_macros.h"
+#include <nctl/HashFunctions.h>
 #include "GLVertexFormat.h"
 #include "GLBufferObject.h"
 #include "IGfxCapabilities.h"
@@ -10,12 +11,12 @@ namespace ncine {
 ///////////////////////////////////////////////////////////
 
 GLVertexFormat::Attribute::Attribute()
-    : enabled_(false), vbo_(nullptr), index_(0), size_(-1), type_(GL_FLOAT), stride_(0), pointer_(nullptr), baseOffset_(0)
+    : enabled_(false), vbo_(nullptr), index_(0), size_(-1), type_(GL_FLOAT), stride_(0), pointer_(nullptr), baseOffset_(0), divisor_(0), hasChanged_(true)
 {
 }
 
 GLVertexFormat::GLVertexFormat()
-    : attributes_(nctl::StaticArrayMode::EXTEND_SIZE), ibo_(nullptr)
+    : attributes_(nctl::StaticArrayMode::EXTEND_SIZE), ibo_(nullptr), hash_(0), isHashDirty_(true)
 {
 }
 
@@ -34,7 +35,8 @@ bool GLVertexFormat::Attribute::operator==(const Attribute &other) const
 	         other.normalized_ == normalized_ &&
 	         other.stride_ == stride_ &&
 	         other.pointer_ == pointer_ &&
-	         other.baseOffset_ == baseOffset_));
+	         other.baseOffset_ == baseOffset_ &&
+	         other.divisor_ == divisor_));
 }
 
 bool GLVertexFormat::Attribute::operator!=(const Attribute &other) const
@@ -53,6 +55,8 @@ void GLVertexFormat::Attribute::init(unsigned int index, GLint size, GLenum type
 	stride_ = 0;
 	pointer_ = nullptr;
 	baseOffset_ = 0;
+	divisor_ = 0;
+	hasChanged_ = true;
 }
 
 void GLVertexFormat::Attribute::setVboParameters(GLsizei stride, const GLvoid *pointer)
@@ -70,10 +74,14 @@ void GLVertexFormat::Attribute::setVboParameters(GLsizei stride, const GLvoid *p
 		stride_ = stride;
 
 	pointer_ = pointer;
+	hasChanged_ = true;
 }
 
 void GLVertexFormat::define()
 {
+	// Discarding the cached hash when a VAO is defined guards against a state that has been changed without a setter
+	isHashDirty_ = true;
+
 	for (unsigned int i = 0; i < MaxAttributes; i++)
 	{
 		if (attributes_[i].enabled_)
@@ -81,12 +89,9 @@ void GLVertexFormat::define()
 			attributes_[i].vbo_->bind();
 			glEnableVertexAttribArray(attributes_[i].index_);
 
-#if (defined(WITH_OPENGLES) && !GL_ES_VERSION_3_2) || defined(__EMSCRIPTEN__)
+			// Per-instance attributes are not affected by the first vertex of a draw call and always need the base offset
 			const GLubyte *initialPointer = reinterpret_cast<const GLubyte *>(attributes_[i].pointer_);
 			const GLvoid *pointer = reinterpret_cast<const GLvoid *>(initialPointer + attributes_[i].baseOffset_);
-#else
-			const GLvoid *pointer = attributes_[i].pointer_;
-#endif
 
 			switch (attributes_[i].type_)
 			{
@@ -105,6 +110,8 @@ void GLVertexFormat::define()
 					glVertexAttribPointer(attributes_[i].index_, attributes_[i].size_, attributes_[i].type_, attributes_[i].normalized_, attributes_[i].stride_, pointer);
 					break;
 			}
+			// A VAO from the pool might have been defined before with a different divisor
+			glVertexAttribDivisor(attributes_[i].index_, attributes_[i].divisor_);
 		}
 	}
 
@@ -117,6 +124,7 @@ void GLVertexFormat::reset()
 	for (unsigned int i = 0; i < MaxAttributes; i++)
 		attributes_[i].enabled_ = false;
 	ibo_ = nullptr;
+	isHashDirty_ = true;
 }
 
 bool GLVertexFormat::operator==(const GLVertexFormat &other) const
@@ -144,4 +152,43 @@ bool GLVertexFormat::operator!=(const GLVertexFormat &other) const
 	return !operator==(other);
 }
 
+uint64_t GLVertexFormat::hash() const
+{
+	static const uint64_t Seed = 2654435761;
+
+	for (unsigned int i = 0; i < MaxAttributes && isHashDirty_ == false; i++)
+		isHashDirty_ = attributes_[i].hasChanged_;
+	if (isHashDirty_ == false)
+		return hash_;
+
+	const uint64_t iboPointer = uintptr_t(ibo_);
+	uint64_t hash = nctl::fasthash64(&iboPointer, sizeof(uint64_t), Seed);
+
+	// Attributes are widened to 64 bits, so that there are no padding bytes to hash
+	uint64_t attributeData[8];
+	for (unsigned int i = 0; i < MaxAttributes; i++)
+	{
+		const Attribute &attribute = attributes_[i];
+		if (attribute.enabled_ == false)
+			continue;
+
+		attributeData[0] = i;
+		attributeData[1] = attribute.vbo_ ? attribute.vbo_->glHandle() : 0;
+		attributeData[2] = (static_cast<uint64_t>(attribute.index_) << 32) | static_cast<uint32_t>(attribute.size_);
+		attributeData[3] = (static_cast<uint64_t>(attribute.type_) << 32) | attribute.normalized_;
+		attributeData[4] = static_cast<uint32_t>(attribute.stride_);
+		attributeData[5] = uintptr_t(attribute.pointer_);
+		attributeData[6] = attribute.baseOffset_;
+		attributeData[7] = attribute.divisor_;
+		hash = nctl::fasthash64(attributeData, sizeof(attributeData), hash);
+	}
+
+	for (unsigned int i = 0; i < MaxAttributes; i++)
+		attributes_[i].hasChanged_ = false;
+	hash_ = hash;
+	isHashDirty_ = false;
+
+	return hash;
+}
+
 }
@@ -0,0 +1,1128 @@
+#define NCINE_INCLUDE_OPENGL
+#include "common_headers.h"
+#include "HeadlessGL.h"
+#include "HeadlessShaderIntrospection.h"
+#include <nctl/Array.h>
+#include <nctl/UniquePtr.h>
+#include <cstring> // for memcpy()
+
+namespace ncine {
+
+namespace {
+	HeadlessGL::Counters totalCounters;
+	HeadlessGL::Counters frameStartCounters;
+	HeadlessGL::Counters lastFrameCounters;
+	unsigned long int numCompletedFrames = 0;
+	/// The value answered to `GL_COMPLETION_STATUS_KHR` queries
+	bool compilationCompleted = true;
+
+	const char *VendorString = "nCine";
+	const char *RendererString = "nCine Headless";
+	const char *VersionString = "3.3.0 nCine Headless";
+	const char *ShadingLanguageVersionString = "3.30 nCine Headless";
+	const char *ExtensionStrings[] = { "GL_ARB_texture_storage", "GL_ARB_buffer_storage", "GL_ARB_get_program_binary", "GL_KHR_parallel_shader_compile" };
+	const GLint NumExtensions = sizeof(ExtensionStrings) / sizeof(*ExtensionStrings);
+
+	const unsigned int MaxTextureUnits = 32;
+	/// The only program binary format, a binary holds the lengths of the two stage sources followed by the sources themselves
+	const GLenum ProgramBinaryFormat = 0x4E43;
+
+	/// The host memory that stands in for the storage of a buffer object
+	struct BufferObject
+	{
+		nctl::UniquePtr<GLubyte[]> data;
+		GLsizeiptr size = 0;
+		GLintptr mapOffset = 0;
+		GLsizeiptr mapLength = 0;
+		GLbitfield mapAccess = 0;
+	};
+
+	/// The dimensions of level zero of a texture, needed to answer `glGetTexImage()`
+	struct TextureObject
+	{
+		GLsizei width = 0;
+		GLsizei height = 0;
+	};
+
+	struct ShaderObject
+	{
+		GLenum type = GL_NONE;
+		nctl::String source;
+	};
+
+	struct ProgramObject
+	{
+		nctl::Array<GLuint> attachedShaders;
+		/// The vertex and fragment sources at the time of linking, they make up the program binary
+		nctl::String stageSources[2];
+		bool isLinked = false;
+		HeadlessShaderIntrospection introspection;
+	};
+
+	enum BufferTarget
+	{
+		ARRAY_BUFFER,
+		ELEMENT_ARRAY_BUFFER,
+		UNIFORM_BUFFER,
+		PIXEL_PACK_BUFFER,
+		PIXEL_UNPACK_BUFFER,
+		TEXTURE_BUFFER,
+		COPY_READ_BUFFER,
+		COPY_WRITE_BUFFER,
+		OTHER_BUFFER,
+
+		COUNT
+	};
+
+	/// Buffer names start from one, the object of name `n` is stored at index `n - 1`
+	nctl::Array<nctl::UniquePtr<BufferObject>> buffers;
+	nctl::Array<TextureObject> textures;
+	nctl::Array<nctl::UniquePtr<ShaderObject>> shaders;
+	nctl::Array<nctl::UniquePtr<ProgramObject>> programs;
+	/// The element array buffer bound to each vertex array object, index zero is the default one
+	nctl::Array<GLuint> vertexArrays;
+
+	GLuint boundBuffers[BufferTarget::COUNT] = {};
+	GLuint boundVertexArray = 0;
+	GLuint boundTextures[MaxTextureUnits] = {};
+	unsigned int activeTextureUnit = 0;
+	GLuint lastFramebufferName = 0;
+	GLuint lastRenderbufferName = 0;
+
+	BufferTarget bufferTarget(GLenum target)
+	{
+		switch (target)
+		{
+			case GL_ARRAY_BUFFER: return BufferTarget::ARRAY_BUFFER;
+			case GL_ELEMENT_ARRAY_BUFFER: return BufferTarget::ELEMENT_ARRAY_BUFFER;
+			case GL_UNIFORM_BUFFER: return BufferTarget::UNIFORM_BUFFER;
+			case GL_PIXEL_PACK_BUFFER: return BufferTarget::PIXEL_PACK_BUFFER;
+			case GL_PIXEL_UNPACK_BUFFER: return BufferTarget::PIXEL_UNPACK_BUFFER;
+			case GL_TEXTURE_BUFFER: return BufferTarget::TEXTURE_BUFFER;
+			case GL_COPY_READ_BUFFER: return BufferTarget::COPY_READ_BUFFER;
+			case GL_COPY_WRITE_BUFFER: return BufferTarget::COPY_WRITE_BUFFER;
+			default: return BufferTarget::OTHER_BUFFER;
+		}
+	}
+
+	GLuint &boundBuffer(GLenum target)
+	{
+		const BufferTarget bufferIndex = bufferTarget(target);
+		if (bufferIndex == BufferTarget::ELEMENT_ARRAY_BUFFER)
+		{
+			if (vertexArrays.isEmpty())
+				vertexArrays.pushBack(0);
+			return vertexArrays[boundVertexArray];
+		}
+		return boundBuffers[bufferIndex];
+	}
+
+	BufferObject *boundBufferObject(GLenum target)
+	{
+		const GLuint name = boundBuffer(target);
+		return (name > 0 && name <= buffers.size()) ? buffers[name - 1].get() : nullptr;
+	}
+
+	TextureObject *boundTextureObject()
+	{
+		const GLuint name = boundTextures[activeTextureUnit];
+		return (name > 0 && name <= textures.size()) ? &textures[name - 1] : nullptr;
+	}
+
+	ProgramObject *programObject(GLuint program)
+	{
+		return (program > 0 && program <= programs.size()) ? programs[program - 1].get() : nullptr;
+	}
+
+	bool isPixelUnpackBufferBound()
+	{
+		return boundBuffers[BufferTarget::PIXEL_UNPACK_BUFFER] != 0;
+	}
+
+	void storeBufferData(GLenum target, GLsizeiptr size, const void *data)
+	{
+		BufferObject *buffer = boundBufferObject(target);
+		if (buffer == nullptr)
+			return;
+
+		buffer->data = nctl::makeUnique<GLubyte[]>(static_cast<unsigned long int>(size > 0 ? size : 1));
+		buffer->size = size;
+		if (data != nullptr && size > 0)
+		{
+			memcpy(buffer->data.get(), data, static_cast<size_t>(size));
+			totalCounters.bufferBytes += static_cast<uint64_t>(size);
+		}
+	}
+
+	unsigned int numComponents(GLenum format)
+	{
+		switch (format)
+		{
+			case GL_RED:
+			case GL_RED_INTEGER:
+			case GL_DEPTH_COMPONENT:
+			case GL_STENCIL_INDEX:
+			case GL_ALPHA:
+			case GL_LUMINANCE:
+				return 1;
+			case GL_RG:
+			case GL_RG_INTEGER:
+			case GL_DEPTH_STENCIL:
+			case GL_LUMINANCE_ALPHA:
+				return 2;
+			case GL_RGB:
+			case GL_BGR:
+			case GL_RGB_INTEGER:
+				return 3;
+			default:
+				return 4;
+		}
+	}
+
+	unsigned int bytesPerPixel(GLenum format, GLenum type)
+	{
+		switch (type)
+		{
+			case GL_UNSIGNED_SHORT_5_6_5:
+			case GL_UNSIGNED_SHORT_4_4_4_4:
+			case GL_UNSIGNED_SHORT_5_5_5_1:
+				return 2;
+			case GL_UNSIGNED_INT_24_8:
+			case GL_UNSIGNED_INT_2_10_10_10_REV:
+			case GL_UNSIGNED_INT_10F_11F_11F_REV:
+				return 4;
+			case GL_UNSIGNED_SHORT:
+			case GL_SHORT:
+			case GL_HALF_FLOAT:
+				return 2 * numComponents(format);
+			case GL_UNSIGNED_INT:
+			case GL_INT:
+			case GL_FLOAT:
+				return 4 * numComponents(format);
+			default:
+				return numComponents(format);
+		}
+	}
+
+	void countTextureUpload(GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels)
+	{
+		// Pixels sourced from a buffer object have already been counted when the buffer was filled
+		if (pixels != nullptr && isPixelUnpackBufferBound() == false && width > 0 && height > 0)
+			totalCounters.textureBytes += static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * bytesPerPixel(format, type);
+	}
+
+	void copyName(const nctl::String &name, GLsizei bufSize, GLsizei *length, GLchar *dest)
+	{
+		GLsizei nameLength = 0;
+		if (dest != nullptr && bufSize > 0)
+		{
+			nameLength = static_cast<GLsizei>(name.length()) < bufSize - 1 ? static_cast<GLsizei>(name.length()) : bufSize - 1;
+			memcpy(dest, name.data(), static_cast<size_t>(nameLength));
+			dest[nameLength] = '\0';
+		}
+		if (length != nullptr)
+			*length = nameLength;
+	}
+
+	template <class T>
+	GLint maxNameLength(const nctl::Array<T> &items)
+	{
+		GLint maxLength = 0;
+		for (const T &item : items)
+		{
+			if (static_cast<GLint>(item.name.length()) + 1 > maxLength)
+				maxLength = static_cast<GLint>(item.name.length()) + 1;
+		}
+		return maxLength;
+	}
+
+	/// Copies a source without `nctl::String::append()`, which truncates long C strings
+	void copySource(nctl::String &dest, const char *source, unsigned int length)
+	{
+		dest.setCapacity(length + 1);
+		memcpy(dest.data(), source, length);
+		dest.data()[length] = '\0';
+		dest.setLength(length);
+	}
+
+	void linkStages(ProgramObject &programObject)
+	{
+		// The vertex stage is added first, so that it assigns the locations of the uniforms it declares
+		const GLenum stages[2] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER };
+		programObject.introspection.clear();
+		for (unsigned int i = 0; i < 2; i++)
+		{
+			if (programObject.stageSources[i].isEmpty() == false)
+				programObject.introspection.addStage(stages[i], programObject.stageSources[i].data());
+		}
+		programObject.isLinked = true;
+	}
+
+	void countUniform(GLsizei count, unsigned int numFloats)
+	{
+		totalCounters.numCalls++;
+		totalCounters.uniformBytes += static_cast<uint64_t>(count) * numFloats * 4;
+	}
+
+	void subtractCounters(HeadlessGL::Counters &result, const HeadlessGL::Counters &a, const HeadlessGL::Counters &b)
+	{
+		result.numCalls = a.numCalls - b.numCalls;
+		result.numDrawCalls = a.numDrawCalls - b.numDrawCalls;
+		result.numBindCalls = a.numBindCalls - b.numBindCalls;
+		result.bufferBytes = a.bufferBytes - b.bufferBytes;
+		result.textureBytes = a.textureBytes - b.textureBytes;
+		result.uniformBytes = a.uniformBytes - b.uniformBytes;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+const HeadlessGL::Counters &HeadlessGL::totalCounters()
+{
+	return ncine::totalCounters;
+}
+
+const HeadlessGL::Counters &HeadlessGL::frameCounters()
+{
+	return lastFrameCounters;
+}
+
+unsigned long int HeadlessGL::numFrames()
+{
+	return numCompletedFrames;
+}
+
+bool HeadlessGL::isCompilationCompleted()
+{
+	return compilationCompleted;
+}
+
+void HeadlessGL::setCompilationCompleted(bool completed)
+{
+	compilationCompleted = completed;
+}
+
+void HeadlessGL::resetCounters()
+{
+	ncine::totalCounters = Counters();
+	frameStartCounters = Counters();
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void HeadlessGL::endFrame()
+{
+	subtractCounters(lastFrameCounters, ncine::totalCounters, frameStartCounters);
+	frameStartCounters = ncine::totalCounters;
+	numCompletedFrames++;
+}
+
+}
+
+using ncine::totalCounters;
+
+/// The stub OpenGL functions, called by the engine instead of the ones of a driver
+extern "C" {
+
+///////////////////////////////////////////////////////////
+// STATE AND QUERIES
+///////////////////////////////////////////////////////////
+
+void glEnable(GLenum cap) { totalCounters.numCalls++; }
+void glDisable(GLenum cap) { totalCounters.numCalls++; }
+void glBlendFunc(GLenum sfactor, GLenum dfactor) { totalCounters.numCalls++; }
+void glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha) { totalCounters.numCalls++; }
+void glCullFace(GLenum mode) { totalCounters.numCalls++; }
+void glDepthMask(GLboolean flag) { totalCounters.numCalls++; }
+void glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) { totalCounters.numCalls++; }
+void glClear(GLbitfield mask) { totalCounters.numCalls++; }
+void glViewport(GLint x, GLint y, GLsizei width, GLsizei height) { totalCounters.numCalls++; }
+void glScissor(GLint x, GLint y, GLsizei width, GLsizei height) { totalCounters.numCalls++; }
+
+GLenum glGetError()
+{
+	totalCounters.numCalls++;
+	return GL_NO_ERROR;
+}
+
+const GLubyte *glGetString(GLenum name)
+{
+	totalCounters.numCalls++;
+	switch (name)
+	{
+		case GL_VENDOR: return reinterpret_cast<const GLubyte *>(ncine::VendorString);
+		case GL_RENDERER: return reinterpret_cast<const GLubyte *>(ncine::RendererString);
+		case GL_VERSION: return reinterpret_cast<const GLubyte *>(ncine::VersionString);
+		case GL_SHADING_LANGUAGE_VERSION: return reinterpret_cast<const GLubyte *>(ncine::ShadingLanguageVersionString);
+		default: return nullptr;
+	}
+}
+
+const GLubyte *glGetStringi(GLenum name, GLuint index)
+{
+	totalCounters.numCalls++;
+	if (name == GL_EXTENSIONS && index < static_cast<GLuint>(ncine::NumExtensions))
+		return reinterpret_cast<const GLubyte *>(ncine::ExtensionStrings[index]);
+	return nullptr;
+}
+
+void glGetIntegerv(GLenum pname, GLint *data)
+{
+	totalCounters.numCalls++;
+	switch (pname)
+	{
+		case GL_MAJOR_VERSION: *data = 3; break;
+		case GL_MINOR_VERSION: *data = 3; break;
+		case GL_MAX_TEXTURE_SIZE: *data = 16384; break;
+		case GL_MAX_TEXTURE_IMAGE_UNITS: *data = static_cast<GLint>(ncine::MaxTextureUnits); break;
+		case GL_MAX_UNIFORM_BLOCK_SIZE: *data = 65536; break;
+		case GL_MAX_UNIFORM_BUFFER_BINDINGS: *data = 84; break;
+		case GL_MAX_VERTEX_UNIFORM_BLOCKS: *data = 14; break;
+		case GL_MAX_FRAGMENT_UNIFORM_BLOCKS: *data = 14; break;
+		case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT: *data = 256; break;
+		case GL_MAX_VERTEX_ATTRIB_STRIDE: *data = 2048; break;
+		case GL_MAX_COLOR_ATTACHMENTS: *data = 8; break;
+		case GL_MAX_LABEL_LENGTH: *data = 256; break;
+		case GL_NUM_EXTENSIONS: *data = ncine::NumExtensions; break;
+		case GL_NUM_PROGRAM_BINARY_FORMATS: *data = 1; break;
+		case GL_PROGRAM_BINARY_FORMATS: *data = static_cast<GLint>(ncine::ProgramBinaryFormat); break;
+		case GL_ACTIVE_TEXTURE: *data = static_cast<GLint>(GL_TEXTURE0 + ncine::activeTextureUnit); break;
+		case GL_VERTEX_ARRAY_BINDING: *data = static_cast<GLint>(ncine::boundVertexArray); break;
+		default: *data = 0; break;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// DEBUG
+///////////////////////////////////////////////////////////
+
+void glDebugMessageCallback(GLDEBUGPROC callback, const void *userParam) { totalCounters.numCalls++; }
+void glDebugMessageInsert(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *buf) { totalCounters.numCalls++; }
+void glPushDebugGroup(GLenum source, GLuint id, GLsizei length, const GLchar *message) { totalCounters.numCalls++; }
+void glPopDebugGroup() { totalCounters.numCalls++; }
+void glObjectLabel(GLenum identifier, GLuint name, GLsizei length, const GLchar *label) { totalCounters.numCalls++; }
+
+void glGetObjectLabel(GLenum identifier, GLuint name, GLsizei bufSize, GLsizei *length, GLchar *label)
+{
+	totalCounters.numCalls++;
+	if (label != nullptr && bufSize > 0)
+		label[0] = '\0';
+	if (length != nullptr)
+		*length = 0;
+}
+
+///////////////////////////////////////////////////////////
+// BUFFERS
+///////////////////////////////////////////////////////////
+
+void glGenBuffers(GLsizei n, GLuint *buffers)
+{
+	totalCounters.numCalls++;
+	for (GLsizei i = 0; i < n; i++)
+	{
+		ncine::buffers.pushBack(nctl::makeUnique<ncine::BufferObject>());
+		buffers[i] = ncine::buffers.size();
+	}
+}
+
+void glDeleteBuffers(GLsizei n, const GLuint *buffers)
+{
+	totalCounters.numCalls++;
+	for (GLsizei i = 0; i < n; i++)
+	{
+		if (buffers[i] > 0 && buffers[i] <= ncine::buffers.size())
+			ncine::buffers[buffers[i] - 1].reset(nullptr);
+	}
+}
+
+void glBindBuffer(GLenum target, GLuint buffer)
+{
+	totalCounters.numCalls++;
+	totalCounters.numBindCalls++;
+	ncine::boundBuffer(target) = buffer;
+}
+
+void glBindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+	totalCounters.numCalls++;
+	totalCounters.numBindCalls++;
+	ncine::boundBuffer(target) = buffer;
+}
+
+void glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+	totalCounters.numCalls++;
+	totalCounters.numBindCalls++;
+	ncine::boundBuffer(target) = buffer;
+}
+
+void glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+	totalCounters.numCalls++;
+	ncine::storeBufferData(target, size, data);
+}
+
+void glBufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags)
+{
+	totalCounters.numCalls++;
+	ncine::storeBufferData(target, size, data);
+}
+
+void glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+	totalCounters.numCalls++;
+	ncine::BufferObject *buffer = ncine::boundBufferObject(target);
+	if (buffer != nullptr && data != nullptr && offset >= 0 && size > 0 && offset + size <= buffer->size)
+	{
+		memcpy(buffer->data.get() + offset, data, static_cast<size_t>(size));
+		totalCounters.bufferBytes += static_cast<uint64_t>(size);
+	}
+}
+
+void *glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+	totalCounters.numCalls++;
+	ncine::BufferObject *buffer = ncine::boundBufferObject(target);
+	if (buffer == nullptr || offset < 0 || length <= 0 || offset + length > buffer->size)
+		return nullptr;
+
+	buffer->mapOffset = offset;
+	buffer->mapLength = length;
+	buffer->mapAccess = access;
+	return buffer->data.get() + offset;
+}
+
+void glFlushMappedBufferRange(GLenum target, GLintptr offset, GLsizeiptr length)
+{
+	totalCounters.numCalls++;
+	if (length > 0)
+		totalCounters.bufferBytes += static_cast<uint64_t>(length);
+}
+
+GLboolean glUnmapBuffer(GLenum target)
+{
+	totalCounters.numCalls++;
+	ncine::BufferObject *buffer = ncine::boundBufferObject(target);
+	if (buffer == nullptr)
+		return GL_FALSE;
+
+	// Without explicit flushing the whole mapped range is considered modified
+	if ((buffer->mapAccess & GL_MAP_WRITE_BIT) && (buffer->mapAccess & GL_MAP_FLUSH_EXPLICIT_BIT) == 0)
+		totalCounters.bufferBytes += static_cast<uint64_t>(buffer->mapLength);
+	buffer->mapOffset = 0;
+	buffer->mapLength = 0;
+	buffer->mapAccess = 0;
+	return GL_TRUE;
+}
+
+void glTexBuffer(GLenum target, GLenum internalformat, GLuint buffer) { totalCounters.numCalls++; }
+
+GLsync glFenceSync(GLenum condition, GLbitfield flags)
+{
+	static int fence = 0;
+	totalCounters.numCalls++;
+	return reinterpret_cast<GLsync>(&fence);
+}
+
+GLenum glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+	totalCounters.numCalls++;
+	return GL_ALREADY_SIGNALED;
+}
+
+void glDeleteSync(GLsync sync) { totalCounters.numCalls++; }
+
+///////////////////////////////////////////////////////////
+// VERTEX ARRAYS AND DRAWING
+///////////////////////////////////////////////////////////
+
+void glGenVertexArrays(GLsizei n, GLuint *arrays)
+{
+	totalCounters.numCalls++;
+	if (ncine::vertexArrays.isEmpty())
+		ncine::vertexArrays.pushBack(0);
+	for (GLsizei i = 0; i < n; i++)
+	{
+		arrays[i] = ncine::vertexArrays.size();
+		ncine::vertexArrays.pushBack(0);
+	}
+}
+
+void glDeleteVertexArrays(GLsizei n, const GLuint *arrays)
+{
+	totalCounters.numCalls++;
+	for (GLsizei i = 0; i < n; i++)
+	{
+		if (arrays[i] == ncine::boundVertexArray)
+			ncine::boundVertexArray = 0;
+	}
+}
+
+void glBindVertexArray(GLuint array)
+{
+	totalCounters.numCalls++;
+	totalCounters.numBindCalls++;
+	ncine::boundVertexArray = (array < ncine::vertexArrays.size()) ? array : 0;
+}
+
+void glEnableVertexAttribArray(GLuint index) { totalCounters.numCalls++; }
+void glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) { totalCounters.numCalls++; }
+void glVertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer) { totalCounters.numCalls++; }
+void glVertexAttribDivisor(GLuint index, GLuint divisor) { totalCounters.numCalls++; }
+
+void glDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+	totalCounters.numCalls++;
+	totalCounters.numDrawCalls++;
+}
+
+void glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount)
+{
+	totalCounters.numCalls++;
+	totalCounters.numDrawCalls++;
+}
+
+void glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices)
+{
+	totalCounters.numCalls++;
+	totalCounters.numDrawCalls++;
+}
+
+void glDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex)
+{
+	totalCounters.numCalls++;
+	totalCounters.numDrawCalls++;
+}
+
+void glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount)
+{
+	totalCounters.numCalls++;
+	totalCounters.numDrawCalls++;
+}
+
+void glDrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex)
+{
+	totalCounters.numCalls++;
+	totalCounters.numDrawCalls++;
+}
+
+///////////////////////////////////////////////////////////
+// TEXTURES
+///////////////////////////////////////////////////////////
+
+void glGenTextures(GLsizei n, GLuint *textures)
+{
+	totalCounters.numCalls++;
+	for (GLsizei i = 0; i < n; i++)
+	{
+		ncine::textures.pushBack(ncine::TextureObject());
+		textures[i] = ncine::textures.size();
+	}
+}
+
+void glDeleteTextures(GLsizei n, const GLuint *textures)
+{
+	totalCounters.numCalls++;
+	for (GLsizei i = 0; i < n; i++)
+	{
+		for (unsigned int unit = 0; unit < ncine::MaxTextureUnits; unit++)
+		{
+			if (ncine::boundTextures[unit] == textures[i])
+				ncine::boundTextures[unit] = 0;
+		}
+	}
+}
+
+void glActiveTexture(GLenum texture)
+{
+	totalCounters.numCalls++;
+	const unsigned int unit = texture - GL_TEXTURE0;
+	ncine::activeTextureUnit = (unit < ncine::MaxTextureUnits) ? unit : 0;
+}
+
+void glBindTexture(GLenum target, GLuint texture)
+{
+	totalCounters.numCalls++;
+	totalCounters.numBindCalls++;
+	ncine::boundTextures[ncine::activeTextureUnit] = texture;
+}
+
+void glTexParameterf(GLenum target, GLenum pname, GLfloat param) { totalCounters.numCalls++; }
+void glTexParameteri(GLenum target, GLenum pname, GLint param) { totalCounters.numCalls++; }
+
+void glTexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)
+{
+	totalCounters.numCalls++;
+	ncine::TextureObject *texture = ncine::boundTextureObject();
+	if (texture != nullptr)
+	{
+		texture->width = width;
+		texture->height = height;
+	}
+}
+
+void glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels)
+{
+	totalCounters.numCalls++;
+	ncine::TextureObject *texture = ncine::boundTextureObject();
+	if (texture != nullptr && level == 0)
+	{
+		texture->width = width;
+		texture->height = height;
+	}
+	ncine::countTextureUpload(width, height, format, type, pixels);
+}
+
+void glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels)
+{
+	totalCounters.numCalls++;
+	ncine::countTextureUpload(width, height, format, type, pixels);
+}
+
+void glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data)
+{
+	totalCounters.numCalls++;
+	ncine::TextureObject *texture = ncine::boundTextureObject();
+	if (texture != nullptr && level == 0)
+	{
+		texture->width = width;
+		texture->height = height;
+	}
+	if (data != nullptr && ncine::isPixelUnpackBufferBound() == false && imageSize > 0)
+		totalCounters.textureBytes += static_cast<uint64_t>(imageSize);
+}
+
+void glCompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data)
+{
+	totalCounters.numCalls++;
+	if (data != nullptr && ncine::isPixelUnpackBufferBound() == false && imageSize > 0)
+		totalCounters.textureBytes += static_cast<uint64_t>(imageSize);
+}
+
+void glGetTexImage(GLenum target, GLint level, GLenum format, GLenum type, void *pixels)
+{
+	totalCounters.numCalls++;
+	const ncine::TextureObject *texture = ncine::boundTextureObject();
+	if (texture == nullptr || pixels == nullptr || ncine::boundBuffers[ncine::BufferTarget::PIXEL_PACK_BUFFER] != 0)
+		return;
+
+	const GLsizei width = (texture->width >> level) > 0 ? (texture->width >> level) : 1;
+	const GLsizei height = (texture->height >> level) > 0 ? (texture->height >> level) : 1;
+	memset(pixels, 0, static_cast<size_t>(width) * static_cast<size_t>(height) * ncine::bytesPerPixel(format, type));
+}
+
+///////////////////////////////////////////////////////////
+// FRAMEBUFFERS
+///////////////////////////////////////////////////////////
+
+void glGenFramebuffers(GLsizei n, GLuint *framebuffers)
+{
+	totalCounters.numCalls++;
+	for (GLsizei i = 0; i < n; i++)
+		framebuffers[i] = ++ncine::lastFramebufferName;
+}
+
+void glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers) { totalCounters.numCalls++; }
+
+void glBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+	totalCounters.numCalls++;
+	totalCounters.numBindCalls++;
+}
+
+void glGenRenderbuffers(GLsizei n, GLuint *renderbuffers)
+{
+	totalCounters.numCalls++;
+	for (GLsizei i = 0; i < n; i++)
+		renderbuffers[i] = ++ncine::lastRenderbufferName;
+}
+
+void glDeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers) { totalCounters.numCalls++; }
+
+void glBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+	totalCounters.numCalls++;
+	totalCounters.numBindCalls++;
+}
+
+void glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) { totalCounters.numCalls++; }
+void glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) { totalCounters.numCalls++; }
+void glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) { totalCounters.numCalls++; }
+void glDrawBuffers(GLsizei n, const GLenum *bufs) { totalCounters.numCalls++; }
+void glInvalidateFramebuffer(GLenum target, GLsizei numAttachments, const GLenum *attachments) { totalCounters.numCalls++; }
+
+GLenum glCheckFramebufferStatus(GLenum target)
+{
+	totalCounters.numCalls++;
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+///////////////////////////////////////////////////////////
+// SHADERS
+///////////////////////////////////////////////////////////
+
+GLuint glCreateShader(GLenum type)
+{
+	totalCounters.numCalls++;
+	nctl::UniquePtr<ncine::ShaderObject> shader = nctl::makeUnique<ncine::ShaderObject>();
+	shader->type = type;
+	ncine::shaders.pushBack(nctl::move(shader));
+	return ncine::shaders.size();
+}
+
+void glDeleteShader(GLuint shader)
+{
+	totalCounters.numCalls++;
+	// The engine detaches and deletes shaders only after having linked them
+	if (shader > 0 && shader <= ncine::shaders.size())
+		ncine::shaders[shader - 1].reset(nullptr);
+}
+
+void glShaderSource(GLuint shader, GLsizei count, const GLchar *const *string, const GLint *length)
+{
+	totalCounters.numCalls++;
+	if (shader == 0 || shader > ncine::shaders.size() || ncine::shaders[shader - 1] == nullptr)
+		return;
+
+	unsigned int totalLength = 0;
+	for (GLsizei i = 0; i < count; i++)
+		totalLength += (length != nullptr && length[i] >= 0) ? static_cast<unsigned int>(length[i]) : static_cast<unsigned int>(strlen(string[i]));
+
+	// The source is copied without `nctl::String::append()`, which truncates long C strings
+	nctl::String &source = ncine::shaders[shader - 1]->source;
+	source.setCapacity(totalLength + 1);
+	char *dest = source.data();
+	for (GLsizei i = 0; i < count; i++)
+	{
+		const size_t stringLength = (length != nullptr && length[i] >= 0) ? static_cast<size_t>(length[i]) : strlen(string[i]);
+		memcpy(dest, string[i], stringLength);
+		dest += stringLength;
+	}
+	*dest = '\0';
+	source.setLength(totalLength);
+}
+
+void glCompileShader(GLuint shader) { totalCounters.numCalls++; }
+void glMaxShaderCompilerThreadsKHR(GLuint count) { totalCounters.numCalls++; }
+
+void glGetShaderiv(GLuint shader, GLenum pname, GLint *params)
+{
+	totalCounters.numCalls++;
+	switch (pname)
+	{
+		case GL_COMPILE_STATUS: *params = GL_TRUE; break;
+		// Compiling and linking are instantaneous, unless the application asks to simulate a driver that is still working
+		case GL_COMPLETION_STATUS_KHR: *params = ncine::compilationCompleted ? GL_TRUE : GL_FALSE; break;
+		case GL_SHADER_TYPE:
+			*params = (shader > 0 && shader <= ncine::shaders.size() && ncine::shaders[shader - 1] != nullptr)
+			              ? static_cast<GLint>(ncine::shaders[shader - 1]->type) : 0;
+			break;
+		default: *params = 0; break;
+	}
+}
+
+void glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+	totalCounters.numCalls++;
+	if (infoLog != nullptr && bufSize > 0)
+		infoLog[0] = '\0';
+	if (length != nullptr)
+		*length = 0;
+}
+
+GLuint glCreateProgram()
+{
+	totalCounters.numCalls++;
+	ncine::programs.pushBack(nctl::makeUnique<ncine::ProgramObject>());
+	return ncine::programs.size();
+}
+
+void glDeleteProgram(GLuint program)
+{
+	totalCounters.numCalls++;
+	if (program > 0 && program <= ncine::programs.size())
+		ncine::programs[program - 1].reset(nullptr);
+}
+
+void glAttachShader(GLuint program, GLuint shader)
+{
+	totalCounters.numCalls++;
+	ncine::ProgramObject *programObject = ncine::programObject(program);
+	if (programObject != nullptr)
+		programObject->attachedShaders.pushBack(shader);
+}
+
+void glDetachShader(GLuint program, GLuint shader)
+{
+	totalCounters.numCalls++;
+	ncine::ProgramObject *programObject = ncine::programObject(program);
+	if (programObject == nullptr)
+		return;
+
+	for (unsigned int i = 0; i < programObject->attachedShaders.size(); i++)
+	{
+		if (programObject->attachedShaders[i] == shader)
+		{
+			programObject->attachedShaders.removeAt(i);
+			break;
+		}
+	}
+}
+
+void glLinkProgram(GLuint program)
+{
+	totalCounters.numCalls++;
+	ncine::ProgramObject *programObject = ncine::programObject(program);
+	if (programObject == nullptr)
+		return;
+
+	programObject->stageSources[0].clear();
+	programObject->stageSources[1].clear();
+	for (GLuint shader : programObject->attachedShaders)
+	{
+		if (shader == 0 || shader > ncine::shaders.size() || ncine::shaders[shader - 1] == nullptr)
+			continue;
+
+		const ncine::ShaderObject &shaderObject = *ncine::shaders[shader - 1];
+		const unsigned int stageIndex = (shaderObject.type == GL_VERTEX_SHADER) ? 0 : 1;
+		ncine::copySource(programObject->stageSources[stageIndex], shaderObject.source.data(), shaderObject.source.length());
+	}
+	ncine::linkStages(*programObject);
+}
+
+void glProgramParameteri(GLuint program, GLenum pname, GLint value) { totalCounters.numCalls++; }
+
+void glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary)
+{
+	totalCounters.numCalls++;
+	const ncine::ProgramObject *programObject = ncine::programObject(program);
+	GLsizei binaryLength = 0;
+	if (programObject != nullptr && programObject->isLinked)
+	{
+		const uint32_t sourceLengths[2] = { programObject->stageSources[0].length(), programObject->stageSources[1].length() };
+		binaryLength = static_cast<GLsizei>(sizeof(sourceLengths) + sourceLengths[0] + sourceLengths[1]);
+		if (binaryLength <= bufSize)
+		{
+			GLubyte *dest = static_cast<GLubyte *>(binary);
+			memcpy(dest, sourceLengths, sizeof(sourceLengths));
+			dest += sizeof(sourceLengths);
+			memcpy(dest, programObject->stageSources[0].data(), sourceLengths[0]);
+			memcpy(dest + sourceLengths[0], programObject->stageSources[1].data(), sourceLengths[1]);
+		}
+		else
+			binaryLength = 0;
+	}
+
+	if (length != nullptr)
+		*length = binaryLength;
+	if (binaryFormat != nullptr)
+		*binaryFormat = ncine::ProgramBinaryFormat;
+}
+
+void glProgramBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length)
+{
+	totalCounters.numCalls++;
+	ncine::ProgramObject *programObject = ncine::programObject(program);
+	if (programObject == nullptr)
+		return;
+
+	// A rejected binary leaves the program unlinked
+	programObject->isLinked = false;
+	programObject->introspection.clear();
+
+	uint32_t sourceLengths[2] = { 0, 0 };
+	if (binaryFormat != ncine::ProgramBinaryFormat || binary == nullptr || length < static_cast<GLsizei>(sizeof(sourceLengths)))
+		return;
+
+	const GLubyte *source = static_cast<const GLubyte *>(binary);
+	memcpy(sourceLengths, source, sizeof(sourceLengths));
+	if (static_cast<uint64_t>(sourceLengths[0]) + sourceLengths[1] + sizeof(sourceLengths) != static_cast<uint64_t>(length))
+		return;
+
+	source += sizeof(sourceLengths);
+	ncine::copySource(programObject->stageSources[0], reinterpret_cast<const char *>(source), sourceLengths[0]);
+	ncine::copySource(programObject->stageSources[1], reinterpret_cast<const char *>(source + sourceLengths[0]), sourceLengths[1]);
+	ncine::linkStages(*programObject);
+}
+
+void glValidateProgram(GLuint program) { totalCounters.numCalls++; }
+
+void glUseProgram(GLuint program)
+{
+	totalCounters.numCalls++;
+	totalCounters.numBindCalls++;
+}
+
+void glGetProgramiv(GLuint program, GLenum pname, GLint *params)
+{
+	totalCounters.numCalls++;
+	const ncine::ProgramObject *programObject = ncine::programObject(program);
+	if (programObject == nullptr)
+	{
+		*params = 0;
+		return;
+	}
+
+	const ncine::HeadlessShaderIntrospection &introspection = programObject->introspection;
+	switch (pname)
+	{
+		case GL_LINK_STATUS:
+		case GL_VALIDATE_STATUS:
+			*params = programObject->isLinked ? GL_TRUE : GL_FALSE;
+			break;
+		case GL_COMPLETION_STATUS_KHR: *params = ncine::compilationCompleted ? GL_TRUE : GL_FALSE; break;
+		case GL_PROGRAM_BINARY_LENGTH:
+			*params = programObject->isLinked ? static_cast<GLint>(2 * sizeof(uint32_t) + programObject->stageSources[0].length() + programObject->stageSources[1].length()) : 0;
+			break;
+		case GL_ATTACHED_SHADERS: *params = static_cast<GLint>(programObject->attachedShaders.size()); break;
+		case GL_ACTIVE_UNIFORMS: *params = static_cast<GLint>(introspection.uniforms.size()); break;
+		case GL_ACTIVE_UNIFORM_MAX_LENGTH: *params = ncine::maxNameLength(introspection.uniforms); break;
+		case GL_ACTIVE_UNIFORM_BLOCKS: *params = static_cast<GLint>(introspection.uniformBlocks.size()); break;
+		case GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH: *params = ncine::maxNameLength(introspection.uniformBlocks); break;
+		case GL_ACTIVE_ATTRIBUTES: *params = static_cast<GLint>(introspection.attributes.size()); break;
+		case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH: *params = ncine::maxNameLength(introspection.attributes); break;
+		default: *params = 0; break;
+	}
+}
+
+void glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+	totalCounters.numCalls++;
+	if (infoLog != nullptr && bufSize > 0)
+		infoLog[0] = '\0';
+	if (length != nullptr)
+		*length = 0;
+}
+
+void glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name)
+{
+	totalCounters.numCalls++;
+	const ncine::ProgramObject *programObject = ncine::programObject(program);
+	if (programObject == nullptr || index >= programObject->introspection.uniforms.size())
+		return;
+
+	const ncine::HeadlessShaderIntrospection::Uniform &uniform = programObject->introspection.uniforms[index];
+	ncine::copyName(uniform.name, bufSize, length, name);
+	*size = uniform.size;
+	*type = uniform.type;
+}
+
+void glGetActiveUniformName(GLuint program, GLuint uniformIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformName)
+{
+	totalCounters.numCalls++;
+	const ncine::ProgramObject *programObject = ncine::programObject(program);
+	if (programObject != nullptr && uniformIndex < programObject->introspection.uniforms.size())
+		ncine::copyName(programObject->introspection.uniforms[uniformIndex].name, bufSize, length, uniformName);
+}
+
+void glGetActiveUniformsiv(GLuint program, GLsizei uniformCount, const GLuint *uniformIndices, GLenum pname, GLint *params)
+{
+	totalCounters.numCalls++;
+	const ncine::ProgramObject *programObject = ncine::programObject(program);
+	if (programObject == nullptr)
+		return;
+
+	const nctl::Array<ncine::HeadlessShaderIntrospection::Uniform> &uniforms = programObject->introspection.uniforms;
+	for (GLsizei i = 0; i < uniformCount; i++)
+	{
+		if (uniformIndices[i] >= uniforms.size())
+			continue;
+
+		const ncine::HeadlessShaderIntrospection::Uniform &uniform = uniforms[uniformIndices[i]];
+		switch (pname)
+		{
+			case GL_UNIFORM_TYPE: params[i] = static_cast<GLint>(uniform.type); break;
+			case GL_UNIFORM_SIZE: params[i] = uniform.size; break;
+			case GL_UNIFORM_NAME_LENGTH: params[i] = static_cast<GLint>(uniform.name.length()) + 1; break;
+			case GL_UNIFORM_BLOCK_INDEX: params[i] = uniform.blockIndex; break;
+			case GL_UNIFORM_OFFSET: params[i] = uniform.offset; break;
+			default: params[i] = 0; break;
+		}
+	}
+}
+
+void glGetActiveUniformBlockiv(GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint *params)
+{
+	totalCounters.numCalls++;
+	const ncine::ProgramObject *programObject = ncine::programObject(program);
+	if (programObject == nullptr || uniformBlockIndex >= programObject->introspection.uniformBlocks.size())
+		return;
+
+	const ncine::HeadlessShaderIntrospection::UniformBlock &block = programObject->introspection.uniformBlocks[uniformBlockIndex];
+	switch (pname)
+	{
+		case GL_UNIFORM_BLOCK_BINDING: *params = block.binding; break;
+		case GL_UNIFORM_BLOCK_DATA_SIZE: *params = block.dataSize; break;
+		case GL_UNIFORM_BLOCK_NAME_LENGTH: *params = static_cast<GLint>(block.name.length()) + 1; break;
+		case GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS: *params = static_cast<GLint>(block.uniformIndices.size()); break;
+		case GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES:
+			for (unsigned int i = 0; i < block.uniformIndices.size(); i++)
+				params[i] = block.uniformIndices[i];
+			break;
+		default: *params = 0; break;
+	}
+}
+
+void glGetActiveUniformBlockName(GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformBlockName)
+{
+	totalCounters.numCalls++;
+	const ncine::ProgramObject *programObject = ncine::programObject(program);
+	if (programObject != nullptr && uniformBlockIndex < programObject->introspection.uniformBlocks.size())
+		ncine::copyName(programObject->introspection.uniformBlocks[uniformBlockIndex].name, bufSize, length, uniformBlockName);
+}
+
+void glUniformBlockBinding(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)
+{
+	totalCounters.numCalls++;
+	ncine::ProgramObject *programObject = ncine::programObject(program);
+	if (programObject != nullptr && uniformBlockIndex < programObject->introspection.uniformBlocks.size())
+		programObject->introspection.uniformBlocks[uniformBlockIndex].binding = static_cast<GLint>(uniformBlockBinding);
+}
+
+GLint glGetUniformLocation(GLuint program, const GLchar *name)
+{
+	totalCounters.numCalls++;
+	const ncine::ProgramObject *programObject = ncine::programObject(program);
+	return (programObject != nullptr) ? programObject->introspection.uniformLocation(name) : -1;
+}
+
+void glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name)
+{
+	totalCounters.numCalls++;
+	const ncine::ProgramObject *programObject = ncine::programObject(program);
+	if (programObject == nullptr || index >= programObject->introspection.attributes.size())
+		return;
+
+	const ncine::HeadlessShaderIntrospection::Attribute &attribute = programObject->introspection.attributes[index];
+	ncine::copyName(attribute.name, bufSize, length, name);
+	*size = attribute.size;
+	*type = attribute.type;
+}
+
+GLint glGetAttribLocation(GLuint program, const GLchar *name)
+{
+	totalCounters.numCalls++;
+	const ncine::ProgramObject *programObject = ncine::programObject(program);
+	return (programObject != nullptr) ? programObject->introspection.attributeLocation(name) : -1;
+}
+
+///////////////////////////////////////////////////////////
+// UNIFORMS
+///////////////////////////////////////////////////////////
+
+void glUniform1fv(GLint location, GLsizei count, const GLfloat *value) { ncine::countUniform(count, 1); }
+void glUniform2fv(GLint location, GLsizei count, const GLfloat *value) { ncine::countUniform(count, 2); }
+void glUniform3fv(GLint location, GLsizei count, const GLfloat *value) { ncine::countUniform(count, 3); }
+void glUniform4fv(GLint location, GLsizei count, const GLfloat *value) { ncine::countUniform(count, 4); }
+void glUniform1iv(GLint location, GLsizei count, const GLint *value) { ncine::countUniform(count, 1); }
+void glUniform2iv(GLint location, GLsizei count, const GLint *value) { ncine::countUniform(count, 2); }
+void glUniform3iv(GLint location, GLsizei count, const GLint *value) { ncine::countUniform(count, 3); }
+void glUniform4iv(GLint location, GLsizei count, const GLint *value) { ncine::countUniform(count, 4); }
+void glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { ncine::countUniform(count, 4); }
+void glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { ncine::countUniform(count, 9); }
+void glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) { ncine::countUniform(count, 16); }
+}
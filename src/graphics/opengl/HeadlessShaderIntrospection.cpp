@@ -0,0 +1,762 @@
+#include <cstring> // for strncmp()
+#include <cstdlib> // for strtol()
+#include "common_macros.h"
+#include <nctl/UniquePtr.h>
+#include "HeadlessShaderIntrospection.h"
+
+namespace ncine {
+
+namespace {
+
+	/// The properties of a GLSL basic type
+	struct BasicType
+	{
+		const char *name;
+		GLenum glType;
+		/// The `std140` base alignment, zero for opaque types
+		int alignment;
+		/// The `std140` size, zero for opaque types
+		int size;
+		/// The number of attribute locations consumed
+		int numLocations;
+	};
+
+	const BasicType BasicTypes[] = {
+		{ "float", GL_FLOAT, 4, 4, 1 }, { "vec2", GL_FLOAT_VEC2, 8, 8, 1 }, { "vec3", GL_FLOAT_VEC3, 16, 12, 1 }, { "vec4", GL_FLOAT_VEC4, 16, 16, 1 },
+		{ "int", GL_INT, 4, 4, 1 }, { "ivec2", GL_INT_VEC2, 8, 8, 1 }, { "ivec3", GL_INT_VEC3, 16, 12, 1 }, { "ivec4", GL_INT_VEC4, 16, 16, 1 },
+		{ "uint", GL_UNSIGNED_INT, 4, 4, 1 }, { "uvec2", GL_UNSIGNED_INT_VEC2, 8, 8, 1 }, { "uvec3", GL_UNSIGNED_INT_VEC3, 16, 12, 1 }, { "uvec4", GL_UNSIGNED_INT_VEC4, 16, 16, 1 },
+		{ "bool", GL_BOOL, 4, 4, 1 }, { "bvec2", GL_BOOL_VEC2, 8, 8, 1 }, { "bvec3", GL_BOOL_VEC3, 16, 12, 1 }, { "bvec4", GL_BOOL_VEC4, 16, 16, 1 },
+		{ "mat2", GL_FLOAT_MAT2, 16, 32, 2 }, { "mat3", GL_FLOAT_MAT3, 16, 48, 3 }, { "mat4", GL_FLOAT_MAT4, 16, 64, 4 },
+		{ "sampler2D", GL_SAMPLER_2D, 0, 0, 0 }, { "sampler3D", GL_SAMPLER_3D, 0, 0, 0 }, { "samplerCube", GL_SAMPLER_CUBE, 0, 0, 0 },
+		{ "sampler2DArray", GL_SAMPLER_2D_ARRAY, 0, 0, 0 }, { "sampler2DShadow", GL_SAMPLER_2D_SHADOW, 0, 0, 0 }, { "samplerBuffer", GL_SAMPLER_BUFFER, 0, 0, 0 },
+		{ "isampler2D", GL_INT_SAMPLER_2D, 0, 0, 0 }, { "usampler2D", GL_UNSIGNED_INT_SAMPLER_2D, 0, 0, 0 }
+	};
+	const int NumBasicTypes = sizeof(BasicTypes) / sizeof(BasicTypes[0]);
+
+	/// The `std140` alignment of arrays and structures
+	const int Std140VectorAlignment = 16;
+
+	inline int roundUp(int value, int alignment)
+	{
+		return (alignment > 0) ? ((value + alignment - 1) / alignment) * alignment : value;
+	}
+
+	inline bool isIdentifierChar(char c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+	}
+
+	/// An object-like macro definition
+	struct Define
+	{
+		nctl::String name;
+		nctl::String value;
+	};
+
+	const Define *findDefine(const nctl::Array<Define> &defines, const nctl::String &name)
+	{
+		for (const Define &define : defines)
+		{
+			if (define.name == name)
+				return &define;
+		}
+		return nullptr;
+	}
+
+	/// Splits a text in identifiers, numbers and single punctuation characters
+	class Lexer
+	{
+	  public:
+		explicit Lexer(const char *text)
+		    : current_(text) {}
+
+		/// Reads the next token, returns false at the end of the text
+		bool next(nctl::String &token)
+		{
+			while (*current_ == ' ' || *current_ == '\t' || *current_ == '\n' || *current_ == '\r')
+				current_++;
+
+			if (*current_ == '\0')
+			{
+				token.clear();
+				return false;
+			}
+
+			const char *start = current_;
+			if (isIdentifierChar(*current_))
+			{
+				// Numbers with a decimal point are read as a single token
+				const bool isNumber = (*current_ >= '0' && *current_ <= '9');
+				while (isIdentifierChar(*current_) || (isNumber && *current_ == '.'))
+					current_++;
+			}
+			else
+				current_++;
+
+			token.assign(start, static_cast<unsigned int>(current_ - start));
+			return true;
+		}
+
+		/// Returns the next token without consuming it
+		bool peek(nctl::String &token) const
+		{
+			Lexer lexer(*this);
+			return lexer.next(token);
+		}
+
+		inline const char *current() const { return current_; }
+
+	  private:
+		const char *current_;
+	};
+
+	/// Evaluates an integer from a token, expanding object-like macros like `BATCH_SIZE (585)`
+	int evaluateInteger(const nctl::String &token, const nctl::Array<Define> &defines)
+	{
+		const Define *define = findDefine(defines, token);
+		const char *text = (define != nullptr) ? define->value.data() : token.data();
+		while (*text == '(' || *text == ' ')
+			text++;
+		return static_cast<int>(strtol(text, nullptr, 0));
+	}
+
+	/// Evaluates the condition of an `#if` or `#elif` directive, only `defined()`, negations and integers are supported
+	bool evaluateCondition(const char *expression, const nctl::Array<Define> &defines)
+	{
+		Lexer lexer(expression);
+		nctl::String token(64);
+
+		bool negate = false;
+		lexer.next(token);
+		while (token == "!")
+		{
+			negate = !negate;
+			lexer.next(token);
+		}
+
+		bool result = false;
+		if (token == "defined")
+		{
+			lexer.next(token);
+			if (token == "(")
+				lexer.next(token);
+			result = (findDefine(defines, token) != nullptr);
+		}
+		else if (token.isEmpty() == false)
+			result = (evaluateInteger(token, defines) != 0);
+
+		return negate ? !result : result;
+	}
+
+	/// A conditional preprocessor block
+	struct Conditional
+	{
+		/// Whether the enclosing block is active
+		bool parentActive;
+		/// Whether the current branch is active
+		bool active;
+		/// Whether one of the branches of the block has already been taken
+		bool taken;
+	};
+
+	/// Removes comments and the lines of inactive conditional blocks, collecting the macro definitions
+	void preprocess(const char *source, nctl::String &output, nctl::Array<Define> &defines)
+	{
+		// Comments are replaced by a space, newlines are preserved for directives
+		const unsigned long sourceLength = strlen(source);
+		nctl::UniquePtr<char[]> stripped = nctl::makeUnique<char[]>(sourceLength + 1);
+		unsigned long length = 0;
+		for (const char *c = source; *c != '\0'; c++)
+		{
+			if (c[0] == '/' && c[1] == '/')
+			{
+				while (c[1] != '\0' && c[1] != '\n')
+					c++;
+				stripped[length++] = ' ';
+			}
+			else if (c[0] == '/' && c[1] == '*')
+			{
+				c += 2;
+				while (*c != '\0' && (c[0] != '*' || c[1] != '/'))
+				{
+					if (*c == '\n')
+						stripped[length++] = '\n';
+					c++;
+				}
+				if (*c == '\0')
+					break;
+				c++;
+				stripped[length++] = ' ';
+			}
+			else
+				stripped[length++] = *c;
+		}
+		stripped[length] = '\0';
+
+		nctl::Array<Conditional> conditionals;
+		nctl::String line(256);
+		nctl::String token(64);
+		const char *lineStart = stripped.get();
+		while (*lineStart != '\0')
+		{
+			const char *lineEnd = lineStart;
+			while (*lineEnd != '\0' && *lineEnd != '\n')
+				lineEnd++;
+			line.assign(lineStart, static_cast<unsigned int>(lineEnd - lineStart));
+			lineStart = (*lineEnd == '\n') ? lineEnd + 1 : lineEnd;
+
+			const bool active = conditionals.isEmpty() || conditionals.back().active;
+			const char *text = line.data();
+			while (*text == ' ' || *text == '\t')
+				text++;
+
+			if (*text != '#')
+			{
+				if (active)
+				{
+					output.append(line);
+					output.append("\n");
+				}
+				continue;
+			}
+
+			Lexer lexer(text + 1);
+			lexer.next(token);
+			if (token == "ifdef" || token == "ifndef")
+			{
+				const bool negate = (token == "ifndef");
+				lexer.next(token);
+				const bool condition = (findDefine(defines, token) != nullptr) != negate;
+				conditionals.pushBack({ active, active && condition, condition });
+			}
+			else if (token == "if")
+			{
+				const bool condition = evaluateCondition(lexer.current(), defines);
+				conditionals.pushBack({ active, active && condition, condition });
+			}
+			else if (token == "elif" && conditionals.isEmpty() == false)
+			{
+				Conditional &conditional = conditionals.back();
+				const bool condition = (conditional.taken == false) && evaluateCondition(lexer.current(), defines);
+				conditional.active = conditional.parentActive && condition;
+				conditional.taken = conditional.taken || condition;
+			}
+			else if (token == "else" && conditionals.isEmpty() == false)
+			{
+				Conditional &conditional = conditionals.back();
+				conditional.active = conditional.parentActive && (conditional.taken == false);
+				conditional.taken = true;
+			}
+			else if (token == "endif" && conditionals.isEmpty() == false)
+				conditionals.popBack();
+			else if (token == "define" && active)
+			{
+				Define define;
+				lexer.next(define.name);
+				const char *value = lexer.current();
+				while (*value == ' ' || *value == '\t')
+					value++;
+				define.value = value;
+				defines.pushBack(nctl::move(define));
+			}
+			else if (token == "undef" && active)
+			{
+				lexer.next(token);
+				for (unsigned int i = 0; i < defines.size(); i++)
+				{
+					if (defines[i].name == token)
+					{
+						defines.removeAt(i);
+						break;
+					}
+				}
+			}
+			// Other directives like `#version`, `#extension` and `#pragma` are ignored
+		}
+	}
+
+	/// A member of a structure or of a uniform block, or a variable declaration
+	struct Member
+	{
+		nctl::String name;
+		/// The index of a basic type, or the index of a structure minus `NumBasicTypes`
+		int typeIndex;
+		/// The number of array elements, zero if the member is not an array
+		int arraySize;
+	};
+
+	/// A structure type declared by the shader
+	struct StructType
+	{
+		nctl::String name;
+		nctl::Array<Member> members;
+	};
+
+	/// Parses the declarations of a preprocessed GLSL shader stage
+	class Parser
+	{
+	  public:
+		Parser(const char *text, const nctl::Array<Define> &defines)
+		    : lexer_(text), defines_(defines), token_(64) {}
+
+		/// Parses the next top-level declaration, returns false at the end of the text
+		bool parseDeclaration(HeadlessShaderIntrospection &introspection, bool isVertexStage, GLint &nextAttributeLocation, GLint &nextUniformLocation);
+
+	  private:
+		Lexer lexer_;
+		const nctl::Array<Define> &defines_;
+		nctl::Array<StructType> structs_;
+		nctl::String token_;
+
+		/// Returns the type index of a basic type or of a structure, or -1 if the token is not a type name
+		int findType(const nctl::String &name) const;
+		/// Skips the tokens of a statement up to a semicolon or up to the end of a block
+		void skipStatement();
+		/// Skips tokens up to the closing bracket of the one that has just been read
+		void skipBlock(const char *open, const char *close);
+		/// Parses the qualifiers in a `layout()`, returns the location, or -1 if not specified
+		int parseLayout();
+		/// Parses the size between square brackets, after the opening one has been read
+		int parseArraySize();
+		/// Reads a token skipping precision qualifiers
+		bool nextSkippingPrecision();
+		/// Parses the members of a structure or a uniform block, after the opening brace has been read
+		void parseMembers(nctl::Array<Member> &members);
+
+		/// Calculates the `std140` base alignment and size of a member
+		void std140Layout(const Member &member, int &alignment, int &size) const;
+		/// Adds a member of a uniform block and its fields as active uniforms, returns the offset after the member
+		void addBlockUniforms(HeadlessShaderIntrospection &introspection, const Member &member, const nctl::String &prefix, int offset, GLint blockIndex);
+		/// Adds the members of a structure or a block, returns the offset after the last member
+		int addBlockMembers(HeadlessShaderIntrospection &introspection, const nctl::Array<Member> &members, const nctl::String &prefix, int offset, GLint blockIndex);
+		/// Adds a default block uniform and the fields of a structure as active uniforms
+		void addDefaultUniforms(HeadlessShaderIntrospection &introspection, const Member &member, const nctl::String &prefix, GLint &nextUniformLocation);
+	};
+
+	bool Parser::parseDeclaration(HeadlessShaderIntrospection &introspection, bool isVertexStage, GLint &nextAttributeLocation, GLint &nextUniformLocation)
+	{
+		if (lexer_.next(token_) == false)
+			return false;
+
+		int location = -1;
+		if (token_ == "layout")
+		{
+			location = parseLayout();
+			lexer_.next(token_);
+		}
+
+		if (token_ == "struct")
+		{
+			StructType structType;
+			lexer_.next(structType.name);
+			lexer_.next(token_);
+			if (token_ == "{")
+			{
+				parseMembers(structType.members);
+				structs_.pushBack(nctl::move(structType));
+			}
+			skipStatement();
+		}
+		else if (token_ == "uniform")
+		{
+			nctl::String name(64);
+			lexer_.next(name);
+			nctl::String next(8);
+			lexer_.peek(next);
+			if (next == "{")
+			{
+				lexer_.next(token_);
+				HeadlessShaderIntrospection::UniformBlock block;
+				block.name = name;
+				block.binding = 0;
+
+				nctl::Array<Member> members;
+				parseMembers(members);
+				// An instance name does not change the uniform names, which are prefixed by the block name
+				const bool hasInstanceName = lexer_.peek(next) && next != ";";
+				skipStatement();
+
+				for (const HeadlessShaderIntrospection::UniformBlock &uniformBlock : introspection.uniformBlocks)
+				{
+					if (uniformBlock.name == block.name)
+						return true;
+				}
+
+				const GLint blockIndex = static_cast<GLint>(introspection.uniformBlocks.size());
+				introspection.uniformBlocks.pushBack(nctl::move(block));
+				nctl::String prefix(64);
+				if (hasInstanceName)
+				{
+					prefix = name;
+					prefix.append(".");
+				}
+				const int endOffset = addBlockMembers(introspection, members, prefix, 0, blockIndex);
+				introspection.uniformBlocks[blockIndex].dataSize = roundUp(endOffset, Std140VectorAlignment);
+			}
+			else
+			{
+				while (name == "lowp" || name == "mediump" || name == "highp")
+					lexer_.next(name);
+
+				Member member;
+				member.typeIndex = findType(name);
+				lexer_.next(token_);
+				while (member.typeIndex >= 0 && token_ != ";" && token_.isEmpty() == false)
+				{
+					member.name = token_;
+					member.arraySize = 0;
+					lexer_.next(token_);
+					if (token_ == "[")
+					{
+						member.arraySize = parseArraySize();
+						lexer_.next(token_);
+					}
+					if (token_ == "=")
+					{
+						// Skipping the initializer
+						while (token_ != "," && token_ != ";" && lexer_.next(token_))
+						{
+							if (token_ == "(")
+								skipBlock("(", ")");
+						}
+					}
+					addDefaultUniforms(introspection, member, nctl::String(""), nextUniformLocation);
+					if (token_ == ",")
+						lexer_.next(token_);
+				}
+				if (member.typeIndex < 0)
+					skipStatement();
+			}
+		}
+		else if ((token_ == "in" || token_ == "attribute") && isVertexStage)
+		{
+			nextSkippingPrecision();
+			const int typeIndex = findType(token_);
+			nctl::String name(64);
+			lexer_.next(name);
+			skipStatement();
+
+			if (typeIndex >= 0 && typeIndex < NumBasicTypes)
+			{
+				HeadlessShaderIntrospection::Attribute attribute;
+				attribute.name = name;
+				attribute.type = BasicTypes[typeIndex].glType;
+				attribute.size = 1;
+				attribute.location = (location >= 0) ? location : nextAttributeLocation;
+				nextAttributeLocation = attribute.location + BasicTypes[typeIndex].numLocations;
+				introspection.attributes.pushBack(nctl::move(attribute));
+			}
+		}
+		else if (token_ != ";")
+			skipStatement();
+
+		return true;
+	}
+
+	int Parser::findType(const nctl::String &name) const
+	{
+		for (int i = 0; i < NumBasicTypes; i++)
+		{
+			if (name == BasicTypes[i].name)
+				return i;
+		}
+		for (unsigned int i = 0; i < structs_.size(); i++)
+		{
+			if (structs_[i].name == name)
+				return NumBasicTypes + static_cast<int>(i);
+		}
+		return -1;
+	}
+
+	void Parser::skipStatement()
+	{
+		// The current token could already be the end of the statement
+		while (token_ != ";")
+		{
+			if (token_ == "{")
+			{
+				skipBlock("{", "}");
+				// A function body is not followed by a semicolon
+				return;
+			}
+			if (lexer_.next(token_) == false)
+				return;
+		}
+	}
+
+	void Parser::skipBlock(const char *open, const char *close)
+	{
+		int depth = 1;
+		while (depth > 0 && lexer_.next(token_))
+		{
+			if (token_ == open)
+				depth++;
+			else if (token_ == close)
+				depth--;
+		}
+		token_.clear();
+	}
+
+	int Parser::parseLayout()
+	{
+		int location = -1;
+		lexer_.next(token_);
+		if (token_ != "(")
+			return location;
+
+		while (lexer_.next(token_) && token_ != ")")
+		{
+			if (token_ == "location")
+			{
+				lexer_.next(token_);
+				if (token_ == "=")
+				{
+					lexer_.next(token_);
+					location = evaluateInteger(token_, defines_);
+				}
+			}
+		}
+		return location;
+	}
+
+	int Parser::parseArraySize()
+	{
+		int size = 0;
+		while (lexer_.next(token_) && token_ != "]")
+		{
+			if (token_ != "(" && token_ != ")")
+				size = evaluateInteger(token_, defines_);
+		}
+		return (size > 0) ? size : 1;
+	}
+
+	bool Parser::nextSkippingPrecision()
+	{
+		bool result = lexer_.next(token_);
+		while (result && (token_ == "lowp" || token_ == "mediump" || token_ == "highp" || token_ == "flat" || token_ == "smooth"))
+			result = lexer_.next(token_);
+		return result;
+	}
+
+	void Parser::parseMembers(nctl::Array<Member> &members)
+	{
+		while (nextSkippingPrecision() && token_ != "}")
+		{
+			if (token_ == "layout")
+			{
+				parseLayout();
+				nextSkippingPrecision();
+			}
+
+			const int typeIndex = findType(token_);
+			if (typeIndex < 0)
+			{
+				skipStatement();
+				continue;
+			}
+
+			// The array size can follow the type, like in `Instance[BATCH_SIZE] instances`
+			int typeArraySize = 0;
+			lexer_.next(token_);
+			if (token_ == "[")
+			{
+				typeArraySize = parseArraySize();
+				lexer_.next(token_);
+			}
+
+			while (token_ != ";" && token_.isEmpty() == false)
+			{
+				Member member;
+				member.name = token_;
+				member.typeIndex = typeIndex;
+				member.arraySize = typeArraySize;
+				lexer_.next(token_);
+				if (token_ == "[")
+				{
+					member.arraySize = parseArraySize();
+					lexer_.next(token_);
+				}
+				members.pushBack(nctl::move(member));
+				if (token_ == ",")
+					lexer_.next(token_);
+			}
+		}
+	}
+
+	void Parser::std140Layout(const Member &member, int &alignment, int &size) const
+	{
+		if (member.typeIndex < NumBasicTypes)
+		{
+			alignment = BasicTypes[member.typeIndex].alignment;
+			size = BasicTypes[member.typeIndex].size;
+		}
+		else
+		{
+			// The alignment of a structure is the largest one of its members, rounded up to the one of a vector
+			const StructType &structType = structs_[member.typeIndex - NumBasicTypes];
+			int offset = 0;
+			alignment = Std140VectorAlignment;
+			for (const Member &structMember : structType.members)
+			{
+				int memberAlignment = 0;
+				int memberSize = 0;
+				std140Layout(structMember, memberAlignment, memberSize);
+				offset = roundUp(offset, memberAlignment) + memberSize;
+				if (memberAlignment > alignment)
+					alignment = memberAlignment;
+			}
+			size = roundUp(offset, alignment);
+		}
+
+		if (member.arraySize > 0)
+		{
+			// The stride of an array is rounded up to the alignment of a vector
+			alignment = roundUp(alignment, Std140VectorAlignment);
+			size = roundUp(size, Std140VectorAlignment) * member.arraySize;
+		}
+	}
+
+	void Parser::addBlockUniforms(HeadlessShaderIntrospection &introspection, const Member &member, const nctl::String &prefix, int offset, GLint blockIndex)
+	{
+		nctl::String name(64);
+		name = prefix;
+		name.append(member.name);
+		if (member.arraySize > 0)
+			name.append("[0]");
+
+		if (member.typeIndex < NumBasicTypes)
+		{
+			HeadlessShaderIntrospection::Uniform uniform;
+			uniform.name = name;
+			uniform.type = BasicTypes[member.typeIndex].glType;
+			uniform.size = (member.arraySize > 0) ? member.arraySize : 1;
+			uniform.blockIndex = blockIndex;
+			uniform.offset = offset;
+			uniform.location = -1;
+			introspection.uniformBlocks[blockIndex].uniformIndices.pushBack(static_cast<GLint>(introspection.uniforms.size()));
+			introspection.uniforms.pushBack(nctl::move(uniform));
+		}
+		else
+		{
+			// Only the first element of an array of structures is reported
+			name.append(".");
+			addBlockMembers(introspection, structs_[member.typeIndex - NumBasicTypes].members, name, offset, blockIndex);
+		}
+	}
+
+	int Parser::addBlockMembers(HeadlessShaderIntrospection &introspection, const nctl::Array<Member> &members, const nctl::String &prefix, int offset, GLint blockIndex)
+	{
+		for (const Member &member : members)
+		{
+			int alignment = 0;
+			int size = 0;
+			std140Layout(member, alignment, size);
+			offset = roundUp(offset, alignment);
+			addBlockUniforms(introspection, member, prefix, offset, blockIndex);
+			offset += size;
+		}
+		return offset;
+	}
+
+	void Parser::addDefaultUniforms(HeadlessShaderIntrospection &introspection, const Member &member, const nctl::String &prefix, GLint &nextUniformLocation)
+	{
+		nctl::String name(64);
+		name = prefix;
+		name.append(member.name);
+
+		if (member.typeIndex >= NumBasicTypes)
+		{
+			name.append(member.arraySize > 0 ? "[0]." : ".");
+			for (const Member &structMember : structs_[member.typeIndex - NumBasicTypes].members)
+				addDefaultUniforms(introspection, structMember, name, nextUniformLocation);
+			return;
+		}
+
+		if (member.arraySize > 0)
+			name.append("[0]");
+		for (const HeadlessShaderIntrospection::Uniform &uniform : introspection.uniforms)
+		{
+			if (uniform.name == name)
+				return;
+		}
+
+		HeadlessShaderIntrospection::Uniform uniform;
+		uniform.name = name;
+		uniform.type = BasicTypes[member.typeIndex].glType;
+		uniform.size = (member.arraySize > 0) ? member.arraySize : 1;
+		uniform.blockIndex = -1;
+		uniform.offset = -1;
+		uniform.location = nextUniformLocation;
+		nextUniformLocation += uniform.size;
+		introspection.uniforms.pushBack(nctl::move(uniform));
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+HeadlessShaderIntrospection::HeadlessShaderIntrospection()
+    : nextUniformLocation_(0), nextAttributeLocation_(0)
+{
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void HeadlessShaderIntrospection::addStage(GLenum shaderType, const char *source)
+{
+	ASSERT(source);
+
+	nctl::Array<Define> defines;
+	nctl::String text(static_cast<unsigned int>(strlen(source) + 1));
+	preprocess(source, text, defines);
+
+	Parser parser(text.data(), defines);
+	const bool isVertexStage = (shaderType == GL_VERTEX_SHADER);
+	while (parser.parseDeclaration(*this, isVertexStage, nextAttributeLocation_, nextUniformLocation_)) {}
+}
+
+void HeadlessShaderIntrospection::clear()
+{
+	uniforms.clear();
+	uniformBlocks.clear();
+	attributes.clear();
+	nextUniformLocation_ = 0;
+	nextAttributeLocation_ = 0;
+}
+
+GLint HeadlessShaderIntrospection::uniformLocation(const char *name) const
+{
+	ASSERT(name);
+
+	// The array index is split from the name, so that `uColors`, `uColors[0]` and `uColors[2]` are all found
+	const char *bracket = strchr(name, '[');
+	const unsigned int baseLength = (bracket != nullptr) ? static_cast<unsigned int>(bracket - name) : static_cast<unsigned int>(strlen(name));
+	const int element = (bracket != nullptr) ? static_cast<int>(strtol(bracket + 1, nullptr, 10)) : 0;
+
+	for (const Uniform &uniform : uniforms)
+	{
+		if (uniform.blockIndex != -1 || strncmp(uniform.name.data(), name, baseLength) != 0)
+			continue;
+
+		const char end = uniform.name.data()[baseLength];
+		if ((end == '\0' || end == '[') && element < uniform.size)
+			return uniform.location + element;
+	}
+	return -1;
+}
+
+GLint HeadlessShaderIntrospection::attributeLocation(const char *name) const
+{
+	for (const Attribute &attribute : attributes)
+	{
+		if (attribute.name == name)
+			return attribute.location;
+	}
+	return -1;
+}
+
+}
@@ -11,6 +11,8 @@
 namespace ncine {
 
 /// It represents the interface to the OpenAL audio device
+/*! Players beyond the number of OpenAL sources play as virtual voices: they advance their playback position
+ *  without a source until they are more audible than a player that has one, by priority first, then by gain and distance. */
 class ALAudioDevice : public IAudioDevice
 {
   public:
@@ -22,8 +24,9 @@ class ALAudioDevice : public IAudioDevice
 	float gain() const override { return gain_; }
 	void setGain(float gain) override;
 
-	inline unsigned int maxNumPlayers() const override { return MaxSources; }
+	inline unsigned int maxNumPlayers() const override { return MaxPlayers; }
 	inline unsigned int numPlayers() const override { return players_.size(); }
+	inline unsigned int numVirtualPlayers() const override { return numVirtualPlayers_; }
 	const IAudioPlayer *player(unsigned int index) const override;
 
 	void stopPlayers() override;
@@ -41,6 +44,8 @@ class ALAudioDevice : public IAudioDevice
   private:
 	/// Maximum number of OpenAL sources (HACK: should use a query)
 	static const unsigned int MaxSources = 16;
+	/// Maximum number of active players, real or virtual
+	static const unsigned int MaxPlayers = 256;
 
 	/// The OpenAL device
 	ALCdevice *device_;
@@ -51,11 +56,22 @@ class ALAudioDevice : public IAudioDevice
 	/// The sources pool
 	nctl::StaticArray<ALuint, MaxSources> sources_;
 	/// The array of currently active audio players
-	nctl::StaticArray<IAudioPlayer *, MaxSources> players_;
+	nctl::StaticArray<IAudioPlayer *, MaxPlayers> players_;
+	/// The number of active players without a source after the last update
+	unsigned int numVirtualPlayers_;
+	/// The virtual players sorted by decreasing audibility, rebuilt at every update
+	nctl::StaticArray<IAudioPlayer *, MaxPlayers> virtualPlayers_;
+	/// The players with a source that could release it, sorted by increasing audibility
+	nctl::StaticArray<IAudioPlayer *, MaxSources> releasablePlayers_;
 
 	/// The OpenAL device name string
 	const char *deviceName_;
 
+	/// Returns a mask with a bit set for each source bound to an active player with a source
+	unsigned int boundSourcesMask() const;
+	/// Gives the free sources, or the ones of the least audible players, to the most audible virtual players
+	void assignSources();
+
 	/// Deleted copy constructor
 	ALAudioDevice(const ALAudioDevice &) = delete;
 	/// Deleted assignment operator
@@ -12,6 +12,7 @@ class AudioLoaderWav : public IAudioLoader
 	explicit AudioLoaderWav(nctl::UniquePtr<IFile> fileHandle);
 
 	nctl::UniquePtr<IAudioReader> createReader() override;
+	const unsigned char *inPlaceSamples() const override;
 
   private:
 	/// Header for the RIFF WAVE format
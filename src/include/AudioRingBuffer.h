@@ -0,0 +1,108 @@
+#ifndef CLASS_NCINE_AUDIORINGBUFFER
+#define CLASS_NCINE_AUDIORINGBUFFER
+
+#include <nctl/Atomic.h>
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+/// A lock-free ring of fixed size blocks of decoded audio, for a single producer and a single consumer thread
+/*! The producer and the consumer each own one index and only read the other one.
+ *  Indices run over twice the number of blocks so that a full ring can be told apart from an empty one. */
+class AudioRingBuffer
+{
+  public:
+	/// The information attached to a block when it is written
+	struct BlockInfo
+	{
+		/// Number of valid bytes in the block
+		unsigned int numBytes = 0;
+		/// True if the stream has been rewound to fill this block
+		bool hasRewound = false;
+		/// True if the stream has no more data after this block
+		bool isLast = false;
+	};
+
+	AudioRingBuffer(unsigned int numBlocks, unsigned int blockSize)
+	    : numBlocks_(numBlocks), blockSize_(blockSize),
+	      data_(nctl::makeUnique<char[]>(numBlocks * blockSize)),
+	      infos_(nctl::makeUnique<BlockInfo[]>(numBlocks))
+	{
+	}
+
+	inline unsigned int numBlocks() const { return numBlocks_; }
+	inline unsigned int blockSize() const { return blockSize_; }
+
+	/// Returns the number of blocks written and not yet read
+	inline unsigned int numReadableBlocks() { return distance(readIndex_.load(nctl::Atomic32::MemoryModel::ACQUIRE), writeIndex_.load(nctl::Atomic32::MemoryModel::ACQUIRE)); }
+
+	/// Returns the next free block for the producer, or `nullptr` if the ring is full
+	inline char *writeBlock()
+	{
+		const int32_t writeIndex = writeIndex_.load(nctl::Atomic32::MemoryModel::RELAXED);
+		const int32_t readIndex = readIndex_.load(nctl::Atomic32::MemoryModel::ACQUIRE);
+		if (distance(readIndex, writeIndex) == numBlocks_)
+			return nullptr;
+		return data_.get() + (writeIndex % numBlocks_) * blockSize_;
+	}
+
+	/// Publishes the block returned by `writeBlock()` to the consumer
+	inline void commitWrite(const BlockInfo &info)
+	{
+		const int32_t writeIndex = writeIndex_.load(nctl::Atomic32::MemoryModel::RELAXED);
+		infos_[writeIndex % numBlocks_] = info;
+		writeIndex_.store(next(writeIndex), nctl::Atomic32::MemoryModel::RELEASE);
+	}
+
+	/// Returns the oldest written block for the consumer, or `nullptr` if the ring is empty
+	inline const char *readBlock(BlockInfo &info)
+	{
+		const int32_t readIndex = readIndex_.load(nctl::Atomic32::MemoryModel::RELAXED);
+		const int32_t writeIndex = writeIndex_.load(nctl::Atomic32::MemoryModel::ACQUIRE);
+		if (readIndex == writeIndex)
+			return nullptr;
+		info = infos_[readIndex % numBlocks_];
+		return data_.get() + (readIndex % numBlocks_) * blockSize_;
+	}
+
+	/// Gives the block returned by `readBlock()` back to the producer
+	inline void commitRead()
+	{
+		const int32_t readIndex = readIndex_.load(nctl::Atomic32::MemoryModel::RELAXED);
+		readIndex_.store(next(readIndex), nctl::Atomic32::MemoryModel::RELEASE);
+	}
+
+	/// Discards every block
+	/*! \note It can only be called when neither the producer nor the consumer are using the ring */
+	inline void clear()
+	{
+		readIndex_.store(0);
+		writeIndex_.store(0);
+	}
+
+  private:
+	unsigned int numBlocks_;
+	unsigned int blockSize_;
+	nctl::UniquePtr<char[]> data_;
+	nctl::UniquePtr<BlockInfo[]> infos_;
+
+	/// The index of the next block to read, only written by the consumer
+	nctl::Atomic32 readIndex_;
+	/// The index of the next block to write, only written by the producer
+	nctl::Atomic32 writeIndex_;
+
+	inline int32_t next(int32_t index) const { return (static_cast<unsigned int>(index) + 1) % (2 * numBlocks_); }
+	inline unsigned int distance(int32_t readIndex, int32_t writeIndex) const
+	{
+		return (static_cast<unsigned int>(writeIndex) + 2 * numBlocks_ - static_cast<unsigned int>(readIndex)) % (2 * numBlocks_);
+	}
+
+	/// Deleted copy constructor
+	AudioRingBuffer(const AudioRingBuffer &) = delete;
+	/// Deleted assignment operator
+	AudioRingBuffer &operator=(const AudioRingBuffer &) = delete;
+};
+
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef CLASS_NCINE_AUDIOSTREAMDECODER
+#define CLASS_NCINE_AUDIOSTREAMDECODER
+
+#include "AudioRingBuffer.h"
+
+namespace ncine {
+
+class IAudioReader;
+
+/// Decodes an audio stream ahead of its playback, on a background thread shared by every decoder
+/*! The decoding thread fills the ring buffer of each started decoder and the thread that plays the stream
+ *  only copies the ready blocks into OpenAL buffers. The thread is created with the first started decoder
+ *  and it is joined when the last one is stopped. */
+class AudioStreamDecoder
+{
+  public:
+	/// Maximum number of decoders that can be started at the same time
+	static const unsigned int MaxNumDecoders = 16;
+
+	AudioStreamDecoder(const IAudioReader &audioReader, unsigned int numBlocks, unsigned int blockSize);
+	~AudioStreamDecoder();
+
+	inline AudioRingBuffer &ringBuffer() { return ringBuffer_; }
+	/// Returns true if the decoder is being served by the decoding thread
+	inline bool isStarted() const { return isStarted_; }
+
+	/// Sets whether the decoding thread rewinds the reader when it reaches the end of the stream
+	inline void setLooping(bool looping) { isLooping_.store(looping ? 1 : 0, nctl::Atomic32::MemoryModel::RELEASE); }
+
+	/// Hands the decoder to the decoding thread, returns false if too many decoders are already started
+	/*! A failed start is not retried until the decoder is stopped */
+	bool start();
+	/// Takes the decoder back from the decoding thread, then rewinds the reader and empties the ring buffer
+	void stop();
+
+  private:
+	/// The reader is only accessed by the decoding thread while the decoder is started
+	const IAudioReader &audioReader_;
+	AudioRingBuffer ringBuffer_;
+	nctl::Atomic32 isLooping_;
+	/// Set by the decoding thread after writing the last block of a stream that does not loop
+	bool hasReachedEnd_;
+	bool isStarted_;
+	/// Set when the decoder could not be started, the stream is decoded by the thread that plays it until it stops
+	bool hasFailedStart_;
+
+	/// Fills the free blocks of the ring buffer, returns false if there was nothing to decode
+	bool decode();
+	static void decodingThreadFunction(void *arg);
+
+	/// Deleted copy constructor
+	AudioStreamDecoder(const AudioStreamDecoder &) = delete;
+	/// Deleted assignment operator
+	AudioStreamDecoder &operator=(const AudioStreamDecoder &) = delete;
+};
+
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef CLASS_NCINE_BINARYSHADERCACHE
+#define CLASS_NCINE_BINARYSHADERCACHE
+
+#include <cstdint>
+#define NCINE_INCLUDE_OPENGL
+#include "common_headers.h"
+#include <nctl/String.h>
+
+namespace ncine {
+
+/// A cache on disk of the binaries of linked shader programs, retrieved by the hash of their sources
+/*! Binaries are only valid for the driver that produced them, the vendor, renderer and version strings are then hashed
+ *  together with the lines prepended to every shader and used as the seed of all source hashes.
+ *  Files saved with a different seed are deleted when the cache is created. */
+class BinaryShaderCache
+{
+  public:
+	/// The counters of the cache operations performed since its creation
+	struct Statistics
+	{
+		/// Number of program binaries loaded and accepted by the driver
+		unsigned int numLoaded = 0;
+		/// Number of program binaries saved after linking from sources
+		unsigned int numSaved = 0;
+		/// Number of program binaries that were found but rejected, their files are deleted
+		unsigned int numRejected = 0;
+	};
+
+	explicit BinaryShaderCache(const char *directory);
+
+	/// Returns true if the device can retrieve program binaries and the cache directory is writable
+	inline bool isAvailable() const { return isAvailable_; }
+	inline const nctl::String &directory() const { return directory_; }
+	inline const Statistics &statistics() const { return statistics_; }
+
+	/// Returns the hash that identifies a program made of a vertex and a fragment shader on this device
+	uint64_t hashSources(const char *vertexSource, const char *fragmentSource) const;
+
+	/// Loads the binary for the hash into an OpenGL program, returns false if it is missing or if the driver rejects it
+	/*! \note The program is left unlinked on failure and shaders can be attached to it as if it was new */
+	bool loadFromCache(GLuint glHandle, uint64_t hash);
+	/// Retrieves the binary of a linked OpenGL program and saves it for the hash
+	bool saveToCache(GLuint glHandle, uint64_t hash);
+	/// Deletes the cached binary for the hash
+	bool removeFromCache(uint64_t hash);
+
+  private:
+	/// The version of the cache file format, to be increased when the header changes
+	static const uint32_t Version = 1;
+
+	bool isAvailable_;
+	/// The hash of the device information strings and of the shader patch lines, used as a seed
+	uint64_t deviceHash_;
+	nctl::String directory_;
+	Statistics statistics_;
+
+	/// Returns the full path of the cache file for the hash
+	nctl::String cacheFilename(uint64_t hash) const;
+	/// Deletes every file that has been saved for a different device hash
+	unsigned int pruneStaleFiles();
+};
+
+}
+
+#endif
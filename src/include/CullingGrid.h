@@ -0,0 +1,68 @@
+#ifndef CLASS_NCINE_CULLINGGRID
+#define CLASS_NCINE_CULLINGGRID
+
+#include <nctl/Array.h>
+#include "Rect.h"
+#ifdef WITH_THREADS
+	#include "ThreadSync.h"
+#endif
+
+namespace ncine {
+
+class SceneNode;
+class DrawableNode;
+
+/// A uniform grid that indexes drawable nodes by their AABB, so that viewports only test the nodes near their culling rectangle
+/*! The unbounded grid coordinates are hashed into a fixed number of buckets, each holding the nodes of all the cells mapped to it.
+ *  A node is added to every cell its AABB overlaps, unless it spans too many of them, in which case it is tested by every query. */
+class CullingGrid
+{
+  public:
+	explicit CullingGrid(float cellSize);
+
+	inline float cellSize() const { return cellSize_; }
+	/// Returns the number of nodes that are tested by every query as they span too many cells
+	inline unsigned int numOversizedNodes() const { return oversizedNodes_.size(); }
+
+	/// Updates the AABB of a drawable node that has just been transformed and queues it to be placed again in the grid
+	/*! \note It is called by the scenegraph update and can be called concurrently from the threads of a parallel update */
+	void nodeHasTransformed(SceneNode &node);
+	/// Places the queued nodes in the cells overlapped by their new AABB
+	void updateCells();
+	/// Marks as rendered in the specified frame every node whose AABB overlaps the rectangle
+	void markOverlappingNodes(const Rectf &rect, unsigned long int frame);
+	/// Removes a node from the grid and from the queue of nodes to place
+	void removeNode(DrawableNode &node);
+
+  private:
+	static const unsigned int NumBuckets = 4096;
+	/// Nodes overlapping more cells than this are kept in a separate list
+	static const int MaxCellsPerNode = 16;
+
+	float cellSize_;
+	float invCellSize_;
+	nctl::Array<nctl::Array<DrawableNode *>> buckets_;
+	/// Nodes that span too many cells to be added to each of them
+	nctl::Array<DrawableNode *> oversizedNodes_;
+	/// Nodes whose AABB has changed since the last update of the cells
+	nctl::Array<DrawableNode *> queuedNodes_;
+#ifdef WITH_THREADS
+	Mutex queueMutex_;
+#endif
+
+	/// Returns the range of cells overlapped by a rectangle as minimum coordinates and number of cells per side
+	Recti cellsRange(const Rectf &rect) const;
+	static unsigned int bucketIndex(int cellX, int cellY);
+	static void markIfOverlapping(DrawableNode *node, const Rectf &rect, unsigned long int frame);
+	void insertNode(DrawableNode &node, const Recti &cells);
+	void removeFromCells(DrawableNode &node);
+
+	/// Deleted copy constructor
+	CullingGrid(const CullingGrid &) = delete;
+	/// Deleted assignment operator
+	CullingGrid &operator=(const CullingGrid &) = delete;
+};
+
+}
+
+#endif
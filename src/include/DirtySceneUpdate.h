@@ -0,0 +1,75 @@
+#ifndef CLASS_NCINE_DIRTYSCENEUPDATE
+#define CLASS_NCINE_DIRTYSCENEUPDATE
+
+#include <nctl/Array.h>
+#ifdef WITH_THREADS
+	#include "ThreadSync.h"
+#endif
+
+namespace ncine {
+
+class SceneNode;
+
+/// A class that only updates the scenegraph subtrees that have changed since the last frame
+/*! The setters of a node add it to a list of dirty subtree roots, the nodes that are not in any of those subtrees are not visited.
+ *  Nodes that change over time in their overridden `update()` method are registered separately and updated every frame. */
+class DirtySceneUpdate
+{
+  public:
+	DirtySceneUpdate();
+	~DirtySceneUpdate();
+
+	/// Returns the number of subtree roots waiting for an update
+	inline unsigned int numDirtyNodes() const { return dirtyNodes_.size(); }
+	/// Returns the number of nodes that are updated every frame
+	inline unsigned int numEveryFrameNodes() const { return everyFrameNodes_.size(); }
+
+	/// Updates the dirty subtrees and the nodes updated every frame that belong to the hierarchy of the specified root node
+	/*! \note Dirty nodes of other hierarchies are kept in the list until a viewport updates their root */
+	void update(SceneNode &rootNode, float interval);
+
+  private:
+	/// The state of a node in relation to the hierarchy being updated
+	enum class NodeState
+	{
+		/// The node will be updated as part of the subtree of one of its ancestors
+		COVERED,
+		/// The node or one of its ancestors has the update disabled
+		DISABLED,
+		/// The node does not belong to the hierarchy being updated
+		DETACHED,
+		/// The node should be updated
+		REACHABLE
+	};
+
+	/// The roots of the subtrees that have changed since the last update
+	nctl::Array<SceneNode *> dirtyNodes_;
+	/// The dirty nodes that are being updated in the current frame
+	nctl::Array<SceneNode *> subtreeRoots_;
+	/// The nodes that are updated every frame
+	nctl::Array<SceneNode *> everyFrameNodes_;
+#ifdef WITH_THREADS
+	/// Setters can be called by the overridden `update()` methods of nodes that are updated by the thread pool
+	Mutex dirtyNodesMutex_;
+#endif
+
+	/// Called by the setters of a node that is not already in the list
+	void addDirtyNode(SceneNode *node);
+	void removeDirtyNode(SceneNode *node);
+	void addEveryFrameNode(SceneNode *node);
+	void removeEveryFrameNode(SceneNode *node);
+
+	/// Walks the ancestors of a node to find out if and how it should be updated
+	NodeState nodeState(const SceneNode *node, const SceneNode &rootNode, bool coveredByDirtyNodes) const;
+
+	/// Deleted copy constructor
+	DirtySceneUpdate(const DirtySceneUpdate &) = delete;
+	/// Deleted assignment operator
+	DirtySceneUpdate &operator=(const DirtySceneUpdate &) = delete;
+
+	friend class SceneNode;
+};
+
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef CLASS_NCINE_FRAMEPACER
+#define CLASS_NCINE_FRAMEPACER
+
+#include "TimeStamp.h"
+
+namespace ncine {
+
+/// A class that waits for a point in time by sleeping while it is safe and spinning for the rest
+/*! The duration of every sleep is measured to estimate the granularity of the OS scheduler,
+ *  so that the thread never oversleeps and only spins for the last fraction of the wait. */
+class FramePacer
+{
+  public:
+	FramePacer();
+
+	/// Waits until the specified number of seconds have passed since the time stamp
+	void waitUntil(const TimeStamp &start, float seconds);
+
+	/// Returns the estimated number of seconds that a short sleep could last
+	inline float sleepEstimate() const { return sleepEstimate_; }
+	/// Returns the number of seconds spent sleeping by the last wait
+	inline float lastSleepTime() const { return lastSleepTime_; }
+	/// Returns the number of seconds spent spinning by the last wait
+	inline float lastSpinTime() const { return lastSpinTime_; }
+
+  private:
+	/// The estimated duration of a short sleep, as the mean of the measured ones plus their standard deviation
+	float sleepEstimate_;
+	/// The running mean of the measured sleep durations
+	double sleepMean_;
+	/// The running sum of squared differences from the mean of the measured sleep durations
+	double sleepM2_;
+	/// The number of sleep durations taken into account by the estimate
+	unsigned int numSleeps_;
+
+	float lastSleepTime_;
+	float lastSpinTime_;
+
+	/// Updates the estimate with a new sleep duration
+	void addSleepDuration(float seconds);
+};
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define CLASS_NCINE_FRAMETIMER
 
 #include "TimeStamp.h"
+#include "FramePacer.h"
 
 namespace ncine {
 
@@ -9,6 +10,23 @@ namespace ncine {
 class FrameTimer
 {
   public:
+	/// Statistics about the precision of the frame duration limiting
+	struct PacingStatistics
+	{
+		/// Number of frames whose duration has been limited
+		unsigned long int numFrames = 0;
+		/// Number of frames that already lasted longer than the target duration
+		unsigned long int numLateFrames = 0;
+		/// Average number of seconds that on time frames lasted longer than the target duration
+		float averageError = 0.0f;
+		/// Maximum number of seconds that an on time frame lasted longer than the target duration
+		float maxError = 0.0f;
+		/// Average number of seconds spent sleeping by a frame
+		float averageSleepTime = 0.0f;
+		/// Average number of seconds spent spinning by a frame
+		float averageSpinTime = 0.0f;
+	};
+
 	/// Constructor
 	FrameTimer(float logInterval, float avgInterval);
 
@@ -21,6 +39,9 @@ class FrameTimer
 	/*! \return A timestamp with last suspension duration */
 	TimeStamp resume();
 
+	/// Waits until the current frame has lasted the specified number of seconds
+	void limitFrameDuration(float seconds);
+
 	/// Returns the total number of frames counted
 	inline unsigned long int totalNumberFrames() const { return totNumFrames_; }
 	/// Returns the interval in seconds between the last two subsequent calls to `addFrame()`
@@ -29,6 +50,8 @@ class FrameTimer
 	inline float frameInterval() const { return frameStart_.secondsSince(); }
 	/// Returns the average FPS during the update interval
 	inline float averageFps() const { return fps_; }
+	/// Returns the statistics about the precision of the frame duration limiting
+	inline const PacingStatistics &pacingStatistics() const { return pacingStats_; }
 
   private:
 	/// Number of seconds between two log events (user defined)
@@ -57,6 +80,11 @@ class FrameTimer
 
 	/// Average FPS calulated during the specified interval
 	float fps_;
+
+	/// The object that sleeps and spins to limit the frame duration
+	FramePacer framePacer_;
+	/// Statistics about the precision of the frame duration limiting
+	PacingStatistics pacingStats_;
 };
 
 }
@@ -31,6 +31,9 @@ class GLShader
 	inline GLuint glHandle() const { return glHandle_; }
 	inline Status status() const { return status_; }
 
+	/// Returns the lines that are prepended to the source of every shader
+	static const char *sourcePatchLines();
+
 	void loadFromString(const char *string);
 	void loadFromFile(const char *filename);
 	bool compile(ErrorChecking errorChecking, bool logOnErrors);
@@ -30,6 +30,8 @@ class GLShaderProgram
 		NOT_LINKED,
 		COMPILATION_FAILED,
 		LINKING_FAILED,
+		/// Compilation and linking have been issued with deferred queries and the driver has not completed them yet
+		LINKING,
 		LINKED,
 		LINKED_WITH_DEFERRED_QUERIES,
 		LINKED_WITH_INTROSPECTION
@@ -54,6 +56,10 @@ class GLShaderProgram
 	inline QueryPhase queryPhase() const { return queryPhase_; }
 
 	bool isLinked() const;
+	/// Checks if the driver has completed compiling and linking a program with deferred queries, without stalling
+	/*! When `GL_KHR_parallel_shader_compile` is available the status is `LINKING` until completion, then queries are performed.
+	 *  Otherwise completion cannot be known in advance and the status is left unchanged, queries will be performed on first use. */
+	Status pollStatus();
 
 	/// Returns the length of the information log including the null termination character
 	unsigned int retrieveInfoLogLength() const;
@@ -68,6 +74,10 @@ class GLShaderProgram
 	bool attachShader(GLenum type, const char *filename);
 	bool attachShaderFromString(GLenum type, const char *string);
 	bool link(Introspection introspection);
+	/// Links the program from the binary cached for the hash of its sources, to be called before attaching any shader
+	/*! If the binary is missing or rejected the method returns false, the shaders should then be attached and linked as usual
+	 *  and the program binary will be saved in the cache once linking succeeds. */
+	bool linkFromBinaryCache(uint64_t sourcesHash, Introspection introspection);
 	void use();
 	bool validate();
 
@@ -105,6 +115,8 @@ class GLShaderProgram
 	Status status_;
 	Introspection introspection_;
 	QueryPhase queryPhase_;
+	/// The hash of the sources used to save the binary when linking succeeds, or zero if it should not be saved
+	uint64_t binaryCacheHash_;
 
 	/// A flag indicating whether the shader program should automatically log errors (the information log)
 	bool shouldLogOnErrors_;
@@ -122,6 +134,8 @@ class GLShaderProgram
 	nctl::StaticHashMap<nctl::String, int, GLVertexFormat::MaxAttributes> attributeLocations_;
 	GLVertexFormat vertexFormat_;
 
+	/// Returns true if the completion of compiling and linking can be checked without stalling
+	static bool isParallelCompileAvailable();
 	bool deferredQueries();
 	bool checkLinking();
 	void performIntrospection();
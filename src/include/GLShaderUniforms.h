@@ -27,6 +27,8 @@ class GLShaderUniforms
 	inline unsigned int numUniforms() const { return uniformCaches_.size(); }
 	inline bool hasUniform(const char *name) const { return (uniformCaches_.find(name) != nullptr); }
 	GLUniformCache *uniform(const char *name);
+	/// Returns the uniform cache only if it has the specified type, to be resolved once and then written with the store functions
+	GLUniformCache *uniformHandle(const char *name, GLenum type);
 	inline const UniformHashMapType allUniforms() const { return uniformCaches_; }
 	void commitUniforms();
 
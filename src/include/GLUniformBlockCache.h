@@ -40,6 +40,8 @@ class GLUniformBlockCache
 	inline bool copyData(const GLubyte *src) { return copyData(0, src, usedSize_); }
 
 	GLUniformCache *uniform(const char *name);
+	/// Returns the uniform cache only if it has the specified type, to be resolved once and then written with the store functions
+	GLUniformCache *uniformHandle(const char *name, GLenum type);
 	/// Wrapper around `GLUniformBlock::setBlockBinding()`
 	void setBlockBinding(GLuint blockBinding);
 
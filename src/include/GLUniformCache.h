@@ -1,8 +1,10 @@
 #ifndef CLASS_NCINE_GLUNIFORMCACHE
 #define CLASS_NCINE_GLUNIFORMCACHE
 
+#include <cstring> // for memcpy()
 #define NCINE_INCLUDE_OPENGL
 #include "common_headers.h"
+#include "common_macros.h"
 
 namespace ncine {
 
@@ -35,6 +37,34 @@ class GLUniformCache
 	bool setIntValue(GLint v0, GLint v1, GLint v2);
 	bool setIntValue(GLint v0, GLint v1, GLint v2, GLint v3);
 
+	/// Stores the values with no checks, only for handles whose type has been validated by a `uniformHandle()` function
+	inline void storeFloatVector(const GLfloat *vec, unsigned int numValues)
+	{
+		ASSERT(dataPointer_ != nullptr);
+		memcpy(dataPointer_, vec, sizeof(GLfloat) * numValues);
+		isDirty_ = true;
+	}
+	/// Stores the values with no checks, only for handles whose type has been validated by a `uniformHandle()` function
+	inline void storeFloatValue(GLfloat v0, GLfloat v1)
+	{
+		ASSERT(dataPointer_ != nullptr);
+		GLfloat *data = reinterpret_cast<GLfloat *>(dataPointer_);
+		data[0] = v0;
+		data[1] = v1;
+		isDirty_ = true;
+	}
+	/// Stores the values with no checks, only for handles whose type has been validated by a `uniformHandle()` function
+	inline void storeFloatValue(GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+	{
+		ASSERT(dataPointer_ != nullptr);
+		GLfloat *data = reinterpret_cast<GLfloat *>(dataPointer_);
+		data[0] = v0;
+		data[1] = v1;
+		data[2] = v2;
+		data[3] = v3;
+		isDirty_ = true;
+	}
+
 	inline bool isDirty() const { return isDirty_; }
 	inline void setDirty(bool isDirty) { isDirty_ = isDirty; }
 	bool commitValue();
@@ -35,14 +35,42 @@ class GLVertexFormat
 		inline GLsizei stride() const { return stride_; }
 		inline const GLvoid *pointer() const { return pointer_; }
 		inline unsigned int baseOffset() const { return baseOffset_; }
+		inline GLuint divisor() const { return divisor_; }
 
 		void setVboParameters(GLsizei stride, const GLvoid *pointer);
-		inline void setVbo(const GLBufferObject *vbo) { vbo_ = vbo; }
-		inline void setBaseOffset(unsigned int baseOffset) { baseOffset_ = baseOffset; }
-
-		inline void setSize(GLint size) { size_ = size; }
-		inline void setType(GLenum type) { type_ = type; }
-		inline void setNormalized(bool normalized) { normalized_ = normalized; }
+		inline void setVbo(const GLBufferObject *vbo)
+		{
+			hasChanged_ |= (vbo_ != vbo);
+			vbo_ = vbo;
+		}
+		inline void setBaseOffset(unsigned int baseOffset)
+		{
+			hasChanged_ |= (baseOffset_ != baseOffset);
+			baseOffset_ = baseOffset;
+		}
+		/// Sets the number of instances that share the same attribute value, or zero for a per-vertex attribute
+		inline void setDivisor(GLuint divisor)
+		{
+			hasChanged_ |= (divisor_ != divisor);
+			divisor_ = divisor;
+		}
+
+		inline void setSize(GLint size)
+		{
+			hasChanged_ |= (size_ != size);
+			size_ = size;
+		}
+		inline void setType(GLenum type)
+		{
+			hasChanged_ |= (type_ != type);
+			type_ = type;
+		}
+		inline void setNormalized(bool normalized)
+		{
+			const GLboolean glNormalized = normalized ? GL_TRUE : GL_FALSE;
+			hasChanged_ |= (normalized_ != glNormalized);
+			normalized_ = glNormalized;
+		}
 
 	  private:
 		bool enabled_;
@@ -53,8 +81,11 @@ class GLVertexFormat
 		GLboolean normalized_;
 		GLsizei stride_;
 		const GLvoid *pointer_;
-		/// Used to simulate missing `glDrawElementsBaseVertex()` on OpenGL ES 3.0
+		/// Used to simulate missing `glDrawElementsBaseVertex()` on OpenGL ES 3.0 and to offset per-instance attributes
 		unsigned int baseOffset_;
+		GLuint divisor_;
+		/// Set when a setter changes the attribute, cleared when the hash of the vertex format is computed again
+		mutable bool hasChanged_;
 
 		friend class GLVertexFormat;
 	};
@@ -66,7 +97,11 @@ class GLVertexFormat
 	inline unsigned int numAttributes() const { return attributes_.size(); }
 
 	inline const GLBufferObject *ibo() const { return ibo_; }
-	inline void setIbo(const GLBufferObject *ibo) { ibo_ = ibo; }
+	inline void setIbo(const GLBufferObject *ibo)
+	{
+		isHashDirty_ |= (ibo_ != ibo);
+		ibo_ = ibo;
+	}
 	void define();
 	void reset();
 
@@ -76,9 +111,18 @@ class GLVertexFormat
 	bool operator==(const GLVertexFormat &other) const;
 	bool operator!=(const GLVertexFormat &other) const;
 
+	/// Returns a hash of the state compared by the equality operator
+	/*! \note Equal formats have the same hash, but two formats with the same hash still need to be compared */
+	/*! \note The hash is cached and only computed again when the IBO or an attribute has changed */
+	uint64_t hash() const;
+
   private:
 	nctl::StaticArray<Attribute, MaxAttributes> attributes_;
 	const GLBufferObject *ibo_;
+
+	/// The hash of the last computed state, the format is bound to a VAO with the same state every time it is drawn
+	mutable uint64_t hash_;
+	mutable bool isHashDirty_;
 };
 
 }
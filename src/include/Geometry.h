@@ -34,6 +34,10 @@ class Geometry
 	inline void setNumVertices(GLsizei numVertices) { numVertices_ = numVertices; }
 	/// Sets the number of float elements that composes the vertex format
 	inline void setNumElementsPerVertex(unsigned int numElements) { numElementsPerVertex_ = numElements; }
+	/// Returns true if the vertex data is read once per instance
+	inline bool hasInstancedVertices() const { return hasInstancedVertices_; }
+	/// Sets the vertex data to be read once per instance, with the VBO offset applied to attribute pointers
+	inline void setInstancedVertices(bool instancedVertices) { hasInstancedVertices_ = instancedVertices; }
 	/// Creates a custom VBO that is unique to this `Geometry` object
 	void createCustomVbo(unsigned int numFloats, GLenum usage);
 	/// Retrieves a pointer that can be used to write vertex data from a custom VBO owned by this object
@@ -99,10 +103,11 @@ class Geometry
 
 	bool hasDirtyVertices_;
 	bool hasDirtyIndices_;
+	bool hasInstancedVertices_;
 
 	void bind();
 	void draw(GLsizei numInstances);
-	void commitVertices();
+	void commitVertices(GLsizei numInstances);
 	void commitIndices();
 
 	inline const RenderBuffersManager::Parameters &vboParams() const { return sharedVboParams_ ? *sharedVboParams_ : vboParams_; }
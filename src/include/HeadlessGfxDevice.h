@@ -0,0 +1,56 @@
+#ifndef CLASS_NCINE_HEADLESSGFXDEVICE
+#define CLASS_NCINE_HEADLESSGFXDEVICE
+
+#include "IGfxDevice.h"
+
+namespace ncine {
+
+/// The graphics device of the headless backend, with no window and no OpenGL context
+/*! The engine is linked to a stub OpenGL layer that only counts calls and bytes,
+ *  so that the scenegraph can be updated, visited, sorted and batched on machines with no GPU. */
+class HeadlessGfxDevice : public IGfxDevice
+{
+  public:
+	HeadlessGfxDevice(const WindowMode &windowMode, const GLContextInfo &glContextInfo, const DisplayMode &displayMode);
+
+	inline void setSwapInterval(int interval) override {}
+
+	inline void setFullScreen(bool fullScreen) override { isFullScreen_ = fullScreen; }
+
+	inline int windowPositionX() const override { return windowPosition_.x; }
+	inline int windowPositionY() const override { return windowPosition_.y; }
+	inline const Vector2i windowPosition() const override { return windowPosition_; }
+	inline void setWindowPosition(int x, int y) override { windowPosition_.set(x, y); }
+
+	void setWindowSize(int width, int height) override;
+
+	inline void setWindowTitle(const char *windowTitle) override {}
+	inline void setWindowIcon(const char *windowIconFilename) override {}
+
+	const VideoMode &currentVideoMode(unsigned int monitorIndex) const override;
+
+  private:
+	/// The width of the virtual monitor when the application asks for its resolution
+	static const int DefaultWidth = 1920;
+	/// The height of the virtual monitor when the application asks for its resolution
+	static const int DefaultHeight = 1080;
+	/// The refresh rate reported for the virtual monitor
+	static const int DefaultRefreshRate = 60;
+
+	/// The position of the window that does not exist
+	Vector2i windowPosition_;
+
+	/// Deleted copy constructor
+	HeadlessGfxDevice(const HeadlessGfxDevice &) = delete;
+	/// Deleted assignment operator
+	HeadlessGfxDevice &operator=(const HeadlessGfxDevice &) = delete;
+
+	void updateMonitors() override;
+
+	/// Ends the frame of the stub OpenGL layer, as there are no buffers to swap
+	void update() override;
+};
+
+}
+
+#endif
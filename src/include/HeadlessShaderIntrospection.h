@@ -0,0 +1,76 @@
+#ifndef CLASS_NCINE_HEADLESSSHADERINTROSPECTION
+#define CLASS_NCINE_HEADLESSSHADERINTROSPECTION
+
+#define NCINE_INCLUDE_OPENGL
+#include "common_headers.h"
+#include <nctl/Array.h>
+#include <nctl/String.h>
+
+namespace ncine {
+
+/// The active uniforms, uniform blocks and attributes that the stub OpenGL layer extracts from GLSL sources
+/*! The headless backend has no driver to compile and link shaders, but the engine relies on introspection
+ *  to find its uniforms. Declarations are parsed after a minimal preprocessing and uniform blocks are laid out
+ *  with the `std140` rules. Only the first element of an array of structures is reported as active. */
+class HeadlessShaderIntrospection
+{
+  public:
+	/// An active uniform, either in the default block or in a uniform block
+	struct Uniform
+	{
+		nctl::String name;
+		GLenum type;
+		GLint size;
+		/// The index of the containing uniform block, or -1 for the default block
+		GLint blockIndex;
+		/// The offset inside the uniform block, or -1 for the default block
+		GLint offset;
+		/// The location in the default block, or -1 for a uniform block member
+		GLint location;
+	};
+
+	/// An active uniform block and the indices of its uniforms
+	struct UniformBlock
+	{
+		nctl::String name;
+		GLint dataSize;
+		GLint binding;
+		nctl::Array<GLint> uniformIndices;
+	};
+
+	/// An active vertex attribute
+	struct Attribute
+	{
+		nctl::String name;
+		GLenum type;
+		GLint size;
+		GLint location;
+	};
+
+	nctl::Array<Uniform> uniforms;
+	nctl::Array<UniformBlock> uniformBlocks;
+	nctl::Array<Attribute> attributes;
+
+	HeadlessShaderIntrospection();
+
+	/// Adds the declarations of a shader stage, skipping the uniforms and the blocks already added by another one
+	void addStage(GLenum shaderType, const char *source);
+	/// Removes every declaration
+	void clear();
+
+	/// Returns the location of the named default block uniform, or -1 if it is not active
+	/*! \note A name can refer to an element of an array, like `uColors[2]` */
+	GLint uniformLocation(const char *name) const;
+	/// Returns the location of the named attribute, or -1 if it is not active
+	GLint attributeLocation(const char *name) const;
+
+  private:
+	/// The location that will be assigned to the next default block uniform
+	GLint nextUniformLocation_;
+	/// The location that will be assigned to the next attribute without a layout qualifier
+	GLint nextAttributeLocation_;
+};
+
+}
+
+#endif
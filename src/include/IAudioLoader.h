@@ -38,6 +38,9 @@ class IAudioLoader
 
 	/// Returns the proper audio reader according to the loader instance
 	virtual nctl::UniquePtr<IAudioReader> createReader() = 0;
+	/// Returns a pointer to the decoded samples if they can be read in place from a memory or mapped file, `nullptr` otherwise
+	/*! \note The pointer is only valid until a reader is created or the loader is destroyed */
+	virtual const unsigned char *inPlaceSamples() const { return nullptr; }
 
   protected:
 	/// A flag indicating if the loading process has been successful
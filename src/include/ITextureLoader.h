@@ -33,7 +33,7 @@ class ITextureLoader
 	/// Returns the texture format object
 	inline const TextureFormat &texFormat() const { return texFormat_; }
 	/// Returns the pointer to pixel data
-	inline const GLubyte *pixels() const { return pixels_.get(); }
+	inline const GLubyte *pixels() const { return (pixels_ != nullptr) ? pixels_.get() : inPlacePixels_; }
 	/// Returns the pointer to pixel data for the specified MIP map level
 	const GLubyte *pixels(unsigned int mipMapLevel) const;
 
@@ -57,6 +57,9 @@ class ITextureLoader
 	nctl::UniquePtr<unsigned long[]> mipDataSizes_;
 	TextureFormat texFormat_;
 	nctl::UniquePtr<GLubyte[]> pixels_;
+	/// Pixel data read in place from a memory or mapped file, used when `pixels_` is empty
+	/*! \note The pointer is only valid as long as the file handle is opened */
+	const GLubyte *inPlacePixels_;
 
 	/// An empty constructor only used by `TextureLoaderRaw`
 	ITextureLoader();
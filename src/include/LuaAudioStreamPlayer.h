@@ -19,6 +19,9 @@ class LuaAudioStreamPlayer
 
 	static int numSamplesInStreamBuffer(lua_State *L);
 	static int streamBufferSize(lua_State *L);
+	static int numStreamBuffers(lua_State *L);
+	static int hasBackgroundDecoding(lua_State *L);
+	static int setStreamBuffers(lua_State *L);
 	static int sampleOffsetInStream(lua_State *L);
 };
 
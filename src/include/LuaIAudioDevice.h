@@ -19,6 +19,7 @@ class LuaIAudioDevice
 
 	static int maxNumPlayers(lua_State *L);
 	static int numPlayers(lua_State *L);
+	static int numVirtualPlayers(lua_State *L);
 	static int player(lua_State *L);
 
 	static int stopPlayers(lua_State *L);
@@ -33,6 +33,7 @@ class LuaIAudioPlayer
 	static int isPlaying(lua_State *L);
 	static int isPaused(lua_State *L);
 	static int isStopped(lua_State *L);
+	static int isVirtual(lua_State *L);
 
 	static int isLooping(lua_State *L);
 	static int setLooping(lua_State *L);
@@ -44,6 +45,10 @@ class LuaIAudioPlayer
 	static int position(lua_State *L);
 	static int setPosition(lua_State *L);
 
+	static int priority(lua_State *L);
+	static int setPriority(lua_State *L);
+	static int audibility(lua_State *L);
+
 	friend class LuaAudioBufferPlayer;
 	friend class LuaAudioStreamPlayer;
 };
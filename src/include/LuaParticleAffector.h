@@ -34,6 +34,12 @@ class LuaParticleAffector
 	static int addRotationStep(lua_State *L);
 	static int addPositionStep(lua_State *L);
 	static int addVelocityStep(lua_State *L);
+
+	static int setColorStep(lua_State *L);
+	static int setSizeStep(lua_State *L);
+	static int setRotationStep(lua_State *L);
+	static int setPositionStep(lua_State *L);
+	static int setVelocityStep(lua_State *L);
 };
 
 }
@@ -29,6 +29,7 @@ class LuaShader
 	static int setAttribute(lua_State *L);
 
 	static int isLinked(lua_State *L);
+	static int isLinking(lua_State *L);
 
 	static int retrieveInfoLogLength(lua_State *L);
 	static int retrieveInfoLog(lua_State *L);
@@ -0,0 +1,24 @@
+#ifndef CLASS_NCINE_LZ4BLOCK
+#define CLASS_NCINE_LZ4BLOCK
+
+#include "common_defines.h"
+
+namespace ncine {
+
+/// The class compressing and decompressing data in the LZ4 block format
+/*! The output is compatible with the `LZ4_compress_default()` and `LZ4_decompress_safe()` functions of the reference library.
+ *  The compressor is a simple greedy one, meant to prepare data offline, while the decompressor is fast and validates its input. */
+class DLL_PUBLIC Lz4Block
+{
+  public:
+	/// Returns the maximum size of the compressed data for an input of the specified size
+	static unsigned int compressBound(unsigned int srcSize);
+	/// Compresses the source data, returns the compressed size or zero if it does not fit in the destination
+	static unsigned int compress(const unsigned char *src, unsigned int srcSize, unsigned char *dst, unsigned int dstCapacity);
+	/// Decompresses the source data, returns false if it is malformed or if it does not decompress to exactly `dstSize` bytes
+	static bool decompress(const unsigned char *src, unsigned int srcSize, unsigned char *dst, unsigned int dstSize);
+};
+
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef CLASS_NCINE_MAPPEDFILE
+#define CLASS_NCINE_MAPPEDFILE
+
+#include "IFile.h"
+
+namespace ncine {
+
+/// The class mapping a whole standard file in memory for reading
+/*! Reads are copies from the mapping, and `data()` gives direct access to it so that loaders can consume the contents in place.
+ *  The pages are loaded on demand by the operating system and they can be dropped without being written to the swap. */
+class MappedFile : public IFile
+{
+  public:
+	/// Constructs a mapped file object
+	/*! \param filename File name including its path */
+	explicit MappedFile(const char *filename);
+	~MappedFile() override;
+
+	/// Tries to open and map the file, only the read mode is supported
+	void open(unsigned char mode) override;
+	/// Unmaps and closes the file
+	void close() override;
+	long int seek(long int offset, int whence) const override;
+	long int tell() const override;
+	unsigned long int read(void *buffer, unsigned long int bytes) const override;
+	/// Mapped files are read-only, nothing is written
+	unsigned long int write(const void *buffer, unsigned long int bytes) override;
+
+	bool isOpened() const override;
+	inline const unsigned char *data() const override { return mappedPtr_; }
+
+  private:
+	const unsigned char *mappedPtr_;
+	/// \note Modified by `seek` and `read` constant methods
+	mutable unsigned long int seekOffset_;
+
+	/// Deleted copy constructor
+	MappedFile(const MappedFile &) = delete;
+	/// Deleted assignment operator
+	MappedFile &operator=(const MappedFile &) = delete;
+};
+
+}
+
+#endif
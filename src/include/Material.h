@@ -55,6 +55,16 @@ class Material
 		BATCHED_TEXTNODES_RED,
 		/// Shader program for a batch of TextNode classes with glyph data in all channels (glyphs are colored)
 		BATCHED_TEXTNODES_SPRITE,
+		/// Shader program for a batch of Sprite classes with per-instance attributes
+		INSTANCED_SPRITES,
+		/// Shader program for a batch of Sprite classes with per-instance attributes and grayscale font texture
+		INSTANCED_SPRITES_GRAY,
+		/// Shader program for a batch of Sprite classes with per-instance attributes, solid colors and no texture
+		INSTANCED_SPRITES_NO_TEXTURE,
+		/// Shader program for the particles of a system stored in arrays, drawn with per-instance attributes
+		PARTICLES,
+		/// Shader program for the particles of a system stored in arrays, drawn with per-instance attributes and grayscale font texture
+		PARTICLES_GRAY,
 		/// A custom shader program
 		CUSTOM
 	};
@@ -81,6 +91,20 @@ class Material
 	static const char *MeshIndexAttributeName;
 	static const char *ColorAttributeName;
 
+	// Per-instance attribute names for batched shaders without an instances block
+	static const unsigned int NumModelMatrixAttributes = 4;
+	static const char *ModelMatrixAttributeNames[NumModelMatrixAttributes];
+	static const char *InstanceColorAttributeName;
+	static const char *InstanceTexRectAttributeName;
+	static const char *InstanceSpriteSizeAttributeName;
+
+	// Anchor point uniform and per-instance attribute names for particle shaders
+	static const char *AnchorPointUniformName;
+	static const char *ParticlePositionAttributeName;
+	static const char *ParticleScaleAttributeName;
+	static const char *ParticleRotationAttributeName;
+	static const char *ParticleColorAttributeName;
+
 	/// Default constructor
 	Material();
 	Material(GLShaderProgram *program, GLTexture *texture);
@@ -95,6 +119,7 @@ class Material
 	inline ShaderProgramType shaderProgramType() const { return shaderProgramType_; }
 	bool setShaderProgramType(ShaderProgramType shaderProgramType);
 	inline const GLShaderProgram *shaderProgram() const { return shaderProgram_; }
+	inline GLShaderProgram *shaderProgram() { return shaderProgram_; }
 	void setShaderProgram(GLShaderProgram *program);
 
 	void setDefaultAttributesParameters();
@@ -108,6 +133,8 @@ class Material
 
 	/// Wrapper around `GLShaderUniforms::uniform()`
 	inline GLUniformCache *uniform(const char *name) { return shaderUniforms_.uniform(name); }
+	/// Wrapper around `GLShaderUniforms::uniformHandle()`
+	inline GLUniformCache *uniformHandle(const char *name, GLenum type) { return shaderUniforms_.uniformHandle(name, type); }
 	/// Wrapper around `GLShaderUniformBlocks::uniformBlock()`
 	inline GLUniformBlockCache *uniformBlock(const char *name) { return shaderUniformBlocks_.uniformBlock(name); }
 
@@ -133,6 +160,8 @@ class Material
 	GLShaderProgram *shaderProgram_;
 	GLShaderUniforms shaderUniforms_;
 	GLShaderUniformBlocks shaderUniformBlocks_;
+	/// The model matrix uniform, in the instance block or on its own, resolved when the shader program is set
+	GLUniformCache *modelMatrixUniform_;
 	const GLTexture *textures_[GLTexture::MaxTextureUnits];
 
 	/// The size of the memory buffer containing uniform values
@@ -0,0 +1,68 @@
+#ifndef CLASS_NCINE_PACKFILE
+#define CLASS_NCINE_PACKFILE
+
+#include <cstdint>
+#include <nctl/SharedPtr.h>
+#include "IFile.h"
+
+namespace ncine {
+
+/// The class reading a file stored inside a mounted pack archive
+/*! Stored entries are read in place from the mapped archive, compressed ones are decompressed in memory when the file is opened.
+ *  The archive stays mapped as long as one of its files exists, even if it has been unmounted. */
+class PackFile : public IFile
+{
+  public:
+	/// The location of a file inside the archive
+	struct Entry
+	{
+		uint64_t offset = 0;
+		/// Size of the file contents
+		uint32_t size = 0;
+		/// Size of the data in the archive, different from `size` when compressed
+		uint32_t storedSize = 0;
+		bool isCompressed = false;
+	};
+
+	/// Constructs a packed file object
+	/*! \param filename File name including its path, as requested to `IFile::createFileHandle()`
+	 *  \param packHandle The opened handle of the archive, shared with the other files from it */
+	PackFile(const char *filename, const nctl::SharedPtr<IFile> &packHandle, const Entry &entry);
+	~PackFile() override;
+
+	/// Tries to open the file, only the read mode is supported
+	void open(unsigned char mode) override;
+	void close() override;
+	long int seek(long int offset, int whence) const override;
+	long int tell() const override;
+	unsigned long int read(void *buffer, unsigned long int bytes) const override;
+	/// Packed files are read-only, nothing is written
+	unsigned long int write(const void *buffer, unsigned long int bytes) override;
+
+	bool isOpened() const override;
+	inline const unsigned char *data() const override { return bufferPtr_; }
+
+	/// Returns a handle to a pack file, mapped in memory when possible
+	static nctl::UniquePtr<IFile> createPackHandle(const char *packFilename);
+
+  private:
+	nctl::SharedPtr<IFile> packHandle_;
+	Entry entry_;
+	/// The file contents when they cannot be read in place from the archive
+	nctl::UniquePtr<unsigned char[]> buffer_;
+	const unsigned char *bufferPtr_;
+	/// \note Modified by `seek` and `read` constant methods
+	mutable unsigned long int seekOffset_;
+
+	/// Reads the stored data of the entry from a new handle of the archive, when it is not mapped in memory
+	bool readStoredData(nctl::UniquePtr<unsigned char[]> &storedData);
+
+	/// Deleted copy constructor
+	PackFile(const PackFile &) = delete;
+	/// Deleted assignment operator
+	PackFile &operator=(const PackFile &) = delete;
+};
+
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef CLASS_NCINE_PARALLELPARTICLESUPDATE
+#define CLASS_NCINE_PARALLELPARTICLESUPDATE
+
+#include <nctl/Array.h>
+#include "ThreadCommands.h"
+
+namespace ncine {
+
+class ParticleSystem;
+
+/// A class that defers the update of the particle arrays of particle systems to the thread pool
+/*! Each system enqueues its own job as soon as it is updated by the scenegraph walk, so that jobs run while
+ *  the walk continues. The jobs are joined before the AABBs of the particles are needed for culling. */
+class ParallelParticlesUpdate
+{
+  public:
+	ParallelParticlesUpdate();
+
+	/// Starts collecting the particle systems updated by the scenegraph walk
+	void begin();
+	/// Waits until every deferred update has been executed, then completes them on the calling thread
+	void join();
+
+  private:
+	/// The systems whose update has been deferred since the last join
+	nctl::Array<ParticleSystem *> systems_;
+	/// Protects the array of systems, as they can be deferred by the parallel scenegraph update
+	Mutex systemsMutex_;
+	/// The index of the next system whose update can be claimed by a command
+	unsigned int nextSystem_;
+	/// The group of the commands enqueued in the thread pool
+	CommandGroup commandGroup_;
+
+	/// Called by `ParticleSystem::update()`, returns false if the update should not be deferred
+	bool defer(ParticleSystem &system);
+	/// Waits for the deferred update of a system that is being destroyed and forgets about it
+	void remove(ParticleSystem &system);
+	/// Returns the next system whose update has not been started yet, or `nullptr` if there are none
+	ParticleSystem *claimSystem();
+	/// Updates systems until there are no more left, called by the commands
+	static void updateFunction(void *arg);
+
+	/// Deleted copy constructor
+	ParallelParticlesUpdate(const ParallelParticlesUpdate &) = delete;
+	/// Deleted assignment operator
+	ParallelParticlesUpdate &operator=(const ParallelParticlesUpdate &) = delete;
+
+	friend class ParticleSystem;
+};
+
+}
+
+#endif
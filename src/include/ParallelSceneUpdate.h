@@ -0,0 +1,57 @@
+#ifndef CLASS_NCINE_PARALLELSCENEUPDATE
+#define CLASS_NCINE_PARALLELSCENEUPDATE
+
+#include <nctl/Array.h>
+#include <nctl/Atomic.h>
+#include "ThreadCommands.h"
+
+namespace ncine {
+
+class SceneNode;
+
+/// A class that distributes the update of scenegraph subtrees to the thread pool
+/*! The nodes above the split depth are updated by the calling thread, so that parent
+ *  transformations are always calculated before their children are updated.
+ *  Each subtree rooted at the split depth is then updated by a worker thread or by the calling one. */
+class ParallelSceneUpdate
+{
+  public:
+	ParallelSceneUpdate();
+
+	/// Updates the hierarchy of the specified root node, distributing the subtrees at the split depth
+	void update(SceneNode &rootNode, float interval, unsigned int splitDepth);
+
+  private:
+	/// The root of the hierarchy being updated
+	SceneNode *rootNode_;
+	/// The depth of the subtree roots that are updated in parallel
+	unsigned int splitDepth_;
+	/// The interval passed to the update of every subtree
+	float interval_;
+
+	/// The roots of the subtrees to update in parallel
+	nctl::Array<SceneNode *> subtrees_;
+	/// The nodes whose children have been deferred to the parallel update
+	nctl::Array<SceneNode *> deferredParents_;
+	/// The index of the next subtree to be updated
+	nctl::Atomic32 nextSubtree_;
+	/// The group of the commands enqueued in the thread pool
+	CommandGroup commandGroup_;
+
+	/// Called by `SceneNode::update()`, returns true if the children of the node have been deferred
+	bool deferChildren(SceneNode *node);
+	/// Updates subtrees until there are no more left, called by every participating thread
+	void updateSubtrees();
+	static void updateSubtreesFunction(void *arg);
+
+	/// Deleted copy constructor
+	ParallelSceneUpdate(const ParallelSceneUpdate &) = delete;
+	/// Deleted assignment operator
+	ParallelSceneUpdate &operator=(const ParallelSceneUpdate &) = delete;
+
+	friend class SceneNode;
+};
+
+}
+
+#endif
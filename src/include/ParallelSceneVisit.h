@@ -0,0 +1,93 @@
+#ifndef CLASS_NCINE_PARALLELSCENEVISIT
+#define CLASS_NCINE_PARALLELSCENEVISIT
+
+#include <nctl/Array.h>
+#include <nctl/Atomic.h>
+#include <nctl/UniquePtr.h>
+#include "ThreadCommands.h"
+
+namespace ncine {
+
+class SceneNode;
+class RenderQueue;
+
+/// A class that distributes the visit of scenegraph subtrees to the thread pool
+/*! The nodes above the split depth are visited by the calling thread, while each subtree rooted at
+ *  the split depth fills the deferred render queue of the thread that visits it.
+ *  Every subtree starts counting from its own visit order index, which is offset when the queues are merged,
+ *  so that commands and nodes end up with the same indices they would have had with a serial visit. */
+class ParallelSceneVisit
+{
+  public:
+	ParallelSceneVisit();
+	~ParallelSceneVisit();
+
+	/// Visits the hierarchy of the specified root node and fills the render queue, distributing the subtrees at the split depth
+	void visit(SceneNode &rootNode, RenderQueue &renderQueue, unsigned int splitDepth);
+
+  private:
+	/// The state of the serial visit when the children of a node have been deferred
+	struct Split
+	{
+		/// Number of nodes visited by the calling thread before the split
+		unsigned int numVisitedNodes;
+		/// Number of commands added by the calling thread before the split
+		unsigned int numCommands;
+		/// The visit order index when the children have been deferred
+		unsigned int visitOrderIndex;
+		/// The number of deferred children
+		unsigned int numSubtrees;
+	};
+
+	/// A subtree visited in parallel and the range of its nodes and commands in a deferred queue
+	struct Subtree
+	{
+		SceneNode *node;
+		unsigned int queueIndex;
+		unsigned int firstNode;
+		unsigned int lastNode;
+		unsigned int firstCommand;
+		unsigned int lastCommand;
+		/// The number of visit order indices used by the subtree
+		unsigned int numVisitOrders;
+	};
+
+	/// The root of the hierarchy being visited
+	SceneNode *rootNode_;
+	/// The depth of the subtree roots that are visited in parallel
+	unsigned int splitDepth_;
+
+	/// The deferred queue filled by the calling thread while visiting the nodes above the split depth
+	nctl::UniquePtr<RenderQueue> serialQueue_;
+	/// The deferred queues filled while visiting the subtrees, one for each participating thread
+	nctl::Array<nctl::UniquePtr<RenderQueue>> subtreeQueues_;
+
+	nctl::Array<Split> splits_;
+	nctl::Array<Subtree> subtrees_;
+	/// The index of the next subtree to be visited
+	nctl::Atomic32 nextSubtree_;
+	/// The index of the next deferred queue to be assigned to a thread
+	nctl::Atomic32 nextQueue_;
+	/// The group of the commands enqueued in the thread pool
+	CommandGroup commandGroup_;
+
+	/// Called by `SceneNode::visit()`, returns true if the children of the node have been deferred
+	bool deferChildren(SceneNode *node, unsigned int visitOrderIndex);
+	/// Visits subtrees until there are no more left, called by every participating thread
+	void visitSubtrees(RenderQueue &queue, unsigned int queueIndex);
+	static void visitSubtreesFunction(void *arg);
+	/// Merges a range of a deferred queue into the render queue, offsetting visit order indices
+	void mergeQueue(RenderQueue &renderQueue, const RenderQueue &deferredQueue, unsigned int firstNode, unsigned int lastNode,
+	                unsigned int firstCommand, unsigned int lastCommand, unsigned int visitOrderOffset);
+
+	/// Deleted copy constructor
+	ParallelSceneVisit(const ParallelSceneVisit &) = delete;
+	/// Deleted assignment operator
+	ParallelSceneVisit &operator=(const ParallelSceneVisit &) = delete;
+
+	friend class SceneNode;
+};
+
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef CLASS_NCINE_PARTICLEARRAYS
+#define CLASS_NCINE_PARTICLEARRAYS
+
+#include <nctl/UniquePtr.h>
+#include "Vector2.h"
+#include "Colorf.h"
+
+namespace ncine {
+
+/// The class storing the data of every particle of a system in contiguous arrays, one for each property
+/*! The alive particles are always the first ones, as a dead particle is replaced by the last alive one. */
+class ParticleArrays
+{
+  public:
+	/// Maximum number of particles
+	const unsigned int capacity;
+	/// Number of particles currently alive
+	unsigned int size;
+
+	/// Particle positions, in local space or in world space depending on the system
+	nctl::UniquePtr<float[]> positionsX;
+	nctl::UniquePtr<float[]> positionsY;
+	/// Particle velocity vectors
+	nctl::UniquePtr<float[]> velocitiesX;
+	nctl::UniquePtr<float[]> velocitiesY;
+	/// Particle remaining lives in seconds
+	nctl::UniquePtr<float[]> lives;
+	/// Initial particle remaining lives
+	nctl::UniquePtr<float[]> startingLives; // for affectors
+	/// Particle rotations in degrees
+	nctl::UniquePtr<float[]> rotations;
+	/// Initial particle rotations
+	nctl::UniquePtr<float[]> startingRotations; // for affectors
+	/// Particle scale factors
+	nctl::UniquePtr<float[]> scalesX;
+	nctl::UniquePtr<float[]> scalesY;
+	/// Particle colors
+	nctl::UniquePtr<Colorf[]> colors;
+	/// Particle normalized ages, calculated before applying the affectors
+	nctl::UniquePtr<float[]> normalizedAges;
+
+	/// Constructs the arrays for the specified maximum number of particles
+	explicit ParticleArrays(unsigned int cap);
+
+	/// Default move constructor
+	ParticleArrays(ParticleArrays &&) = default;
+
+	/// Initializes a new particle with initial life, position, velocity and rotation, if there is still space for it
+	bool add(float life, const Vector2f &pos, const Vector2f &vel, float rot);
+	/// Removes the particle at the specified index by moving the last alive one in its place
+	void remove(unsigned int index);
+	/// Removes all particles
+	inline void clear() { size = 0; }
+
+	/// Calculates the normalized age of every particle in the specified range
+	void updateNormalizedAges(unsigned int first, unsigned int count);
+	/// Decreases the life and integrates the position of every particle in the specified range
+	void integrate(unsigned int first, unsigned int count, float interval);
+	/// Removes every particle with no remaining life
+	void removeDead();
+
+  private:
+	/// Deleted copy constructor
+	ParticleArrays(const ParticleArrays &) = delete;
+	/// Deleted assignment operator
+	ParticleArrays &operator=(const ParticleArrays &) = delete;
+};
+
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef CLASS_NCINE_PARTICLEARRAYSNODE
+#define CLASS_NCINE_PARTICLEARRAYSNODE
+
+#include "BaseSprite.h"
+#include "ParticleArrays.h"
+
+namespace ncine {
+
+/// The drawable node that stores the particles of a system in arrays and renders them with a single instanced command
+/*! It is the only child of a particle system that does not use a `Particle` sprite for each of its particles. */
+class ParticleArraysNode : public BaseSprite
+{
+  public:
+	/// Constructs the node with the specified maximum amount of particles, texture and texture rectangle
+	ParticleArraysNode(SceneNode *parent, unsigned int count, Texture *texture, const Recti &texRect);
+
+	/// Default move constructor
+	ParticleArraysNode(ParticleArraysNode &&) = default;
+
+	/// Returns the particle arrays
+	inline ParticleArrays &particles() { return particles_; }
+	/// Returns the constant particle arrays
+	inline const ParticleArrays &particles() const { return particles_; }
+
+	/// Sets the transformation anchor point of every particle, relative to its size
+	void setParticlesAnchorPoint(float xx, float yy);
+	/// Sets the local space flag, the particle positions are otherwise in world space
+	void setInLocalSpace(bool inLocalSpace);
+
+	/// Called by the particle system when particles are emitted, updated or killed
+	void particlesHaveChanged();
+
+	/// Skips rendering when no particle is alive
+	bool draw(RenderQueue &renderQueue) override;
+
+  protected:
+	/// Returns a copy of this object
+	/*! \note This method is protected as it should only be called by a `ParticleSystem` */
+	inline ParticleArraysNode clone() const { return ParticleArraysNode(*this); }
+
+	/// Protected copy constructor used to clone objects
+	ParticleArraysNode(const ParticleArraysNode &other);
+
+	/// Calculates the AABB enclosing every alive particle
+	void updateAabb() override;
+
+	void shaderHasChanged() override;
+	void textureHasChanged(Texture *newTexture) override;
+	void updateRenderCommand() override;
+
+  private:
+	ParticleArrays particles_;
+	/// Per-instance vertex data in host memory, copied into a VBO when the particles change
+	nctl::UniquePtr<float[]> instancesData_;
+	/// The transformation anchor point of every particle, relative to its size
+	Vector2f particlesAnchorPoint_;
+	/// A flag indicating whether the particle positions are in local space or not
+	bool inLocalSpace_;
+	/// A flag indicating whether the per-instance vertex data should be filled again
+	bool particlesChanged_;
+
+	/// The anchor point uniform handle, resolved when the shader changes
+	GLUniformCache *anchorPointUniform_;
+
+	void init();
+	/// Custom transform method to allow world space particles to be independent from the system
+	void transform() override;
+
+	/// Deleted assignment operator
+	ParticleArraysNode &operator=(const ParticleArraysNode &) = delete;
+
+	friend class ParticleSystem;
+};
+
+}
+
+#endif
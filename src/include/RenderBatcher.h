@@ -12,33 +12,76 @@ class RenderCommand;
 class RenderBatcher
 {
   public:
+	/// The batches created from a sorted queue, reused by the next frame if the queue does not change
+	/*! \note Every render queue has its own cache, as it also owns the memory of the instances collected in its batches */
+	class BatchCache
+	{
+	  public:
+		BatchCache();
+
+	  private:
+		/// A range of the sorted queue whose commands share the lower part of the material sort key and the primitive type
+		struct Segment
+		{
+			unsigned int start;
+			unsigned int end;
+			/// The flag is `true` if the commands of the segment are collected into batches
+			bool batched;
+		};
+
+		/// A batch collected in the last frame, with the memory holding its uniforms and instances
+		struct Batch
+		{
+			const RenderCommand *firstCommand;
+			unsigned int size;
+			const unsigned char *uniformsData;
+		};
+
+		struct ManagedBuffer
+		{
+			ManagedBuffer()
+			    : size(0), freeSpace(0) {}
+
+			unsigned int size;
+			unsigned int freeSpace;
+			nctl::UniquePtr<unsigned char[]> buffer;
+		};
+
+		/// Material sort keys of the sorted queue the segments have been created from
+		nctl::Array<uint64_t> materialSortKeys_;
+		/// Commands of the sorted queue the segments have been created from
+		nctl::Array<const RenderCommand *> commands_;
+		nctl::Array<Segment> segments_;
+		nctl::Array<Batch> batches_;
+		unsigned int minBatchSize_;
+		unsigned int maxBatchSize_;
+		/// The frame in which the batches have been collected
+		unsigned long int frame_;
+		/// The number of batches collected in the current frame
+		unsigned int numBatches_;
+
+		/// Memory buffers to collect UBO data before committing it
+		/*! \note It is a RAM buffer and cannot be handled by the `RenderBuffersManager` */
+		nctl::Array<ManagedBuffer> buffers_;
+
+		friend class RenderBatcher;
+	};
+
 	RenderBatcher();
 
 	void collectInstances(const nctl::Array<RenderCommand *> &srcQueue, nctl::Array<RenderCommand *> &destQueue);
-	void createBatches(const nctl::Array<RenderCommand *> &srcQueue, nctl::Array<RenderCommand *> &destQueue);
-	void reset();
+	void createBatches(const nctl::Array<RenderCommand *> &srcQueue, nctl::Array<RenderCommand *> &destQueue, BatchCache &cache);
 
   private:
 	static unsigned int UboMaxSize;
 
-	struct ManagedBuffer
-	{
-		ManagedBuffer()
-		    : size(0), freeSpace(0) {}
-
-		unsigned int size;
-		unsigned int freeSpace;
-		nctl::UniquePtr<unsigned char[]> buffer;
-	};
-
-	/// Memory buffers to collect UBO data before committing it
-	/*! \note It is a RAM buffer and cannot be handled by the `RenderBuffersManager` */
-	nctl::Array<ManagedBuffer> buffers_;
+	bool isCacheValid(const nctl::Array<RenderCommand *> &srcQueue, const BatchCache &cache, unsigned int minBatchSize, unsigned int maxBatchSize) const;
+	void createSegments(const nctl::Array<RenderCommand *> &srcQueue, BatchCache &cache, unsigned int minBatchSize);
 
-	RenderCommand *collectCommands(nctl::Array<RenderCommand *>::ConstIterator start, nctl::Array<RenderCommand *>::ConstIterator end, nctl::Array<RenderCommand *>::ConstIterator &nextStart);
+	RenderCommand *collectCommands(nctl::Array<RenderCommand *>::ConstIterator start, nctl::Array<RenderCommand *>::ConstIterator end, nctl::Array<RenderCommand *>::ConstIterator &nextStart, BatchCache &cache, bool cacheIsValid);
 
-	unsigned char *acquireMemory(unsigned int bytes);
-	void createBuffer(unsigned int size);
+	unsigned char *acquireMemory(BatchCache &cache, unsigned int bytes);
+	void createBuffer(BatchCache &cache, unsigned int size);
 };
 
 }
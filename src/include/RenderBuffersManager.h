@@ -44,7 +44,8 @@ class RenderBuffersManager
 		GLubyte *mapBase;
 	};
 
-	RenderBuffersManager(bool useBufferMapping, unsigned long vboMaxSize, unsigned long iboMaxSize);
+	RenderBuffersManager(bool useBufferMapping, bool usePersistentMapping, unsigned long vboMaxSize, unsigned long iboMaxSize);
+	~RenderBuffersManager();
 
 	/// Returns the specifications for a buffer of the specified type
 	inline const BufferSpecifications &specs(BufferTypes::Enum type) const { return specs_[type]; }
@@ -53,13 +54,26 @@ class RenderBuffersManager
 	/// Requests an amount of bytes from the specified buffer type with a custom alignment requirement
 	Parameters acquireMemory(BufferTypes::Enum type, unsigned long bytes, unsigned int alignment);
 
+	/// Uploads the memory acquired in the current frame and releases it
+	void flushUnmap();
+	/// Makes the memory of every buffer available again for the next frame
+	void remap();
+
   private:
+	/// Number of regions in a persistently mapped buffer, one for each frame that the GPU might still be using
+	static const unsigned int NumRegions = 3;
+
 	BufferSpecifications specs_[BufferTypes::COUNT];
 
 	struct ManagedBuffer
 	{
 		ManagedBuffer()
-		    : type(BufferTypes::ARRAY), size(0), freeSpace(0), mapBase(nullptr) {}
+		    : type(BufferTypes::ARRAY), size(0), freeSpace(0), mapBase(nullptr),
+		      regionStride(0), regionOffset(0), fenceWaits(0), fenceStalls(0)
+		{
+			for (unsigned int i = 0; i < NumRegions; i++)
+				fences[i] = nullptr;
+		}
 
 		BufferTypes::Enum type;
 		nctl::UniquePtr<GLBufferObject> object;
@@ -67,15 +81,30 @@ class RenderBuffersManager
 		unsigned long freeSpace;
 		GLubyte *mapBase;
 		nctl::UniquePtr<GLubyte[]> hostBuffer;
+
+		/// The distance in bytes between two regions of a persistently mapped buffer
+		unsigned long regionStride;
+		/// The offset in bytes of the region used in the current frame
+		unsigned long regionOffset;
+		/// The fences signaled when the GPU has finished using each region
+		GLsync fences[NumRegions];
+		/// Number of fences checked before writing to a region since the last statistics gathering
+		unsigned int fenceWaits;
+		/// Number of fences that were not yet signaled and blocked the CPU since the last statistics gathering
+		unsigned int fenceStalls;
 	};
 
+	/// The flag is `true` if the managed buffers are persistently mapped and split in fenced regions
+	bool withPersistentMapping_;
+	/// The index of the region used in the current frame by every persistently mapped buffer
+	unsigned int currentRegion_;
+
 	nctl::Array<ManagedBuffer> buffers_;
 
-	void flushUnmap();
-	void remap();
 	void createBuffer(const BufferSpecifications &specs);
+	/// Blocks until the GPU has finished using the current region of a persistently mapped buffer
+	void waitForRegion(ManagedBuffer &buffer);
 
-	friend class ScreenViewport;
 	friend class RenderStatistics;
 };
 
@@ -69,6 +69,14 @@ class RenderCommand
 	inline uint32_t lowerMaterialSortKey() const { return static_cast<int32_t>(materialSortKey_); }
 	/// Calculates a material sort key for the queue
 	void calculateMaterialSortKey();
+	/// Adds an offset to a non-zero visit order index, updating the material sort key without hashing the material again
+	void offsetVisitOrder(uint16_t offset);
+	/// Returns the number of the last frame in which the data of the instance block has changed
+	inline unsigned long int instanceUpdateFrame() const { return instanceUpdateFrame_; }
+	/// Sets the number of the last frame in which the data of the instance block has changed
+	/*! \note Batches copy again the instance block of a command only if it has changed since they have been collected */
+	inline void setInstanceUpdateFrame(unsigned long int frame) { instanceUpdateFrame_ = frame; }
+
 	/// Returns the id based secondary sort key for the queue
 	inline unsigned int idSortKey() const { return idSortKey_; }
 	/// Sets the id based secondary sort key for the queue
@@ -118,6 +126,8 @@ class RenderCommand
 	uint16_t visitOrder_;
 	int numInstances_;
 	int batchSize_;
+	/// The frame of the last change to the instance block, it is always considered changed until it is set for the first time
+	unsigned long int instanceUpdateFrame_;
 
 	bool transformationCommitted_;
 
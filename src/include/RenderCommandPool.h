@@ -2,6 +2,7 @@
 #define CLASS_NCINE_RENDERCOMMANDPOOL
 
 #include <nctl/Array.h>
+#include <nctl/HashMap.h>
 #include <nctl/UniquePtr.h>
 #include "Material.h"
 
@@ -33,8 +34,16 @@ class RenderCommandPool
 	void reset();
 
   private:
-	nctl::Array<nctl::UniquePtr<RenderCommand>> freeCommandsPool_;
+	/// The arrays of free commands, one for each shader program
+	nctl::Array<nctl::Array<nctl::UniquePtr<RenderCommand>>> freeCommandsPools_;
+	/// The index of the free commands array of a shader program
+	nctl::HashMap<const GLShaderProgram *, unsigned int> freeCommandsIndex_;
+	/// The total number of free commands
+	unsigned int numFreeCommands_;
 	nctl::Array<nctl::UniquePtr<RenderCommand>> usedCommandsPool_;
+
+	/// Returns the array of free commands for the specified shader program, creating it if needed
+	nctl::Array<nctl::UniquePtr<RenderCommand>> &freeCommands(const GLShaderProgram *shaderProgram);
 };
 
 }
@@ -2,10 +2,13 @@
 #define CLASS_NCINE_RENDERQUEUE
 
 #include "RenderCommand.h"
+#include "RenderBatcher.h"
 #include <nctl/Array.h>
 
 namespace ncine {
 
+class SceneNode;
+
 /// A class that sorts and issues the render commands collected by the scenegraph visit
 class RenderQueue
 {
@@ -16,18 +19,56 @@ class RenderQueue
 	/// Returns true if the queue does not contain any render commands
 	bool isEmpty() const;
 
+	/// Returns true if the queue only collects commands to be merged later into another queue
+	inline bool isDeferred() const { return isDeferred_; }
+	/// Sets the deferred state of the queue, it should only be changed when the queue is empty
+	inline void setDeferred(bool deferred) { isDeferred_ = deferred; }
+
 	/// Adds a draw command to the queue
 	void addCommand(RenderCommand *command);
+	/// Adds a draw command whose material sort key has already been calculated
+	void addMergedCommand(RenderCommand *command);
+	/// Accounts for a drawable node that has been culled during the visit
+	void addCulledNode();
+
+	/// Adds a visited node to a deferred queue, so that its visit order index can be offset when merging
+	inline void addVisitedNode(SceneNode *node) { visitedNodes_.pushBack(node); }
+	/// Returns the array of nodes visited while filling a deferred queue
+	inline const nctl::Array<SceneNode *> &visitedNodes() const { return visitedNodes_; }
+	/// Returns the array of commands collected by a deferred queue, in visit order
+	inline const nctl::Array<RenderCommand *> &deferredCommands() const { return deferredCommands_; }
+	/// Returns the number of drawable nodes culled while filling a deferred queue
+	inline unsigned int numCulledNodes() const { return numCulledNodes_; }
 
 	/// Sorts the queues, create batches and commits commands
 	void sortAndCommit();
+	/// Sorts the opaque and the transparent queues with their respective orders
+	void sort();
+	/// Collects the sorted commands into batches, if batching is enabled
+	void createBatches();
+	/// Uploads the data of every command to be issued, to avoid stalls while drawing
+	void commit();
 	/// Issues every render command in order
 	void draw();
 
-	/// Clears all the queues and resets the render batcher
+	/// Clears all the queues
 	void clear();
 
   private:
+	/// The sorting key of a render command in a queue, packed for a cache friendly radix sort
+	struct SortKey
+	{
+		/// The material sort key, bitwise inverted for descending orders
+		uint64_t materialKey;
+		/// The id based secondary sort key, bitwise inverted for descending orders
+		uint32_t idKey;
+		/// The index of the command in the unsorted queue
+		uint32_t commandIndex;
+	};
+
+	/// The flag is `true` if the queue only collects commands to be merged later
+	bool isDeferred_;
+
 	/// Array of opaque render command pointers
 	nctl::Array<RenderCommand *> opaqueQueue_;
 	/// Array of opaque batched render command pointers
@@ -36,6 +77,30 @@ class RenderQueue
 	nctl::Array<RenderCommand *> transparentQueue_;
 	/// Array of transparent batched render command pointers
 	nctl::Array<RenderCommand *> transparentBatchedQueue_;
+
+	/// The batches of the opaque queue, reused when the sorted queue does not change between frames
+	RenderBatcher::BatchCache opaqueBatchCache_;
+	/// The batches of the transparent queue, reused when the sorted queue does not change between frames
+	RenderBatcher::BatchCache transparentBatchCache_;
+
+	/// Array of sort keys for the opaque queue
+	nctl::Array<SortKey> opaqueSortKeys_;
+	/// Array of sort keys for the transparent queue
+	nctl::Array<SortKey> transparentSortKeys_;
+	/// Scratch buffer for the radix sort passes
+	nctl::Array<SortKey> sortKeysScratch_;
+	/// Scratch array of render command pointers in sorted order
+	nctl::Array<RenderCommand *> sortedQueue_;
+
+	/// Array of render command pointers collected by a deferred queue
+	nctl::Array<RenderCommand *> deferredCommands_;
+	/// Array of nodes visited while filling a deferred queue
+	nctl::Array<SceneNode *> visitedNodes_;
+	/// Number of drawable nodes culled while filling a deferred queue
+	unsigned int numCulledNodes_;
+
+	/// Sorts a queue in ascending order of its sort keys
+	void sortQueue(nctl::Array<RenderCommand *> &queue, nctl::Array<SortKey> &sortKeys);
 };
 
 }
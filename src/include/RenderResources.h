@@ -6,6 +6,7 @@
 
 #include <nctl/UniquePtr.h>
 #include <nctl/HashMap.h>
+#include <nctl/Array.h>
 #include "Material.h"
 #include "Matrix4x4.h"
 #include "GLShaderProgram.h" // For the UniquePtr to invoke the destructor
@@ -17,6 +18,11 @@ class RenderBuffersManager;
 class RenderVaoPool;
 class RenderCommandPool;
 class RenderBatcher;
+class CullingGrid;
+class DirtySceneUpdate;
+class BinaryShaderCache;
+class TextureUploadQueue;
+class ShaderState;
 class Camera;
 class Viewport;
 
@@ -52,6 +58,32 @@ class RenderResources
 		int drawindex;
 	};
 
+	/// A per-instance vertex format structure for batched sprites, it mirrors the `std140` layout of their instance block
+	struct InstanceFormatSprite
+	{
+		GLfloat modelMatrix[16];
+		GLfloat color[4];
+		GLfloat texRect[4];
+		GLfloat spriteSize[2];
+	};
+
+	/// A per-instance vertex format structure for batched sprites with no texture, it mirrors the `std140` layout of their instance block
+	struct InstanceFormatSpriteNoTexture
+	{
+		GLfloat modelMatrix[16];
+		GLfloat color[4];
+		GLfloat spriteSize[2];
+	};
+
+	/// A per-instance vertex format structure for the particles of a system stored in arrays
+	struct InstanceFormatParticle
+	{
+		GLfloat position[2];
+		GLfloat scale[2];
+		GLfloat rotation;
+		GLfloat color[4];
+	};
+
 	struct CameraUniformData
 	{
 		CameraUniformData()
@@ -67,6 +99,14 @@ class RenderResources
 	static inline RenderVaoPool &vaoPool() { return *vaoPool_; }
 	static inline RenderCommandPool &renderCommandPool() { return *renderCommandPool_; }
 	static inline RenderBatcher &renderBatcher() { return *renderBatcher_; }
+	/// Returns the spatial index used by viewports for culling, or `nullptr` if it is disabled
+	static inline CullingGrid *cullingGrid() { return cullingGrid_.get(); }
+	/// Returns the object that only updates the changed scenegraph subtrees, or `nullptr` if it is disabled
+	static inline DirtySceneUpdate *dirtySceneUpdate() { return dirtySceneUpdate_.get(); }
+	/// Returns the cache on disk of linked shader program binaries, or `nullptr` if it is disabled
+	static inline BinaryShaderCache *binaryShaderCache() { return binaryShaderCache_.get(); }
+	/// Returns the queue that uploads asynchronously loaded textures
+	static inline TextureUploadQueue &textureUploadQueue() { return *textureUploadQueue_; }
 
 	static GLShaderProgram *shaderProgram(Material::ShaderProgramType shaderProgramType);
 
@@ -74,6 +114,10 @@ class RenderResources
 	static bool registerBatchedShader(const GLShaderProgram *shader, ncine::GLShaderProgram *batchedShader);
 	static bool unregisterBatchedShader(const GLShaderProgram *shader);
 
+	/// Adds a shader state whose shader is still linking, to be applied once the driver has completed it
+	static void addPendingShaderState(ShaderState *shaderState);
+	static bool removePendingShaderState(ShaderState *shaderState);
+
 	static inline unsigned char *cameraUniformsBuffer() { return cameraUniformsBuffer_; }
 	static CameraUniformData *findCameraUniformData(GLShaderProgram *shaderProgram);
 	static void insertCameraUniformData(GLShaderProgram *shaderProgram, CameraUniformData &&cameraUniformData);
@@ -89,10 +133,22 @@ class RenderResources
 	static nctl::UniquePtr<RenderVaoPool> vaoPool_;
 	static nctl::UniquePtr<RenderCommandPool> renderCommandPool_;
 	static nctl::UniquePtr<RenderBatcher> renderBatcher_;
-
-	static const unsigned int NumDefaultShaderPrograms = 18;
+	static nctl::UniquePtr<CullingGrid> cullingGrid_;
+	static nctl::UniquePtr<DirtySceneUpdate> dirtySceneUpdate_;
+	static nctl::UniquePtr<BinaryShaderCache> binaryShaderCache_;
+	static nctl::UniquePtr<TextureUploadQueue> textureUploadQueue_;
+
+	/// The name of the directory inside the save path where program binaries are cached
+	static const char *BinaryShaderCacheDirectory;
+
+	static const unsigned int NumDefaultShaderPrograms = 23;
+	/// The number of default shader programs with per-instance attributes for batched sprites, they are only loaded when enabled
+	static const unsigned int NumInstancedShaderPrograms = 3;
+	/// The number of default shader programs for particles stored in arrays, they are the last ones and are only loaded when enabled
+	static const unsigned int NumParticleShaderPrograms = 2;
 	static nctl::UniquePtr<GLShaderProgram> defaultShaderPrograms_[NumDefaultShaderPrograms];
 	static nctl::HashMap<const GLShaderProgram *, GLShaderProgram *> batchedShaders_;
+	static nctl::Array<ShaderState *> pendingShaderStates_;
 
 	static const unsigned int UniformsBufferSize = 128; // two 4x4 float matrices
 	static unsigned char cameraUniformsBuffer_[UniformsBufferSize];
@@ -111,6 +167,8 @@ class RenderResources
 	static void dispose();
 
 	static void registerDefaultBatchedShaders();
+	/// Applies the shaders of the pending states that have completed linking, without stalling on the others
+	static void updatePendingShaderStates();
 
 	/// Static class, deleted constructor
 	RenderResources() = delete;
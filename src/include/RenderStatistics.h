@@ -40,9 +40,13 @@ class RenderStatistics
 		unsigned int count;
 		unsigned long size;
 		unsigned long usedSpace;
+		/// Number of fences checked before reusing a region of a persistently mapped buffer
+		unsigned int fenceWaits;
+		/// Number of fences that were not yet signaled, making the CPU wait for the GPU
+		unsigned int fenceStalls;
 
 		Buffers()
-		    : count(0), size(0), usedSpace(0) {}
+		    : count(0), size(0), usedSpace(0), fenceWaits(0), fenceStalls(0) {}
 
 	  private:
 		void reset()
@@ -50,6 +54,8 @@ class RenderStatistics
 			count = 0;
 			size = 0;
 			usedSpace = 0;
+			fenceWaits = 0;
+			fenceStalls = 0;
 		}
 		friend RenderStatistics;
 	};
@@ -217,6 +223,7 @@ class RenderStatistics
 		customIbos_.dataSize -= datasize;
 	}
 	static inline void addCulledNode() { culledNodes_[index_]++; }
+	static inline void addCulledNodes(unsigned int numNodes) { culledNodes_[index_] += numNodes; }
 	static inline void addVaoPoolReuse() { vaoPool_.reuses++; }
 	static inline void addVaoPoolBinding() { vaoPool_.bindings++; }
 	static inline void addCommandPoolRetrieval() { commandPool_.retrievals++; }
@@ -226,7 +233,7 @@ class RenderStatistics
 	friend class RenderBuffersManager;
 	friend class Texture;
 	friend class Geometry;
-	friend class DrawableNode;
+	friend class ParallelSceneVisit;
 	friend class RenderVaoPool;
 	friend class RenderCommandPool;
 };
@@ -2,8 +2,8 @@
 #define CLASS_NCINE_RENDERVAOPOOL
 
 #include <nctl/Array.h>
+#include <nctl/HashMapList.h>
 #include <nctl/UniquePtr.h>
-#include "TimeStamp.h"
 #include "GLVertexArrayObject.h"
 #include "GLVertexFormat.h"
 
@@ -19,15 +19,31 @@ class RenderVaoPool
 	void bindVao(const GLVertexFormat &vertexFormat);
 
   private:
+	/// The index used to terminate the list of recently bound VAOs
+	static const unsigned int InvalidIndex = ~0u;
+
 	struct VaoBinding
 	{
 		nctl::UniquePtr<GLVertexArrayObject> object;
 		GLVertexFormat format;
-		TimeStamp lastBindTime;
+		/// The hash of the vertex format, used as the key of the index
+		uint64_t formatHash;
+		/// The binding that has been bound right after this one
+		unsigned int moreRecent;
+		/// The binding that has been bound right before this one
+		unsigned int lessRecent;
 	};
 
 	nctl::Array<VaoBinding> vaoPool_;
-
+	/// The index of the pool bindings by the hash of their vertex format, chained as keys are removed every time a VAO is reused
+	nctl::HashMapList<uint64_t, unsigned int> formatIndex_;
+	/// The most recently bound VAO, the head of a doubly linked list through the bindings
+	unsigned int mostRecent_;
+	/// The least recently bound VAO, the first one to be reused when the pool is full
+	unsigned int leastRecent_;
+
+	/// Moves a binding to the head of the list of recently bound VAOs
+	void markAsMostRecent(unsigned int index);
 	void insertGLDebugMessage(const VaoBinding &binding);
 };
 
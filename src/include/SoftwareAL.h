@@ -0,0 +1,90 @@
+#ifndef NCINE_SOFTWAREAL
+#define NCINE_SOFTWAREAL
+
+/// The subset of the OpenAL and ALC API used by the engine, implemented by the software mixer
+/*! Types and token values are the ones of the OpenAL 1.1 specification, so that no OpenAL header is needed. */
+
+typedef char ALboolean;
+typedef char ALchar;
+typedef int ALint;
+typedef unsigned int ALuint;
+typedef int ALsizei;
+typedef int ALenum;
+typedef float ALfloat;
+typedef void ALvoid;
+
+typedef char ALCboolean;
+typedef char ALCchar;
+typedef int ALCint;
+typedef int ALCenum;
+typedef struct ALCdevice ALCdevice;
+typedef struct ALCcontext ALCcontext;
+
+#define AL_NONE 0
+#define AL_FALSE 0
+#define AL_TRUE 1
+
+#define AL_NO_ERROR 0
+#define AL_INVALID_NAME 0xA001
+#define AL_INVALID_ENUM 0xA002
+#define AL_INVALID_VALUE 0xA003
+#define AL_INVALID_OPERATION 0xA004
+
+#define AL_PITCH 0x1003
+#define AL_POSITION 0x1004
+#define AL_LOOPING 0x1007
+#define AL_BUFFER 0x1009
+#define AL_GAIN 0x100A
+#define AL_SOURCE_STATE 0x1010
+#define AL_INITIAL 0x1011
+#define AL_PLAYING 0x1012
+#define AL_PAUSED 0x1013
+#define AL_STOPPED 0x1014
+#define AL_BUFFERS_QUEUED 0x1015
+#define AL_BUFFERS_PROCESSED 0x1016
+#define AL_SEC_OFFSET 0x1024
+#define AL_SAMPLE_OFFSET 0x1025
+
+#define AL_FORMAT_MONO8 0x1100
+#define AL_FORMAT_MONO16 0x1101
+#define AL_FORMAT_STEREO8 0x1102
+#define AL_FORMAT_STEREO16 0x1103
+
+#define ALC_FALSE 0
+#define ALC_TRUE 1
+#define ALC_DEVICE_SPECIFIER 0x1005
+
+extern "C" {
+
+ALenum alGetError();
+
+void alGenBuffers(ALsizei n, ALuint *buffers);
+void alDeleteBuffers(ALsizei n, const ALuint *buffers);
+void alBufferData(ALuint buffer, ALenum format, const ALvoid *data, ALsizei size, ALsizei freq);
+
+void alGenSources(ALsizei n, ALuint *sources);
+void alDeleteSources(ALsizei n, const ALuint *sources);
+void alSourcei(ALuint source, ALenum param, ALint value);
+void alSourcef(ALuint source, ALenum param, ALfloat value);
+void alSourcefv(ALuint source, ALenum param, const ALfloat *values);
+void alGetSourcei(ALuint source, ALenum param, ALint *value);
+void alGetSourcef(ALuint source, ALenum param, ALfloat *value);
+void alSourcePlay(ALuint source);
+void alSourcePause(ALuint source);
+void alSourceStop(ALuint source);
+void alSourceQueueBuffers(ALuint source, ALsizei nb, const ALuint *buffers);
+void alSourceUnqueueBuffers(ALuint source, ALsizei nb, ALuint *buffers);
+
+void alListenerf(ALenum param, ALfloat value);
+void alListener3f(ALenum param, ALfloat value1, ALfloat value2, ALfloat value3);
+
+ALCdevice *alcOpenDevice(const ALCchar *devicename);
+ALCboolean alcCloseDevice(ALCdevice *device);
+ALCcontext *alcCreateContext(ALCdevice *device, const ALCint *attrlist);
+void alcDestroyContext(ALCcontext *context);
+ALCboolean alcMakeContextCurrent(ALCcontext *context);
+const ALCchar *alcGetString(ALCdevice *device, ALCenum param);
+
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef CLASS_NCINE_TEXTUREUPLOADQUEUE
+#define CLASS_NCINE_TEXTUREUPLOADQUEUE
+
+#include <nctl/Array.h>
+#include <nctl/SharedPtr.h>
+#include <nctl/String.h>
+#include <nctl/Atomic.h>
+
+namespace ncine {
+
+class Texture;
+class ITextureLoader;
+class GLBufferObject;
+
+/// The request of an asynchronous texture load, shared by the texture, the upload queue, and the decoding command
+struct TextureLoadRequest
+{
+	/// Decoding states, the only ones changed by a worker thread
+	enum State
+	{
+		QUEUED,
+		DECODING,
+		DECODED,
+		FAILED
+	};
+
+	TextureLoadRequest(Texture *tex, const char *name);
+	~TextureLoadRequest();
+
+	/// Decodes the image file with the texture loader matching its extension, it can be called by a worker thread
+	void decode();
+
+	nctl::String filename;
+	/// The decoded image, only accessed by the main thread once the state is `DECODED`
+	nctl::UniquePtr<ITextureLoader> texLoader;
+	nctl::Atomic32 state;
+
+	/// The texture to upload to, or `nullptr` if the request has been cancelled
+	/*! \note Only accessed by the main thread */
+	Texture *texture;
+	/// The MIP level to upload next
+	int mipLevel;
+	/// The first row of the MIP level to upload next
+	int row;
+};
+
+/// The class that decodes textures on the thread pool and uploads them a few rows per frame
+/*! Requests are decoded in the order they have been queued, leaving a worker thread free for the parallel scenegraph commands.
+ *  Without a spare worker thread a single image is decoded every frame by the main thread. */
+class TextureUploadQueue
+{
+  public:
+	/// Creates a queue that uploads at most the specified number of bytes per frame, or without limits if it is zero
+	explicit TextureUploadQueue(unsigned long budget);
+	~TextureUploadQueue();
+
+	/// Queues a request to load an image file into a texture
+	nctl::SharedPtr<TextureLoadRequest> enqueue(Texture &texture, const char *filename);
+	/// Uploads the decoded images within the budget, then starts decoding the queued ones
+	/*! \note It should be called once per frame by the main thread */
+	void process();
+
+	/// Returns the number of requests that have not completed yet
+	inline unsigned int numRequests() const { return requests_.size(); }
+
+  private:
+	/// The maximum number of bytes uploaded every frame, or zero for no limits
+	unsigned long budget_;
+	/// The pending requests, in the order they have been queued
+	nctl::Array<nctl::SharedPtr<TextureLoadRequest>> requests_;
+	/// The pixel buffer object used to stage uploads, or `nullptr` if they are sourced from client memory
+	nctl::UniquePtr<GLBufferObject> pixelBuffer_;
+
+	/// Uploads as many rows as the remaining budget allows, then returns the number of uploaded bytes
+	unsigned long upload(TextureLoadRequest &request, unsigned long remainingBudget);
+
+	/// Deleted copy constructor
+	TextureUploadQueue(const TextureUploadQueue &) = delete;
+	/// Deleted assignment operator
+	TextureUploadQueue &operator=(const TextureUploadQueue &) = delete;
+};
+
+}
+
+#endif
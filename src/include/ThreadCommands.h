@@ -3,6 +3,7 @@
 
 #include "common_macros.h"
 #include "IThreadCommand.h"
+#include "ThreadSync.h"
 
 namespace ncine {
 
@@ -19,6 +20,96 @@ class DummyCommand : public IThreadCommand
 	unsigned int requestCode_;
 };
 
+/// A group of thread commands that a thread can wait on until the ones started by a worker thread have been executed
+/*! The waiting thread is expected to have done the work of the commands that no worker thread has started yet.
+ *  Those commands are cancelled, and a cancelled command that is executed later does nothing. */
+class CommandGroup
+{
+  public:
+	CommandGroup()
+	    : numPending_(0), numUnclaimed_(0) {}
+
+	/// Adds a number of commands to the pending ones
+	inline void add(unsigned int numCommands)
+	{
+		mutex_.lock();
+		numPending_ += numCommands;
+		numUnclaimed_ += numCommands;
+		mutex_.unlock();
+	}
+
+	/// Called by a command before executing, returns false if it has been cancelled
+	inline bool claim()
+	{
+		mutex_.lock();
+		const bool claimed = (numUnclaimed_ > 0);
+		if (claimed)
+			numUnclaimed_--;
+		mutex_.unlock();
+		return claimed;
+	}
+
+	/// Marks a pending command as executed
+	inline void done()
+	{
+		mutex_.lock();
+		ASSERT(numPending_ > 0);
+		numPending_--;
+		if (numPending_ == 0)
+			cond_.broadcast();
+		mutex_.unlock();
+	}
+
+	/// Cancels the commands that have not been claimed, then blocks the calling thread until the claimed ones have been executed
+	inline void wait()
+	{
+		mutex_.lock();
+		numPending_ -= numUnclaimed_;
+		numUnclaimed_ = 0;
+		while (numPending_ > 0)
+			cond_.wait(mutex_);
+		mutex_.unlock();
+	}
+
+  private:
+	unsigned int numPending_;
+	/// The number of pending commands that no worker thread has started yet
+	unsigned int numUnclaimed_;
+	Mutex mutex_;
+	CondVariable cond_;
+
+	/// Deleted copy constructor
+	CommandGroup(const CommandGroup &) = delete;
+	/// Deleted assignment operator
+	CommandGroup &operator=(const CommandGroup &) = delete;
+};
+
+/// A thread command that calls a function and then notifies its group
+class GroupFunctionCommand : public IThreadCommand
+{
+  public:
+	using FunctionPtr = void (*)(void *);
+
+	/// Creates a command for a group, the group should account for it with `CommandGroup::add()`
+	/*! \note The argument should outlive the command, as a cancelled command might still be in the queue of the thread pool */
+	GroupFunctionCommand(CommandGroup &group, FunctionPtr function, void *arg)
+	    : group_(group), function_(function), arg_(arg) {}
+
+	inline void execute() override
+	{
+		if (group_.claim())
+		{
+			function_(arg_);
+			group_.done();
+		}
+	}
+
+  private:
+	CommandGroup &group_;
+	FunctionPtr function_;
+	void *arg_;
+};
+
 }
 
 #endif
@@ -21,6 +21,8 @@ class ThreadPool : public IThreadPool
 
 	/// Enqueues a command request for a worker thread
 	void enqueueCommand(nctl::UniquePtr<IThreadCommand> threadCommand) override;
+	/// Returns the number of worker threads in the pool
+	inline unsigned int numThreads() const override { return numThreads_; }
 
   private:
 	struct ThreadStruct
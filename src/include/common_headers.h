@@ -17,7 +17,11 @@
 	#endif
 #endif
 
-#if defined(NCINE_INCLUDE_OPENAL)
+#if defined(WITH_SOFTWARE_AUDIO)
+	#if defined(NCINE_INCLUDE_OPENAL) || defined(NCINE_INCLUDE_OPENALC)
+		#include "SoftwareAL.h"
+	#endif
+#elif defined(NCINE_INCLUDE_OPENAL)
 	#ifdef __APPLE__
 		#include <OpenAL/al.h>
 	#else
@@ -25,7 +29,7 @@
 	#endif
 #endif
 
-#if defined(NCINE_INCLUDE_OPENALC)
+#if defined(NCINE_INCLUDE_OPENALC) && !defined(WITH_SOFTWARE_AUDIO)
 	#ifdef __APPLE__
 		#include <OpenAL/alc.h>
 		#include <OpenAL/al.h>
@@ -0,0 +1,25 @@
+#include "HeadlessInputManager.h"
+#include "JoyMapping.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+const int IInputManager::MaxNumJoysticks = 4;
+
+HeadlessMouseState HeadlessInputManager::mouseState_;
+HeadlessKeyboardState HeadlessInputManager::keyboardState_;
+HeadlessJoystickState HeadlessInputManager::nullJoystickState_;
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+HeadlessInputManager::HeadlessInputManager()
+{
+	joyMapping_.init(this);
+}
+
+}
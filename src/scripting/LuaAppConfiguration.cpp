@@ -30,12 +30,23 @@ namespace AppConfiguration {
 	static const char *windowIconFilename = "window_icon";
 
 	static const char *useBufferMapping = "buffer_mapping";
+	static const char *usePersistentMapping = "persistent_mapping";
+	static const char *useInstancedAttributes = "instanced_attributes";
 	static const char *deferShaderQueries = "defer_shader_queries";
+	static const char *useBinaryShaderCache = "binary_shader_cache";
+	static const char *useAsyncShaderCompilation = "async_shader_compilation";
 	static const char *fixedBatchSize = "fixed_batch_size";
 	static const char *vboSize = "vbo_size";
 	static const char *iboSize = "ibo_size";
 	static const char *vaoPoolSize = "vao_pool_size";
 	static const char *renderCommandPoolSize = "rendercommand_pool_size";
+	static const char *textureUploadBudget = "texture_upload_budget";
+	static const char *parallelUpdateDepth = "parallel_update_depth";
+	static const char *parallelVisitDepth = "parallel_visit_depth";
+	static const char *cullingGridCellSize = "culling_grid_cell_size";
+	static const char *useDirtyListUpdate = "dirty_list_update";
+	static const char *useParticleArrays = "particle_arrays";
+	static const char *useParallelParticlesUpdate = "parallel_particles_update";
 
 	static const char *withDebugOverlay = "debug_overlay";
 	static const char *withAudio = "audio";
@@ -66,7 +77,7 @@ void LuaAppConfiguration::exposeConstants(lua_State *L)
 
 void LuaAppConfiguration::push(lua_State *L, const AppConfiguration &appCfg)
 {
-	lua_createtable(L, 0, 33);
+	lua_createtable(L, 0, 41);
 
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::dataPath, appCfg.dataPath().data());
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::logFile, appCfg.logFile.data());
@@ -86,12 +97,23 @@ void LuaAppConfiguration::push(lua_State *L, const AppConfiguration &appCfg)
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::windowIconFilename, appCfg.windowIconFilename.data());
 
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::useBufferMapping, appCfg.useBufferMapping);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::usePersistentMapping, appCfg.usePersistentMapping);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::useInstancedAttributes, appCfg.useInstancedAttributes);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::deferShaderQueries, appCfg.deferShaderQueries);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::useBinaryShaderCache, appCfg.useBinaryShaderCache);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::useAsyncShaderCompilation, appCfg.useAsyncShaderCompilation);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::fixedBatchSize, appCfg.fixedBatchSize);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::vboSize, static_cast<int64_t>(appCfg.vboSize));
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::iboSize, static_cast<int64_t>(appCfg.iboSize));
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::vaoPoolSize, appCfg.vaoPoolSize);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::renderCommandPoolSize, appCfg.renderCommandPoolSize);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::textureUploadBudget, static_cast<int64_t>(appCfg.textureUploadBudget));
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::parallelUpdateDepth, appCfg.parallelUpdateDepth);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::parallelVisitDepth, appCfg.parallelVisitDepth);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::cullingGridCellSize, appCfg.cullingGridCellSize);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::useDirtyListUpdate, appCfg.useDirtyListUpdate);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::useParticleArrays, appCfg.useParticleArrays);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::useParallelParticlesUpdate, appCfg.useParallelParticlesUpdate);
 
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::withDebugOverlay, appCfg.withDebugOverlay);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::withAudio, appCfg.withAudio);
@@ -161,8 +183,16 @@ void LuaAppConfiguration::retrieveAndSet(lua_State *L, AppConfiguration &appCfg)
 
 	const bool useBufferMapping = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::useBufferMapping);
 	appCfg.useBufferMapping = useBufferMapping;
+	const bool usePersistentMapping = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::usePersistentMapping);
+	appCfg.usePersistentMapping = usePersistentMapping;
+	const bool useInstancedAttributes = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::useInstancedAttributes);
+	appCfg.useInstancedAttributes = useInstancedAttributes;
 	const bool deferShaderQueries = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::deferShaderQueries);
 	appCfg.deferShaderQueries = deferShaderQueries;
+	const bool useBinaryShaderCache = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::useBinaryShaderCache);
+	appCfg.useBinaryShaderCache = useBinaryShaderCache;
+	const bool useAsyncShaderCompilation = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::useAsyncShaderCompilation);
+	appCfg.useAsyncShaderCompilation = useAsyncShaderCompilation;
 	const unsigned int fixedBatchSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::AppConfiguration::fixedBatchSize);
 	appCfg.fixedBatchSize = fixedBatchSize;
 	const unsigned long vboSize = LuaUtils::retrieveField<uint64_t>(L, -1, LuaNames::AppConfiguration::vboSize);
@@ -173,6 +203,20 @@ void LuaAppConfiguration::retrieveAndSet(lua_State *L, AppConfiguration &appCfg)
 	appCfg.vaoPoolSize = vaoPoolSize;
 	const unsigned int renderCommandPoolSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::AppConfiguration::renderCommandPoolSize);
 	appCfg.renderCommandPoolSize = renderCommandPoolSize;
+	const unsigned long textureUploadBudget = LuaUtils::retrieveField<uint64_t>(L, -1, LuaNames::AppConfiguration::textureUploadBudget);
+	appCfg.textureUploadBudget = textureUploadBudget;
+	const unsigned int parallelUpdateDepth = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::AppConfiguration::parallelUpdateDepth);
+	appCfg.parallelUpdateDepth = parallelUpdateDepth;
+	const unsigned int parallelVisitDepth = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::AppConfiguration::parallelVisitDepth);
+	appCfg.parallelVisitDepth = parallelVisitDepth;
+	const float cullingGridCellSize = LuaUtils::retrieveField<float>(L, -1, LuaNames::AppConfiguration::cullingGridCellSize);
+	appCfg.cullingGridCellSize = cullingGridCellSize;
+	const bool useDirtyListUpdate = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::useDirtyListUpdate);
+	appCfg.useDirtyListUpdate = useDirtyListUpdate;
+	const bool useParticleArrays = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::useParticleArrays);
+	appCfg.useParticleArrays = useParticleArrays;
+	const bool useParallelParticlesUpdate = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::useParallelParticlesUpdate);
+	appCfg.useParallelParticlesUpdate = useParallelParticlesUpdate;
 
 	const bool withDebugOverlay = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::withDebugOverlay);
 	appCfg.withDebugOverlay = withDebugOverlay;
@@ -13,6 +13,9 @@ namespace AudioStreamPlayer {
 
 	static const char *numSamplesInStreamBuffer = "num_samples_in_streambuffer";
 	static const char *streamBufferSize = "streambuffer_size";
+	static const char *numStreamBuffers = "num_streambuffers";
+	static const char *hasBackgroundDecoding = "has_background_decoding";
+	static const char *setStreamBuffers = "set_streambuffers";
 	static const char *sampleOffsetInStream = "sample_offset_in_stream";
 }}
 
@@ -33,6 +36,9 @@ void LuaAudioStreamPlayer::expose(LuaStateManager *stateManager)
 
 	LuaUtils::addFunction(L, LuaNames::AudioStreamPlayer::numSamplesInStreamBuffer, numSamplesInStreamBuffer);
 	LuaUtils::addFunction(L, LuaNames::AudioStreamPlayer::streamBufferSize, streamBufferSize);
+	LuaUtils::addFunction(L, LuaNames::AudioStreamPlayer::numStreamBuffers, numStreamBuffers);
+	LuaUtils::addFunction(L, LuaNames::AudioStreamPlayer::hasBackgroundDecoding, hasBackgroundDecoding);
+	LuaUtils::addFunction(L, LuaNames::AudioStreamPlayer::setStreamBuffers, setStreamBuffers);
 	LuaUtils::addFunction(L, LuaNames::AudioStreamPlayer::sampleOffsetInStream, sampleOffsetInStream);
 
 	LuaIAudioPlayer::exposeFunctions(L);
@@ -83,6 +89,45 @@ int LuaAudioStreamPlayer::streamBufferSize(lua_State *L)
 	return 1;
 }
 
+int LuaAudioStreamPlayer::numStreamBuffers(lua_State *L)
+{
+	AudioStreamPlayer *audioStreamPlayer = LuaUntrackedUserData<AudioStreamPlayer>::retrieve(L, -1);
+
+	if (audioStreamPlayer)
+		LuaUtils::push(L, audioStreamPlayer->numStreamBuffers());
+	else
+		LuaUtils::pushNil(L);
+
+	return 1;
+}
+
+int LuaAudioStreamPlayer::hasBackgroundDecoding(lua_State *L)
+{
+	AudioStreamPlayer *audioStreamPlayer = LuaUntrackedUserData<AudioStreamPlayer>::retrieve(L, -1);
+
+	if (audioStreamPlayer)
+		LuaUtils::push(L, audioStreamPlayer->hasBackgroundDecoding());
+	else
+		LuaUtils::pushNil(L);
+
+	return 1;
+}
+
+int LuaAudioStreamPlayer::setStreamBuffers(lua_State *L)
+{
+	AudioStreamPlayer *audioStreamPlayer = LuaUntrackedUserData<AudioStreamPlayer>::retrieve(L, -4);
+	const unsigned int numBuffers = LuaUtils::retrieve<uint32_t>(L, -3);
+	const unsigned int bufferSize = LuaUtils::retrieve<uint32_t>(L, -2);
+	const bool backgroundDecoding = LuaUtils::retrieve<bool>(L, -1);
+
+	if (audioStreamPlayer)
+		LuaUtils::push(L, audioStreamPlayer->setStreamBuffers(numBuffers, bufferSize, backgroundDecoding));
+	else
+		LuaUtils::pushNil(L);
+
+	return 1;
+}
+
 int LuaAudioStreamPlayer::sampleOffsetInStream(lua_State *L)
 {
 	AudioStreamPlayer *audioStreamPlayer = LuaUntrackedUserData<AudioStreamPlayer>::retrieve(L, -1);
@@ -18,6 +18,7 @@ namespace IAudioDevice {
 
 	static const char *maxNumPlayers = "get_max_num_players";
 	static const char *numPlayers = "get_num_players";
+	static const char *numVirtualPlayers = "get_num_virtual_players";
 	static const char *player = "get_player";
 
 	static const char *pausePlayers = "pause_players";
@@ -33,7 +34,7 @@ namespace IAudioDevice {
 
 void LuaIAudioDevice::expose(lua_State *L)
 {
-	lua_createtable(L, 0, 9);
+	lua_createtable(L, 0, 10);
 
 	LuaUtils::addFunction(L, LuaNames::IAudioDevice::name, name);
 
@@ -42,6 +43,7 @@ void LuaIAudioDevice::expose(lua_State *L)
 
 	LuaUtils::addFunction(L, LuaNames::IAudioDevice::maxNumPlayers, maxNumPlayers);
 	LuaUtils::addFunction(L, LuaNames::IAudioDevice::numPlayers, numPlayers);
+	LuaUtils::addFunction(L, LuaNames::IAudioDevice::numVirtualPlayers, numVirtualPlayers);
 	LuaUtils::addFunction(L, LuaNames::IAudioDevice::player, player);
 
 	LuaUtils::addFunction(L, LuaNames::IAudioDevice::pausePlayers, pausePlayers);
@@ -93,6 +95,14 @@ int LuaIAudioDevice::numPlayers(lua_State *L)
 	return 1;
 }
 
+int LuaIAudioDevice::numVirtualPlayers(lua_State *L)
+{
+	const unsigned int numVirtualPlayers = theServiceLocator().audioDevice().numVirtualPlayers();
+	LuaUtils::push(L, numVirtualPlayers);
+
+	return 1;
+}
+
 int LuaIAudioDevice::player(lua_State *L)
 {
 	const int unsigned index = LuaUtils::retrieve<uint32_t>(L, -1);
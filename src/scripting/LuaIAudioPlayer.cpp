@@ -30,6 +30,7 @@ namespace IAudioPlayer {
 	static const char *isPlaying = "is_playing";
 	static const char *isPaused = "is_paused";
 	static const char *isStopped = "is_stopped";
+	static const char *isVirtual = "is_virtual";
 
 	static const char *isLooping = "is_looping";
 	static const char *setLooping = "set_looping";
@@ -40,6 +41,10 @@ namespace IAudioPlayer {
 	static const char *setPitch = "set_pitch";
 	static const char *position = "get_position";
 	static const char *setPosition = "set_position";
+
+	static const char *priority = "get_priority";
+	static const char *setPriority = "set_priority";
+	static const char *audibility = "get_audibility";
 }}
 
 ///////////////////////////////////////////////////////////
@@ -70,6 +75,7 @@ void LuaIAudioPlayer::exposeFunctions(lua_State *L)
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::isPlaying, isPlaying);
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::isPaused, isPaused);
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::isStopped, isStopped);
+	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::isVirtual, isVirtual);
 
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::isLooping, isLooping);
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::setLooping, setLooping);
@@ -80,6 +86,10 @@ void LuaIAudioPlayer::exposeFunctions(lua_State *L)
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::setPitch, setPitch);
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::position, position);
 	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::setPosition, setPosition);
+
+	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::priority, priority);
+	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::setPriority, setPriority);
+	LuaUtils::addFunction(L, LuaNames::IAudioPlayer::audibility, audibility);
 }
 
 int LuaIAudioPlayer::sourceId(lua_State *L)
@@ -267,6 +277,18 @@ int LuaIAudioPlayer::isStopped(lua_State *L)
 	return 1;
 }
 
+int LuaIAudioPlayer::isVirtual(lua_State *L)
+{
+	IAudioPlayer *audioPlayer = LuaUntrackedUserData<IAudioPlayer>::retrieve(L, -1);
+
+	if (audioPlayer)
+		LuaUtils::push(L, audioPlayer->isVirtual());
+	else
+		LuaUtils::pushNil(L);
+
+	return 1;
+}
+
 int LuaIAudioPlayer::isLooping(lua_State *L)
 {
 	IAudioPlayer *audioPlayer = LuaUntrackedUserData<IAudioPlayer>::retrieve(L, -1);
@@ -360,4 +382,39 @@ int LuaIAudioPlayer::setPosition(lua_State *L)
 	return 0;
 }
 
+int LuaIAudioPlayer::priority(lua_State *L)
+{
+	IAudioPlayer *audioPlayer = LuaUntrackedUserData<IAudioPlayer>::retrieve(L, -1);
+
+	if (audioPlayer)
+		LuaUtils::push(L, audioPlayer->priority());
+	else
+		LuaUtils::pushNil(L);
+
+	return 1;
+}
+
+int LuaIAudioPlayer::setPriority(lua_State *L)
+{
+	IAudioPlayer *audioPlayer = LuaUntrackedUserData<IAudioPlayer>::retrieve(L, -2);
+	const int priority = LuaUtils::retrieve<int>(L, -1);
+
+	if (audioPlayer)
+		audioPlayer->setPriority(priority);
+
+	return 0;
+}
+
+int LuaIAudioPlayer::audibility(lua_State *L)
+{
+	IAudioPlayer *audioPlayer = LuaUntrackedUserData<IAudioPlayer>::retrieve(L, -1);
+
+	if (audioPlayer)
+		LuaUtils::push(L, audioPlayer->audibility());
+	else
+		LuaUtils::pushNil(L);
+
+	return 1;
+}
+
 }
@@ -37,6 +37,12 @@ namespace ParticleAffector {
 	static const char *addRotationStep = "add_rotation_step";
 	static const char *addPositionStep = "add_position_step";
 	static const char *addVelocityStep = "add_velocity_step";
+
+	static const char *setColorStep = "set_color_step";
+	static const char *setSizeStep = "set_size_step";
+	static const char *setRotationStep = "set_rotation_step";
+	static const char *setPositionStep = "set_position_step";
+	static const char *setVelocityStep = "set_velocity_step";
 }}
 
 ///////////////////////////////////////////////////////////
@@ -68,6 +74,12 @@ void LuaParticleAffector::expose(LuaStateManager *stateManager)
 	LuaUtils::addFunction(L, LuaNames::ParticleAffector::addPositionStep, addPositionStep);
 	LuaUtils::addFunction(L, LuaNames::ParticleAffector::addVelocityStep, addVelocityStep);
 
+	LuaUtils::addFunction(L, LuaNames::ParticleAffector::setColorStep, setColorStep);
+	LuaUtils::addFunction(L, LuaNames::ParticleAffector::setSizeStep, setSizeStep);
+	LuaUtils::addFunction(L, LuaNames::ParticleAffector::setRotationStep, setRotationStep);
+	LuaUtils::addFunction(L, LuaNames::ParticleAffector::setPositionStep, setPositionStep);
+	LuaUtils::addFunction(L, LuaNames::ParticleAffector::setVelocityStep, setVelocityStep);
+
 	lua_setfield(L, -2, LuaNames::ParticleAffector::ParticleAffector);
 }
 
@@ -429,4 +441,88 @@ int LuaParticleAffector::addVelocityStep(lua_State *L)
 	return 0;
 }
 
+int LuaParticleAffector::setColorStep(lua_State *L)
+{
+	int colorIndex = 0;
+	const Colorf color = LuaColorUtils::retrieve(L, -1, colorIndex);
+	ParticleAffector *affector = LuaUntrackedUserData<ParticleAffector>::retrieve(L, colorIndex - 3);
+	const unsigned int index = LuaUtils::retrieve<uint32_t>(L, colorIndex - 2);
+	const float age = LuaUtils::retrieve<float>(L, colorIndex - 1);
+
+	if (affector && affector->type() == ParticleAffector::Type::COLOR)
+	{
+		ColorAffector *colorAffector = static_cast<ColorAffector *>(affector);
+		colorAffector->setColorStep(index, age, color);
+	}
+
+	return 0;
+}
+
+int LuaParticleAffector::setSizeStep(lua_State *L)
+{
+	int vectorIndex = 0;
+	const Vector2f scale = LuaVector2fUtils::retrieve(L, -1, vectorIndex);
+	ParticleAffector *affector = LuaUntrackedUserData<ParticleAffector>::retrieve(L, vectorIndex - 3);
+	const unsigned int index = LuaUtils::retrieve<uint32_t>(L, vectorIndex - 2);
+	const float age = LuaUtils::retrieve<float>(L, vectorIndex - 1);
+
+	if (affector && affector->type() == ParticleAffector::Type::SIZE)
+	{
+		SizeAffector *sizeAffector = static_cast<SizeAffector *>(affector);
+		sizeAffector->setSizeStep(index, age, scale);
+	}
+
+	return 0;
+}
+
+int LuaParticleAffector::setRotationStep(lua_State *L)
+{
+	ParticleAffector *affector = LuaUntrackedUserData<ParticleAffector>::retrieve(L, -4);
+	const unsigned int index = LuaUtils::retrieve<uint32_t>(L, -3);
+	const float age = LuaUtils::retrieve<float>(L, -2);
+	const float angle = LuaUtils::retrieve<float>(L, -1);
+
+	if (affector && affector->type() == ParticleAffector::Type::ROTATION)
+	{
+		RotationAffector *rotationAffector = static_cast<RotationAffector *>(affector);
+		rotationAffector->setRotationStep(index, age, angle);
+	}
+
+	return 0;
+}
+
+int LuaParticleAffector::setPositionStep(lua_State *L)
+{
+	int vectorIndex = 0;
+	const Vector2f position = LuaVector2fUtils::retrieve(L, -1, vectorIndex);
+	ParticleAffector *affector = LuaUntrackedUserData<ParticleAffector>::retrieve(L, vectorIndex - 3);
+	const unsigned int index = LuaUtils::retrieve<uint32_t>(L, vectorIndex - 2);
+	const float age = LuaUtils::retrieve<float>(L, vectorIndex - 1);
+
+	if (affector && affector->type() == ParticleAffector::Type::POSITION)
+	{
+		PositionAffector *positionAffector = static_cast<PositionAffector *>(affector);
+		positionAffector->setPositionStep(index, age, position);
+	}
+
+	return 0;
+}
+
+int LuaParticleAffector::setVelocityStep(lua_State *L)
+{
+	int vectorIndex = 0;
+	const Vector2f velocity = LuaVector2fUtils::retrieve(L, -1, vectorIndex);
+	ParticleAffector *affector = LuaUntrackedUserData<ParticleAffector>::retrieve(L, vectorIndex - 3);
+	const unsigned int index = LuaUtils::retrieve<uint32_t>(L, vectorIndex - 2);
+	const float age = LuaUtils::retrieve<float>(L, vectorIndex - 1);
+
+	if (affector && affector->type() == ParticleAffector::Type::VELOCITY)
+	{
+		VelocityAffector *velocityAffector = static_cast<VelocityAffector *>(affector);
+		velocityAffector->setVelocityStep(index, age, velocity);
+	}
+
+	return 0;
+}
+
 }
\ No newline at end of file
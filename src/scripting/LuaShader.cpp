@@ -46,6 +46,7 @@ namespace Shader {
 	static const char *setAttribute = "set_attribute";
 
 	static const char *isLinked = "is_linked";
+	static const char *isLinking = "is_linking";
 
 	static const char *retrieveInfoLogLength = "retrieve_infolog_length";
 	static const char *retrieveInfoLog = "retrieve_infolog";
@@ -121,6 +122,7 @@ void LuaShader::expose(LuaStateManager *stateManager)
 	LuaUtils::addFunction(L, LuaNames::Shader::setAttribute, setAttribute);
 
 	LuaUtils::addFunction(L, LuaNames::Shader::isLinked, isLinked);
+	LuaUtils::addFunction(L, LuaNames::Shader::isLinking, isLinking);
 
 	LuaUtils::addFunction(L, LuaNames::Shader::retrieveInfoLogLength, retrieveInfoLogLength);
 	LuaUtils::addFunction(L, LuaNames::Shader::retrieveInfoLog, retrieveInfoLog);
@@ -261,6 +263,18 @@ int LuaShader::isLinked(lua_State *L)
 	return 1;
 }
 
+int LuaShader::isLinking(lua_State *L)
+{
+	Shader *shader = LuaUntrackedUserData<Shader>::retrieve(L, -1);
+
+	if (shader)
+		LuaUtils::push(L, shader->isLinking());
+	else
+		LuaUtils::pushNil(L);
+
+	return 1;
+}
+
 int LuaShader::retrieveInfoLogLength(lua_State *L)
 {
 	Shader *shader = LuaUntrackedUserData<Shader>::retrieve(L, -1);
@@ -0,0 +1,25 @@
+uniform mat4 uProjectionMatrix;
+uniform mat4 uViewMatrix;
+
+in vec4 aModelMatrix0;
+in vec4 aModelMatrix1;
+in vec4 aModelMatrix2;
+in vec4 aModelMatrix3;
+in vec4 aInstanceColor;
+in vec4 aInstanceTexRect;
+in vec2 aInstanceSpriteSize;
+
+out vec2 vTexCoords;
+out vec4 vColor;
+
+void main()
+{
+	vec2 aPosition = vec2(0.5 - float(gl_VertexID >> 1), -0.5 + float(gl_VertexID % 2));
+	vec2 aTexCoords = vec2(1.0 - float(gl_VertexID >> 1), 1.0 - float(gl_VertexID % 2));
+	vec4 position = vec4(aPosition.x * aInstanceSpriteSize.x, aPosition.y * aInstanceSpriteSize.y, 0.0, 1.0);
+	mat4 modelMatrix = mat4(aModelMatrix0, aModelMatrix1, aModelMatrix2, aModelMatrix3);
+
+	gl_Position = uProjectionMatrix * uViewMatrix * modelMatrix * position;
+	vTexCoords = vec2(aTexCoords.x * aInstanceTexRect.x + aInstanceTexRect.y, aTexCoords.y * aInstanceTexRect.z + aInstanceTexRect.w);
+	vColor = aInstanceColor;
+}
@@ -0,0 +1,35 @@
+uniform mat4 uProjectionMatrix;
+uniform mat4 uViewMatrix;
+
+layout (std140) uniform InstanceBlock
+{
+	mat4 modelMatrix;
+	vec4 color;
+	vec4 texRect;
+	vec2 spriteSize;
+	vec2 anchorPoint;
+};
+
+in vec2 aParticlePosition;
+in vec2 aParticleScale;
+in float aParticleRotation;
+in vec4 aParticleColor;
+
+out vec2 vTexCoords;
+out vec4 vColor;
+
+void main()
+{
+	vec2 aPosition = vec2(0.5 - float(gl_VertexID >> 1), -0.5 + float(gl_VertexID % 2));
+	vec2 aTexCoords = vec2(1.0 - float(gl_VertexID >> 1), 1.0 - float(gl_VertexID % 2));
+	vec2 corner = (aPosition * spriteSize - anchorPoint) * aParticleScale;
+
+	float angle = radians(aParticleRotation);
+	float c = cos(angle);
+	float s = sin(angle);
+	vec4 position = vec4(c * corner.x - s * corner.y + aParticlePosition.x, s * corner.x + c * corner.y + aParticlePosition.y, 0.0, 1.0);
+
+	gl_Position = uProjectionMatrix * uViewMatrix * modelMatrix * position;
+	vTexCoords = vec2(aTexCoords.x * texRect.x + texRect.y, aTexCoords.y * texRect.z + texRect.w);
+	vColor = aParticleColor * color;
+}
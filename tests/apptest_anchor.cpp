@@ -400,7 +400,7 @@ void MyEventHandler::onFrameStart()
 			particleSystems_[i]->setAnchorPoint(anchorPoint_);
 			particleSystems_[i]->setPositionX(positionX);
 			particleSystems_[i]->setPositionY(position_.y + (height * 0.5f));
-			rotationAffectors_[i]->steps()[1].angle = angle_;
+			rotationAffectors_[i]->setRotationStep(1, rotationAffectors_[i]->steps()[1].age, angle_);
 			sizeAffectors_[i]->setBaseScale(scale_);
 			particleSystems_[i]->setFlippedX(flippedX_);
 			particleSystems_[i]->setFlippedY(flippedY_);
@@ -79,6 +79,7 @@ uint8_t randomBuffer[randomBufferLength];
 nctl::String auxString(256);
 int selectedTextureObject = -1;
 int selectedTexture = -1;
+bool textureWasLoading[MyEventHandler::NumTextures];
 nc::Colorf texelsColor;
 nc::Recti texelsRegion;
 nctl::String saveTexelsFilename(256);
@@ -110,6 +111,19 @@ const char *audioPlayerStateToString(nc::IAudioPlayer::PlayerState state)
 	return "Unknown";
 }
 
+const char *textureLoadingStateToString(nc::Texture::LoadingState state)
+{
+	switch (state)
+	{
+		case nc::Texture::LoadingState::READY: return "Ready";
+		case nc::Texture::LoadingState::DECODING: return "Decoding";
+		case nc::Texture::LoadingState::UPLOADING: return "Uploading";
+		case nc::Texture::LoadingState::FAILED: return "Failed";
+	}
+
+	return "Unknown";
+}
+
 }
 
 nctl::UniquePtr<nc::IAppEventHandler> createAppEventHandler()
@@ -120,6 +134,8 @@ nctl::UniquePtr<nc::IAppEventHandler> createAppEventHandler()
 void MyEventHandler::onPreInit(nc::AppConfiguration &config)
 {
 	setDataPath(config);
+	// Textures are decoded by worker threads while the loading screen keeps animating
+	config.withThreads = true;
 }
 
 void MyEventHandler::onInit()
@@ -177,7 +193,11 @@ void MyEventHandler::onInit()
 	shader_ = nctl::makeUnique<nc::Shader>();
 #else
 	for (unsigned int i = 0; i < NumTextures; i++)
-		textures_.pushBack(nctl::makeUnique<nc::Texture>((prefixDataPath("textures", TextureFiles[i])).data()));
+	{
+		textures_.pushBack(nctl::makeUnique<nc::Texture>());
+		textures_[i]->loadFromFileAsync((prefixDataPath("textures", TextureFiles[i])).data());
+		textureWasLoading[i] = true;
+	}
 	audioBuffer_ = nctl::makeUnique<nc::AudioBuffer>((prefixDataPath("sounds", SoundFiles[0])).data());
 	streamPlayer_ = nctl::makeUnique<nc::AudioStreamPlayer>((prefixDataPath("sounds", SoundFiles[3])).data());
 	font_ = nctl::makeUnique<nc::Font>((prefixDataPath("fonts", FontFiles[0])).data());
@@ -225,6 +245,14 @@ void MyEventHandler::onInit()
 
 void MyEventHandler::onFrameStart()
 {
+	for (unsigned int i = 0; i < NumTextures; i++)
+	{
+		// Sprites are updated with the size of their texture once it has been loaded asynchronously
+		if (textureWasLoading[i] && textures_[i]->isLoading() == false)
+			refreshSprites(*textures_[i]);
+		textureWasLoading[i] = textures_[i]->isLoading();
+	}
+
 	ImGui::SetNextWindowSize(ImVec2(500.0f, 500.0f), ImGuiCond_FirstUseEver);
 	ImGui::SetNextWindowPos(ImVec2(20.0f, 20.0f), ImGuiCond_FirstUseEver);
 	if (showImGui)
@@ -256,6 +284,7 @@ void MyEventHandler::onFrameStart()
 					nc::Texture &tex = *textures_[selectedTextureObject];
 					ImGui::Text("Name: \"%s\"", tex.name());
 					ImGui::Text("Size: %d x %d, Channels: %u", tex.width(), tex.height(), tex.numChannels());
+					ImGui::Text("Loading state: %s", textureLoadingStateToString(tex.loadingState()));
 
 					if (ImGui::TreeNode("Load from File or Memory##Textures"))
 					{
@@ -276,6 +305,12 @@ void MyEventHandler::onFrameStart()
 							textureHasChanged = hasLoaded;
 						}
 						ImGui::SameLine();
+						if (ImGui::Button("Load Asynchronously") && selectedTexture >= 0 && selectedTexture < NumTextures)
+						{
+							tex.loadFromFileAsync((prefixDataPath("textures", TextureFiles[selectedTexture])).data());
+							textureWasLoading[selectedTextureObject] = true;
+						}
+						ImGui::SameLine();
 						if (ImGui::Button("Load from Memory") && selectedTexture >= 0 && selectedTexture < NumTextures)
 						{
 							const bool hasLoaded = tex.loadFromMemory(TextureFiles[selectedTexture],
@@ -429,11 +464,7 @@ void MyEventHandler::onFrameStart()
 					if (textureHasChanged)
 					{
 						texelsRegion.set(0, 0, tex.width(), tex.height());
-						for (unsigned int i = 0; i < NumSprites; i++)
-						{
-							if (sprites_[i]->texture() == &tex)
-								sprites_[i]->setTexture(&tex);
-						}
+						refreshSprites(tex);
 					}
 				}
 				else
@@ -764,6 +795,15 @@ void MyEventHandler::onFrameStart()
 	}
 }
 
+void MyEventHandler::refreshSprites(nc::Texture &texture)
+{
+	for (unsigned int i = 0; i < NumSprites; i++)
+	{
+		if (sprites_[i]->texture() == &texture)
+			sprites_[i]->setTexture(&texture);
+	}
+}
+
 void MyEventHandler::onKeyReleased(const nc::KeyboardEvent &event)
 {
 	if (event.mod & nc::KeyMod::CTRL && event.sym == nc::KeySym::H)
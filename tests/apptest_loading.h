@@ -56,6 +56,9 @@ class MyEventHandler :
 	nctl::UniquePtr<nc::LuaStateManager> luaState_;
 
 	nctl::UniquePtr<nc::Shader> shader_;
+
+	/// Updates the sprites using a texture after its contents have changed
+	void refreshSprites(nc::Texture &texture);
 };
 
 #endif
@@ -139,25 +139,33 @@ void MyEventHandler::onFrameStart()
 							colorAffector->setEnabled(enabled);
 
 							int removeIndex = -1;
-							for (unsigned int i = 0; i < colorAffector->steps().size(); i++)
+							int changedIndex = -1;
+							nc::ColorAffector::ColorStep changedStep;
+							for (unsigned int i = 0; i < colorAffector->numSteps(); i++)
 							{
-								nc::ColorAffector::ColorStep &step = colorAffector->steps()[i];
+								nc::ColorAffector::ColorStep step = colorAffector->steps()[i];
 
-								ImGui::PushID(&step);
-								ImGui::SliderFloat("Age", &step.age, 0.0f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
-								ImGui::ColorEdit3("Color", step.color.data());
+								ImGui::PushID(static_cast<int>(i));
+								bool hasChanged = ImGui::SliderFloat("Age", &step.age, 0.0f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+								hasChanged |= ImGui::ColorEdit3("Color", step.color.data());
 								ImGui::SameLine();
 								if (ImGui::Button("[-]"))
 									removeIndex = i;
 								ImGui::PopID();
 								ImGui::Dummy(ImVec2(0.0f, ImGui::GetTextLineHeightWithSpacing() * LineHeightSpacing));
 
-								if (i < colorAffector->steps().size() - 1 && step.age > colorAffector->steps()[i + 1].age)
-									nctl::swap(step.age, colorAffector->steps()[i + 1].age);
+								if (hasChanged)
+								{
+									changedIndex = i;
+									changedStep = step;
+								}
 							}
 
+							// Setting a step might change its position, it is done after iterating
 							if (removeIndex >= 0)
-								colorAffector->steps().removeAt(removeIndex);
+								colorAffector->removeStep(removeIndex);
+							else if (changedIndex >= 0)
+								colorAffector->setColorStep(changedIndex, changedStep);
 
 							ImGui::Separator();
 							static nc::ColorAffector::ColorStep newStep;
@@ -187,25 +195,33 @@ void MyEventHandler::onFrameStart()
 								sizeAffector->setBaseScale(baseScale);
 							ImGui::Dummy(ImVec2(0.0f, ImGui::GetTextLineHeightWithSpacing() * LineHeightSpacing));
 
-							for (unsigned int i = 0; i < sizeAffector->steps().size(); i++)
+							int changedIndex = -1;
+							nc::SizeAffector::SizeStep changedStep;
+							for (unsigned int i = 0; i < sizeAffector->numSteps(); i++)
 							{
-								nc::SizeAffector::SizeStep &step = sizeAffector->steps()[i];
+								nc::SizeAffector::SizeStep step = sizeAffector->steps()[i];
 
-								ImGui::PushID(&step);
-								ImGui::SliderFloat("Age", &step.age, 0.0f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
-								ImGui::SliderFloat2("Scale", step.scale.data(), 0.0f, 2.0f, "%.2f");
+								ImGui::PushID(static_cast<int>(i));
+								bool hasChanged = ImGui::SliderFloat("Age", &step.age, 0.0f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+								hasChanged |= ImGui::SliderFloat2("Scale", step.scale.data(), 0.0f, 2.0f, "%.2f");
 								ImGui::SameLine();
 								if (ImGui::Button("[-]"))
 									removeIndex = i;
 								ImGui::PopID();
 								ImGui::Dummy(ImVec2(0.0f, ImGui::GetTextLineHeightWithSpacing() * LineHeightSpacing));
 
-								if (i < sizeAffector->steps().size() - 1 && step.age > sizeAffector->steps()[i + 1].age)
-									nctl::swap(step.age, sizeAffector->steps()[i + 1].age);
+								if (hasChanged)
+								{
+									changedIndex = i;
+									changedStep = step;
+								}
 							}
 
+							// Setting a step might change its position, it is done after iterating
 							if (removeIndex >= 0)
-								sizeAffector->steps().removeAt(removeIndex);
+								sizeAffector->removeStep(removeIndex);
+							else if (changedIndex >= 0)
+								sizeAffector->setSizeStep(changedIndex, changedStep);
 
 							ImGui::Separator();
 							static nc::SizeAffector::SizeStep newStep;
@@ -230,25 +246,33 @@ void MyEventHandler::onFrameStart()
 							rotationAffector->setEnabled(enabled);
 
 							int removeIndex = -1;
-							for (unsigned int i = 0; i < rotationAffector->steps().size(); i++)
+							int changedIndex = -1;
+							nc::RotationAffector::RotationStep changedStep;
+							for (unsigned int i = 0; i < rotationAffector->numSteps(); i++)
 							{
-								nc::RotationAffector::RotationStep &step = rotationAffector->steps()[i];
+								nc::RotationAffector::RotationStep step = rotationAffector->steps()[i];
 
-								ImGui::PushID(&step);
-								ImGui::SliderFloat("Age", &step.age, 0.0f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
-								ImGui::SliderFloat("Angle", &step.angle, 0.0f, 360.0f, "%.2f");
+								ImGui::PushID(static_cast<int>(i));
+								bool hasChanged = ImGui::SliderFloat("Age", &step.age, 0.0f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+								hasChanged |= ImGui::SliderFloat("Angle", &step.angle, 0.0f, 360.0f, "%.2f");
 								ImGui::SameLine();
 								if (ImGui::Button("[-]"))
 									removeIndex = i;
 								ImGui::PopID();
 								ImGui::Dummy(ImVec2(0.0f, ImGui::GetTextLineHeightWithSpacing() * LineHeightSpacing));
 
-								if (i < rotationAffector->steps().size() - 1 && step.age > rotationAffector->steps()[i + 1].age)
-									nctl::swap(step.age, rotationAffector->steps()[i + 1].age);
+								if (hasChanged)
+								{
+									changedIndex = i;
+									changedStep = step;
+								}
 							}
 
+							// Setting a step might change its position, it is done after iterating
 							if (removeIndex >= 0)
-								rotationAffector->steps().removeAt(removeIndex);
+								rotationAffector->removeStep(removeIndex);
+							else if (changedIndex >= 0)
+								rotationAffector->setRotationStep(changedIndex, changedStep);
 
 							ImGui::Separator();
 							static nc::RotationAffector::RotationStep newStep;
@@ -273,25 +297,33 @@ void MyEventHandler::onFrameStart()
 							positionAffector->setEnabled(enabled);
 
 							int removeIndex = -1;
-							for (unsigned int i = 0; i < positionAffector->steps().size(); i++)
+							int changedIndex = -1;
+							nc::PositionAffector::PositionStep changedStep;
+							for (unsigned int i = 0; i < positionAffector->numSteps(); i++)
 							{
-								nc::PositionAffector::PositionStep &step = positionAffector->steps()[i];
+								nc::PositionAffector::PositionStep step = positionAffector->steps()[i];
 
-								ImGui::PushID(&step);
-								ImGui::SliderFloat("Age", &step.age, 0.0f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
-								ImGui::InputFloat2("Position", step.position.data(), "%.2f");
+								ImGui::PushID(static_cast<int>(i));
+								bool hasChanged = ImGui::SliderFloat("Age", &step.age, 0.0f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+								hasChanged |= ImGui::InputFloat2("Position", step.position.data(), "%.2f");
 								ImGui::SameLine();
 								if (ImGui::Button("[-]"))
 									removeIndex = i;
 								ImGui::PopID();
 								ImGui::Dummy(ImVec2(0.0f, ImGui::GetTextLineHeightWithSpacing() * LineHeightSpacing));
 
-								if (i < positionAffector->steps().size() - 1 && step.age > positionAffector->steps()[i + 1].age)
-									nctl::swap(step.age, positionAffector->steps()[i + 1].age);
+								if (hasChanged)
+								{
+									changedIndex = i;
+									changedStep = step;
+								}
 							}
 
+							// Setting a step might change its position, it is done after iterating
 							if (removeIndex >= 0)
-								positionAffector->steps().removeAt(removeIndex);
+								positionAffector->removeStep(removeIndex);
+							else if (changedIndex >= 0)
+								positionAffector->setPositionStep(changedIndex, changedStep);
 
 							ImGui::Separator();
 							static nc::PositionAffector::PositionStep newStep;
@@ -316,25 +348,33 @@ void MyEventHandler::onFrameStart()
 							velocityAffector->setEnabled(enabled);
 
 							int removeIndex = -1;
-							for (unsigned int i = 0; i < velocityAffector->steps().size(); i++)
+							int changedIndex = -1;
+							nc::VelocityAffector::VelocityStep changedStep;
+							for (unsigned int i = 0; i < velocityAffector->numSteps(); i++)
 							{
-								nc::VelocityAffector::VelocityStep &step = velocityAffector->steps()[i];
+								nc::VelocityAffector::VelocityStep step = velocityAffector->steps()[i];
 
-								ImGui::PushID(&step);
-								ImGui::SliderFloat("Age", &step.age, 0.0f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
-								ImGui::InputFloat2("Velocity", step.velocity.data(), "%.2f");
+								ImGui::PushID(static_cast<int>(i));
+								bool hasChanged = ImGui::SliderFloat("Age", &step.age, 0.0f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+								hasChanged |= ImGui::InputFloat2("Velocity", step.velocity.data(), "%.2f");
 								ImGui::SameLine();
 								if (ImGui::Button("[-]"))
 									removeIndex = i;
 								ImGui::PopID();
 								ImGui::Dummy(ImVec2(0.0f, ImGui::GetTextLineHeightWithSpacing() * LineHeightSpacing));
 
-								if (i < velocityAffector->steps().size() - 1 && step.age > velocityAffector->steps()[i + 1].age)
-									nctl::swap(step.age, velocityAffector->steps()[i + 1].age);
+								if (hasChanged)
+								{
+									changedIndex = i;
+									changedStep = step;
+								}
 							}
 
+							// Setting a step might change its position, it is done after iterating
 							if (removeIndex >= 0)
-								velocityAffector->steps().removeAt(removeIndex);
+								velocityAffector->removeStep(removeIndex);
+							else if (changedIndex >= 0)
+								velocityAffector->setVelocityStep(changedIndex, changedStep);
 
 							ImGui::Separator();
 							static nc::VelocityAffector::VelocityStep newStep;
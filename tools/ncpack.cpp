@@ -0,0 +1,61 @@
+#include <cstdio>
+#include <cstring>
+#include <ncine/FileSystem.h>
+#include <ncine/PackArchive.h>
+
+namespace nc = ncine;
+
+namespace {
+
+void printUsage(const char *programName)
+{
+	printf("Usage: %s [-c] <directory> <archive.%s>\n", programName, nc::PackArchive::Extension);
+	printf("Packs all the files inside a directory and its subdirectories into an archive to mount with `PackArchive::mount()`\n\n");
+	printf("  -c  Compress the files with LZ4, those that do not get smaller are stored as they are\n");
+}
+
+}
+
+/// Packs a directory of assets into an archive
+int main(int argc, char **argv)
+{
+	bool compress = false;
+	const char *directory = nullptr;
+	const char *archive = nullptr;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-c") == 0)
+			compress = true;
+		else if (directory == nullptr)
+			directory = argv[i];
+		else if (archive == nullptr)
+			archive = argv[i];
+		else
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (directory == nullptr || archive == nullptr)
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	if (nc::FileSystem::isDirectory(directory) == false)
+	{
+		fprintf(stderr, "\"%s\" is not a directory\n", directory);
+		return 1;
+	}
+
+	if (nc::PackArchive::build(directory, archive, compress) == false)
+	{
+		fprintf(stderr, "Cannot write the archive \"%s\"\n", archive);
+		return 1;
+	}
+
+	printf("Archive \"%s\" written, %ld bytes\n", archive, nc::FileSystem::fileSize(archive));
+	return 0;
+}
@@ -335,6 +335,41 @@ TEST_F(ArrayAlgorithmsTest, Sort)
 	ASSERT_EQ(isSorted(array_), true);
 }
 
+TEST_F(ArrayAlgorithmsTest, RadixSort)
+{
+	printf("Filling the array with random numbers\n");
+	array_.clear();
+	initArrayRandom(array_);
+	printArray(array_);
+
+	printf("Radix sorting the array\n");
+	nctl::Array<int> scratch(Capacity);
+	scratch.setSize(array_.size());
+	nctl::radixSort(array_.data(), array_.data() + array_.size(), scratch.data(), [](int value) { return static_cast<uint32_t>(value); });
+	printArray(array_);
+	const bool sorted = nctl::isSorted(array_.begin(), array_.end());
+	printf("The array is %s\n", sorted ? "sorted" : "not sorted");
+
+	ASSERT_EQ(sorted, true);
+	ASSERT_EQ(isSorted(array_), true);
+}
+
+TEST_F(ArrayAlgorithmsTest, RadixSortStable)
+{
+	printf("Radix sorting the array on the value parity\n");
+	nctl::Array<int> scratch(Capacity);
+	scratch.setSize(array_.size());
+	nctl::radixSort(array_.data(), array_.data() + array_.size(), scratch.data(), [](int value) { return static_cast<uint8_t>(value % 2); });
+	printArray(array_);
+
+	ASSERT_EQ(array_.size(), Capacity);
+	for (unsigned int i = 0; i < Capacity / 2; i++)
+	{
+		ASSERT_EQ(array_[i], i * 2);
+		ASSERT_EQ(array_[i + Capacity / 2], i * 2 + 1);
+	}
+}
+
 TEST_F(ArrayAlgorithmsTest, SortedUntil)
 {
 	const unsigned int position = 5;
@@ -0,0 +1,142 @@
+#include <cstring>
+#include "AudioRingBuffer.h"
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const unsigned int NumBlocks = 4;
+const unsigned int BlockSize = 16;
+
+/// Writes a block filled with the value, returns false if the ring is full
+bool writeValue(nc::AudioRingBuffer &ringBuffer, unsigned char value)
+{
+	char *block = ringBuffer.writeBlock();
+	if (block == nullptr)
+		return false;
+
+	memset(block, value, BlockSize);
+	nc::AudioRingBuffer::BlockInfo info;
+	info.numBytes = value;
+	ringBuffer.commitWrite(info);
+	return true;
+}
+
+/// Reads a block and checks that it is filled with the value, returns false if the ring is empty
+bool readValue(nc::AudioRingBuffer &ringBuffer, unsigned char value)
+{
+	nc::AudioRingBuffer::BlockInfo info;
+	const char *block = ringBuffer.readBlock(info);
+	if (block == nullptr)
+		return false;
+
+	EXPECT_EQ(info.numBytes, value);
+	for (unsigned int i = 0; i < BlockSize; i++)
+		EXPECT_EQ(static_cast<unsigned char>(block[i]), value);
+	ringBuffer.commitRead();
+	return true;
+}
+
+class AudioRingBufferTest : public ::testing::Test
+{
+  public:
+	AudioRingBufferTest()
+	    : ringBuffer_(NumBlocks, BlockSize) {}
+
+  protected:
+	nc::AudioRingBuffer ringBuffer_;
+};
+
+TEST_F(AudioRingBufferTest, Empty)
+{
+	printf("Reading from an empty ring buffer\n");
+	nc::AudioRingBuffer::BlockInfo info;
+	ASSERT_EQ(ringBuffer_.numBlocks(), NumBlocks);
+	ASSERT_EQ(ringBuffer_.blockSize(), BlockSize);
+	ASSERT_EQ(ringBuffer_.numReadableBlocks(), 0u);
+	ASSERT_EQ(ringBuffer_.readBlock(info), nullptr);
+	ASSERT_NE(ringBuffer_.writeBlock(), nullptr);
+}
+
+TEST_F(AudioRingBufferTest, Full)
+{
+	for (unsigned int i = 0; i < NumBlocks; i++)
+	{
+		ASSERT_TRUE(writeValue(ringBuffer_, static_cast<unsigned char>(i + 1)));
+		ASSERT_EQ(ringBuffer_.numReadableBlocks(), i + 1);
+	}
+
+	printf("Writing to a full ring buffer\n");
+	ASSERT_EQ(ringBuffer_.writeBlock(), nullptr);
+	ASSERT_FALSE(writeValue(ringBuffer_, 0));
+
+	for (unsigned int i = 0; i < NumBlocks; i++)
+		ASSERT_TRUE(readValue(ringBuffer_, static_cast<unsigned char>(i + 1)));
+	ASSERT_EQ(ringBuffer_.numReadableBlocks(), 0u);
+	ASSERT_FALSE(readValue(ringBuffer_, 0));
+}
+
+TEST_F(AudioRingBufferTest, BlockInfo)
+{
+	nc::AudioRingBuffer::BlockInfo writtenInfo;
+	writtenInfo.numBytes = BlockSize / 2;
+	writtenInfo.hasRewound = true;
+	writtenInfo.isLast = true;
+	ASSERT_NE(ringBuffer_.writeBlock(), nullptr);
+	ringBuffer_.commitWrite(writtenInfo);
+
+	printf("Reading the information attached to a block\n");
+	nc::AudioRingBuffer::BlockInfo readInfo;
+	ASSERT_NE(ringBuffer_.readBlock(readInfo), nullptr);
+	ASSERT_EQ(readInfo.numBytes, BlockSize / 2);
+	ASSERT_TRUE(readInfo.hasRewound);
+	ASSERT_TRUE(readInfo.isLast);
+}
+
+TEST_F(AudioRingBufferTest, WrapAround)
+{
+	// Indices run over twice the number of blocks, every wrap of both of them is exercised
+	const unsigned int NumRounds = 4 * NumBlocks + 1;
+
+	unsigned char writeValueIndex = 1;
+	unsigned char readValueIndex = 1;
+	for (unsigned int round = 0; round < NumRounds; round++)
+	{
+		printf("Round %u: writing three blocks and reading two\n", round);
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			if (ringBuffer_.numReadableBlocks() < NumBlocks)
+				ASSERT_TRUE(writeValue(ringBuffer_, writeValueIndex++));
+		}
+		for (unsigned int i = 0; i < 2; i++)
+			ASSERT_TRUE(readValue(ringBuffer_, readValueIndex++));
+		ASSERT_EQ(ringBuffer_.numReadableBlocks(), static_cast<unsigned int>(writeValueIndex - readValueIndex));
+	}
+
+	while (readValue(ringBuffer_, readValueIndex))
+		readValueIndex++;
+	ASSERT_EQ(readValueIndex, writeValueIndex);
+}
+
+TEST_F(AudioRingBufferTest, Clear)
+{
+	ASSERT_TRUE(writeValue(ringBuffer_, 1));
+	ASSERT_TRUE(writeValue(ringBuffer_, 2));
+	ASSERT_TRUE(readValue(ringBuffer_, 1));
+	ASSERT_TRUE(writeValue(ringBuffer_, 3));
+
+	printf("Clearing a ring buffer with two readable blocks\n");
+	ringBuffer_.clear();
+	ASSERT_EQ(ringBuffer_.numReadableBlocks(), 0u);
+	ASSERT_FALSE(readValue(ringBuffer_, 0));
+
+	// The whole capacity is available again
+	for (unsigned int i = 0; i < NumBlocks; i++)
+		ASSERT_TRUE(writeValue(ringBuffer_, static_cast<unsigned char>(i + 10)));
+	ASSERT_FALSE(writeValue(ringBuffer_, 0));
+	for (unsigned int i = 0; i < NumBlocks; i++)
+		ASSERT_TRUE(readValue(ringBuffer_, static_cast<unsigned char>(i + 10)));
+}
+
+}
@@ -0,0 +1,108 @@
+#include <nctl/Atomic.h>
+#include "AudioRingBuffer.h"
+#include "gtest/gtest.h"
+#include "test_thread_functions.h"
+#if !defined(_WIN32)
+	#include <sched.h>
+#endif
+
+namespace nc = ncine;
+
+namespace {
+
+const int NumThreads = 2;
+const unsigned int NumBlocks = 3;
+const unsigned int BlockSize = 64;
+const unsigned int NumWords = BlockSize / sizeof(uint32_t);
+const uint32_t NumIterations = 100000;
+
+/// Lets the other thread run while waiting for a block, it might share the same processor
+void yieldThread()
+{
+#if defined(_WIN32)
+	SwitchToThread();
+#else
+	sched_yield();
+#endif
+}
+
+class AudioRingBufferThreadsTest : public ::testing::Test
+{
+  public:
+	AudioRingBufferThreadsTest()
+	    : ringBuffer_(NumBlocks, BlockSize), numReadBlocks_(0), numErrors_(0), tr_(this) {}
+
+	/// Writes blocks filled with a counter, the last one is flagged
+	void produce()
+	{
+		for (uint32_t i = 0; i < NumIterations; i++)
+		{
+			char *block = nullptr;
+			while ((block = ringBuffer_.writeBlock()) == nullptr)
+				yieldThread();
+
+			uint32_t *words = reinterpret_cast<uint32_t *>(block);
+			for (unsigned int j = 0; j < NumWords; j++)
+				words[j] = i + j;
+
+			nc::AudioRingBuffer::BlockInfo info;
+			info.numBytes = i % BlockSize;
+			info.isLast = (i == NumIterations - 1);
+			ringBuffer_.commitWrite(info);
+		}
+	}
+
+	/// Reads blocks until the last one, checking that they arrive in order and intact
+	void consume()
+	{
+		bool isLast = false;
+		uint32_t i = 0;
+		while (isLast == false)
+		{
+			nc::AudioRingBuffer::BlockInfo info;
+			const char *block = nullptr;
+			while ((block = ringBuffer_.readBlock(info)) == nullptr)
+				yieldThread();
+
+			const uint32_t *words = reinterpret_cast<const uint32_t *>(block);
+			for (unsigned int j = 0; j < NumWords; j++)
+			{
+				if (words[j] != i + j)
+					numErrors_++;
+			}
+			if (info.numBytes != i % BlockSize)
+				numErrors_++;
+
+			isLast = info.isLast;
+			ringBuffer_.commitRead();
+			i++;
+		}
+		numReadBlocks_ = i;
+	}
+
+	nc::AudioRingBuffer ringBuffer_;
+	/// Decides which of the two threads is the producer
+	nctl::Atomic32 role_;
+	uint32_t numReadBlocks_;
+	nctl::Atomic32 numErrors_;
+	ThreadRunner<NumThreads> tr_;
+};
+
+TEST_F(AudioRingBufferThreadsTest, ProducerConsumer)
+{
+	tr_.runThreads([](void *arg) -> ThreadRunner<NumThreads>::threadFuncRet {
+		AudioRingBufferThreadsTest *obj = static_cast<AudioRingBufferThreadsTest *>(arg);
+		if (obj->role_.fetchAdd(1) == 0)
+			obj->produce();
+		else
+			obj->consume();
+		return obj->tr_.retFunc();
+	});
+
+	printf("Letting the producer and the consumer threads join after %u blocks\n", numReadBlocks_);
+	ASSERT_EQ(numReadBlocks_, NumIterations);
+	ASSERT_EQ(numErrors_.load(), 0);
+	ASSERT_EQ(ringBuffer_.numReadableBlocks(), 0u);
+}
+
+}
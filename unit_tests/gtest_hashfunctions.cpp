@@ -0,0 +1,87 @@
+#include <cstring>
+#include <nctl/HashFunctions.h>
+#include "gtest/gtest.h"
+
+namespace {
+
+const unsigned int MaxLength = 40;
+const unsigned int Padding = 16;
+const uint64_t Seed = 0x12345678ULL;
+
+/// Copies the sample data at an offset inside a buffer filled with a pattern
+unsigned char *placeData(unsigned char *buffer, unsigned int offset, unsigned int length, unsigned char pattern)
+{
+	memset(buffer, pattern, MaxLength + 2 * Padding);
+	unsigned char *data = buffer + offset;
+	for (unsigned int i = 0; i < length; i++)
+		data[i] = static_cast<unsigned char>(i * 7 + 1);
+	return data;
+}
+
+class HashFunctionsTest : public ::testing::Test
+{
+};
+
+TEST_F(HashFunctionsTest, IgnoreBytesAfterTheEnd)
+{
+	unsigned char firstBuffer[MaxLength + 2 * Padding];
+	unsigned char secondBuffer[MaxLength + 2 * Padding];
+
+	for (unsigned int length = 0; length <= MaxLength; length++)
+	{
+		printf("Hashing %u bytes followed by different contents\n", length);
+		const unsigned char *firstData = placeData(firstBuffer, Padding, length, 0x00);
+		const unsigned char *secondData = placeData(secondBuffer, Padding, length, 0xFF);
+
+		ASSERT_EQ(nctl::fasthash64(firstData, length, Seed), nctl::fasthash64(secondData, length, Seed));
+		ASSERT_EQ(nctl::fasthash32(firstData, length, Seed), nctl::fasthash32(secondData, length, Seed));
+	}
+}
+
+TEST_F(HashFunctionsTest, SameHashAtDifferentAlignments)
+{
+	unsigned char buffer[MaxLength + 2 * Padding];
+
+	for (unsigned int length = 0; length <= MaxLength; length++)
+	{
+		const unsigned char *alignedData = placeData(buffer, Padding, length, 0xAA);
+		const uint64_t alignedHash = nctl::fasthash64(alignedData, length, Seed);
+
+		for (unsigned int offset = 1; offset < 8; offset++)
+		{
+			printf("Hashing %u bytes at an offset of %u bytes\n", length, offset);
+			const unsigned char *data = placeData(buffer, Padding + offset, length, static_cast<unsigned char>(offset));
+			ASSERT_EQ(nctl::fasthash64(data, length, Seed), alignedHash);
+		}
+	}
+}
+
+TEST_F(HashFunctionsTest, EveryByteChangesTheHash)
+{
+	unsigned char buffer[MaxLength + 2 * Padding];
+
+	for (unsigned int length = 1; length <= MaxLength; length++)
+	{
+		unsigned char *data = placeData(buffer, Padding, length, 0x00);
+		const uint64_t hash = nctl::fasthash64(data, length, Seed);
+
+		for (unsigned int i = 0; i < length; i++)
+		{
+			data[i] ^= 0x80;
+			ASSERT_NE(nctl::fasthash64(data, length, Seed), hash);
+			data[i] ^= 0x80;
+		}
+	}
+}
+
+TEST_F(HashFunctionsTest, LengthAndSeedChangeTheHash)
+{
+	const unsigned char zeroes[16] = {};
+
+	printf("Hashing zeroes of different lengths and with different seeds\n");
+	ASSERT_NE(nctl::fasthash64(zeroes, 8, Seed), nctl::fasthash64(zeroes, 16, Seed));
+	ASSERT_NE(nctl::fasthash64(zeroes, 0, Seed), nctl::fasthash64(zeroes, 0, Seed + 1));
+	ASSERT_EQ(nctl::fasthash64(zeroes, 0, Seed), nctl::fasthash64(nullptr, 0, Seed));
+}
+
+}
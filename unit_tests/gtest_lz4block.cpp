@@ -0,0 +1,213 @@
+#include <cstring>
+#include <nctl/UniquePtr.h>
+#include <ncine/Random.h>
+#include "Lz4Block.h"
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const unsigned int Seed = 12345;
+
+/// Compresses and decompresses the data, returns the compressed size
+unsigned int roundTrip(const unsigned char *data, unsigned int size)
+{
+	const unsigned int capacity = nc::Lz4Block::compressBound(size);
+	nctl::UniquePtr<unsigned char[]> compressed = nctl::makeUnique<unsigned char[]>(capacity);
+	const unsigned int compressedSize = nc::Lz4Block::compress(data, size, compressed.get(), capacity);
+	EXPECT_GT(compressedSize, 0u);
+	EXPECT_LE(compressedSize, capacity);
+
+	// One more byte to check that nothing is written past the end
+	nctl::UniquePtr<unsigned char[]> decompressed = nctl::makeUnique<unsigned char[]>(size + 1);
+	decompressed[size] = 0xAB;
+	EXPECT_TRUE(nc::Lz4Block::decompress(compressed.get(), compressedSize, decompressed.get(), size));
+	EXPECT_EQ(memcmp(data, decompressed.get(), size), 0);
+	EXPECT_EQ(decompressed[size], 0xAB);
+
+	return compressedSize;
+}
+
+class Lz4BlockTest : public ::testing::Test
+{
+  public:
+	Lz4BlockTest()
+	    : random_(Seed, Seed) {}
+
+  protected:
+	/// Fills the array with random bytes, that cannot be compressed
+	void fillRandom(unsigned char *data, unsigned int size)
+	{
+		for (unsigned int i = 0; i < size; i++)
+			data[i] = static_cast<unsigned char>(random_.integer(0, 256));
+	}
+
+	/// Fills the array with a short repeating pattern
+	void fillRepetitive(unsigned char *data, unsigned int size)
+	{
+		const char Pattern[] = "nCine pattern ";
+		for (unsigned int i = 0; i < size; i++)
+			data[i] = static_cast<unsigned char>(Pattern[i % (sizeof(Pattern) - 1)]);
+	}
+
+	nc::Random random_;
+};
+
+TEST_F(Lz4BlockTest, RoundTripEmpty)
+{
+	const unsigned char data[1] = {};
+	printf("Compressing an empty input\n");
+	const unsigned int compressedSize = roundTrip(data, 0);
+
+	ASSERT_EQ(compressedSize, 1u);
+}
+
+TEST_F(Lz4BlockTest, RoundTripTiny)
+{
+	// Inputs this small are always stored as literals
+	unsigned char data[12];
+	fillRepetitive(data, 12);
+	for (unsigned int size = 1; size <= 12; size++)
+	{
+		printf("Compressing %u bytes\n", size);
+		const unsigned int compressedSize = roundTrip(data, size);
+		ASSERT_EQ(compressedSize, size + 1);
+	}
+}
+
+TEST_F(Lz4BlockTest, RoundTripIncompressible)
+{
+	const unsigned int Size = 64 * 1024;
+	nctl::UniquePtr<unsigned char[]> data = nctl::makeUnique<unsigned char[]>(Size);
+	fillRandom(data.get(), Size);
+
+	const unsigned int compressedSize = roundTrip(data.get(), Size);
+	printf("Random data of %u bytes compressed to %u bytes\n", Size, compressedSize);
+
+	ASSERT_LE(compressedSize, nc::Lz4Block::compressBound(Size));
+}
+
+TEST_F(Lz4BlockTest, RoundTripRepetitive)
+{
+	const unsigned int Size = 64 * 1024;
+	nctl::UniquePtr<unsigned char[]> data = nctl::makeUnique<unsigned char[]>(Size);
+	fillRepetitive(data.get(), Size);
+
+	const unsigned int compressedSize = roundTrip(data.get(), Size);
+	printf("Repetitive data of %u bytes compressed to %u bytes\n", Size, compressedSize);
+
+	ASSERT_LT(compressedSize, Size / 100);
+}
+
+TEST_F(Lz4BlockTest, RoundTripOverlappingMatches)
+{
+	// A run of the same byte is encoded as a match whose offset is shorter than its length
+	const unsigned int Size = 1000;
+	unsigned char data[Size];
+	memset(data, 'a', Size);
+	data[Size - 1] = 'b';
+
+	const unsigned int compressedSize = roundTrip(data, Size);
+	printf("A run of %u bytes compressed to %u bytes\n", Size, compressedSize);
+
+	ASSERT_LT(compressedSize, 20u);
+}
+
+TEST_F(Lz4BlockTest, DecompressOverlappingMatch)
+{
+	// One literal, a match with an offset of one and a length of nine, then five literals
+	const unsigned char compressed[] = { 0x15, 'a', 0x01, 0x00, 0x50, 'b', 'c', 'd', 'e', 'f' };
+	const char expected[] = "aaaaaaaaaabcdef";
+	unsigned char decompressed[15];
+
+	printf("Decompressing a stream with an overlapping match\n");
+	ASSERT_TRUE(nc::Lz4Block::decompress(compressed, sizeof(compressed), decompressed, 15));
+	ASSERT_EQ(memcmp(decompressed, expected, 15), 0);
+}
+
+TEST_F(Lz4BlockTest, RejectTruncated)
+{
+	const unsigned int Size = 4096;
+	unsigned char data[Size];
+	fillRepetitive(data, Size / 2);
+	fillRandom(data + Size / 2, Size / 2);
+
+	unsigned char compressed[Size + Size / 255 + 16];
+	const unsigned int compressedSize = nc::Lz4Block::compress(data, Size, compressed, sizeof(compressed));
+	ASSERT_GT(compressedSize, 0u);
+
+	unsigned char decompressed[Size];
+	for (unsigned int size = 0; size < compressedSize; size++)
+	{
+		printf("Decompressing %u bytes of %u\n", size, compressedSize);
+		ASSERT_FALSE(nc::Lz4Block::decompress(compressed, size, decompressed, Size));
+	}
+}
+
+TEST_F(Lz4BlockTest, RejectWrongSize)
+{
+	const unsigned int Size = 256;
+	unsigned char data[Size];
+	fillRepetitive(data, Size);
+
+	unsigned char compressed[Size + Size / 255 + 16];
+	const unsigned int compressedSize = nc::Lz4Block::compress(data, Size, compressed, sizeof(compressed));
+	ASSERT_GT(compressedSize, 0u);
+
+	unsigned char decompressed[Size + 1];
+	printf("Decompressing into a smaller and a bigger destination\n");
+	ASSERT_FALSE(nc::Lz4Block::decompress(compressed, compressedSize, decompressed, Size - 1));
+	ASSERT_FALSE(nc::Lz4Block::decompress(compressed, compressedSize, decompressed, Size + 1));
+}
+
+TEST_F(Lz4BlockTest, RejectCorruptStreams)
+{
+	unsigned char decompressed[64];
+
+	printf("Decompressing a match with a zero offset\n");
+	const unsigned char zeroOffset[] = { 0x10, 'a', 0x00, 0x00, 0x00 };
+	ASSERT_FALSE(nc::Lz4Block::decompress(zeroOffset, sizeof(zeroOffset), decompressed, 5));
+
+	printf("Decompressing a match that points before the start of the output\n");
+	const unsigned char farOffset[] = { 0x10, 'a', 0x02, 0x00, 0x00 };
+	ASSERT_FALSE(nc::Lz4Block::decompress(farOffset, sizeof(farOffset), decompressed, 5));
+
+	printf("Decompressing literals that go past the end of the input\n");
+	const unsigned char longLiterals[] = { 0x50, 'a', 'b' };
+	ASSERT_FALSE(nc::Lz4Block::decompress(longLiterals, sizeof(longLiterals), decompressed, 5));
+
+	printf("Decompressing a length that is not terminated\n");
+	const unsigned char unterminatedLength[] = { 0xF0, 0xFF, 0xFF };
+	ASSERT_FALSE(nc::Lz4Block::decompress(unterminatedLength, sizeof(unterminatedLength), decompressed, 64));
+
+	printf("Decompressing a match that goes past the end of the output\n");
+	const unsigned char longMatch[] = { 0x1F, 'a', 0x01, 0x00, 0x10 };
+	ASSERT_FALSE(nc::Lz4Block::decompress(longMatch, sizeof(longMatch), decompressed, 10));
+}
+
+TEST_F(Lz4BlockTest, RejectRandomCorruption)
+{
+	const unsigned int Size = 4096;
+	unsigned char data[Size];
+	fillRepetitive(data, Size);
+
+	unsigned char compressed[Size + Size / 255 + 16];
+	const unsigned int compressedSize = nc::Lz4Block::compress(data, Size, compressed, sizeof(compressed));
+	ASSERT_GT(compressedSize, 0u);
+
+	// Corrupt streams either fail or decompress to different data, they never write past the destination
+	unsigned char decompressed[Size + 1];
+	printf("Decompressing streams with a corrupt byte\n");
+	for (unsigned int i = 0; i < compressedSize; i++)
+	{
+		const unsigned char original = compressed[i];
+		compressed[i] = static_cast<unsigned char>(random_.integer(0, 256));
+		decompressed[Size] = 0xAB;
+		nc::Lz4Block::decompress(compressed, compressedSize, decompressed, Size);
+		ASSERT_EQ(decompressed[Size], 0xAB);
+		compressed[i] = original;
+	}
+}
+
+}
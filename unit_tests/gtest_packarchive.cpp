@@ -0,0 +1,220 @@
+#include <cstring>
+#include <nctl/String.h>
+#include <nctl/UniquePtr.h>
+#include <ncine/FileSystem.h>
+#include <ncine/IFile.h>
+#include <ncine/PackArchive.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const char *DirectoryName = "TestPackDir";
+const char *SubDirectoryName = "TestPackDir/SubDir";
+const char *PackName = "TestPack.pak";
+const char *CorruptPackName = "TestPackCorrupt.pak";
+const char *RootPath = "TestPackRoot";
+
+const char *TextFile = "Text.txt";
+const char *BinaryFile = "SubDir/Binary.bin";
+const char *EmptyFile = "Empty.txt";
+
+const unsigned int TextSize = 10000;
+const unsigned int BinarySize = 5000;
+
+/// The offset of the first index entry and of the fields inside an entry
+const unsigned int FirstEntryOffset = 32;
+const unsigned int EntryOffsetField = 8;
+const unsigned int EntrySizeField = 16;
+
+void fillText(unsigned char *data, unsigned int size)
+{
+	const char Pattern[] = "The quick brown fox jumps over the lazy dog. ";
+	for (unsigned int i = 0; i < size; i++)
+		data[i] = static_cast<unsigned char>(Pattern[i % (sizeof(Pattern) - 1)]);
+}
+
+void fillBinary(unsigned char *data, unsigned int size)
+{
+	uint32_t state = 12345;
+	for (unsigned int i = 0; i < size; i++)
+	{
+		state = state * 1664525U + 1013904223U;
+		data[i] = static_cast<unsigned char>(state >> 24);
+	}
+}
+
+void writeFile(const char *path, const unsigned char *data, unsigned int size)
+{
+	nctl::UniquePtr<nc::IFile> file = nc::IFile::createFileHandle(path);
+	file->open(nc::IFile::OpenMode::WRITE | nc::IFile::OpenMode::BINARY);
+	if (size > 0)
+		file->write(data, size);
+	file->close();
+}
+
+nctl::UniquePtr<unsigned char[]> readFile(const char *path, long int &size)
+{
+	nctl::UniquePtr<nc::IFile> file = nc::IFile::createFileHandle(path);
+	file->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+	size = file->isOpened() ? file->size() : -1;
+	nctl::UniquePtr<unsigned char[]> data = nctl::makeUnique<unsigned char[]>(size > 0 ? size : 1);
+	if (size > 0)
+		file->read(data.get(), size);
+	return data;
+}
+
+/// Returns true if the file read from the root path has the expected contents
+bool hasContents(const char *filename, const unsigned char *expected, unsigned int expectedSize)
+{
+	long int size = 0;
+	nctl::UniquePtr<unsigned char[]> data = readFile(nc::FileSystem::joinPath(RootPath, filename).data(), size);
+	return (size == static_cast<long int>(expectedSize) && memcmp(data.get(), expected, expectedSize) == 0);
+}
+
+/// Writes a copy of the pack archive with a field of the first index entry replaced
+void writeCorruptPack(unsigned int fieldOffset, const void *value, unsigned int valueSize)
+{
+	long int size = 0;
+	nctl::UniquePtr<unsigned char[]> data = readFile(PackName, size);
+	memcpy(data.get() + FirstEntryOffset + fieldOffset, value, valueSize);
+	writeFile(CorruptPackName, data.get(), static_cast<unsigned int>(size));
+}
+
+class PackArchiveTest : public ::testing::Test
+{
+  protected:
+	void SetUp() override
+	{
+		fillText(text_, TextSize);
+		fillBinary(binary_, BinarySize);
+
+		nc::FileSystem::createDir(DirectoryName);
+		nc::FileSystem::createDir(SubDirectoryName);
+		writeFile(nc::FileSystem::joinPath(DirectoryName, TextFile).data(), text_, TextSize);
+		writeFile(nc::FileSystem::joinPath(DirectoryName, BinaryFile).data(), binary_, BinarySize);
+		writeFile(nc::FileSystem::joinPath(DirectoryName, EmptyFile).data(), nullptr, 0);
+	}
+
+	void TearDown() override
+	{
+		nc::PackArchive::unmountAll();
+		nc::FileSystem::deleteFile(nc::FileSystem::joinPath(DirectoryName, TextFile).data());
+		nc::FileSystem::deleteFile(nc::FileSystem::joinPath(DirectoryName, BinaryFile).data());
+		nc::FileSystem::deleteFile(nc::FileSystem::joinPath(DirectoryName, EmptyFile).data());
+		nc::FileSystem::deleteEmptyDir(SubDirectoryName);
+		nc::FileSystem::deleteEmptyDir(DirectoryName);
+		nc::FileSystem::deleteFile(PackName);
+		nc::FileSystem::deleteFile(CorruptPackName);
+	}
+
+	unsigned char text_[TextSize];
+	unsigned char binary_[BinarySize];
+};
+
+TEST_F(PackArchiveTest, BuildMountAndRead)
+{
+	printf("Building a pack archive without compression\n");
+	ASSERT_TRUE(nc::PackArchive::build(DirectoryName, PackName, false));
+	ASSERT_TRUE(nc::PackArchive::mount(PackName, RootPath));
+	ASSERT_EQ(nc::PackArchive::numMounted(), 1u);
+
+	ASSERT_TRUE(hasContents(TextFile, text_, TextSize));
+	ASSERT_TRUE(hasContents(BinaryFile, binary_, BinarySize));
+	ASSERT_TRUE(hasContents(EmptyFile, text_, 0));
+}
+
+TEST_F(PackArchiveTest, BuildCompressedMountAndRead)
+{
+	printf("Building a pack archive with compression\n");
+	ASSERT_TRUE(nc::PackArchive::build(DirectoryName, PackName, true));
+	ASSERT_LT(nc::FileSystem::fileSize(PackName), static_cast<long int>(TextSize + BinarySize));
+	ASSERT_TRUE(nc::PackArchive::mount(PackName, RootPath));
+
+	ASSERT_TRUE(hasContents(TextFile, text_, TextSize));
+	ASSERT_TRUE(hasContents(BinaryFile, binary_, BinarySize));
+	ASSERT_TRUE(hasContents(EmptyFile, text_, 0));
+}
+
+TEST_F(PackArchiveTest, Lookup)
+{
+	ASSERT_TRUE(nc::PackArchive::build(DirectoryName, PackName, true));
+	ASSERT_TRUE(nc::PackArchive::mount(PackName, RootPath));
+
+	printf("Looking up packed files with different path separators\n");
+	ASSERT_TRUE(nc::PackArchive::contains("TestPackRoot/Text.txt"));
+	ASSERT_TRUE(nc::PackArchive::contains("TestPackRoot/./SubDir/Binary.bin"));
+	ASSERT_TRUE(nc::PackArchive::contains("TestPackRoot\\SubDir\\Binary.bin"));
+
+	printf("Looking up files that are not packed\n");
+	ASSERT_FALSE(nc::PackArchive::contains("TestPackRoot/Missing.txt"));
+	ASSERT_FALSE(nc::PackArchive::contains("TestPackRoot/SubDir"));
+	ASSERT_FALSE(nc::PackArchive::contains("Text.txt"));
+	ASSERT_FALSE(nc::PackArchive::contains(PackName));
+}
+
+TEST_F(PackArchiveTest, MountTwiceAndUnmount)
+{
+	ASSERT_TRUE(nc::PackArchive::build(DirectoryName, PackName, false));
+	ASSERT_TRUE(nc::PackArchive::mount(PackName, RootPath));
+
+	printf("Mounting the same pack archive twice\n");
+	ASSERT_FALSE(nc::PackArchive::mount(PackName, RootPath));
+	ASSERT_EQ(nc::PackArchive::numMounted(), 1u);
+
+	printf("Unmounting the pack archive\n");
+	ASSERT_TRUE(nc::PackArchive::unmount(PackName));
+	ASSERT_FALSE(nc::PackArchive::unmount(PackName));
+	ASSERT_EQ(nc::PackArchive::numMounted(), 0u);
+	ASSERT_FALSE(nc::PackArchive::contains("TestPackRoot/Text.txt"));
+}
+
+TEST_F(PackArchiveTest, RejectNotAPack)
+{
+	printf("Mounting a file that is not a pack archive\n");
+	writeFile(CorruptPackName, text_, TextSize);
+	ASSERT_FALSE(nc::PackArchive::mount(CorruptPackName, RootPath));
+	ASSERT_EQ(nc::PackArchive::numMounted(), 0u);
+}
+
+TEST_F(PackArchiveTest, RejectTruncatedIndex)
+{
+	ASSERT_TRUE(nc::PackArchive::build(DirectoryName, PackName, false));
+
+	printf("Mounting a pack archive with too many entries\n");
+	const uint32_t numEntries = nc::IFile::int32FromLE(0x08000000);
+	long int size = 0;
+	nctl::UniquePtr<unsigned char[]> data = readFile(PackName, size);
+	memcpy(data.get() + 8, &numEntries, sizeof(uint32_t));
+	writeFile(CorruptPackName, data.get(), static_cast<unsigned int>(size));
+	ASSERT_FALSE(nc::PackArchive::mount(CorruptPackName, RootPath));
+
+	printf("Mounting a pack archive cut in the middle of the index\n");
+	writeFile(CorruptPackName, data.get(), FirstEntryOffset + 8);
+	ASSERT_FALSE(nc::PackArchive::mount(CorruptPackName, RootPath));
+	ASSERT_EQ(nc::PackArchive::numMounted(), 0u);
+}
+
+TEST_F(PackArchiveTest, RejectCorruptIndexEntry)
+{
+	ASSERT_TRUE(nc::PackArchive::build(DirectoryName, PackName, false));
+
+	printf("Mounting a pack archive with an offset past the end\n");
+	const uint64_t offset = nc::IFile::int64FromLE(nc::FileSystem::fileSize(PackName) + 1);
+	writeCorruptPack(EntryOffsetField, &offset, sizeof(uint64_t));
+	ASSERT_FALSE(nc::PackArchive::mount(CorruptPackName, RootPath));
+
+	printf("Mounting a pack archive with an offset that wraps around\n");
+	const uint64_t wrappingOffset = nc::IFile::int64FromLE(~uint64_t(0) - 16);
+	writeCorruptPack(EntryOffsetField, &wrappingOffset, sizeof(uint64_t));
+	ASSERT_FALSE(nc::PackArchive::mount(CorruptPackName, RootPath));
+
+	printf("Mounting a pack archive with a stored entry bigger than its data\n");
+	const uint32_t entrySize = nc::IFile::int32FromLE(TextSize + BinarySize);
+	writeCorruptPack(EntrySizeField, &entrySize, sizeof(uint32_t));
+	ASSERT_FALSE(nc::PackArchive::mount(CorruptPackName, RootPath));
+	ASSERT_EQ(nc::PackArchive::numMounted(), 0u);
+}
+
+}
@@ -0,0 +1,193 @@
+#include <ncine/PCApplication.h>
+#include <ncine/IAppEventHandler.h>
+#include <ncine/AppConfiguration.h>
+#include <ncine/HeadlessGL.h>
+#include <ncine/Texture.h>
+#include <ncine/Sprite.h>
+#include <ncine/Shader.h>
+#include <ncine/ShaderState.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const char *FragmentSource = R"(
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+uniform sampler2D uTexture;
+uniform float uIntensity;
+in vec2 vTexCoords;
+out vec4 fragColor;
+
+void main()
+{
+	fragColor = texture(uTexture, vTexCoords) * uIntensity;
+}
+)";
+
+/// Number of frames the driver takes to link the shader
+const unsigned int LinkingFrames = 4;
+
+/// What has been observed in a frame
+struct FrameResult
+{
+	bool isLinking = false;
+	bool isShaderPending = false;
+	bool canSetUniform = false;
+	/// Draw calls issued by the previous frame
+	uint64_t numDrawCalls = 0;
+};
+
+const unsigned int NumFrames = 4 * LinkingFrames;
+FrameResult frameResults[NumFrames];
+bool linkingAfterLoad = false;
+bool pendingAfterSet = false;
+
+/// Loads a custom shader while the headless driver reports that linking has not completed, then reloads it
+class AsyncShaderEventHandler : public nc::IAppEventHandler
+{
+  public:
+	void onPreInit(nc::AppConfiguration &config) override
+	{
+		config.withAudio = false;
+		config.withThreads = false;
+		config.withDebugOverlay = false;
+		config.useAsyncShaderCompilation = true;
+		config.consoleLogLevel = nc::ILogger::LogLevel::ERROR;
+	}
+
+	void onInit() override
+	{
+		texture_ = nctl::makeUnique<nc::Texture>("Texture", nc::Texture::Format::RGBA8, 8, 8);
+		sprite_ = nctl::makeUnique<nc::Sprite>(&nc::theApplication().rootNode(), texture_.get(), 100.0f, 100.0f);
+
+		nc::HeadlessGL::setCompilationCompleted(false);
+		shader_ = nctl::makeUnique<nc::Shader>();
+		shader_->loadFromMemory("AsyncShader", nc::Shader::Introspection::ENABLED, nc::Shader::DefaultVertex::SPRITE, FragmentSource);
+		linkingAfterLoad = shader_->isLinking();
+
+		shaderState_ = nctl::makeUnique<nc::ShaderState>(sprite_.get(), shader_.get());
+		pendingAfterSet = shaderState_->isShaderPending();
+	}
+
+	void onFrameStart() override
+	{
+		FrameResult &result = frameResults[frame_];
+		result.isLinking = shader_->isLinking();
+		result.isShaderPending = shaderState_->isShaderPending();
+		result.canSetUniform = shaderState_->setUniformFloat(nullptr, "uIntensity", 1.0f);
+		result.numDrawCalls = nc::HeadlessGL::frameCounters().numDrawCalls;
+
+		frame_++;
+		if (frame_ == LinkingFrames || frame_ == 3 * LinkingFrames)
+			nc::HeadlessGL::setCompilationCompleted(true);
+		else if (frame_ == 2 * LinkingFrames)
+		{
+			// Loading new data into the shader while the node uses it
+			nc::HeadlessGL::setCompilationCompleted(false);
+			shader_->loadFromMemory("AsyncShader", nc::Shader::Introspection::ENABLED, nc::Shader::DefaultVertex::SPRITE, FragmentSource);
+			shaderState_->resetShader();
+		}
+		else if (frame_ == NumFrames)
+			nc::theApplication().quit();
+	}
+
+	void onShutdown() override
+	{
+		shaderState_.reset(nullptr);
+		shader_.reset(nullptr);
+		sprite_.reset(nullptr);
+		texture_.reset(nullptr);
+		nc::HeadlessGL::setCompilationCompleted(true);
+	}
+
+  private:
+	unsigned int frame_ = 0;
+	nctl::UniquePtr<nc::Texture> texture_;
+	nctl::UniquePtr<nc::Sprite> sprite_;
+	nctl::UniquePtr<nc::Shader> shader_;
+	nctl::UniquePtr<nc::ShaderState> shaderState_;
+};
+
+nctl::UniquePtr<nc::IAppEventHandler> createAppEventHandler()
+{
+	return nctl::makeUnique<AsyncShaderEventHandler>();
+}
+
+class ShaderStateAsyncTest : public ::testing::Test
+{
+  public:
+	static void SetUpTestCase()
+	{
+		char programName[] = "gtest_shaderstate_async";
+		char *argv[] = { programName };
+		nc::PCApplication::start(createAppEventHandler, 1, argv);
+	}
+};
+
+TEST_F(ShaderStateAsyncTest, PendingWhileLinking)
+{
+	printf("Setting a shader that is still linking\n");
+	ASSERT_TRUE(linkingAfterLoad);
+	ASSERT_TRUE(pendingAfterSet);
+
+	for (unsigned int i = 0; i < LinkingFrames; i++)
+	{
+		printf("Frame %u: linking: %d, pending: %d, draw calls: %lu\n", i, frameResults[i].isLinking,
+		       frameResults[i].isShaderPending, static_cast<unsigned long>(frameResults[i].numDrawCalls));
+		// Nothing has queried the program and stalled until the driver completes it
+		ASSERT_TRUE(frameResults[i].isLinking);
+		ASSERT_TRUE(frameResults[i].isShaderPending);
+		ASSERT_FALSE(frameResults[i].canSetUniform);
+	}
+}
+
+TEST_F(ShaderStateAsyncTest, DrawWithPreviousProgramWhileLinking)
+{
+	// The first frame reports the draw calls of the initialization
+	for (unsigned int i = 1; i < LinkingFrames; i++)
+	{
+		printf("Frame %u: draw calls: %lu\n", i, static_cast<unsigned long>(frameResults[i].numDrawCalls));
+		ASSERT_EQ(frameResults[i].numDrawCalls, 1u);
+	}
+}
+
+TEST_F(ShaderStateAsyncTest, AppliedWhenLinked)
+{
+	for (unsigned int i = LinkingFrames; i < 2 * LinkingFrames; i++)
+	{
+		printf("Frame %u: linking: %d, pending: %d, draw calls: %lu\n", i, frameResults[i].isLinking,
+		       frameResults[i].isShaderPending, static_cast<unsigned long>(frameResults[i].numDrawCalls));
+		ASSERT_FALSE(frameResults[i].isLinking);
+		ASSERT_FALSE(frameResults[i].isShaderPending);
+		ASSERT_TRUE(frameResults[i].canSetUniform);
+		ASSERT_EQ(frameResults[i].numDrawCalls, 1u);
+	}
+}
+
+TEST_F(ShaderStateAsyncTest, FallBackWhileReloading)
+{
+	for (unsigned int i = 2 * LinkingFrames; i < 3 * LinkingFrames; i++)
+	{
+		printf("Frame %u: linking: %d, pending: %d, draw calls: %lu\n", i, frameResults[i].isLinking,
+		       frameResults[i].isShaderPending, static_cast<unsigned long>(frameResults[i].numDrawCalls));
+		ASSERT_TRUE(frameResults[i].isLinking);
+		ASSERT_TRUE(frameResults[i].isShaderPending);
+		ASSERT_FALSE(frameResults[i].canSetUniform);
+		ASSERT_EQ(frameResults[i].numDrawCalls, 1u);
+	}
+
+	for (unsigned int i = 3 * LinkingFrames; i < NumFrames; i++)
+	{
+		printf("Frame %u: linking: %d, pending: %d, draw calls: %lu\n", i, frameResults[i].isLinking,
+		       frameResults[i].isShaderPending, static_cast<unsigned long>(frameResults[i].numDrawCalls));
+		ASSERT_FALSE(frameResults[i].isLinking);
+		ASSERT_FALSE(frameResults[i].isShaderPending);
+		ASSERT_TRUE(frameResults[i].canSetUniform);
+	}
+}
+
+}